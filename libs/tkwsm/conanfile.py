@@ -21,7 +21,7 @@ required_conan_version = ">=2.4"
 
 class TkwsmConan(ConanFile):
     name = "tkwsm"
-    version = "0.3.13"
+    version = "0.3.15"
     package_type = "library"
     license = "Apache 2"
     url = "https://github.com/quantinuum/tket"
@@ -15,19 +15,16 @@
 #pragma once
 #include <chrono>
 #include <memory>
+#include <vector>
 
 #include "../GraphTheoretic/NeighboursData.hpp"
 #include "../GraphTheoretic/VertexRelabelling.hpp"
-#include "../Searching/SearchBranch.hpp"
 #include "MainSolverParameters.hpp"
 #include "SolutionData.hpp"
 
 namespace tket {
 namespace WeightedSubgraphMonomorphism {
 
-struct PreSearchComponents;
-struct SearchComponents;
-
 /** The main class which takes a raw WSM problem and tries to solve it. */
 class MainSolver {
  public:
@@ -69,18 +66,13 @@ class MainSolver {
   SolutionData m_solution_data;
   mutable SolutionData m_solution_data_original_vertices;
 
+  /** Searches a part of the problem; defined in the .cpp file. */
+  class Worker;
+
   // If the problem is trivially insoluble, no need to spend time constructing
-  // these.
-  std::unique_ptr<PreSearchComponents> m_pre_search_components_ptr;
-  std::unique_ptr<SearchComponents> m_search_components_ptr;
-  std::unique_ptr<SearchBranch> m_search_branch_ptr;
-
-  /** Do NOT backtrack, just move down directly from the current node as far as
-   * possible, i.e. a single solve iteration. Returns TRUE if we end with a full
-   * solution, false otherwise.
-   */
-  bool move_down_from_reduced_node(
-      const SearchBranch::ReductionParameters& reduction_parameters);
+  // these. With several threads, the domain of one pattern vertex is split
+  // between the workers; otherwise there is a single worker.
+  std::vector<std::unique_ptr<Worker>> m_workers;
 
   /** Performs the solve.
    * We should NOT time things by timing each individual iteration and summing
@@ -92,9 +84,18 @@ class MainSolver {
       const MainSolverParameters& parameters, std::size_t max_iterations,
       const std::chrono::steady_clock::time_point& desired_end_time);
 
-  void add_solution_from_final_node(
-      const MainSolverParameters& parameters,
-      const SearchBranch::ReductionParameters& reduction_parameters);
+  /** With several workers, run them concurrently for one round of
+   * iterations, each using the best weight found by any worker before the
+   * round began for pruning.
+   */
+  void solve_round(
+      const MainSolverParameters& parameters, std::size_t max_iterations,
+      const std::chrono::steady_clock::time_point& desired_end_time);
+
+  /** Combine the iterations, solutions and statistics of the workers
+   * into m_solution_data, in worker order.
+   */
+  void merge_worker_solution_data(const MainSolverParameters& parameters);
 };
 
 }  // namespace WeightedSubgraphMonomorphism
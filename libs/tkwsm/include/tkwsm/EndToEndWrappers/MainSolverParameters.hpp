@@ -73,6 +73,20 @@ struct MainSolverParameters {
    */
   unsigned max_distance_for_distance_reduction_during_search;
 
+  /** How many threads to search with. If more than one, the domain of a
+   * pattern vertex is split between that many workers, which search their
+   * parts concurrently and share the best solution weight found so far
+   * after every round of iterations. The result depends only on this and
+   * rng_seed, not on thread timings (timeouts aside).
+   * Fixed when the MainSolver is constructed.
+   */
+  unsigned number_of_threads;
+
+  /** Seeds the random choices made during the search. With several threads,
+   * worker i uses rng_seed + i. Fixed when the MainSolver is constructed.
+   */
+  std::size_t rng_seed;
+
   /** Just set the timeout in milliseconds; the most common parameter. */
   explicit MainSolverParameters(long long timeout_ms = 1000);
 };
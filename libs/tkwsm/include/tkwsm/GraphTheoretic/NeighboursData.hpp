@@ -15,6 +15,7 @@
 #pragma once
 #include <map>
 #include <optional>
+#include <span>
 #include <utility>
 
 #include "GeneralStructs.hpp"
@@ -78,12 +79,13 @@ class NeighboursData {
 
   /** Return all the neighbouring vertices of v, together with
    * the edge weights, sorted by neighbouring vertex.
-   * The data is stored within this class, so time O(log (number of V)).
+   * The data is stored contiguously within this class, so time O(1).
    * @param v A vertex.
    * @return The neighbours of v and edge weights, sorted by vertex number.
+   *    A view into this object, valid for as long as it exists.
    */
-  const std::vector<std::pair<VertexWSM, WeightWSM>>&
-  get_neighbours_and_weights(VertexWSM v) const;
+  std::span<const std::pair<VertexWSM, WeightWSM>> get_neighbours_and_weights(
+      VertexWSM v) const;
 
   /** Get the list of vertex degrees of all neighbours of v, sorted in
    * increasing order.
@@ -112,12 +114,14 @@ class NeighboursData {
   std::vector<WeightWSM> get_weights_expensive() const;
 
  private:
-  // Element[i] gives all neighbouring vertices and edge weights
-  // for vertex i, sorted by the neighbouring vertex numerical value.
-  std::vector<std::vector<std::pair<VertexWSM, WeightWSM>>>
-      m_neighbours_and_weights;
-
-  std::vector<std::pair<VertexWSM, WeightWSM>> m_empty_data;
+  // Compressed sparse row storage. The neighbouring vertices and edge
+  // weights of vertex i are the elements with indices in
+  // [ m_offsets[i], m_offsets[i+1] ) of m_neighbours_and_weights,
+  // sorted by the neighbouring vertex numerical value.
+  // Thus m_offsets has size (number of vertices) + 1.
+  std::vector<std::size_t> m_offsets;
+
+  std::vector<std::pair<VertexWSM, WeightWSM>> m_neighbours_and_weights;
 
   std::size_t m_number_of_edges;
 };
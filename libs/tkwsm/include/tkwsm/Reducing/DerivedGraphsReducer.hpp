@@ -61,6 +61,10 @@ class DerivedGraphsReducer : public ReducerInterface {
   DerivedGraphs m_derived_pattern_graphs;
   DerivedGraphs m_derived_target_graphs;
 
+  // The set of target vertices to intersect domains with,
+  // reused between pattern vertices.
+  boost::dynamic_bitset<> m_target_mask;
+
   // We will call this several times with different derived graphs data.
   ReductionResult reduce_with_derived_data(
       const DerivedGraphStructs::NeighboursAndCounts&
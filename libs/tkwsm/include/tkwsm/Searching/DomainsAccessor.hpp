@@ -148,8 +148,7 @@ class DomainsAccessor {
   /** Simply intersect Domain(PV) with the specified set of TV, represented
    * by a bitset. For speed, uses the "swap" function (similar to vector::swap
    * and set::swap - time O(1), no copies) - which thus alters domain_mask.
-   * We should have an intersect function WITHOUT doing this -
-   * the operator -= function should work.
+   * Use intersect_domain instead if the mask is to be reused.
    * We check for and update new assignments if necessary.
    * @param pattern_v The pattern vertex.
    * @param domain_mask A set of target vertices to intersect with the domain;
@@ -159,6 +158,35 @@ class DomainsAccessor {
   IntersectionResult intersect_domain_with_swap(
       VertexWSM pattern_v, boost::dynamic_bitset<>& domain_mask);
 
+  /** As intersect_domain_with_swap, but leaves domain_mask unchanged,
+   * so that it can be reused for other pattern vertices.
+   * If the domain is already a subset of the mask (common during reduction),
+   * no copy is made.
+   * @param pattern_v The pattern vertex.
+   * @param domain_mask A set of target vertices to intersect with the domain.
+   * @param work_bitset An extra bitset, to avoid memory reallocation.
+   * @return The result of changing the domain.
+   */
+  IntersectionResult intersect_domain(
+      VertexWSM pattern_v, const boost::dynamic_bitset<>& domain_mask,
+      boost::dynamic_bitset<>& work_bitset);
+
+  /** Intersect Domain(PV) with the same mask, for every PV in the given set.
+   * We continue to the end even if new assignments are found (so that
+   * the caller's reduction is fully processed), but stop immediately
+   * if a nogood is found.
+   * @param pattern_vertices The set of pattern vertices whose domains
+   * are to be reduced.
+   * @param domain_mask A set of target vertices to intersect with each domain.
+   * @param work_bitset An extra bitset, to avoid memory reallocation.
+   * @return NOGOOD if any domain became empty, NEW_ASSIGNMENTS if any
+   * domain became a singleton, otherwise SUCCESS.
+   */
+  ReductionResult intersect_domains(
+      const boost::dynamic_bitset<>& pattern_vertices,
+      const boost::dynamic_bitset<>& domain_mask,
+      boost::dynamic_bitset<>& work_bitset);
+
  private:
   NodesRawData& m_raw_data;
 };
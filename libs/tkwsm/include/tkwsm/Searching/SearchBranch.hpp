@@ -126,8 +126,9 @@ class SearchBranch {
    * (Also, we don't need to store the impossible ones,
    * since the caller should erase them from all data as soon as they fail
    * the checks).
+   * Element[pv] is the set of checked tv, so lookup is a single bit test.
    */
-  PossibleAssignments m_checked_assignments;
+  std::vector<boost::dynamic_bitset<>> m_checked_assignments;
 
   std::unique_ptr<WeightChecker> m_weight_checker_ptr;
 
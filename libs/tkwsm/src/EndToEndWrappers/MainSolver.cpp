@@ -16,13 +16,16 @@
 
 #include <algorithm>
 #include <chrono>
+#include <exception>
 #include <numeric>
+#include <thread>
 #include <tkassert/Assert.hpp>
 
 #include "tkwsm/Common/GeneralUtils.hpp"
 #include "tkwsm/EndToEndWrappers/PreSearchComponents.hpp"
 #include "tkwsm/EndToEndWrappers/SearchComponents.hpp"
 #include "tkwsm/GraphTheoretic/DomainInitialiser.hpp"
+#include "tkwsm/Searching/SearchBranch.hpp"
 #include "tkwsm/WeightPruning/WeightChecker.hpp"
 
 namespace tket {
@@ -30,6 +33,122 @@ namespace WeightedSubgraphMonomorphism {
 
 typedef std::chrono::steady_clock Clock;
 
+// With several workers, they share the best weight found so far
+// after each round of this many iterations (per worker).
+static constexpr std::size_t ITERATIONS_PER_ROUND = 1000;
+
+static bool terminate_with_enough_full_solutions(
+    const MainSolverParameters& parameters, const SolutionData& solution_data) {
+  if (parameters.for_multiple_full_solutions_the_max_number_to_obtain == 0) {
+    return parameters.terminate_with_first_full_solution &&
+           !solution_data.solutions.empty();
+  }
+  return solution_data.solutions.size() >=
+         parameters.for_multiple_full_solutions_the_max_number_to_obtain;
+}
+
+class MainSolver::Worker {
+ public:
+  /** The search data, solutions and statistics of this worker only. */
+  SolutionData solution_data;
+
+  Worker(
+      const DomainInitialiser::InitialDomains& initial_domains,
+      const NeighboursData& pattern_ndata, const NeighboursData& target_ndata,
+      std::unique_ptr<PreSearchComponents> pre_search_components_ptr,
+      const MainSolverParameters& parameters, std::size_t rng_seed)
+      : m_target_ndata(target_ndata),
+        m_pre_search_components_ptr(std::move(pre_search_components_ptr)) {
+    TKET_ASSERT(m_pre_search_components_ptr);
+    m_search_components.rng.set_seed(rng_seed);
+    m_search_branch_ptr = std::make_unique<SearchBranch>(
+        initial_domains, pattern_ndata,
+        m_pre_search_components_ptr->pattern_near_ndata, target_ndata,
+        m_pre_search_components_ptr->target_near_ndata,
+        parameters.max_distance_for_distance_reduction_during_search,
+        solution_data.extra_statistics);
+  }
+
+  SearchBranch& get_search_branch() { return *m_search_branch_ptr; }
+
+  /** Search until this worker has done max_iterations in total,
+   * or the time is up, or it has finished.
+   * @param parameters The parameters which configure the solving algorithm.
+   * @param max_iterations The cumulative iterations of this worker to stop at.
+   * @param desired_end_time When to stop.
+   * @param best_weight_elsewhere If set, only look for solutions of strictly
+   * smaller weight than this (found by another worker).
+   */
+  void solve(
+      const MainSolverParameters& parameters, std::size_t max_iterations,
+      const Clock::time_point& desired_end_time,
+      std::optional<WeightWSM> best_weight_elsewhere);
+
+ private:
+  const NeighboursData& m_target_ndata;
+  std::unique_ptr<PreSearchComponents> m_pre_search_components_ptr;
+  SearchComponents m_search_components;
+  std::unique_ptr<SearchBranch> m_search_branch_ptr;
+
+  /** Do NOT backtrack, just move down directly from the current node as far as
+   * possible, i.e. a single solve iteration. Returns TRUE if we end with a full
+   * solution, false otherwise.
+   */
+  bool move_down_from_reduced_node(
+      const SearchBranch::ReductionParameters& reduction_parameters);
+
+  void add_solution_from_final_node(
+      const MainSolverParameters& parameters,
+      const SearchBranch::ReductionParameters& reduction_parameters);
+};
+
+// Split the initial domains into (at most) the given number of parts,
+// by sharing out the domain of one pattern vertex; every solution
+// lies in exactly one part. Prefer the smallest domain which can be
+// split into that many parts, as the search would choose a small
+// domain first anyway.
+static std::vector<DomainInitialiser::InitialDomains> split_initial_domains(
+    const DomainInitialiser::InitialDomains& initial_domains,
+    unsigned number_of_parts) {
+  std::optional<VertexWSM> pv_to_split;
+  std::size_t size_to_split = 0;
+  if (number_of_parts > 1) {
+    for (unsigned pv = 0; pv < initial_domains.size(); ++pv) {
+      const std::size_t size = initial_domains[pv].count();
+      if (size < 2) {
+        continue;
+      }
+      const bool can_split = size >= number_of_parts;
+      const bool best_can_split = size_to_split >= number_of_parts;
+      const bool better =
+          can_split ? !best_can_split || size < size_to_split
+                    : !best_can_split && size > size_to_split;
+      if (!pv_to_split || better) {
+        pv_to_split = pv;
+        size_to_split = size;
+      }
+    }
+  }
+  if (!pv_to_split) {
+    return {initial_domains};
+  }
+  const std::size_t actual_number_of_parts =
+      std::min<std::size_t>(number_of_parts, size_to_split);
+  std::vector<DomainInitialiser::InitialDomains> parts(
+      actual_number_of_parts, initial_domains);
+  for (auto& part : parts) {
+    part[pv_to_split.value()].reset();
+  }
+  const boost::dynamic_bitset<>& domain = initial_domains[pv_to_split.value()];
+  std::size_t counter = 0;
+  for (auto tv = domain.find_first(); tv < domain.size();
+       tv = domain.find_next(tv)) {
+    parts[counter % actual_number_of_parts][pv_to_split.value()].set(tv);
+    ++counter;
+  }
+  return parts;
+}
+
 MainSolver::MainSolver(
     const GraphEdgeWeights& pattern_edges, const GraphEdgeWeights& target_edges,
     const MainSolverParameters& parameters)
@@ -71,31 +190,44 @@ MainSolver::MainSolver(
 
   const auto init_start = Clock::now();
 
-  m_pre_search_components_ptr = std::make_unique<PreSearchComponents>(
+  auto pre_search_components_ptr = std::make_unique<PreSearchComponents>(
       m_pattern_neighbours_data, m_target_neighbours_data);
-  TKET_ASSERT(m_pre_search_components_ptr);
+  TKET_ASSERT(pre_search_components_ptr);
 
   {
     DomainInitialiser::InitialDomains initial_domains;
     const bool initialisation_succeeded =
         DomainInitialiser::full_initialisation(
             initial_domains, m_pattern_neighbours_data,
-            m_pre_search_components_ptr->pattern_near_ndata,
+            pre_search_components_ptr->pattern_near_ndata,
             m_target_neighbours_data,
-            m_pre_search_components_ptr->target_near_ndata,
+            pre_search_components_ptr->target_near_ndata,
             parameters.max_distance_for_domain_initialisation_distance_filter);
 
     if (initialisation_succeeded) {
-      m_search_components_ptr = std::make_unique<SearchComponents>();
-      TKET_ASSERT(m_search_components_ptr);
-
-      m_search_branch_ptr = std::make_unique<SearchBranch>(
-          initial_domains, m_pattern_neighbours_data,
-          m_pre_search_components_ptr->pattern_near_ndata,
-          m_target_neighbours_data,
-          m_pre_search_components_ptr->target_near_ndata,
-          parameters.max_distance_for_distance_reduction_during_search,
-          m_solution_data.extra_statistics);
+      const auto domain_parts =
+          split_initial_domains(initial_domains, parameters.number_of_threads);
+      for (unsigned ii = 0; ii < domain_parts.size(); ++ii) {
+        // Each worker lazily fills its own near neighbours data.
+        if (ii > 0) {
+          pre_search_components_ptr = std::make_unique<PreSearchComponents>(
+              m_pattern_neighbours_data, m_target_neighbours_data);
+        }
+        m_workers.emplace_back(std::make_unique<Worker>(
+            domain_parts[ii], m_pattern_neighbours_data,
+            m_target_neighbours_data, std::move(pre_search_components_ptr),
+            parameters, parameters.rng_seed + ii));
+        TKET_ASSERT(m_workers.back());
+      }
+      // The workers only count their own parts.
+      m_solution_data.extra_statistics =
+          m_workers[0]->solution_data.extra_statistics;
+      m_solution_data.extra_statistics.initial_number_of_possible_assignments =
+          0;
+      for (const auto& domain : initial_domains) {
+        m_solution_data.extra_statistics
+            .initial_number_of_possible_assignments += domain.count();
+      }
     }
     m_solution_data.initialisation_time_ms =
         std::chrono::duration_cast<std::chrono::milliseconds>(
@@ -158,9 +290,20 @@ MainSolver::MainSolver(
   if (m_solution_data.trivial_weight_lower_bound !=
       m_solution_data.trivial_weight_initial_upper_bound) {
     // It's not an unweighted problem, so it's worth checking for weights.
-    m_search_branch_ptr->activate_weight_checker(
-        m_solution_data.total_p_edge_weights);
+    for (auto& worker_ptr : m_workers) {
+      worker_ptr->get_search_branch().activate_weight_checker(
+          m_solution_data.total_p_edge_weights);
+    }
+  }
+  for (auto& worker_ptr : m_workers) {
+    SolutionData& worker_data = worker_ptr->solution_data;
+    worker_data.trivial_weight_lower_bound =
+        m_solution_data.trivial_weight_lower_bound;
+    worker_data.trivial_weight_initial_upper_bound =
+        m_solution_data.trivial_weight_initial_upper_bound;
+    worker_data.total_p_edge_weights = m_solution_data.total_p_edge_weights;
   }
+  merge_worker_solution_data(parameters);
 
   if (m_solution_data.initialisation_time_ms >= parameters.timeout_ms) {
     return;
@@ -184,9 +327,6 @@ MainSolver::MainSolver(
 MainSolver::~MainSolver() {}
 
 const SolutionData& MainSolver::get_solution_data() const {
-  if (m_search_branch_ptr) {
-    m_search_branch_ptr->get_updated_extra_statistics();
-  }
   if (m_pattern_vertex_relabelling.new_to_old_vertex_labels.empty() &&
       m_target_vertex_relabelling.new_to_old_vertex_labels.empty()) {
     return m_solution_data;
@@ -234,16 +374,6 @@ void MainSolver::solve(const MainSolverParameters& parameters) {
           .count();
 }
 
-static bool terminate_with_enough_full_solutions(
-    const MainSolverParameters& parameters, const SolutionData& solution_data) {
-  if (parameters.for_multiple_full_solutions_the_max_number_to_obtain == 0) {
-    return parameters.terminate_with_first_full_solution &&
-           !solution_data.solutions.empty();
-  }
-  return solution_data.solutions.size() >=
-         parameters.for_multiple_full_solutions_the_max_number_to_obtain;
-}
-
 void MainSolver::internal_solve(
     const MainSolverParameters& parameters, std::size_t max_iterations,
     const std::chrono::steady_clock::time_point& desired_end_time) {
@@ -251,6 +381,155 @@ void MainSolver::internal_solve(
       terminate_with_enough_full_solutions(parameters, m_solution_data)) {
     return;
   }
+  TKET_ASSERT(!m_workers.empty());
+  if (m_workers.size() == 1) {
+    m_workers[0]->solve(
+        parameters, max_iterations, desired_end_time, std::nullopt);
+    merge_worker_solution_data(parameters);
+    return;
+  }
+  while (m_solution_data.iterations < max_iterations) {
+    solve_round(parameters, max_iterations, desired_end_time);
+    merge_worker_solution_data(parameters);
+    if (m_solution_data.finished ||
+        terminate_with_enough_full_solutions(parameters, m_solution_data) ||
+        Clock::now() >= desired_end_time) {
+      return;
+    }
+  }
+}
+
+void MainSolver::solve_round(
+    const MainSolverParameters& parameters, std::size_t max_iterations,
+    const std::chrono::steady_clock::time_point& desired_end_time) {
+  std::optional<WeightWSM> best_weight;
+  if (parameters.for_multiple_full_solutions_the_max_number_to_obtain == 0 &&
+      !m_solution_data.solutions.empty()) {
+    best_weight = m_solution_data.solutions[0].scalar_product;
+  }
+
+  // Share out the remaining iterations between the unfinished workers,
+  // so that the total is the same however the threads are scheduled.
+  std::vector<unsigned> active_workers;
+  for (unsigned ii = 0; ii < m_workers.size(); ++ii) {
+    if (!m_workers[ii]->solution_data.finished) {
+      active_workers.push_back(ii);
+    }
+  }
+  TKET_ASSERT(!active_workers.empty());
+  const std::size_t remaining_iterations =
+      max_iterations - m_solution_data.iterations;
+  std::vector<std::size_t> worker_max_iterations(m_workers.size());
+  for (unsigned jj = 0; jj < active_workers.size(); ++jj) {
+    std::size_t quota = remaining_iterations / active_workers.size();
+    if (jj < remaining_iterations % active_workers.size()) {
+      ++quota;
+    }
+    const SolutionData& worker_data =
+        m_workers[active_workers[jj]]->solution_data;
+    worker_max_iterations[active_workers[jj]] =
+        worker_data.iterations + std::min(quota, ITERATIONS_PER_ROUND);
+  }
+
+  std::vector<std::exception_ptr> exceptions(m_workers.size());
+  auto run_worker = [&](unsigned index) {
+    try {
+      m_workers[index]->solve(
+          parameters, worker_max_iterations[index], desired_end_time,
+          best_weight);
+    } catch (...) {
+      exceptions[index] = std::current_exception();
+    }
+  };
+  std::vector<std::thread> threads;
+  threads.reserve(active_workers.size() - 1);
+  for (unsigned jj = 1; jj < active_workers.size(); ++jj) {
+    threads.emplace_back(run_worker, active_workers[jj]);
+  }
+  run_worker(active_workers[0]);
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  for (const std::exception_ptr& exception : exceptions) {
+    if (exception) {
+      std::rethrow_exception(exception);
+    }
+  }
+}
+
+void MainSolver::merge_worker_solution_data(
+    const MainSolverParameters& parameters) {
+  m_solution_data.finished = true;
+  m_solution_data.iterations = 0;
+  m_solution_data.solutions.clear();
+  ExtraStatistics& statistics = m_solution_data.extra_statistics;
+  statistics.n_tv_initially_passed_to_weight_nogood_detector.reset();
+  statistics.n_tv_still_valid_in_weight_nogood_detector.reset();
+  statistics.total_number_of_assignments_tried = 0;
+  statistics.total_number_of_impossible_assignments = 0;
+  statistics.impossible_target_vertices.clear();
+
+  for (auto& worker_ptr : m_workers) {
+    const SolutionData& worker_data = worker_ptr->solution_data;
+    worker_ptr->get_search_branch().get_updated_extra_statistics();
+    m_solution_data.finished &= worker_data.finished;
+    m_solution_data.iterations += worker_data.iterations;
+
+    if (parameters.for_multiple_full_solutions_the_max_number_to_obtain > 0) {
+      m_solution_data.solutions.insert(
+          m_solution_data.solutions.end(), worker_data.solutions.cbegin(),
+          worker_data.solutions.cend());
+    } else {
+      // Keep only the best solution, the earliest worker winning ties.
+      for (const SolutionWSM& solution : worker_data.solutions) {
+        if (m_solution_data.solutions.empty()) {
+          m_solution_data.solutions.push_back(solution);
+        } else if (
+            solution.scalar_product <
+            m_solution_data.solutions[0].scalar_product) {
+          m_solution_data.solutions[0] = solution;
+        }
+      }
+    }
+
+    const ExtraStatistics& worker_statistics = worker_data.extra_statistics;
+    // An empty optional compares less than any value.
+    statistics.n_tv_initially_passed_to_weight_nogood_detector = std::max(
+        statistics.n_tv_initially_passed_to_weight_nogood_detector,
+        worker_statistics.n_tv_initially_passed_to_weight_nogood_detector);
+    statistics.n_tv_still_valid_in_weight_nogood_detector = std::max(
+        statistics.n_tv_still_valid_in_weight_nogood_detector,
+        worker_statistics.n_tv_still_valid_in_weight_nogood_detector);
+    statistics.total_number_of_assignments_tried +=
+        worker_statistics.total_number_of_assignments_tried;
+    statistics.total_number_of_impossible_assignments +=
+        worker_statistics.total_number_of_impossible_assignments;
+    for (VertexWSM tv : worker_statistics.impossible_target_vertices) {
+      if (std::find(
+              statistics.impossible_target_vertices.cbegin(),
+              statistics.impossible_target_vertices.cend(),
+              tv) == statistics.impossible_target_vertices.cend()) {
+        statistics.impossible_target_vertices.push_back(tv);
+      }
+    }
+  }
+  // Several workers may between them have found more than enough.
+  if (parameters.for_multiple_full_solutions_the_max_number_to_obtain > 0 &&
+      m_solution_data.solutions.size() >
+          parameters.for_multiple_full_solutions_the_max_number_to_obtain) {
+    m_solution_data.solutions.resize(
+        parameters.for_multiple_full_solutions_the_max_number_to_obtain);
+  }
+}
+
+void MainSolver::Worker::solve(
+    const MainSolverParameters& parameters, std::size_t max_iterations,
+    const Clock::time_point& desired_end_time,
+    std::optional<WeightWSM> best_weight_elsewhere) {
+  if (solution_data.finished ||
+      terminate_with_enough_full_solutions(parameters, solution_data)) {
+    return;
+  }
   TKET_ASSERT(m_pre_search_components_ptr);
   TKET_ASSERT(m_search_branch_ptr);
 
@@ -263,10 +542,21 @@ void MainSolver::internal_solve(
   } else {
     set_maximum(initial_weight_upper_bound);
   }
+  if (best_weight_elsewhere) {
+    if (best_weight_elsewhere.value() <=
+        solution_data.trivial_weight_lower_bound) {
+      // Nothing here can beat it.
+      solution_data.finished = true;
+      return;
+    }
+    // Only a strictly better solution is of any use.
+    initial_weight_upper_bound = std::min(
+        initial_weight_upper_bound, best_weight_elsewhere.value() - 1);
+  }
 
-  while (m_solution_data.iterations < max_iterations) {
+  while (solution_data.iterations < max_iterations) {
     // Set the maximum weight.
-    if (m_solution_data.solutions.empty()) {
+    if (solution_data.solutions.empty()) {
       // We have no solution yet.
       reduction_parameters.max_weight = initial_weight_upper_bound;
     } else {
@@ -281,28 +571,28 @@ void MainSolver::internal_solve(
         // choose the best.
         {
           auto best_scalar_product =
-              m_solution_data.solutions[0].scalar_product;
+              solution_data.solutions[0].scalar_product;
           unsigned best_index = 0;
-          for (unsigned index = 1; index < m_solution_data.solutions.size();
+          for (unsigned index = 1; index < solution_data.solutions.size();
                ++index) {
-            if (m_solution_data.solutions[index].scalar_product <
+            if (solution_data.solutions[index].scalar_product <
                 best_scalar_product) {
               best_scalar_product =
-                  m_solution_data.solutions[index].scalar_product;
+                  solution_data.solutions[index].scalar_product;
               best_index = index;
             }
           }
           if (best_index > 0) {
-            m_solution_data.solutions[0] =
-                m_solution_data.solutions[best_index];
+            solution_data.solutions[0] =
+                solution_data.solutions[best_index];
           }
         }
-        m_solution_data.solutions.resize(1);
+        solution_data.solutions.resize(1);
         reduction_parameters.max_weight =
-            m_solution_data.solutions[0].scalar_product;
+            solution_data.solutions[0].scalar_product;
         if (reduction_parameters.max_weight == 0) {
           // We can't do better than zero!
-          m_solution_data.finished = true;
+          solution_data.finished = true;
           return;
         }
         // Make it strictly better.
@@ -313,23 +603,23 @@ void MainSolver::internal_solve(
     }
 
     if (reduction_parameters.max_weight <
-        m_solution_data.trivial_weight_lower_bound) {
-      m_solution_data.finished = true;
+        solution_data.trivial_weight_lower_bound) {
+      solution_data.finished = true;
       return;
     }
 
     // Now we can search!
-    ++m_solution_data.iterations;
+    ++solution_data.iterations;
 
     // On the first move ONLY, we don't backtrack; but we also haven't reduced.
-    if (m_solution_data.iterations == 1) {
+    if (solution_data.iterations == 1) {
       if (!m_search_branch_ptr->reduce_current_node(reduction_parameters)) {
-        m_solution_data.finished = true;
+        solution_data.finished = true;
         return;
       }
     } else {
       if (!m_search_branch_ptr->backtrack(reduction_parameters)) {
-        m_solution_data.finished = true;
+        solution_data.finished = true;
         return;
       }
     }
@@ -339,7 +629,7 @@ void MainSolver::internal_solve(
       // We also already checked that we haven't yet got too many,
       // if we're storing more than one.
       add_solution_from_final_node(parameters, reduction_parameters);
-      if (terminate_with_enough_full_solutions(parameters, m_solution_data)) {
+      if (terminate_with_enough_full_solutions(parameters, solution_data)) {
         return;
       }
     }
@@ -349,7 +639,7 @@ void MainSolver::internal_solve(
   }
 }
 
-void MainSolver::add_solution_from_final_node(
+void MainSolver::Worker::add_solution_from_final_node(
     const MainSolverParameters& parameters,
     const SearchBranch::ReductionParameters& reduction_parameters) {
   TKET_ASSERT(m_pre_search_components_ptr);
@@ -360,17 +650,17 @@ void MainSolver::add_solution_from_final_node(
 
   TKET_ASSERT(
       accessor.get_total_p_edge_weights() ==
-      m_solution_data.total_p_edge_weights);
+      solution_data.total_p_edge_weights);
 
   TKET_ASSERT(scalar_product <= reduction_parameters.max_weight);
 
   // We'll overwrite the solution into back().
   if (parameters.for_multiple_full_solutions_the_max_number_to_obtain > 0 ||
-      m_solution_data.solutions.empty()) {
-    m_solution_data.solutions.emplace_back();
+      solution_data.solutions.empty()) {
+    solution_data.solutions.emplace_back();
   }
   std::vector<std::pair<VertexWSM, VertexWSM>>& assignments =
-      m_solution_data.solutions.back().assignments;
+      solution_data.solutions.back().assignments;
   const auto number_of_pv = accessor.get_number_of_pattern_vertices();
   assignments.clear();
   assignments.reserve(number_of_pv);
@@ -380,22 +670,21 @@ void MainSolver::add_solution_from_final_node(
     TKET_ASSERT(bitset_information.single_element);
     assignments.emplace_back(pv, bitset_information.single_element.value());
   }
-  m_solution_data.solutions.back().scalar_product = scalar_product;
+  solution_data.solutions.back().scalar_product = scalar_product;
 
-  m_solution_data.solutions.back().total_p_edges_weight =
-      m_solution_data.total_p_edge_weights;
+  solution_data.solutions.back().total_p_edges_weight =
+      solution_data.total_p_edge_weights;
 }
 
-bool MainSolver::move_down_from_reduced_node(
+bool MainSolver::Worker::move_down_from_reduced_node(
     const SearchBranch::ReductionParameters& reduction_parameters) {
-  TKET_ASSERT(m_search_components_ptr);
   TKET_ASSERT(m_search_branch_ptr);
 
   for (;;) {
     const VariableOrdering::Result next_var_result =
-        m_search_components_ptr->variable_ordering.get_variable(
+        m_search_components.variable_ordering.get_variable(
             m_search_branch_ptr->get_domains_accessor_nonconst(),
-            m_search_components_ptr->rng);
+            m_search_components.rng);
 
     if (next_var_result.empty_domain) {
       return false;
@@ -415,9 +704,9 @@ bool MainSolver::move_down_from_reduced_node(
     // Now choose a value (i.e., some TV in Domain(PV)).
     // Thus the new assignment will be next_pv -> next_tv.
     const VertexWSM next_tv =
-        m_search_components_ptr->value_ordering.get_target_value(
+        m_search_components.value_ordering.get_target_value(
             m_search_branch_ptr->get_domains_accessor().get_domain(next_pv),
-            m_target_neighbours_data, m_search_components_ptr->rng);
+            m_target_ndata, m_search_components.rng);
 
     m_search_branch_ptr->move_down(next_pv, next_tv);
     if (!m_search_branch_ptr->reduce_current_node(reduction_parameters)) {
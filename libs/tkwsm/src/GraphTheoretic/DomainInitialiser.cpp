@@ -15,6 +15,7 @@
 #include "tkwsm/GraphTheoretic/DomainInitialiser.hpp"
 
 #include <algorithm>
+#include <map>
 #include <tkassert/Assert.hpp>
 
 #include "tkwsm/Common/GeneralUtils.hpp"
@@ -72,49 +73,74 @@ bool DomainInitialiser::degree_sequence_initialisation(
   // homogeneity: e.g., IBM heavy hexagons, square grids, etc.;
   // so it's unlikely that many target vertices can be removed in this way).
 
-  // FIRST: the target vertex;
-  // SECOND: its degree sequence.
-  typedef std::pair<VertexWSM, std::vector<std::size_t>> DegSeqData;
-  std::vector<DegSeqData> target_degree_sequences;
-
-  target_degree_sequences.reserve(number_of_tv);
+  // Target graphs are often very homogeneous, so many TV share
+  // the same degree sequence. Thus, group TV with equal sequences together,
+  // so that each PV need only be compared with each distinct sequence.
+  // KEY: a degree sequence; VALUE: the set of TV with that sequence.
+  std::map<std::vector<std::size_t>, boost::dynamic_bitset<>>
+      target_vertices_by_sequence;
   for (unsigned tv = 0; tv < number_of_tv; ++tv) {
+    auto& tv_set = target_vertices_by_sequence
+        [target_neighbours_data.get_sorted_degree_sequence_expensive(tv)];
+    if (tv_set.empty()) {
+      tv_set.resize(number_of_tv);
+    }
+    tv_set.set(tv);
+  }
+
+  // FIRST: the degree sequence;
+  // SECOND: all TV with this degree sequence.
+  typedef std::pair<std::vector<std::size_t>, boost::dynamic_bitset<>>
+      DegSeqData;
+  std::vector<DegSeqData> target_degree_sequences;
+  target_degree_sequences.reserve(target_vertices_by_sequence.size());
+  for (auto& entry : target_vertices_by_sequence) {
     target_degree_sequences.emplace_back(
-        tv, target_neighbours_data.get_sorted_degree_sequence_expensive(tv));
+        entry.first, std::move(entry.second));
   }
+  target_vertices_by_sequence.clear();
 
-  // Sort by decreasing sequence length.
+  // Sort by decreasing sequence length. (The sequences are distinct,
+  // so this is deterministic).
   std::sort(
       target_degree_sequences.begin(), target_degree_sequences.end(),
       [](const DegSeqData& lhs, const DegSeqData& rhs) -> bool {
-        return lhs.second.size() > rhs.second.size() ||
-               // This is not crucial, it just ensures exact behaviour for
-               // nonstable sorts:
-               (lhs.second.size() == rhs.second.size() &&
+        return lhs.first.size() > rhs.first.size() ||
+               (lhs.first.size() == rhs.first.size() &&
                 lhs.first < rhs.first);
       });
 
-  std::vector<std::size_t> pattern_sequence;
-  for (unsigned pv = 0; pv < initial_domains.size(); ++pv) {
-    initial_domains[pv].resize(number_of_tv);
+  // Similarly, many PV share degree sequences, and then have equal domains.
+  // KEY: a pattern degree sequence; VALUE: a PV with that sequence.
+  std::map<std::vector<std::size_t>, VertexWSM> pv_with_sequence;
 
-    pattern_sequence =
+  for (unsigned pv = 0; pv < initial_domains.size(); ++pv) {
+    std::vector<std::size_t> pattern_sequence =
         pattern_neighbours_data.get_sorted_degree_sequence_expensive(pv);
+    const auto pv_with_sequence_opt =
+        get_optional_value(pv_with_sequence, pattern_sequence);
+    if (pv_with_sequence_opt) {
+      // Already nonempty.
+      initial_domains[pv] = initial_domains[pv_with_sequence_opt.value()];
+      continue;
+    }
+    initial_domains[pv].resize(number_of_tv);
 
     // Now, which target vertices have compatible degree sequences?
     for (const DegSeqData& deg_seq_data : target_degree_sequences) {
-      const auto& target_sequence = deg_seq_data.second;
+      const auto& target_sequence = deg_seq_data.first;
       if (target_sequence.size() < pattern_sequence.size()) {
         break;
       }
       if (FilterUtils::compatible_sorted_degree_sequences(
               pattern_sequence, target_sequence)) {
-        initial_domains[pv].set(deg_seq_data.first);
+        initial_domains[pv] |= deg_seq_data.second;
       }
     }
     if (initial_domains[pv].none()) {
       return false;
     }
+    pv_with_sequence.emplace(std::move(pattern_sequence), pv);
   }
   return true;
 }
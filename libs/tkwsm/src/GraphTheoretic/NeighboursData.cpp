@@ -15,7 +15,6 @@
 #include "tkwsm/GraphTheoretic/NeighboursData.hpp"
 
 #include <algorithm>
-#include <set>
 #include <stdexcept>
 #include <tkassert/Assert.hpp>
 
@@ -31,8 +30,7 @@ std::size_t NeighboursData::get_number_of_edges() const {
 std::vector<VertexWSM> NeighboursData::get_neighbours_expensive(
     VertexWSM v) const {
   std::vector<VertexWSM> result;
-  const std::vector<std::pair<VertexWSM, WeightWSM>>& neighbours_and_weights =
-      get_neighbours_and_weights(v);
+  const auto neighbours_and_weights = get_neighbours_and_weights(v);
   result.reserve(neighbours_and_weights.size());
   for (const std::pair<VertexWSM, WeightWSM>& entry : neighbours_and_weights) {
     result.push_back(entry.first);
@@ -41,124 +39,144 @@ std::vector<VertexWSM> NeighboursData::get_neighbours_expensive(
 }
 
 std::size_t NeighboursData::get_number_of_nonisolated_vertices() const {
-  return m_neighbours_and_weights.size();
+  return m_offsets.size() - 1;
 }
 
 NeighboursData::NeighboursData(const GraphEdgeWeights& edges_and_weights) {
-  // Only the edges (v1,v2) with v1<v2.
-  std::set<std::pair<VertexWSM, VertexWSM>> ordered_edges_seen;
-  std::set<VertexWSM> vertices_seen;
+  // Only the edges (v1,v2) with v1<v2, possibly repeated if both
+  // (v1,v2) and (v2,v1) were passed in.
+  std::vector<std::pair<EdgeWSM, WeightWSM>> ordered_edges;
+  ordered_edges.reserve(edges_and_weights.size());
+  std::vector<VertexWSM> vertices_seen;
+  vertices_seen.reserve(2 * edges_and_weights.size());
   for (const std::pair<const EdgeWSM, WeightWSM>& entry : edges_and_weights) {
     const VertexWSM& v1 = entry.first.first;
     const VertexWSM& v2 = entry.first.second;
-    vertices_seen.insert(v1);
-    vertices_seen.insert(v2);
+    vertices_seen.push_back(v1);
+    vertices_seen.push_back(v2);
     if (v1 == v2) {
       throw std::runtime_error("Loop found in graph; not allowed");
     }
-    ordered_edges_seen.insert(get_edge(v1, v2));
+    ordered_edges.emplace_back(get_edge(v1, v2), entry.second);
   }
   if (vertices_seen.empty()) {
     throw std::runtime_error("No edges passed to NeighboursData");
   }
-  if (*vertices_seen.cbegin() != 0 ||
-      *vertices_seen.crbegin() != vertices_seen.size() - 1) {
+  std::sort(vertices_seen.begin(), vertices_seen.end());
+  vertices_seen.erase(
+      std::unique(vertices_seen.begin(), vertices_seen.end()),
+      vertices_seen.end());
+  if (vertices_seen[0] != 0 ||
+      vertices_seen.back() != vertices_seen.size() - 1) {
     throw std::runtime_error("Vertices should be [0,1,2,...,N].");
   }
-  for (const EdgeWSM& edge : ordered_edges_seen) {
-    const std::optional<WeightWSM> weight_opt =
-        get_optional_value(edges_and_weights, edge);
-    if (weight_opt) {
-      const std::optional<WeightWSM> other_weight_opt = get_optional_value(
-          edges_and_weights, std::make_pair(edge.second, edge.first));
-      if (other_weight_opt && weight_opt.value() != other_weight_opt.value()) {
-        throw std::runtime_error("Edge weights mismatch");
-      }
+  // Now any duplicate edges are adjacent, and must have equal weights.
+  std::sort(ordered_edges.begin(), ordered_edges.end());
+  for (unsigned ii = 1; ii < ordered_edges.size(); ++ii) {
+    if (ordered_edges[ii - 1].first == ordered_edges[ii].first &&
+        ordered_edges[ii - 1].second != ordered_edges[ii].second) {
+      throw std::runtime_error("Edge weights mismatch");
     }
   }
-  m_number_of_edges = ordered_edges_seen.size();
-  m_neighbours_and_weights.resize(vertices_seen.size());
+  ordered_edges.erase(
+      std::unique(
+          ordered_edges.begin(), ordered_edges.end(),
+          [](const std::pair<EdgeWSM, WeightWSM>& lhs,
+             const std::pair<EdgeWSM, WeightWSM>& rhs) {
+            return lhs.first == rhs.first;
+          }),
+      ordered_edges.end());
+  m_number_of_edges = ordered_edges.size();
+
+  // Count the degrees, then fill in the rows.
+  m_offsets.assign(vertices_seen.size() + 1, 0);
+  for (const std::pair<EdgeWSM, WeightWSM>& entry : ordered_edges) {
+    ++m_offsets[entry.first.first + 1];
+    ++m_offsets[entry.first.second + 1];
+  }
+  for (unsigned ii = 1; ii < m_offsets.size(); ++ii) {
+    m_offsets[ii] += m_offsets[ii - 1];
+  }
+  m_neighbours_and_weights.resize(2 * m_number_of_edges);
+  std::vector<std::size_t> next_positions(
+      m_offsets.cbegin(), m_offsets.cend() - 1);
 
-  for (const EdgeWSM& edge : ordered_edges_seen) {
-    const VertexWSM& v1 = edge.first;
-    const VertexWSM& v2 = edge.second;
+  // Because the edges (v1,v2) are sorted lexicographically, with v1<v2,
+  // each row automatically ends up sorted: the neighbours of v which are
+  // smaller than v come from edges (u,v), all processed before the
+  // edges (v,w) giving the larger neighbours, each in increasing order.
+  for (const std::pair<EdgeWSM, WeightWSM>& entry : ordered_edges) {
+    const VertexWSM& v1 = entry.first.first;
+    const VertexWSM& v2 = entry.first.second;
     TKET_ASSERT(v1 < v2);
     TKET_ASSERT(v2 < vertices_seen.size());
-    WeightWSM weight;
-    const std::optional<WeightWSM> weight_opt =
-        get_optional_value(edges_and_weights, edge);
-    if (weight_opt) {
-      weight = weight_opt.value();
-    } else {
-      weight = edges_and_weights.at(std::make_pair(v2, v1));
-    }
-    m_neighbours_and_weights[v1].emplace_back(v2, weight);
-    m_neighbours_and_weights[v2].emplace_back(v1, weight);
+    m_neighbours_and_weights[next_positions[v1]] =
+        std::make_pair(v2, entry.second);
+    ++next_positions[v1];
+    m_neighbours_and_weights[next_positions[v2]] =
+        std::make_pair(v1, entry.second);
+    ++next_positions[v2];
   }
-  for (std::vector<std::pair<VertexWSM, WeightWSM>>& neigh_data :
-       m_neighbours_and_weights) {
-    // Automatically sort by vertex first; lexicographic.
-    std::sort(neigh_data.begin(), neigh_data.end());
-    TKET_ASSERT(is_sorted_and_unique(neigh_data));
+  for (VertexWSM v = 0; v < vertices_seen.size(); ++v) {
+    TKET_ASSERT(next_positions[v] == m_offsets[v + 1]);
+    TKET_ASSERT(std::is_sorted(
+        m_neighbours_and_weights.cbegin() + m_offsets[v],
+        m_neighbours_and_weights.cbegin() + m_offsets[v + 1]));
   }
 }
 
 std::optional<WeightWSM> NeighboursData::get_edge_weight_opt(
     VertexWSM v1, VertexWSM v2) const {
-  if (v1 >= m_neighbours_and_weights.size()) {
-    return {};
-  }
-  const std::vector<std::pair<VertexWSM, WeightWSM>>& v1_data =
-      m_neighbours_and_weights[v1];
+  const auto v1_data = get_neighbours_and_weights(v1);
   // (x,0) = (x,min) <= (x,w) <= (x+1, y) in lexicographic order
   std::pair<VertexWSM, WeightWSM> key;
   key.first = v2;
   key.second = 0;
-  const auto v2_citer = std::lower_bound(v1_data.cbegin(), v1_data.cend(), key);
-  if (v2_citer != v1_data.cend() && v2_citer->first == v2) {
-    return v2_citer->second;
+  const auto v2_iter = std::lower_bound(v1_data.begin(), v1_data.end(), key);
+  if (v2_iter != v1_data.end() && v2_iter->first == v2) {
+    return v2_iter->second;
   }
   return {};
 }
 
 std::size_t NeighboursData::get_degree(VertexWSM v) const {
-  if (v >= m_neighbours_and_weights.size()) {
+  if (v >= get_number_of_nonisolated_vertices()) {
     return 0;
   }
-  return m_neighbours_and_weights[v].size();
+  return m_offsets[v + 1] - m_offsets[v];
 }
 
 std::vector<std::size_t> NeighboursData::get_sorted_degree_sequence_expensive(
     VertexWSM v) const {
   std::vector<std::size_t> result;
-  if (v >= m_neighbours_and_weights.size()) {
-    return result;
-  }
-  for (const std::pair<VertexWSM, WeightWSM>& entry :
-       m_neighbours_and_weights[v]) {
+  const auto neighbours_and_weights = get_neighbours_and_weights(v);
+  result.reserve(neighbours_and_weights.size());
+  for (const std::pair<VertexWSM, WeightWSM>& entry : neighbours_and_weights) {
     result.push_back(get_degree(entry.first));
   }
   std::sort(result.begin(), result.end());
   return result;
 }
 
-const std::vector<std::pair<VertexWSM, WeightWSM>>&
+std::span<const std::pair<VertexWSM, WeightWSM>>
 NeighboursData::get_neighbours_and_weights(VertexWSM v) const {
-  if (v >= m_neighbours_and_weights.size()) {
-    return m_empty_data;
+  if (v >= get_number_of_nonisolated_vertices()) {
+    return {};
   }
-  return m_neighbours_and_weights[v];
+  return std::span<const std::pair<VertexWSM, WeightWSM>>(
+      m_neighbours_and_weights.data() + m_offsets[v],
+      m_offsets[v + 1] - m_offsets[v]);
 }
 
 std::vector<WeightWSM> NeighboursData::get_weights_expensive() const {
   std::vector<WeightWSM> weights;
   weights.reserve(m_number_of_edges);
-  for (unsigned v1 = 0; v1 < m_neighbours_and_weights.size(); ++v1) {
+  for (VertexWSM v1 = 0; v1 + 1 < m_offsets.size(); ++v1) {
     // Every edge is implicitly stored twice, for (v1, v2) and (v2, v1).
     // To avoid duplicates, only write the weight when v1>v2.
     // The neighbour edges are stored with increasing v, as always.
     for (const std::pair<VertexWSM, WeightWSM>& inner_entry :
-         m_neighbours_and_weights[v1]) {
+         get_neighbours_and_weights(v1)) {
       const VertexWSM& v2 = inner_entry.first;
       if (v2 > v1) {
         break;
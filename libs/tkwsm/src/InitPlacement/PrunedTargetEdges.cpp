@@ -43,9 +43,9 @@ static GraphEdgeWeights get_only_used_target_edges(
         pattern_ndata.get_neighbours_and_weights(pv1);
     // Only consider p-edges (pv1, pv2) with pv1 < pv2.
     for (auto citer = std::lower_bound(
-             neighbours_and_weights.cbegin(), neighbours_and_weights.cend(),
+             neighbours_and_weights.begin(), neighbours_and_weights.end(),
              std::make_pair(VertexWSM(pv1 + 1), WeightWSM(0)));
-         citer != neighbours_and_weights.cend(); ++citer) {
+         citer != neighbours_and_weights.end(); ++citer) {
       // We have an edge (pv1, pv2).
       const unsigned tv2 = assigned_target_vertices.at(citer->first);
       const auto t_edge = get_edge(tv1, tv2);
@@ -154,10 +154,10 @@ get_explicit_extra_edges_adjoining_one_used_tv_unsorted(
         explicit_target_ndata.get_neighbours_and_weights(*citer_tv1);
 
     for (auto citer_other = std::lower_bound(
-             explicit_neighbours_and_weights.cbegin(),
-             explicit_neighbours_and_weights.cend(),
+             explicit_neighbours_and_weights.begin(),
+             explicit_neighbours_and_weights.end(),
              std::make_pair(VertexWSM(*citer_tv1 + 1), WeightWSM(0)));
-         citer_other != explicit_neighbours_and_weights.cend(); ++citer_other) {
+         citer_other != explicit_neighbours_and_weights.end(); ++citer_other) {
       const auto& tv2 = citer_other->first;
       const auto& explicit_weight = citer_other->second;
 
@@ -39,9 +39,9 @@ WeightWSM get_scalar_product_with_complete_target(
         pattern_ndata.get_neighbours_and_weights(pv);
     // Only use edges (v1,v2) with v1<v2.
     for (auto citer = std::lower_bound(
-             neighbours_and_weights.cbegin(), neighbours_and_weights.cend(),
+             neighbours_and_weights.begin(), neighbours_and_weights.end(),
              std::make_pair(pv, WeightWSM(0)));
-         citer != neighbours_and_weights.cend(); ++citer) {
+         citer != neighbours_and_weights.end(); ++citer) {
       const VertexWSM& other_pv = citer->first;
       const unsigned& other_tv = assignments.at(other_pv);
       TKET_ASSERT(other_tv < target_ndata.get_number_of_nonisolated_vertices());
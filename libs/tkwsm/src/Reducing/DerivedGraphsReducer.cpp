@@ -14,6 +14,7 @@
 
 #include "tkwsm/Reducing/DerivedGraphsReducer.hpp"
 
+#include <optional>
 #include <tkassert/Assert.hpp>
 
 #include "tkwsm/GraphTheoretic/FilterUtils.hpp"
@@ -65,30 +66,34 @@ ReductionResult DerivedGraphsReducer::reduce_with_derived_data(
   // to squeeze the maximum performance from lazy evaluation).
   bool found_new_assignment = false;
 
+  // The mask of TV with count >= (PV count) depends only upon the PV count,
+  // which is often shared by many PV, so only rebuild it when it changes.
+  std::optional<DerivedGraphStructs::Count> mask_count_opt;
+
   for (const std::pair<VertexWSM, DerivedGraphStructs::Count>& p_entry :
        pattern_derived_neighbours_data) {
     // This PV is a neighbour of the root PV, in some derived graph.
     const VertexWSM& pv = p_entry.first;
-    {
-      const auto& domain = accessor.get_domain(pv);
-      if (other_vertex_reduction_can_be_skipped_by_symmetry(
-              domain, accessor, root_pattern_vertex, pv)) {
-        continue;
-      }
-      work_bitset.resize(domain.size());
-      work_bitset.reset();
+    const auto& domain = accessor.get_domain(pv);
+    if (other_vertex_reduction_can_be_skipped_by_symmetry(
+            domain, accessor, root_pattern_vertex, pv)) {
+      continue;
     }
     // This is the edge weight of PV--(root PV) in the derived graph.
     const DerivedGraphStructs::Count& p_count = p_entry.second;
 
-    for (const auto& entry : target_derived_neighbours_data) {
-      if (entry.second >= p_count) {
-        TKET_ASSERT(!work_bitset.test_set(entry.first));
+    if (mask_count_opt != p_count) {
+      mask_count_opt = p_count;
+      m_target_mask.resize(domain.size());
+      m_target_mask.reset();
+      for (const auto& entry : target_derived_neighbours_data) {
+        if (entry.second >= p_count) {
+          TKET_ASSERT(!m_target_mask.test_set(entry.first));
+        }
       }
     }
-
-    switch (
-        accessor.intersect_domain_with_swap(pv, work_bitset).reduction_result) {
+    switch (accessor.intersect_domain(pv, m_target_mask, work_bitset)
+                .reduction_result) {
       case ReductionResult::NOGOOD:
         return ReductionResult::NOGOOD;
       case ReductionResult::NEW_ASSIGNMENTS:
@@ -45,36 +45,17 @@ bool DistancesReducer::check(std::pair<VertexWSM, VertexWSM> assignment) {
 ReductionResult DistancesReducer::reduce(
     std::pair<VertexWSM, VertexWSM> assignment, DomainsAccessor& accessor,
     boost::dynamic_bitset<>& work_bitset) {
-  auto result = ReductionResult::SUCCESS;
-
-  const boost::dynamic_bitset<>& pv_at_distance_d =
+  // Every PV' with dist(PV, PV')=d must map to some TV'
+  // with dist(TV, TV') <= d.
+  // Even if a new assignment is found, we continue to the end,
+  // because the assignment PV->TV hasn't been fully processed
+  // until ALL such PV' have been considered.
+  return accessor.intersect_domains(
       m_pattern_near_ndata.get_vertices_at_exact_distance(
-          assignment.first, m_distance);
-
-  for (auto new_pv = pv_at_distance_d.find_first();
-       new_pv < pv_at_distance_d.size();
-       new_pv = pv_at_distance_d.find_next(new_pv)) {
-    work_bitset = m_target_near_ndata.get_vertices_up_to_distance(
-        assignment.second, m_distance);
-
-    switch (accessor.intersect_domain_with_swap(new_pv, work_bitset)
-                .reduction_result) {
-      case ReductionResult::NEW_ASSIGNMENTS:
-        // Normally we would return now,
-        // BUT the assignment PV->TV hasn't been fully processed
-        // until ALL PV' with  dist(PV, PV')=d  have been considered.
-        // Thus, continue, to finish off this assignment,
-        // rather than trying to store partial data
-        // and resuming later.
-        result = ReductionResult::NEW_ASSIGNMENTS;
-        break;
-      case ReductionResult::NOGOOD:
-        return ReductionResult::NOGOOD;
-      case ReductionResult::SUCCESS:
-        break;
-    }
-  }
-  return result;
+          assignment.first, m_distance),
+      m_target_near_ndata.get_vertices_up_to_distance(
+          assignment.second, m_distance),
+      work_bitset);
 }
 
 }  // namespace WeightedSubgraphMonomorphism
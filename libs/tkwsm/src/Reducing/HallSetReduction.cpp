@@ -363,11 +363,9 @@ HallSetReduction::Partition::reduce_with_hall_set(
   unsigned number_of_newly_assigned_vertices = 0;
 
   for (unsigned ii = 0; ii < number_of_vertices_to_reduce; ++ii) {
-    // TODO: make an intersect function WITHOUT doing a swap,
-    // to avoid this copy.
-    domain_mask_workset = union_of_domains_complement;
-    const auto intersect_result = accessor.intersect_domain_with_swap(
-        domains_data[ii].pv, domain_mask_workset);
+    const auto intersect_result = accessor.intersect_domain(
+        domains_data[ii].pv, union_of_domains_complement,
+        domain_mask_workset);
 
     if (intersect_result.reduction_result == ReductionResult::NOGOOD) {
       reduction_data.result_to_return = ReductionResult::NOGOOD;
@@ -188,6 +188,41 @@ DomainsAccessor::IntersectionResult DomainsAccessor::intersect_domain_with_swap(
   return result;
 }
 
+DomainsAccessor::IntersectionResult DomainsAccessor::intersect_domain(
+    VertexWSM pv, const boost::dynamic_bitset<>& domain_mask,
+    boost::dynamic_bitset<>& work_bitset) {
+  if (get_domain(pv).is_subset_of(domain_mask)) {
+    IntersectionResult result;
+    result.reduction_result = ReductionResult::SUCCESS;
+    result.new_domain_size = get_domain_size(pv);
+    result.changed = false;
+    return result;
+  }
+  // Assignment between equal-sized bitsets reuses the existing storage.
+  work_bitset = domain_mask;
+  return intersect_domain_with_swap(pv, work_bitset);
+}
+
+ReductionResult DomainsAccessor::intersect_domains(
+    const boost::dynamic_bitset<>& pattern_vertices,
+    const boost::dynamic_bitset<>& domain_mask,
+    boost::dynamic_bitset<>& work_bitset) {
+  auto result = ReductionResult::SUCCESS;
+  for (auto pv = pattern_vertices.find_first(); pv < pattern_vertices.size();
+       pv = pattern_vertices.find_next(pv)) {
+    switch (intersect_domain(pv, domain_mask, work_bitset).reduction_result) {
+      case ReductionResult::NEW_ASSIGNMENTS:
+        result = ReductionResult::NEW_ASSIGNMENTS;
+        break;
+      case ReductionResult::NOGOOD:
+        return ReductionResult::NOGOOD;
+      case ReductionResult::SUCCESS:
+        break;
+    }
+  }
+  return result;
+}
+
 const std::vector<VertexWSM>&
 DomainsAccessor::get_unassigned_pattern_vertices_superset() const {
   const auto& candidate =
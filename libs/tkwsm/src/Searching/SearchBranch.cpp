@@ -48,6 +48,9 @@ SearchBranch::SearchBranch(
   for (const boost::dynamic_bitset<>& domain : initial_domains) {
     m_extra_statistics.initial_number_of_possible_assignments += domain.count();
   }
+  m_checked_assignments.assign(
+      m_extra_statistics.number_of_pattern_vertices,
+      boost::dynamic_bitset<>(m_extra_statistics.number_of_target_vertices));
 
   // In what order should we do reduction/checks?
   // The simplest/cheapest first? Most powerful?
@@ -93,8 +96,8 @@ const ExtraStatistics& SearchBranch::get_updated_extra_statistics() {
     }
   }
   m_extra_statistics.total_number_of_assignments_tried = 0;
-  for (const auto& entry : m_checked_assignments) {
-    m_extra_statistics.total_number_of_assignments_tried += entry.second.size();
+  for (const boost::dynamic_bitset<>& checked_tv : m_checked_assignments) {
+    m_extra_statistics.total_number_of_assignments_tried += checked_tv.count();
   }
   return m_extra_statistics;
 }
@@ -112,8 +115,9 @@ bool SearchBranch::perform_single_assignment_checks_in_reduce_loop(
       m_domains_accessor.get_new_assignments();
   for (auto ii = num_assignments_alldiff_processed; ii < new_assignments.size();
        ++ii) {
-    if (m_checked_assignments[new_assignments[ii].first].count(
-            new_assignments[ii].second) != 0) {
+    const VertexWSM& pv = new_assignments[ii].first;
+    const VertexWSM& tv = new_assignments[ii].second;
+    if (m_checked_assignments[pv].test(tv)) {
       continue;
     }
     for (auto& reducer_wrapper : m_reducer_wrappers) {
@@ -128,6 +132,8 @@ bool SearchBranch::perform_single_assignment_checks_in_reduce_loop(
         return false;
       }
     }
+    // Similarly, passing the checks does not depend on the other domains.
+    m_checked_assignments[pv].set(tv);
   }
   return true;
 }
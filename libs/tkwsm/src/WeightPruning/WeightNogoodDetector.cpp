@@ -50,8 +50,7 @@ std::optional<WeightWSM> WeightNogoodDetector::get_min_weight_for_tv(
   // We must find the minimum weight, by looking at all neighbours.
   WeightWSM min_weight;
   set_maximum(min_weight);
-  const std::vector<std::pair<VertexWSM, WeightWSM>>& data =
-      m_target_neighbours_data.get_neighbours_and_weights(tv);
+  const auto data = m_target_neighbours_data.get_neighbours_and_weights(tv);
   for (const std::pair<VertexWSM, WeightWSM>& entry : data) {
     const VertexWSM& neighbour_tv = entry.first;
     if (m_valid_target_vertices.count(neighbour_tv) == 0) {
@@ -141,9 +140,8 @@ WeightNogoodDetector::get_extra_scalar_product_lower_bound(
     // which could possibly contain f(pv).
     const auto minimum_t_weight = get_t_weight_lower_bound(pv1);
 
-    const std::vector<std::pair<VertexWSM, WeightWSM>>&
-        p_neighbours_and_weights =
-            m_pattern_neighbours_data.get_neighbours_and_weights(pv1);
+    const auto p_neighbours_and_weights =
+        m_pattern_neighbours_data.get_neighbours_and_weights(pv1);
 
     for (const std::pair<VertexWSM, WeightWSM>& pv2_weight_pair :
          p_neighbours_and_weights) {
@@ -30,22 +30,6 @@ void clamp(T& val, T low, T high) {
   val = std::clamp(val, low, high);
 }
 
-namespace {
-struct TempCounter {
-  unsigned good_count = 0;
-  unsigned ok_count = 0;
-  unsigned bad_count = 0;
-  unsigned old_total = 0;
-
-  unsigned get_total() const { return good_count + ok_count + bad_count; }
-};
-}  // namespace
-
-static TempCounter& get_counter() {
-  static TempCounter counter;
-  return counter;
-}
-
 bool WeightNogoodDetectorManager::should_activate_detector(
     WeightWSM current_weight, WeightWSM max_weight,
     WeightWSM current_sum_of_p_edge_weights, std::size_t n_assigned_vertices,
@@ -130,7 +114,6 @@ bool WeightNogoodDetectorManager::should_activate_detector(
 }
 
 void WeightNogoodDetectorManager::register_success() {
-  get_counter().good_count += 1;
   m_state.final_weight_estimate_pk_to_activate *=
       m_parameters.final_weight_estimate_pk_success_growth_pk;
   m_state.final_weight_estimate_pk_to_activate /= 1024;
@@ -147,14 +130,12 @@ void WeightNogoodDetectorManager::register_lower_bound_failure(
     WeightWSM extra_weight_lower_bound) {
   if (current_weight + 2 * extra_weight_lower_bound < max_weight) {
     // Bad failure.
-    get_counter().bad_count += 1;
     m_state.final_weight_estimate_pk_to_activate *=
         m_parameters.final_weight_estimate_pk_bad_failure_growth_pk;
     m_state.min_weight_pk_to_activate *=
         m_parameters.bad_failure_pk_to_activate_growth_factor_pk;
     m_state.remaining_skips = m_parameters.bad_failure_skip;
   } else {
-    get_counter().ok_count += 1;
     // "OK" failure; the lower bound wasn't that far off the amount needed.
     m_state.final_weight_estimate_pk_to_activate *=
         m_parameters.final_weight_estimate_pk_ok_failure_growth_pk;
@@ -120,8 +120,7 @@ static std::string to_string(const NeighboursData& ndata) {
   ss << number_of_vertices << " vertices. Neighbours and weights:";
   for (unsigned vv = 0; vv < number_of_vertices; ++vv) {
     ss << "\nv=" << vv << ": [ ";
-    const std::vector<std::pair<VertexWSM, WeightWSM>>& data =
-        ndata.get_neighbours_and_weights(vv);
+    const auto data = ndata.get_neighbours_and_weights(vv);
     for (const std::pair<VertexWSM, WeightWSM>& entry : data) {
       ss << entry.first << ";" << entry.second << " ";
     }
@@ -157,6 +156,17 @@ SCENARIO("neighbours_data with invalid and simple input data") {
   edge_weights[std::make_pair<VertexWSM, VertexWSM>(0, 2)] = 2;
   const NeighboursData ndata2(edge_weights);
   CHECK(ndata1_str == to_string(ndata2));
+
+  // Out of range vertices simply have no neighbours.
+  CHECK(ndata2.get_degree(3) == 0);
+  CHECK(ndata2.get_neighbours_and_weights(3).empty());
+  CHECK(!ndata2.get_edge_weight_opt(3, 0));
+  CHECK(!ndata2.get_edge_weight_opt(1, 2));
+  CHECK(ndata2.get_edge_weight_opt(2, 0).value() == 2);
+
+  // Vertices must be contiguous.
+  edge_weights[get_edge(2, 4)] = 1;
+  CHECK_THROWS_AS(NeighboursData(edge_weights), std::runtime_error);
 }
 
 }  // namespace WeightedSubgraphMonomorphism
@@ -0,0 +1,126 @@
+// Copyright Quantinuum
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <catch2/catch_test_macros.hpp>
+#include <set>
+#include <tkwsm/EndToEndWrappers/MainSolver.hpp>
+
+#include "../TestUtils/CheckedSolution.hpp"
+#include "../TestUtils/SquareGridGeneration.hpp"
+
+// Searching with several threads splits the domain of one pattern vertex
+// between workers. It should find the same optimal weights as a single
+// thread, and repeat exactly for a fixed number of threads.
+
+namespace tket {
+namespace WeightedSubgraphMonomorphism {
+
+SCENARIO("Parallel search finds optimal square grid embeddings") {
+  RNG rng;
+  const std::vector<std::pair<unsigned, unsigned>> sizes{
+      {2, 1}, {4, 2}, {3, 3}, {8, 8}};
+  std::vector<SquareGrid> grids(sizes.size());
+  for (unsigned ii = 0; ii < sizes.size(); ++ii) {
+    grids[ii].width = sizes[ii].first;
+    grids[ii].height = sizes[ii].second;
+    grids[ii].fill_weights(rng);
+  }
+  CheckedSolution::Statistics stats("parallel square grids");
+
+  for (unsigned ii = 0; ii + 1 < grids.size(); ++ii) {
+    const auto pattern = grids[ii].get_graph_edge_weights();
+    const auto target = grids.back().get_graph_edge_weights();
+    CheckedSolution::ProblemInformation info;
+    info.known_optimal_solution =
+        grids[ii].get_subgraph_isomorphism_min_scalar_product(grids.back());
+
+    for (unsigned number_of_threads : {1, 2, 3, 8}) {
+      MainSolverParameters solver_params(10000);
+      solver_params.number_of_threads = number_of_threads;
+      const CheckedSolution solution(
+          pattern, target, info, solver_params, stats);
+      CHECK(solution.finished);
+      CHECK(solution.scalar_product == info.known_optimal_solution.value());
+
+      const CheckedSolution repeated_solution(
+          pattern, target, info, solver_params, stats);
+      CHECK(repeated_solution.iterations == solution.iterations);
+      CHECK(repeated_solution.assignments == solution.assignments);
+    }
+  }
+  stats.finish();
+}
+
+SCENARIO("Parallel search with an iteration limit") {
+  RNG rng;
+  SquareGrid pattern_grid;
+  pattern_grid.width = 4;
+  pattern_grid.height = 3;
+  pattern_grid.fill_weights(rng);
+  SquareGrid target_grid;
+  target_grid.width = 9;
+  target_grid.height = 9;
+  target_grid.fill_weights(rng);
+  const auto pattern = pattern_grid.get_graph_edge_weights();
+  const auto target = target_grid.get_graph_edge_weights();
+
+  MainSolverParameters solver_params(100000);
+  solver_params.number_of_threads = 4;
+  solver_params.iterations_timeout = 50;
+  MainSolver solver(pattern, target, solver_params);
+  const SolutionData& initial_data = solver.get_solution_data();
+  REQUIRE(!initial_data.finished);
+  CHECK(initial_data.iterations == 50);
+
+  // Resuming continues the same workers.
+  solver_params.iterations_timeout = 1000000;
+  solver.solve(solver_params);
+  const SolutionData& final_data = solver.get_solution_data();
+  CHECK(final_data.finished);
+  REQUIRE(final_data.solutions.size() == 1);
+  CHECK(
+      final_data.solutions[0].scalar_product ==
+      pattern_grid.get_subgraph_isomorphism_min_scalar_product(target_grid));
+}
+
+SCENARIO("Parallel search for all automorphisms of a cycle") {
+  const unsigned cycle_length = 7;
+  GraphEdgeWeights edges;
+  for (unsigned ii = 0; ii < cycle_length; ++ii) {
+    edges[get_edge(ii, (ii + 1) % cycle_length)] = 1;
+  }
+  MainSolverParameters solver_params(10000);
+  solver_params.for_multiple_full_solutions_the_max_number_to_obtain = 100;
+  solver_params.number_of_threads = 3;
+  const MainSolver solver(edges, edges, solver_params);
+  const SolutionData& solution_data = solver.get_solution_data();
+  CHECK(solution_data.finished);
+
+  // Rotations and reflections.
+  REQUIRE(solution_data.solutions.size() == 2 * cycle_length);
+  std::set<std::vector<std::pair<VertexWSM, VertexWSM>>> distinct_solutions;
+  for (const SolutionWSM& solution : solution_data.solutions) {
+    CHECK(solution.scalar_product == cycle_length);
+    distinct_solutions.insert(solution.assignments);
+  }
+  CHECK(distinct_solutions.size() == solution_data.solutions.size());
+
+  // With a smaller limit, the combined solutions are cut off.
+  solver_params.for_multiple_full_solutions_the_max_number_to_obtain = 5;
+  const MainSolver limited_solver(edges, edges, solver_params);
+  CHECK(limited_solver.get_solution_data().solutions.size() == 5);
+}
+
+}  // namespace WeightedSubgraphMonomorphism
+}  // namespace tket
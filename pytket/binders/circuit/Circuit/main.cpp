@@ -17,8 +17,10 @@
 #include <nanobind/nanobind.h>
 #include <nanobind/operators.h>
 
+#include <fstream>
 #include <optional>
 #include <sstream>
+#include <stdexcept>
 #include <utility>
 
 #include "UnitRegister.hpp"
@@ -30,10 +32,13 @@
 #include "py_operators.hpp"
 #include "tket/Circuit/Boxes.hpp"
 #include "tket/Circuit/Circuit.hpp"
+#include "tket/Circuit/CircuitJsonStream.hpp"
 #include "tket/Circuit/Command.hpp"
 #include "tket/Circuit/DummyBox.hpp"
 #include "tket/Circuit/PauliExpBoxes.hpp"
 #include "tket/Circuit/Simulation/CircuitSimulator.hpp"
+#include "tket/Circuit/Simulation/SimulatedMeasurement.hpp"
+#include "tket/Circuit/Simulation/StabiliserSimulator.hpp"
 #include "tket/Circuit/ToffoliBox.hpp"
 #include "tket/Mapping/Verification.hpp"
 #include "typecast.hpp"
@@ -129,13 +134,28 @@ void def_circuit(nb::class_<Circuit> &pyCircuit) {
           ":return: a list of all the Commands in the circuit")
       .def(
           "get_unitary",
-          [](const Circuit &circ) { return tket_sim::get_unitary(circ); },
-          ":return: The numerical unitary matrix of the circuit, using ILO-BE "
-          "convention.")
+          [](const Circuit &circ, unsigned max_number_of_qubits,
+             unsigned n_threads) {
+            nb::gil_scoped_release release;
+            return tket_sim::get_unitary(
+                circ, EPS, max_number_of_qubits, n_threads);
+          },
+          "Calculate the numerical unitary matrix of the circuit, using "
+          "ILO-BE convention."
+          "\n\n:param max_number_of_qubits: Raise an error if the circuit "
+          "has more qubits than this."
+          "\n:param n_threads: Maximum number of threads to use. Threads are "
+          "started for each gate, so extra threads only help on large "
+          "circuits."
+          "\n:return: The unitary matrix.",
+          nb::arg("max_number_of_qubits") = 11, nb::arg("n_threads") = 1)
       .def(
           "get_unitary_times_other",
-          [](const Circuit &circ, Eigen::MatrixXcd matr) {
-            tket_sim::apply_unitary(circ, matr);
+          [](const Circuit &circ, Eigen::MatrixXcd matr,
+             unsigned max_number_of_qubits, unsigned n_threads) {
+            nb::gil_scoped_release release;
+            tket_sim::apply_unitary(
+                circ, matr, EPS, max_number_of_qubits, n_threads);
             return matr;
           },
           "Calculate UM, where U is the numerical unitary matrix of "
@@ -143,15 +163,107 @@ void def_circuit(nb::class_<Circuit> &pyCircuit) {
           "This is more efficient than calculating U separately, if M has "
           "fewer columns than U."
           "\n\n:param matr: The matrix to be multiplied."
+          "\n:param max_number_of_qubits: Raise an error if the circuit "
+          "has more qubits than this."
+          "\n:param n_threads: Maximum number of threads to use; see "
+          ":py:meth:`get_unitary`."
           "\n:return: The product of the circuit unitary and the given matrix.",
-          nb::arg("matr"))
+          nb::arg("matr"), nb::arg("max_number_of_qubits") = 11,
+          nb::arg("n_threads") = 1)
       .def(
           "get_statevector",
-          [](const Circuit &circ) { return tket_sim::get_statevector(circ); },
+          [](const Circuit &circ, unsigned max_number_of_qubits,
+             unsigned n_threads) {
+            nb::gil_scoped_release release;
+            return tket_sim::get_statevector(
+                circ, EPS, max_number_of_qubits, n_threads);
+          },
           "Calculate the statevector resulting from applying the circuit to "
           "the all-zero state, using ILO-BE convention. The result is a one-"
           "dimensional array."
-          "\n\n:return: The calculated vector.")
+          "\n\n:param max_number_of_qubits: Raise an error if the circuit "
+          "has more qubits than this."
+          "\n:param n_threads: Maximum number of threads to use; see "
+          ":py:meth:`get_unitary`."
+          "\n:return: The calculated vector.",
+          nb::arg("max_number_of_qubits") = 11, nb::arg("n_threads") = 1)
+      .def(
+          "sample_shots",
+          [](const Circuit &circ, unsigned n_shots, std::size_t seed,
+             unsigned max_number_of_qubits, unsigned n_threads) {
+            nb::gil_scoped_release release;
+            return tket_sim::sample_shots(
+                circ, n_shots, seed, max_number_of_qubits, n_threads);
+          },
+          "Sample outcomes of measuring every qubit at the end of the "
+          "circuit applied to the all-zero state, by simulating the "
+          "statevector. The circuit must not contain measurements."
+          "\n\n:param n_shots: Number of outcomes to sample."
+          "\n:param seed: Seed for the random number generator; the same "
+          "seed always gives the same outcomes."
+          "\n:param max_number_of_qubits: Raise an error if the circuit "
+          "has more qubits than this."
+          "\n:param n_threads: Maximum number of threads to use; see "
+          ":py:meth:`get_unitary`."
+          "\n:return: A boolean array with one row per shot and one "
+          "column per qubit, in the order of :py:attr:`qubits`.",
+          nb::arg("n_shots"), nb::arg("seed"),
+          nb::arg("max_number_of_qubits") = 11, nb::arg("n_threads") = 1)
+      .def(
+          "get_expectation_value",
+          [](const Circuit &circ, const std::vector<SpCxPauliTensor> &op,
+             unsigned max_number_of_qubits, unsigned n_threads) {
+            nb::gil_scoped_release release;
+            return tket_sim::expectation(
+                circ, op, max_number_of_qubits, n_threads);
+          },
+          "Calculate the expectation value of an operator, given as a sum "
+          "of Pauli terms, in the state resulting from applying the circuit "
+          "to the all-zero state."
+          "\n\n:param op: The terms of the operator, which may only act on "
+          "qubits of the circuit."
+          "\n:param max_number_of_qubits: Raise an error if the circuit "
+          "has more qubits than this."
+          "\n:param n_threads: Maximum number of threads to use; see "
+          ":py:meth:`get_unitary`."
+          "\n:return: The expectation value.",
+          nb::arg("op"), nb::arg("max_number_of_qubits") = 11,
+          nb::arg("n_threads") = 1)
+      .def(
+          "get_stabiliser_state",
+          [](const Circuit &circ, std::size_t seed) {
+            SymplecticTableau tab = [&] {
+              nb::gil_scoped_release release;
+              return tket_sim::get_stabiliser_state(circ, seed);
+            }();
+            PauliStabiliserVec stabilisers;
+            for (unsigned i = 0; i < tab.get_n_rows(); ++i) {
+              stabilisers.push_back(tab.get_pauli(i));
+            }
+            return stabilisers;
+          },
+          "Simulate a Clifford circuit, which may contain measurements, "
+          "resets and conditional gates, on the all-zero state using a "
+          "stabiliser tableau. This scales to thousands of qubits."
+          "\n\n:param seed: Seed for the random measurement outcomes."
+          "\n:return: Generators of the stabiliser group of the final state, "
+          "with Paulis in the order of :py:attr:`qubits`.",
+          nb::arg("seed") = 0)
+      .def(
+          "sample_clifford_shots",
+          [](const Circuit &circ, unsigned n_shots, std::size_t seed) {
+            nb::gil_scoped_release release;
+            return tket_sim::sample_clifford_shots(circ, n_shots, seed);
+          },
+          "Sample the bits written by a Clifford circuit, which may contain "
+          "measurements, resets and conditional gates, by simulating it "
+          "with a stabiliser tableau once per shot."
+          "\n\n:param n_shots: Number of times to run the circuit."
+          "\n:param seed: Seed for the random measurement outcomes; the "
+          "same seed always gives the same shots."
+          "\n:return: A boolean array with one row per shot and one "
+          "column per bit, in the order of :py:attr:`bits`.",
+          nb::arg("n_shots"), nb::arg("seed"))
       .def(
           "add_q_register",
           [](Circuit &circ, const std::string &name, const std::size_t &size) {
@@ -602,11 +714,66 @@ void def_circuit(nb::class_<Circuit> &pyCircuit) {
       .def_static(
           "from_json",
           [](const std::string &circuit_str) {
-            Circuit c = json::parse(circuit_str);
-            return c;
+            return circuit_from_json_stream(circuit_str);
           },
           "Construct Circuit instance from JSON serialized "
           "UTF-8 string representation of the Circuit.")
+      .def(
+          "to_binary",
+          [](const Circuit &c) {
+            const std::string data = c.to_binary();
+            return nb::bytes(data.data(), data.size());
+          },
+          ":return: a compact binary serialization of the Circuit")
+      .def_static(
+          "from_binary",
+          [](const nb::bytes &data) {
+            return Circuit::from_binary(
+                std::string_view(data.c_str(), data.size()));
+          },
+          "Construct Circuit instance from its binary serialization, as "
+          "returned by :py:meth:`to_binary`.",
+          nb::arg("data"))
+      .def(
+          "to_binary_file", &Circuit::to_binary_file,
+          "Write the binary serialization of the Circuit to a file."
+          "\n\n:param filename: path of the file to write",
+          nb::arg("filename"))
+      .def_static(
+          "from_binary_file", &Circuit::from_binary_file,
+          "Construct Circuit instance from a file written by "
+          ":py:meth:`to_binary_file`. The file is memory-mapped where the "
+          "platform supports it."
+          "\n\n:param filename: path of the file to read",
+          nb::arg("filename"))
+      .def(
+          "to_json_file",
+          [](const Circuit &c, const std::string &filename) {
+            std::ofstream out(filename);
+            if (!out) {
+              throw std::invalid_argument("Cannot open " + filename);
+            }
+            circuit_to_json_stream(c, out);
+          },
+          "Write the JSON serialization of the Circuit to a file, one "
+          "command at a time, without building the whole JSON document in "
+          "memory."
+          "\n\n:param filename: path of the file to write",
+          nb::arg("filename"))
+      .def_static(
+          "from_json_file",
+          [](const std::string &filename) {
+            std::ifstream in(filename);
+            if (!in) {
+              throw std::invalid_argument("Cannot open " + filename);
+            }
+            return circuit_from_json_stream(in);
+          },
+          "Construct Circuit instance from a file containing its JSON "
+          "serialization. Commands are added to the circuit as they are "
+          "read, so the whole JSON document is never held in memory."
+          "\n\n:param filename: path of the file to read",
+          nb::arg("filename"))
       .def(
           "__getstate__",
           [](const Circuit &circ) {
@@ -666,6 +833,10 @@ void def_circuit(nb::class_<Circuit> &pyCircuit) {
           "is_symbolic", &Circuit::is_symbolic,
           ":return: True if the circuit "
           "contains any free symbols, False otherwise.")
+      .def(
+          "structural_hash", &Circuit::structural_hash,
+          ":return: a hash of the circuit's DAG, units, name and phase, "
+          "independent of the order in which commutable commands were added")
       .def(
           "substitute_named",
           [](Circuit &circ, Op_ptr op, const std::string &opgroup) {
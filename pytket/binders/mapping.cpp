@@ -71,11 +71,13 @@ NB_MODULE(mapping, m) {
       "Lexicographical Comparison approach outlined in arXiv:1902.08091."
       "Only supports 1-qubit, 2-qubit and barrier gates.")
       .def(
-          nb::init<unsigned>(),
+          nb::init<unsigned, unsigned>(),
           "LexiRoute constructor.\n\n:param lookahead: Maximum depth of "
           "lookahead employed when picking SWAP for purpose of logical to "
-          "physical mapping.",
-          nb::arg("lookahead") = 10);
+          "physical mapping."
+          "\n:param n_threads: Maximum number of threads used to score "
+          "candidate SWAPs. The routed circuit does not depend on this value.",
+          nb::arg("lookahead") = 10, nb::arg("n_threads") = 1);
 
   nb::class_<AASRouteRoutingMethod, RoutingMethod>(
       m, "AASRouteRoutingMethod",
@@ -118,6 +120,50 @@ NB_MODULE(mapping, m) {
       "Defines a RoutingMethod object for decomposing boxes.")
       .def(nb::init<>(), "BoxDecompositionRoutingMethod constructor.");
 
+  nb::enum_<PortfolioObjective>(
+      m, "PortfolioObjective",
+      "Objective used to choose between the results of portfolio routing.")
+      .value(
+          "SwapCount", PortfolioObjective::SwapCount,
+          "Fewest SWAP and BRIDGE gates, then least depth.")
+      .value(
+          "Depth", PortfolioObjective::Depth,
+          "Least depth, then fewest SWAP and BRIDGE gates.");
+
+  nb::class_<PortfolioRoutingConfig>(
+      m, "PortfolioRoutingConfig",
+      "One configuration tried by "
+      ":py:meth:`MappingManager.route_circuit_portfolio`.")
+      .def(
+          "__init__",
+          [](PortfolioRoutingConfig* p,
+             const nb::tket_custom::SequenceVec<RoutingMethodPtr>&
+                 routing_methods,
+             const std::optional<std::map<Qubit, Node>>& placement) {
+            new (p) PortfolioRoutingConfig{routing_methods, placement};
+          },
+          "Constructor.\n\n:param routing_methods: Ranked methods to use "
+          "for routing subcircuits"
+          "\n:param placement: Initial placement of the circuit's qubits, if "
+          "any",
+          nb::arg("routing_methods"), nb::arg("placement") = nb::none());
+
+  nb::class_<PortfolioRoutingResult>(
+      m, "PortfolioRoutingResult",
+      "Outcome of :py:meth:`MappingManager.route_circuit_portfolio`.")
+      .def_ro(
+          "config_index", &PortfolioRoutingResult::config_index,
+          "Index of the chosen configuration.")
+      .def_ro(
+          "n_swaps", &PortfolioRoutingResult::n_swaps,
+          "Number of SWAP and BRIDGE gates in the chosen result.")
+      .def_ro(
+          "depth", &PortfolioRoutingResult::depth,
+          "Depth of the chosen result.")
+      .def_ro(
+          "n_completed", &PortfolioRoutingResult::n_completed,
+          "Number of configurations that finished routing.");
+
   nb::class_<MappingManager>(
       m, "MappingManager",
       "Defined by a pytket Architecture object, maps Circuit logical qubits "
@@ -143,6 +189,34 @@ NB_MODULE(mapping, m) {
           "\n:param routing_methods: Ranked methods to use for routing "
           "subcircuits. In given order, each method is sequentially checked "
           "for viability, with the first viable method being used.",
-          nb::arg("circuit"), nb::arg("routing_methods"));
+          nb::arg("circuit"), nb::arg("routing_methods"))
+      .def(
+          "route_circuit_portfolio",
+          [](const MappingManager& self, Circuit& circuit,
+             const nb::tket_custom::SequenceVec<PortfolioRoutingConfig>&
+                 configs,
+             PortfolioObjective objective, unsigned n_threads,
+             std::optional<unsigned> timeout_ms) {
+            nb::gil_scoped_release release;
+            return self.route_circuit_portfolio(
+                circuit, configs, nullptr, objective, n_threads, timeout_ms);
+          },
+          "Routes a copy of the circuit with each configuration "
+          "concurrently, and replaces the circuit with the best result. The "
+          "GIL is released while the circuits are routed. Once the time "
+          "budget has passed and at least one configuration has finished, "
+          "the remaining configurations are abandoned. A routing method "
+          "shared between configurations is called from several threads at "
+          "once, so must be thread-safe."
+          "\n\n:param circuit: pytket circuit to be mapped"
+          "\n:param configs: Configurations to try"
+          "\n:param objective: How to rank the routed circuits"
+          "\n:param n_threads: Maximum number of threads; 0 uses all "
+          "hardware threads"
+          "\n:param timeout_ms: Wall-clock budget in milliseconds, if any"
+          "\n:return: The chosen configuration and its metrics",
+          nb::arg("circuit"), nb::arg("configs"),
+          nb::arg("objective") = PortfolioObjective::SwapCount,
+          nb::arg("n_threads") = 0, nb::arg("timeout_ms") = nb::none());
 }
 }  // namespace tket
@@ -177,8 +177,10 @@ NB_MODULE(partition, m) {
       "measurement_reduction",
       [](const nb::tket_custom::SequenceList<SpPauliString> &strings,
          PauliPartitionStrat strat, GraphColourMethod method,
-         CXConfigType cx_config) {
-        return measurement_reduction(strings, strat, method, cx_config);
+         CXConfigType cx_config, unsigned n_threads) {
+        nb::gil_scoped_release release;
+        return measurement_reduction(
+            strings, strat, method, cx_config, n_threads);
       },
       "Automatically performs graph colouring and diagonalisation to "
       "reduce measurements required for Pauli strings."
@@ -188,16 +190,20 @@ NB_MODULE(partition, m) {
       "\n:param method: The `GraphColourMethod` to use."
       "\n:param cx_config: Whenever diagonalisation is required, use "
       "this configuration of CX gates"
+      "\n:param n_threads: Number of threads used to build the graph for "
+      "graph-based colouring methods"
       "\n:return: a :py:class:`~.MeasurementSetup` object",
       nb::arg("strings"), nb::arg("strat"),
       nb::arg("method") = GraphColourMethod::Lazy,
-      nb::arg("cx_config") = CXConfigType::Snake);
+      nb::arg("cx_config") = CXConfigType::Snake, nb::arg("n_threads") = 1);
 
   m.def(
       "term_sequence",
       [](const nb::tket_custom::SequenceList<SpPauliString> &strings,
-         PauliPartitionStrat strat, GraphColourMethod method) {
-        return term_sequence(strings, strat, method);
+         PauliPartitionStrat strat, GraphColourMethod method,
+         unsigned n_threads) {
+        nb::gil_scoped_release release;
+        return term_sequence(strings, strat, method, n_threads);
       },
       "Takes in a list of QubitPauliString objects and partitions them "
       "into mutually commuting sets according to some PauliPartitionStrat, "
@@ -208,9 +214,11 @@ NB_MODULE(partition, m) {
       "\n:param strat: The `PauliPartitionStrat` to use. Defaults to "
       "`CommutingSets`."
       "\n:param method: The `GraphColourMethod` to use."
+      "\n:param n_threads: Number of threads used to build the graph for "
+      "graph-based colouring methods"
       "\n:return: a list of lists of " CLSOBJS(~.QubitPauliString),
       nb::arg("strings"), nb::arg("strat") = PauliPartitionStrat::CommutingSets,
-      nb::arg("method") = GraphColourMethod::Lazy);
+      nb::arg("method") = GraphColourMethod::Lazy, nb::arg("n_threads") = 1);
 }
 
 }  // namespace tket
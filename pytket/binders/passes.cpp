@@ -25,6 +25,7 @@
 #include "tket/Mapping/LexiLabelling.hpp"
 #include "tket/Mapping/LexiRouteRoutingMethod.hpp"
 #include "tket/Mapping/RoutingMethod.hpp"
+#include "tket/Predicates/CompilationCache.hpp"
 #include "tket/Predicates/CompilerPass.hpp"
 #include "tket/Predicates/PassGenerators.hpp"
 #include "tket/Predicates/PassLibrary.hpp"
@@ -202,6 +203,28 @@ NB_MODULE(passes, m) {
           "recursive Steiner--Gauss method for CNOT synthesis")
       .export_values();
 
+  nb::class_<CompilationCache>(
+      m, "CompilationCache",
+      "A cache of compilation results, keyed by the structure of the input "
+      "circuit and the configuration of the pass. Used with "
+      ":py:meth:`BasePass.apply_cached`.")
+      .def(
+          nb::init<std::size_t, std::optional<std::string>>(),
+          "Construct an empty cache."
+          "\n\n:param capacity: maximum number of entries held in memory"
+          "\n:param directory: if given, entries are also stored as files in "
+          "this existing directory, so that they persist between sessions",
+          nb::arg("capacity") = 256, nb::arg("directory") = nb::none())
+      .def("__len__", &CompilationCache::size)
+      .def_prop_ro(
+          "hits", &CompilationCache::hits, "Number of successful lookups.")
+      .def_prop_ro(
+          "misses", &CompilationCache::misses,
+          "Number of unsuccessful lookups.")
+      .def(
+          "clear", &CompilationCache::clear,
+          "Remove all entries from memory (but not from the directory).");
+
   /* Compiler passes */
 
   class PyBasePass : public BasePass {
@@ -266,6 +289,104 @@ NB_MODULE(passes, m) {
           "configuration are passed into the callback."
           "\n:return: True if pass modified the circuit, else False",
           nb::arg("circuit"), nb::arg("before_apply"), nb::arg("after_apply"))
+      .def(
+          "apply_cached",
+          [](const BasePass &pass, Circuit &circ, CompilationCache &cache) {
+            CompilationUnit cu(circ);
+            bool applied = pass.apply_cached(cu, cache);
+            circ = cu.get_circ_ref();
+            return applied;
+          },
+          "Apply to a :py:class:`~.Circuit` in-place, reusing the result from "
+          "the cache if this pass has already been applied to an identical "
+          "circuit. Passes containing custom transformations, predicates or "
+          "routing methods are always applied and never cached."
+          "\n\n:param circuit: circuit to compile"
+          "\n:param cache: cache of compilation results"
+          "\n:return: True if pass modified the circuit, else False",
+          nb::arg("circuit"), nb::arg("cache"))
+      .def(
+          "apply_cached",
+          [](const BasePass &pass, CompilationUnit &cu, CompilationCache &cache,
+             SafetyMode safety_mode) {
+            return pass.apply_cached(cu, cache, safety_mode);
+          },
+          "Apply to a :py:class:`~.CompilationUnit`, reusing the result from "
+          "the cache if this pass has already been applied to an identical "
+          "circuit. The initial and final maps are updated as by "
+          ":py:meth:`apply`."
+          "\n\n:param compilation_unit: unit to compile"
+          "\n:param cache: cache of compilation results"
+          "\n:return: True if pass modified the circuit, else False",
+          nb::arg("compilation_unit"), nb::arg("cache"),
+          nb::arg("safety_mode") = SafetyMode::Default)
+      .def(
+          "apply_batch",
+          [](const BasePass &pass, const std::vector<Circuit *> &circuits,
+             unsigned n_threads) {
+            std::vector<CompilationUnit> cus;
+            cus.reserve(circuits.size());
+            for (const Circuit *circ : circuits) {
+              cus.emplace_back(*circ);
+            }
+            std::vector<bool> applied;
+            {
+              nb::gil_scoped_release release;
+              applied = pass.apply_batch(cus, n_threads);
+            }
+            for (std::size_t i = 0; i < circuits.size(); ++i) {
+              *circuits[i] = cus[i].get_circ_ref();
+            }
+            return applied;
+          },
+          "Apply to a list of :py:class:`~.Circuit` in-place, compiling the "
+          "circuits concurrently on a pool of threads. The GIL is released "
+          "while the circuits are compiled."
+          "\n\n:param circuits: circuits to compile; these must be distinct "
+          "objects"
+          "\n:param n_threads: maximum number of threads to use; 0 means the "
+          "number of hardware threads"
+          "\n:return: for each circuit, True if the pass modified it, else "
+          "False",
+          nb::arg("circuits"), nb::arg("n_threads") = 0)
+      .def(
+          "apply_batch",
+          [](const BasePass &pass,
+             const std::vector<CompilationUnit *> &compilation_units,
+             unsigned n_threads, SafetyMode safety_mode) {
+            std::vector<CompilationUnit> cus;
+            cus.reserve(compilation_units.size());
+            for (CompilationUnit *cu : compilation_units) {
+              cus.push_back(std::move(*cu));
+            }
+            // Hand the units back to the caller even if compilation throws.
+            auto restore_units = [&]() {
+              for (std::size_t i = 0; i < compilation_units.size(); ++i) {
+                *compilation_units[i] = std::move(cus[i]);
+              }
+            };
+            std::vector<bool> applied;
+            try {
+              nb::gil_scoped_release release;
+              applied = pass.apply_batch(cus, n_threads, safety_mode);
+            } catch (...) {
+              restore_units();
+              throw;
+            }
+            restore_units();
+            return applied;
+          },
+          "Apply to a list of :py:class:`~.CompilationUnit`, compiling them "
+          "concurrently on a pool of threads. The GIL is released while the "
+          "units are compiled."
+          "\n\n:param compilation_units: units to compile; these must be "
+          "distinct objects"
+          "\n:param n_threads: maximum number of threads to use; 0 means the "
+          "number of hardware threads"
+          "\n:return: for each unit, True if the pass modified its circuit, "
+          "else False",
+          nb::arg("compilation_units"), nb::arg("n_threads") = 0,
+          nb::arg("safety_mode") = SafetyMode::Default)
       .def("__str__", [](const BasePass &) { return "<tket::BasePass>"; })
       .def("__repr__", &BasePass::to_string)
       .def(
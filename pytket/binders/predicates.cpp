@@ -358,6 +358,25 @@ NB_MODULE(predicates, m) {
           },
           "Returns the map from the original qubits to their "
           "corresponding qubits at the end of the current circuit.")
+      .def(
+          "enable_trace", &CompilationUnit::enable_trace,
+          "Start recording the passes applied to this unit, with their "
+          "timings and the circuit size before and after each, discarding "
+          "any earlier record. If `enable` is False, stop recording."
+          "\n\nRecording computes the circuit depth before and after every "
+          "pass, so slows compilation down.",
+          nb::arg("enable") = true)
+      .def_prop_ro(
+          "trace",
+          [](const CompilationUnit &cu) -> nb::object {
+            if (!cu.get_trace()) return nb::none();
+            return nb::cast<nb::dict>(
+                nb::object(json(cu.get_trace()->to_chrome_trace())));
+          },
+          "The passes and predicate checks recorded since tracing was "
+          "enabled, in the Chrome trace event format (which can be saved "
+          "as JSON and viewed in Perfetto or chrome://tracing), or None "
+          "if tracing is not enabled.")
       .def(
           "__str__",
           [](const CompilationUnit &) { return "<tket::CompilationUnit>"; })
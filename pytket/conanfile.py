@@ -59,7 +59,7 @@ class pytketRecipe(ConanFile):
         self.requires("tklog/0.3.3@tket/stable")
         self.requires("tkrng/0.3.3@tket/stable")
         self.requires("tktokenswap/0.3.13@tket/stable")
-        self.requires("tkwsm/0.3.13@tket/stable")
+        self.requires("tkwsm/0.3.15@tket/stable")
 
     def export(self):
         # Copy the TKET_VERSION file to the export folder
@@ -1769,26 +1769,72 @@ class Circuit:
     def get_commands(self) -> list[Command]:
         """:return: a list of all the Commands in the circuit"""
 
-    def get_unitary(self) -> Annotated[NDArray[numpy.complex128], dict(shape=(None, None), order='F')]:
+    def get_unitary(self, max_number_of_qubits: int = 11, n_threads: int = 1) -> Annotated[NDArray[numpy.complex128], dict(shape=(None, None), order='F')]:
         """
-        :return: The numerical unitary matrix of the circuit, using ILO-BE convention.
+        Calculate the numerical unitary matrix of the circuit, using ILO-BE convention.
+
+        :param max_number_of_qubits: Raise an error if the circuit has more qubits than this.
+        :param n_threads: Maximum number of threads to use. Threads are started for each gate, so extra threads only help on large circuits.
+        :return: The unitary matrix.
         """
 
-    def get_unitary_times_other(self, matr: Annotated[NDArray[numpy.complex128], dict(shape=(None, None), order='F')]) -> Annotated[NDArray[numpy.complex128], dict(shape=(None, None), order='F')]:
+    def get_unitary_times_other(self, matr: Annotated[NDArray[numpy.complex128], dict(shape=(None, None), order='F')], max_number_of_qubits: int = 11, n_threads: int = 1) -> Annotated[NDArray[numpy.complex128], dict(shape=(None, None), order='F')]:
         """
         Calculate UM, where U is the numerical unitary matrix of the circuit, with ILO-BE convention, and M is another matrix. This is more efficient than calculating U separately, if M has fewer columns than U.
 
         :param matr: The matrix to be multiplied.
+        :param max_number_of_qubits: Raise an error if the circuit has more qubits than this.
+        :param n_threads: Maximum number of threads to use; see :py:meth:`get_unitary`.
         :return: The product of the circuit unitary and the given matrix.
         """
 
-    def get_statevector(self) -> Annotated[NDArray[numpy.complex128], dict(shape=(None,), order='C')]:
+    def get_statevector(self, max_number_of_qubits: int = 11, n_threads: int = 1) -> Annotated[NDArray[numpy.complex128], dict(shape=(None,), order='C')]:
         """
         Calculate the statevector resulting from applying the circuit to the all-zero state, using ILO-BE convention. The result is a one-dimensional array.
 
+        :param max_number_of_qubits: Raise an error if the circuit has more qubits than this.
+        :param n_threads: Maximum number of threads to use; see :py:meth:`get_unitary`.
         :return: The calculated vector.
         """
 
+    def sample_shots(self, n_shots: int, seed: int, max_number_of_qubits: int = 11, n_threads: int = 1) -> Annotated[NDArray[numpy.bool_], dict(shape=(None, None), order='F')]:
+        """
+        Sample outcomes of measuring every qubit at the end of the circuit applied to the all-zero state, by simulating the statevector. The circuit must not contain measurements.
+
+        :param n_shots: Number of outcomes to sample.
+        :param seed: Seed for the random number generator; the same seed always gives the same outcomes.
+        :param max_number_of_qubits: Raise an error if the circuit has more qubits than this.
+        :param n_threads: Maximum number of threads to use; see :py:meth:`get_unitary`.
+        :return: A boolean array with one row per shot and one column per qubit, in the order of :py:attr:`qubits`.
+        """
+
+    def get_expectation_value(self, op: Sequence[pytket._tket.pauli.QubitPauliTensor], max_number_of_qubits: int = 11, n_threads: int = 1) -> complex:
+        """
+        Calculate the expectation value of an operator, given as a sum of Pauli terms, in the state resulting from applying the circuit to the all-zero state.
+
+        :param op: The terms of the operator, which may only act on qubits of the circuit.
+        :param max_number_of_qubits: Raise an error if the circuit has more qubits than this.
+        :param n_threads: Maximum number of threads to use; see :py:meth:`get_unitary`.
+        :return: The expectation value.
+        """
+
+    def get_stabiliser_state(self, seed: int = 0) -> list[pytket._tket.pauli.PauliStabiliser]:
+        """
+        Simulate a Clifford circuit, which may contain measurements, resets and conditional gates, on the all-zero state using a stabiliser tableau. This scales to thousands of qubits.
+
+        :param seed: Seed for the random measurement outcomes.
+        :return: Generators of the stabiliser group of the final state, with Paulis in the order of :py:attr:`qubits`.
+        """
+
+    def sample_clifford_shots(self, n_shots: int, seed: int) -> Annotated[NDArray[numpy.bool_], dict(shape=(None, None), order='F')]:
+        """
+        Sample the bits written by a Clifford circuit, which may contain measurements, resets and conditional gates, by simulating it with a stabiliser tableau once per shot.
+
+        :param n_shots: Number of times to run the circuit.
+        :param seed: Seed for the random measurement outcomes; the same seed always gives the same shots.
+        :return: A boolean array with one row per shot and one column per bit, in the order of :py:attr:`bits`.
+        """
+
     @overload
     def add_q_register(self, name: str, size: int) -> pytket._tket.unit_id.QubitRegister:
         """
@@ -2154,6 +2200,45 @@ class Circuit:
         Construct Circuit instance from JSON serialized UTF-8 string representation of the Circuit.
         """
 
+    def to_binary(self) -> bytes:
+        """:return: a compact binary serialization of the Circuit"""
+
+    @staticmethod
+    def from_binary(data: bytes) -> Circuit:
+        """
+        Construct Circuit instance from its binary serialization, as returned by :py:meth:`to_binary`.
+        """
+
+    def to_binary_file(self, filename: str) -> None:
+        """
+        Write the binary serialization of the Circuit to a file.
+
+        :param filename: path of the file to write
+        """
+
+    @staticmethod
+    def from_binary_file(filename: str) -> Circuit:
+        """
+        Construct Circuit instance from a file written by :py:meth:`to_binary_file`. The file is memory-mapped where the platform supports it.
+
+        :param filename: path of the file to read
+        """
+
+    def to_json_file(self, filename: str) -> None:
+        """
+        Write the JSON serialization of the Circuit to a file, one command at a time, without building the whole JSON document in memory.
+
+        :param filename: path of the file to write
+        """
+
+    @staticmethod
+    def from_json_file(filename: str) -> Circuit:
+        """
+        Construct Circuit instance from a file containing its JSON serialization. Commands are added to the circuit as they are read, so the whole JSON document is never held in memory.
+
+        :param filename: path of the file to read
+        """
+
     def __getstate__(self) -> tuple: ...
 
     def __setstate__(self, arg: tuple, /) -> None: ...
@@ -2207,6 +2292,11 @@ class Circuit:
         :return: True if the circuit contains any free symbols, False otherwise.
         """
 
+    def structural_hash(self) -> int:
+        """
+        :return: a hash of the circuit's DAG, units, name and phase, independent of the order in which commutable commands were added
+        """
+
     @overload
     def substitute_named(self, op: Op, opgroup: str) -> bool:
         """
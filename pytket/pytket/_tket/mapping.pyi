@@ -1,4 +1,5 @@
 from collections.abc import Callable, Mapping, Sequence
+import enum
 
 import pytket._tket.architecture
 import pytket._tket.circuit
@@ -31,11 +32,12 @@ class LexiRouteRoutingMethod(RoutingMethod):
     Defines a RoutingMethod object for mapping circuits that uses the Lexicographical Comparison approach outlined in arXiv:1902.08091.Only supports 1-qubit, 2-qubit and barrier gates.
     """
 
-    def __init__(self, lookahead: int = 10) -> None:
+    def __init__(self, lookahead: int = 10, n_threads: int = 1) -> None:
         """
         LexiRoute constructor.
 
         :param lookahead: Maximum depth of lookahead employed when picking SWAP for purpose of logical to physical mapping.
+        :param n_threads: Maximum number of threads used to score candidate SWAPs. The routed circuit does not depend on this value.
         """
 
 class AASRouteRoutingMethod(RoutingMethod):
@@ -85,6 +87,49 @@ class BoxDecompositionRoutingMethod(RoutingMethod):
     def __init__(self) -> None:
         """BoxDecompositionRoutingMethod constructor."""
 
+class PortfolioObjective(enum.Enum):
+    """Objective used to choose between the results of portfolio routing."""
+
+    SwapCount = 0
+    """Fewest SWAP and BRIDGE gates, then least depth."""
+
+    Depth = 1
+    """Least depth, then fewest SWAP and BRIDGE gates."""
+
+class PortfolioRoutingConfig:
+    """
+    One configuration tried by :py:meth:`MappingManager.route_circuit_portfolio`.
+    """
+
+    def __init__(self, routing_methods: Sequence[RoutingMethod], placement: Mapping[pytket._tket.unit_id.Qubit, pytket._tket.unit_id.Node] | None = None) -> None:
+        """
+        Constructor.
+
+        :param routing_methods: Ranked methods to use for routing subcircuits
+        :param placement: Initial placement of the circuit's qubits, if any
+        """
+
+class PortfolioRoutingResult:
+    """
+    Outcome of :py:meth:`MappingManager.route_circuit_portfolio`.
+    """
+
+    @property
+    def config_index(self) -> int:
+        """Index of the chosen configuration."""
+
+    @property
+    def n_swaps(self) -> int:
+        """Number of SWAP and BRIDGE gates in the chosen result."""
+
+    @property
+    def depth(self) -> int:
+        """Depth of the chosen result."""
+
+    @property
+    def n_completed(self) -> int:
+        """Number of configurations that finished routing."""
+
 class MappingManager:
     """
     Defined by a pytket Architecture object, maps Circuit logical qubits to physically permitted Architecture qubits. Mapping is completed by sequential routing (full or partial) of subcircuits. A custom method for routing (full or partial) of subcircuits can be defined in Python.
@@ -104,3 +149,15 @@ class MappingManager:
         :param circuit: pytket circuit to be mapped
         :param routing_methods: Ranked methods to use for routing subcircuits. In given order, each method is sequentially checked for viability, with the first viable method being used.
         """
+
+    def route_circuit_portfolio(self, circuit: pytket._tket.circuit.Circuit, configs: Sequence[PortfolioRoutingConfig], objective: PortfolioObjective = PortfolioObjective.SwapCount, n_threads: int = 0, timeout_ms: int | None = None) -> PortfolioRoutingResult:
+        """
+        Routes a copy of the circuit with each configuration concurrently, and replaces the circuit with the best result. The GIL is released while the circuits are routed. Once the time budget has passed and at least one configuration has finished, the remaining configurations are abandoned. A routing method shared between configurations is called from several threads at once, so must be thread-safe.
+
+        :param circuit: pytket circuit to be mapped
+        :param configs: Configurations to try
+        :param objective: How to rank the routed circuits
+        :param n_threads: Maximum number of threads; 0 uses all hardware threads
+        :param timeout_ms: Wall-clock budget in milliseconds, if any
+        :return: The chosen configuration and its metrics
+        """
@@ -125,7 +125,7 @@ class MeasurementSetup:
 
     def __setstate__(self, arg: tuple, /) -> None: ...
 
-def measurement_reduction(strings: Sequence[pytket._tket.pauli.QubitPauliString], strat: PauliPartitionStrat, method: GraphColourMethod = GraphColourMethod.Lazy, cx_config: pytket._tket.circuit.CXConfigType = pytket._tket.circuit.CXConfigType.Snake) -> MeasurementSetup:
+def measurement_reduction(strings: Sequence[pytket._tket.pauli.QubitPauliString], strat: PauliPartitionStrat, method: GraphColourMethod = GraphColourMethod.Lazy, cx_config: pytket._tket.circuit.CXConfigType = pytket._tket.circuit.CXConfigType.Snake, n_threads: int = 1) -> MeasurementSetup:
     """
     Automatically performs graph colouring and diagonalisation to reduce measurements required for Pauli strings.
 
@@ -133,15 +133,17 @@ def measurement_reduction(strings: Sequence[pytket._tket.pauli.QubitPauliString]
     :param strat: The `PauliPartitionStrat` to use.
     :param method: The `GraphColourMethod` to use.
     :param cx_config: Whenever diagonalisation is required, use this configuration of CX gates
+    :param n_threads: Number of threads used to build the graph for graph-based colouring methods
     :return: a :py:class:`~.MeasurementSetup` object
     """
 
-def term_sequence(strings: Sequence[pytket._tket.pauli.QubitPauliString], strat: PauliPartitionStrat = PauliPartitionStrat.CommutingSets, method: GraphColourMethod = GraphColourMethod.Lazy) -> list[list[pytket._tket.pauli.QubitPauliString]]:
+def term_sequence(strings: Sequence[pytket._tket.pauli.QubitPauliString], strat: PauliPartitionStrat = PauliPartitionStrat.CommutingSets, method: GraphColourMethod = GraphColourMethod.Lazy, n_threads: int = 1) -> list[list[pytket._tket.pauli.QubitPauliString]]:
     """
     Takes in a list of QubitPauliString objects and partitions them into mutually commuting sets according to some PauliPartitionStrat, then sequences in an arbitrary order.
 
     :param tensors: A list of `QubitPauliString` objects to be sequenced. Assumes that each Pauli tensor is unique, and does not combine equivalent tensors.
     :param strat: The `PauliPartitionStrat` to use. Defaults to `CommutingSets`.
     :param method: The `GraphColourMethod` to use.
+    :param n_threads: Number of threads used to build the graph for graph-based colouring methods
     :return: a list of lists of :py:class:`~.QubitPauliString` s
     """
@@ -47,6 +47,32 @@ HamPath: CNotSynthType = CNotSynthType.HamPath
 
 Rec: CNotSynthType = CNotSynthType.Rec
 
+class CompilationCache:
+    """
+    A cache of compilation results, keyed by the structure of the input circuit and the configuration of the pass. Used with :py:meth:`BasePass.apply_cached`.
+    """
+
+    def __init__(self, capacity: int = 256, directory: str | None = None) -> None:
+        """
+        Construct an empty cache.
+
+        :param capacity: maximum number of entries held in memory
+        :param directory: if given, entries are also stored as files in this existing directory, so that they persist between sessions
+        """
+
+    def __len__(self) -> int: ...
+
+    @property
+    def hits(self) -> int:
+        """Number of successful lookups."""
+
+    @property
+    def misses(self) -> int:
+        """Number of unsuccessful lookups."""
+
+    def clear(self) -> None:
+        """Remove all entries from memory (but not from the directory)."""
+
 class BasePass:
     """Base class for passes."""
 
@@ -77,6 +103,46 @@ class BasePass:
         :return: True if pass modified the circuit, else False
         """
 
+    @overload
+    def apply_cached(self, circuit: pytket._tket.circuit.Circuit, cache: CompilationCache) -> bool:
+        """
+        Apply to a :py:class:`~.Circuit` in-place, reusing the result from the cache if this pass has already been applied to an identical circuit. Passes containing custom transformations, predicates or routing methods are always applied and never cached.
+
+        :param circuit: circuit to compile
+        :param cache: cache of compilation results
+        :return: True if pass modified the circuit, else False
+        """
+
+    @overload
+    def apply_cached(self, compilation_unit: pytket._tket.predicates.CompilationUnit, cache: CompilationCache, safety_mode: SafetyMode = SafetyMode.Default) -> bool:
+        """
+        Apply to a :py:class:`~.CompilationUnit`, reusing the result from the cache if this pass has already been applied to an identical circuit. The initial and final maps are updated as by :py:meth:`apply`.
+
+        :param compilation_unit: unit to compile
+        :param cache: cache of compilation results
+        :return: True if pass modified the circuit, else False
+        """
+
+    @overload
+    def apply_batch(self, circuits: Sequence[pytket._tket.circuit.Circuit], n_threads: int = 0) -> list[bool]:
+        """
+        Apply to a list of :py:class:`~.Circuit` in-place, compiling the circuits concurrently on a pool of threads. The GIL is released while the circuits are compiled.
+
+        :param circuits: circuits to compile; these must be distinct objects
+        :param n_threads: maximum number of threads to use; 0 means the number of hardware threads
+        :return: for each circuit, True if the pass modified it, else False
+        """
+
+    @overload
+    def apply_batch(self, compilation_units: Sequence[pytket._tket.predicates.CompilationUnit], n_threads: int = 0, safety_mode: SafetyMode = SafetyMode.Default) -> list[bool]:
+        """
+        Apply to a list of :py:class:`~.CompilationUnit`, compiling them concurrently on a pool of threads. The GIL is released while the units are compiled.
+
+        :param compilation_units: units to compile; these must be distinct objects
+        :param n_threads: maximum number of threads to use; 0 means the number of hardware threads
+        :return: for each unit, True if the pass modified its circuit, else False
+        """
+
     def __str__(self) -> str: ...
 
     def __repr__(self) -> str: ...
@@ -260,6 +260,19 @@ class CompilationUnit:
         Returns the map from the original qubits to their corresponding qubits at the end of the current circuit.
         """
 
+    def enable_trace(self, enable: bool = True) -> None:
+        """
+        Start recording the passes applied to this unit, with their timings and the circuit size before and after each, discarding any earlier record. If `enable` is False, stop recording.
+
+        Recording computes the circuit depth before and after every pass, so slows compilation down.
+        """
+
+    @property
+    def trace(self) -> dict | None:
+        """
+        The passes and predicate checks recorded since tracing was enabled, in the Chrome trace event format (which can be saved as JSON and viewed in Perfetto or chrome://tracing), or None if tracing is not enabled.
+        """
+
     def __str__(self) -> str: ...
 
     def __repr__(self) -> str: ...
@@ -927,6 +927,33 @@ def test_circuit_to_serialized_json_roundtrip(circuit: Circuit) -> None:
     assert Circuit.from_json(serialized_form).to_json() == serialized_form
 
 
+@given(st.circuits())
+@settings(deadline=None)
+def test_circuit_binary_roundtrip(circuit: Circuit) -> None:
+    assert Circuit.from_binary(circuit.to_binary()) == circuit
+
+
+def test_circuit_binary_file_roundtrip(tmp_path: Path) -> None:
+    c = Circuit(2, 1).H(0).CX(0, 1).Measure(1, 0)
+    filename = str(tmp_path / "circuit.tkbc")
+    c.to_binary_file(filename)
+    assert Circuit.from_binary_file(filename) == c
+    with pytest.raises(RuntimeError):
+        Circuit.from_binary(b"TKBD")
+
+
+def test_circuit_json_file_roundtrip(tmp_path: Path) -> None:
+    c = Circuit(3, 1, "file").H(0).CX(0, 1).Rz(0.25, 2).Measure(2, 0)
+    c.add_phase(0.5)
+    filename = str(tmp_path / "circuit.json")
+    c.to_json_file(filename)
+    with open(filename) as f:
+        assert json.load(f) == c.to_dict()
+    c1 = Circuit.from_json_file(filename)
+    assert c1 == c
+    assert c1.name == "file"
+
+
 @given(st.circuits())
 @settings(deadline=None)
 def test_circuit_pickle_roundtrip(circuit: Circuit) -> None:
@@ -12,17 +12,22 @@
 # See the License for the specific language governing permissions and
 # limitations under the License.
 
+from pathlib import Path
+
 import pytest
 
 from pytket.architecture import Architecture
 from pytket.circuit import Circuit, OpType, reg_eq
 from pytket.passes import (
     CXMappingPass,
+    CompilationCache,
+    ComposePhasePolyBoxes,
     FullPeepholeOptimise,
     PassSelector,
     scratch_reg_resize_pass,
 )
 from pytket.placement import Placement
+from pytket.predicates import CompilationUnit
 from pytket.unit_id import _TEMP_BIT_NAME, _TEMP_BIT_REG_BASE
 
 
@@ -311,3 +316,63 @@ def test_resize_scratch_registers() -> None:
     c_compiled = circ.copy()
     scratch_reg_resize_pass(10).apply(c_compiled)
     assert circ == c_compiled
+
+
+def test_apply_batch() -> None:
+    circs = []
+    for i in range(8):
+        c = Circuit(3)
+        c.Rz(0.1 * (i + 1), 0).CX(0, 1).CX(1, 2).Rz(0.2, 2).CX(1, 2).CX(0, 1)
+        circs.append(c)
+    expected = [c.copy() for c in circs]
+    for c in expected:
+        FullPeepholeOptimise().apply(c)
+    applied = FullPeepholeOptimise().apply_batch(circs, n_threads=4)
+    assert applied == [True] * len(circs)
+    assert circs == expected
+
+    cus = [CompilationUnit(c.copy()) for c in expected]
+    applied = FullPeepholeOptimise().apply_batch(cus, n_threads=2)
+    assert len(applied) == len(cus)
+    assert [cu.circuit for cu in cus] == expected
+
+
+def test_apply_batch_failure() -> None:
+    good = Circuit(2).H(0).CX(0, 1).CX(0, 1)
+    bad = Circuit(2, 1).H(0)
+    bad.X(1, condition_bits=[0], condition_value=1)
+    # ComposePhasePolyBoxes requires no classical control.
+    cus = [CompilationUnit(c.copy()) for c in [good, bad, good]]
+    with pytest.raises(RuntimeError, match="Predicate requirements"):
+        ComposePhasePolyBoxes().apply_batch(cus, n_threads=2)
+    # Every unit is still usable, whether or not it was compiled.
+    assert cus[1].circuit == bad
+    for i in [0, 2]:
+        assert cus[i].circuit.n_qubits == 2
+        cu = CompilationUnit(good.copy())
+        ComposePhasePolyBoxes().apply(cu)
+        assert cus[i].circuit in [good, cu.circuit]
+
+
+def test_apply_cached(tmp_path: Path) -> None:
+    c = Circuit(3)
+    c.Rz(0.1, 0).CX(0, 1).CX(1, 2).Rz(0.2, 2).CX(1, 2).CX(0, 1)
+    expected = c.copy()
+    FullPeepholeOptimise().apply(expected)
+
+    cache = CompilationCache(directory=str(tmp_path))
+    c0 = c.copy()
+    assert FullPeepholeOptimise().apply_cached(c0, cache)
+    assert c0 == expected
+    assert (cache.hits, cache.misses, len(cache)) == (0, 1, 1)
+    c1 = c.copy()
+    assert FullPeepholeOptimise().apply_cached(c1, cache)
+    assert c1 == expected
+    assert cache.hits == 1
+
+    # A new cache reads the entry written by the first one.
+    cache = CompilationCache(directory=str(tmp_path))
+    c2 = c.copy()
+    assert FullPeepholeOptimise().apply_cached(c2, cache)
+    assert c2 == expected
+    assert (cache.hits, cache.misses) == (1, 0)
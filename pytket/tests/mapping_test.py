@@ -27,6 +27,8 @@ from pytket.mapping import (
     LexiRouteRoutingMethod,
     MappingManager,
     MultiGateReorderRoutingMethod,
+    PortfolioObjective,
+    PortfolioRoutingConfig,
     RoutingMethodCircuit,
 )
 from pytket.placement import Placement
@@ -134,6 +136,31 @@ def test_LexiRouteRoutingMethod() -> None:
     assert routed_commands[3].qubits == [nodes[0], nodes[1]]
 
 
+
+def test_route_circuit_portfolio() -> None:
+    test_c = Circuit(4).CX(0, 1).CX(2, 3)
+    qubits = test_c.qubits
+    nodes = [Node("test", i) for i in range(4)]
+    test_a = Architecture(
+        [(nodes[0], nodes[1]), (nodes[1], nodes[2]), (nodes[2], nodes[3])]
+    )
+    test_mm = MappingManager(test_a)
+    far = dict(zip(qubits, [nodes[0], nodes[3], nodes[1], nodes[2]]))
+    near = dict(zip(qubits, nodes))
+    configs = [
+        PortfolioRoutingConfig([LexiRouteRoutingMethod()], far),
+        PortfolioRoutingConfig([LexiRouteRoutingMethod()], near),
+    ]
+    result = test_mm.route_circuit_portfolio(
+        test_c, configs, PortfolioObjective.SwapCount, n_threads=2
+    )
+    assert result.config_index == 1
+    assert result.n_swaps == 0
+    assert result.depth == 1
+    assert result.n_completed == 2
+    assert test_c.qubits == nodes
+    assert test_c.n_gates_of_type(OpType.SWAP) == 0
+
 def test_AASRouteRoutingMethod() -> None:
     test_c = Circuit(3, 3)
     n_qb = 3
@@ -11,6 +11,7 @@
 # WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
 # See the License for the specific language governing permissions and
 # limitations under the License.
+import json
 import pickle
 from typing import Any
 
@@ -659,6 +660,29 @@ def test_apply_pass_with_callbacks() -> None:
     assert handler.pass_names[2] == "RemoveRedundancies"
 
 
+def test_compilation_unit_trace() -> None:
+    circ = Circuit(2)
+    circ.H(0).H(0).CX(0, 1).CX(0, 1).Rz(0.5, 1)
+    cu = CompilationUnit(circ)
+    assert cu.trace is None
+    cu.enable_trace()
+    p = SequencePass([RepeatPass(RemoveRedundancies()), SynthesiseTK()])
+    assert p.apply(cu)
+    trace = cu.trace
+    assert trace is not None
+    events = trace["traceEvents"]
+    assert events[-1]["name"] == "SequencePass"
+    assert events[-1]["args"]["before"]["n_gates"] == 5
+    assert events[-1]["args"]["after"]["n_gates"] == 1
+    repeats = [ev for ev in events if ev["name"] == "RepeatPass"]
+    assert len(repeats) == 1
+    inner = [ev for ev in events if ev["name"] == "RemoveRedundancies"]
+    assert repeats[0]["args"]["iterations"] == len(inner)
+    json.dumps(trace)
+    cu.enable_trace(False)
+    assert cu.trace is None
+
+
 def test_remove_discarded() -> None:
     c = Circuit(3, 2)
     c.H(0).H(1).H(2).CX(0, 1).Measure(0, 0).Measure(1, 1).H(0).H(1)
@@ -19,7 +19,8 @@ from typing import Any
 import numpy as np
 import pytest
 
-from pytket.circuit import CircBox, Circuit, Op, OpType, QControlBox
+from pytket.circuit import CircBox, Circuit, Op, OpType, QControlBox, Qubit
+from pytket.pauli import Pauli, QubitPauliTensor
 
 # Note: of course, one could write many more (circuit -> unitary) tests.
 # But the functions are just wrappers around Simulation functions in tket,
@@ -267,3 +268,47 @@ def test_boxes() -> None:
     assert np.allclose(u, np.eye(4, dtype=complex))
     s = c.get_statevector()
     assert np.isclose(s[0], 1.0)
+
+
+def test_qubit_limit_and_threads() -> None:
+    c = Circuit(12)
+    for q in range(12):
+        c.H(q)
+    for q in range(11):
+        c.CX(q, q + 1).Rz(0.1 * q, q + 1)
+    with pytest.raises(RuntimeError):
+        c.get_statevector()
+    sv = c.get_statevector(max_number_of_qubits=12)
+    assert sv.shape == (2**12,)
+    assert np.isclose(np.linalg.norm(sv), 1.0)
+    assert np.allclose(c.get_statevector(max_number_of_qubits=12, n_threads=4), sv)
+
+    small = Circuit(3).H(0).CX(0, 1).Ry(0.3, 2).CZ(1, 2)
+    u = small.get_unitary()
+    assert np.allclose(small.get_unitary(n_threads=4), u)
+    with pytest.raises(RuntimeError):
+        small.get_unitary(max_number_of_qubits=2)
+    m = np.eye(8, 2, dtype=np.complex128)
+    assert np.allclose(small.get_unitary_times_other(m, n_threads=4), u @ m)
+
+
+def test_sampling_beyond_default_qubit_limit() -> None:
+    ghz = Circuit(12).H(0)
+    for q in range(11):
+        ghz.CX(q, q + 1)
+    with pytest.raises(RuntimeError):
+        ghz.sample_shots(10, 1)
+    shots = ghz.sample_shots(50, 1, max_number_of_qubits=12)
+    assert shots.shape == (50, 12)
+    assert all(row.all() or not row.any() for row in shots)
+    assert np.array_equal(
+        ghz.sample_shots(50, 1, max_number_of_qubits=12, n_threads=4), shots
+    )
+
+    zz = QubitPauliTensor([Qubit(0), Qubit(11)], [Pauli.Z, Pauli.Z])
+    with pytest.raises(RuntimeError):
+        ghz.get_expectation_value([zz])
+    assert np.isclose(ghz.get_expectation_value([zz], max_number_of_qubits=12), 1)
+    assert np.isclose(
+        ghz.get_expectation_value([zz], max_number_of_qubits=12, n_threads=4), 1
+    )
@@ -6,6 +6,7 @@ extern "C" {
 #endif
 
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
 // Opaque handle to tket Circuit object
@@ -28,12 +29,32 @@ typedef enum { TKET_TARGET_CX = 0, TKET_TARGET_TK2 = 1 } TketTargetGate;
 TketCircuit *tket_circuit_from_json(const char *json_str);
 TketError tket_circuit_to_json(const TketCircuit *circuit, char **json_str);
 
+// Conversion between Circuit and its compact binary serialisation. The buffer
+// returned by tket_circuit_to_binary must be released with free().
+TketCircuit *tket_circuit_from_binary(const unsigned char *data, size_t size);
+TketError tket_circuit_to_binary(
+    const TketCircuit *circuit, unsigned char **data, size_t *size);
+
 // Loading a Pass from its c-string JSON
 TketPass *tket_pass_from_json(const char *json_str);
 
 // Applying a pass to a circuit
 TketError tket_apply_pass(TketCircuit *circuit, const TketPass *pass);
 
+/**
+ * Apply a pass to each of an array of circuits, compiling them concurrently
+ *
+ * @param circuits Array of distinct circuits (each modified in-place)
+ * @param n_circuits Number of circuits in the array
+ * @param pass Pass to apply
+ * @param n_threads Maximum number of threads to use (0 for the number of
+ * hardware threads)
+ * @return TKET_SUCCESS if successful, error code otherwise
+ */
+TketError tket_apply_pass_batch(
+    TketCircuit **circuits, size_t n_circuits, const TketPass *pass,
+    unsigned n_threads);
+
 // Free memory
 void tket_free_circuit(TketCircuit *circuit);
 void tket_free_pass(TketPass *pass);
@@ -3,8 +3,12 @@ extern "C" {
 }
 
 #include <cstring>
+#include <sstream>
+#include <string_view>
+#include <vector>
 
 #include "tket/Circuit/Circuit.hpp"
+#include "tket/Circuit/CircuitJsonStream.hpp"
 #include "tket/Predicates/CompilerPass.hpp"
 #include "tket/Transformations/BasicOptimisation.hpp"
 #include "tket/Transformations/OptimisationPass.hpp"
@@ -40,7 +44,7 @@ TketCircuit *tket_circuit_from_json(const char *json_str) {
   // Parse JSON and create circuit
   try {
     tc = new TketCircuit;
-    tc->circuit = json::parse(json_str);
+    tc->circuit = circuit_from_json_stream(json_str);
   } catch (const json::parse_error &e) {
     std::cerr << "Invalid JSON in tket_circuit_from_json: " << e.what()
               << std::endl;
@@ -63,8 +67,9 @@ TketError tket_circuit_to_json(const TketCircuit *tc, char **json_str) {
 
   // Convert circuit to JSON
   try {
-    json j = tc->circuit;
-    s = j.dump();
+    std::ostringstream out;
+    circuit_to_json_stream(tc->circuit, out);
+    s = out.str();
   } catch (const json::exception &e) {
     // Something went wrong with reading the circuit into JSON
     return TKET_ERROR_CIRCUIT_INVALID;
@@ -85,6 +90,53 @@ TketError tket_circuit_to_json(const TketCircuit *tc, char **json_str) {
   return TKET_SUCCESS;
 }
 
+TketCircuit *tket_circuit_from_binary(const unsigned char *data, size_t size) {
+  if (!data) return nullptr;
+
+  TketCircuit *tc = nullptr;
+
+  try {
+    tc = new TketCircuit;
+    tc->circuit = Circuit::from_binary(
+        std::string_view(reinterpret_cast<const char *>(data), size));
+  } catch (const BinaryFormatError &e) {
+    std::cerr << "Invalid data in tket_circuit_from_binary: " << e.what()
+              << std::endl;
+    if (tc) tket_free_circuit(tc);
+    tc = nullptr;
+  } catch (...) {
+    // Clean up memory, print error, and exit
+    if (tc) tket_free_circuit(tc);
+    std::cerr << "Unknown error in tket_circuit_from_binary" << std::endl;
+    std::exit(EXIT_FAILURE);
+  }
+
+  return tc;
+}
+
+TketError tket_circuit_to_binary(
+    const TketCircuit *tc, unsigned char **data, size_t *size) {
+  if (!tc || !data || !size) return TKET_ERROR_NULL_POINTER;
+
+  std::string s;
+  try {
+    s = tc->circuit.to_binary();
+  } catch (const json::exception &e) {
+    // An operation could not be serialised
+    return TKET_ERROR_CIRCUIT_INVALID;
+  }
+
+  *data = (unsigned char *)malloc(s.empty() ? 1 : s.size());
+  if (!*data) {
+    std::cerr << "Out of memory in tket_circuit_to_binary" << std::endl;
+    std::exit(EXIT_FAILURE);
+  }
+  std::memcpy(*data, s.data(), s.size());
+  *size = s.size();
+
+  return TKET_SUCCESS;
+}
+
 TketPass *tket_pass_from_json(const char *json_str) {
   if (!json_str) return nullptr;
 
@@ -118,6 +170,23 @@ TketError tket_apply_pass(TketCircuit *tc, const TketPass *tp) {
   return TKET_SUCCESS;
 }
 
+TketError tket_apply_pass_batch(
+    TketCircuit **tcs, size_t n_circuits, const TketPass *tp,
+    unsigned n_threads) {
+  if (!tp || (n_circuits > 0 && !tcs)) return TKET_ERROR_NULL_POINTER;
+  std::vector<CompilationUnit> cus;
+  cus.reserve(n_circuits);
+  for (size_t i = 0; i < n_circuits; ++i) {
+    if (!tcs[i]) return TKET_ERROR_NULL_POINTER;
+    cus.emplace_back(tcs[i]->circuit);
+  }
+  tp->pass->apply_batch(cus, n_threads);
+  for (size_t i = 0; i < n_circuits; ++i) {
+    tcs[i]->circuit = cus[i].get_circ_ref();
+  }
+  return TKET_SUCCESS;
+}
+
 void tket_free_circuit(TketCircuit *tc) { delete tc; }
 
 void tket_free_pass(TketPass *tp) { delete tp; }
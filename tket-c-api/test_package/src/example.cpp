@@ -25,6 +25,35 @@ int main() {
   tket_circuit_to_json(circ, &circ1_json);
   assert(strstr(circ1_json, "CZ"));
 
+  unsigned char *circ_bin = nullptr;
+  size_t circ_bin_size = 0;
+  rv = tket_circuit_to_binary(circ, &circ_bin, &circ_bin_size);
+  assert(rv == TKET_SUCCESS);
+  TketCircuit *circ2 = tket_circuit_from_binary(circ_bin, circ_bin_size);
+  assert(circ2 != nullptr);
+  char *circ2_json = nullptr;
+  tket_circuit_to_json(circ2, &circ2_json);
+  assert(std::string(circ1_json) == circ2_json);
+  free(circ2_json);
+  free(circ_bin);
+  tket_free_circuit(circ2);
+
+  TketCircuit *batch[2] = {
+      tket_circuit_from_json(circ_json.c_str()),
+      tket_circuit_from_json(circ_json.c_str())};
+  rv = tket_apply_pass_batch(batch, 2, pass, 2);
+  if (rv != TKET_SUCCESS) {
+    std::cerr << "Error applying pass to batch: " << rv << std::endl;
+    return -1;
+  }
+  for (TketCircuit *batch_circ : batch) {
+    char *batch_json = nullptr;
+    tket_circuit_to_json(batch_circ, &batch_json);
+    assert(strstr(batch_json, "CZ"));
+    free(batch_json);
+    tket_free_circuit(batch_circ);
+  }
+
   tket_free_circuit(circ);
   tket_free_pass(pass);
   free(circ1_json);
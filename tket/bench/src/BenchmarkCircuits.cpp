@@ -0,0 +1,177 @@
+// Copyright Quantinuum
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "BenchmarkCircuits.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <stdexcept>
+#include <tkrng/RNG.hpp>
+#include <utility>
+#include <vector>
+
+#include "tket/Circuit/PauliExpBoxes.hpp"
+#include "tket/Utils/Json.hpp"
+#include "tket/Utils/PauliTensor.hpp"
+
+namespace tket {
+namespace bench {
+
+static void add_random_gates(
+    Circuit &circ, unsigned n_gates, const std::vector<OpType> &gates,
+    RNG &rng) {
+  const unsigned n_qubits = circ.n_qubits();
+  if (n_qubits < 2) throw std::invalid_argument("Need at least two qubits");
+  for (unsigned i = 0; i < n_gates; ++i) {
+    const OpType type = rng.get_element(gates);
+    if (type == OpType::CX) {
+      unsigned control = rng.get_size_t(n_qubits - 1);
+      unsigned target = rng.get_size_t(n_qubits - 2);
+      if (target >= control) ++target;
+      circ.add_op<unsigned>(type, {control, target});
+    } else {
+      circ.add_op<unsigned>(type, {unsigned(rng.get_size_t(n_qubits - 1))});
+    }
+  }
+}
+
+Circuit random_clifford_t(
+    unsigned n_qubits, unsigned n_gates, std::size_t seed) {
+  RNG rng;
+  rng.set_seed(seed);
+  Circuit circ(n_qubits);
+  add_random_gates(
+      circ, n_gates, {OpType::H, OpType::S, OpType::T, OpType::CX}, rng);
+  return circ;
+}
+
+Circuit random_clifford(unsigned n_qubits, unsigned n_gates, std::size_t seed) {
+  RNG rng;
+  rng.set_seed(seed);
+  Circuit circ(n_qubits, n_qubits);
+  add_random_gates(circ, n_gates, {OpType::H, OpType::S, OpType::CX}, rng);
+  for (unsigned q = 0; q < n_qubits; ++q) {
+    circ.add_measure(q, q);
+  }
+  return circ;
+}
+
+Circuit qft(unsigned n_qubits) {
+  Circuit circ(n_qubits);
+  for (unsigned i = 0; i < n_qubits; ++i) {
+    circ.add_op<unsigned>(OpType::H, {i});
+    for (unsigned j = i + 1; j < n_qubits; ++j) {
+      circ.add_op<unsigned>(OpType::CU1, std::ldexp(1., -int(j - i)), {j, i});
+    }
+  }
+  for (unsigned i = 0; i < n_qubits / 2; ++i) {
+    circ.add_op<unsigned>(OpType::SWAP, {i, n_qubits - 1 - i});
+  }
+  return circ;
+}
+
+// The Jordan-Wigner strings for an excitation between the given (sorted)
+// qubits: X or Y on the qubits themselves, Z between the first and second,
+// and between the third and fourth.
+static DensePauliMap excitation_string(
+    unsigned n_qubits, const std::vector<unsigned> &qubits,
+    const std::vector<Pauli> &ends) {
+  DensePauliMap paulis(n_qubits, Pauli::I);
+  for (unsigned k = 0; k + 1 < qubits.size(); k += 2) {
+    for (unsigned q = qubits[k] + 1; q < qubits[k + 1]; ++q) {
+      paulis[q] = Pauli::Z;
+    }
+  }
+  for (unsigned k = 0; k < qubits.size(); ++k) {
+    paulis[qubits[k]] = ends[k];
+  }
+  return paulis;
+}
+
+Circuit uccsd_like(
+    unsigned n_qubits, unsigned n_excitations, std::size_t seed,
+    bool decompose) {
+  if (n_qubits < 4) throw std::invalid_argument("Need at least four qubits");
+  RNG rng;
+  rng.set_seed(seed);
+  std::vector<unsigned> all_qubits(n_qubits);
+  for (unsigned q = 0; q < n_qubits; ++q) all_qubits[q] = q;
+  Circuit circ(n_qubits);
+  for (unsigned e = 0; e < n_excitations; ++e) {
+    const bool is_double = rng.get_size_t(1) == 1;
+    std::vector<unsigned> pool = all_qubits;
+    std::vector<unsigned> qubits;
+    for (unsigned k = 0; k < (is_double ? 4u : 2u); ++k) {
+      qubits.push_back(rng.get_and_remove_element(pool));
+    }
+    std::sort(qubits.begin(), qubits.end());
+    const double angle = double(rng.get_size_t(1, 999)) / 1000.;
+    std::vector<std::pair<std::vector<Pauli>, double>> terms;
+    if (is_double) {
+      // The eight strings with an odd number of Ys.
+      for (unsigned mask = 0; mask < 16; ++mask) {
+        unsigned n_y = 0;
+        std::vector<Pauli> ends;
+        for (unsigned k = 0; k < 4; ++k) {
+          const bool y = (mask >> k) & 1;
+          n_y += y;
+          ends.push_back(y ? Pauli::Y : Pauli::X);
+        }
+        if (n_y % 2 == 1) {
+          terms.push_back({ends, (n_y == 1) ? angle : -angle});
+        }
+      }
+    } else {
+      terms = {{{Pauli::X, Pauli::Y}, angle}, {{Pauli::Y, Pauli::X}, -angle}};
+    }
+    for (const auto &[ends, t] : terms) {
+      circ.add_box(
+          PauliExpBox(
+              SymPauliTensor(excitation_string(n_qubits, qubits, ends), t)),
+          all_qubits);
+    }
+  }
+  if (decompose) circ.decompose_boxes_recursively();
+  return circ;
+}
+
+Architecture heavy_hex(unsigned n_rows, unsigned row_length) {
+  std::vector<std::pair<unsigned, unsigned>> edges;
+  std::vector<std::vector<unsigned>> rows(n_rows);
+  unsigned next = 0;
+  for (unsigned r = 0; r < n_rows; ++r) {
+    for (unsigned c = 0; c < row_length; ++c) {
+      rows[r].push_back(next++);
+      if (c > 0) edges.push_back({rows[r][c - 1], rows[r][c]});
+    }
+  }
+  for (unsigned r = 0; r + 1 < n_rows; ++r) {
+    for (unsigned c = (r % 2 == 0) ? 0 : 2; c < row_length; c += 4) {
+      const unsigned bridge = next++;
+      edges.push_back({rows[r][c], bridge});
+      edges.push_back({bridge, rows[r + 1][c]});
+    }
+  }
+  return Architecture(edges);
+}
+
+Circuit load_circuit(const std::string &filename) {
+  std::ifstream file(filename);
+  if (!file) throw std::runtime_error("Cannot open " + filename);
+  return nlohmann::json::parse(file).get<Circuit>();
+}
+
+}  // namespace bench
+}  // namespace tket
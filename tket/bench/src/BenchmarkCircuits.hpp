@@ -0,0 +1,67 @@
+// Copyright Quantinuum
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+#include "tket/Architecture/Architecture.hpp"
+#include "tket/Circuit/Circuit.hpp"
+
+namespace tket {
+namespace bench {
+
+// Families of circuits whose size can be scaled. The random families are
+// generated from a fixed seed, so are the same on every platform.
+
+/** Random gates from {H, S, T, CX} */
+Circuit random_clifford_t(
+    unsigned n_qubits, unsigned n_gates, std::size_t seed = 0);
+
+/**
+ * Random gates from {H, S, CX}, followed by a measurement of every qubit
+ */
+Circuit random_clifford(
+    unsigned n_qubits, unsigned n_gates, std::size_t seed = 0);
+
+/** Quantum Fourier transform, with the final qubit reversal as SWAP gates */
+Circuit qft(unsigned n_qubits);
+
+/**
+ * Pauli gadgets of random single and double excitations under the
+ * Jordan-Wigner encoding, as in a UCCSD ansatz.
+ *
+ * @param n_qubits number of qubits
+ * @param n_excitations number of excitations, each of which contributes two
+ *   (single) or eight (double) Pauli gadgets
+ * @param seed seed for the choice of excitations and angles
+ * @param decompose whether to decompose the PauliExpBoxes into gates
+ */
+Circuit uccsd_like(
+    unsigned n_qubits, unsigned n_excitations, std::size_t seed = 0,
+    bool decompose = false);
+
+/**
+ * Heavy-hexagon lattice, as used by IBM devices: rows of qubits in a line,
+ * with adjacent rows linked by a bridging qubit at every fourth column,
+ * alternating between columns 0, 4, 8, ... and 2, 6, 10, ...
+ */
+Architecture heavy_hex(unsigned n_rows, unsigned row_length);
+
+/** Load a circuit serialized as JSON */
+Circuit load_circuit(const std::string &filename);
+
+}  // namespace bench
+}  // namespace tket
@@ -0,0 +1,181 @@
+// Copyright Quantinuum
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "Benchmarks.hpp"
+
+#include <filesystem>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+
+#include "BenchmarkCircuits.hpp"
+#include "tket/Circuit/Simulation/CircuitSimulator.hpp"
+#include "tket/Circuit/Simulation/StabiliserSimulator.hpp"
+#include "tket/Predicates/CompilationUnit.hpp"
+#include "tket/Predicates/CompilerPass.hpp"
+#include "tket/Predicates/PassGenerators.hpp"
+#include "tket/Utils/Json.hpp"
+
+namespace tket {
+namespace bench {
+
+namespace {
+
+class PassBenchmark : public Benchmark {
+ public:
+  PassBenchmark(const Circuit &circ, const PassPtr &pass)
+      : circ_(circ), pass_(pass) {}
+
+  void setup() override { c_unit_.emplace(circ_); }
+
+  void run() override { pass_->apply(*c_unit_); }
+
+ private:
+  const Circuit circ_;
+  const PassPtr pass_;
+  std::optional<CompilationUnit> c_unit_;
+};
+
+class FunctionBenchmark : public Benchmark {
+ public:
+  explicit FunctionBenchmark(std::function<void()> f) : f_(std::move(f)) {}
+
+  void run() override { f_(); }
+
+ private:
+  const std::function<void()> f_;
+};
+
+struct Input {
+  std::string name;
+  std::function<Circuit()> make;
+};
+
+}  // namespace
+
+std::vector<BenchmarkCase> all_benchmarks(const std::string &circuits_dir) {
+  auto file = [&circuits_dir](const std::string &name) -> Input {
+    const std::string path =
+        (std::filesystem::path(circuits_dir) / (name + ".json")).string();
+    return {name, [path]() { return load_circuit(path); }};
+  };
+  auto clifford_t = [](unsigned n_qubits, unsigned n_gates) -> Input {
+    return {
+        "clifford_t_q" + std::to_string(n_qubits) + "_g" +
+            std::to_string(n_gates),
+        [=]() { return random_clifford_t(n_qubits, n_gates); }};
+  };
+  auto qft_circ = [](unsigned n_qubits) -> Input {
+    return {
+        "qft_q" + std::to_string(n_qubits),
+        [=]() { return qft(n_qubits); }};
+  };
+  auto uccsd = [](unsigned n_qubits, unsigned n_excitations,
+                  bool decompose) -> Input {
+    return {
+        std::string(decompose ? "uccsd_gates_q" : "uccsd_q") +
+            std::to_string(n_qubits) + "_e" + std::to_string(n_excitations),
+        [=]() {
+          return uccsd_like(n_qubits, n_excitations, 0, decompose);
+        }};
+  };
+  const std::vector<Input> test_circuits = {
+      file("bug777_circuit"), file("lexiroute_circuit"),
+      file("lexiroute_circuit_relabel_to_ancilla"), file("weirdzx")};
+
+  std::vector<BenchmarkCase> cases;
+  auto add_pass = [&cases](
+                      const std::string &op,
+                      const std::function<PassPtr()> &make_pass,
+                      const std::vector<Input> &inputs) {
+    for (const Input &in : inputs) {
+      cases.push_back({op + "/" + in.name, [=]() {
+                         return std::make_unique<PassBenchmark>(
+                             in.make(), make_pass());
+                       }});
+    }
+  };
+  auto add_function = [&cases](
+                          const std::string &op,
+                          const std::function<void(const Circuit &)> &f,
+                          const std::vector<Input> &inputs) {
+    for (const Input &in : inputs) {
+      cases.push_back({op + "/" + in.name, [=]() {
+                         Circuit circ = in.make();
+                         return std::make_unique<FunctionBenchmark>(
+                             [=]() { f(circ); });
+                       }});
+    }
+  };
+
+  add_pass(
+      "FullPeepholeOptimise", []() { return FullPeepholeOptimise(); },
+      {clifford_t(8, 1000), qft_circ(10), uccsd(8, 10, true),
+       test_circuits[0]});
+  add_pass(
+      "CliffordSimp", []() { return gen_clifford_simp_pass(); },
+      {clifford_t(16, 4000), qft_circ(20), test_circuits[3]});
+  add_pass(
+      "GreedyPauliSimp", []() { return gen_greedy_pauli_simp(); },
+      {uccsd(8, 20, false), uccsd(12, 40, false), clifford_t(8, 1000)});
+  add_pass(
+      "DefaultMapping[grid_5x5]",
+      []() { return gen_default_mapping_pass(SquareGrid(5, 5)); },
+      {clifford_t(25, 2000), qft_circ(20), test_circuits[1]});
+  add_pass(
+      "DefaultMapping[heavy_hex_3x15]",
+      []() { return gen_default_mapping_pass(heavy_hex(3, 15)); },
+      {clifford_t(40, 2000), qft_circ(20), test_circuits[1]});
+
+  std::vector<Input> serialisation_inputs = {
+      clifford_t(50, 20000), uccsd(12, 40, false)};
+  serialisation_inputs.insert(
+      serialisation_inputs.end(), test_circuits.begin(), test_circuits.end());
+  add_function(
+      "JsonRoundTrip",
+      [](const Circuit &circ) {
+        const nlohmann::json j = circ;
+        const Circuit copy = j.get<Circuit>();
+        if (copy.n_gates() != circ.n_gates()) {
+          throw std::logic_error("JSON round trip changed the circuit");
+        }
+      },
+      serialisation_inputs);
+  add_function(
+      "BinaryRoundTrip",
+      [](const Circuit &circ) {
+        const Circuit copy = Circuit::from_binary(circ.to_binary());
+        if (copy.n_gates() != circ.n_gates()) {
+          throw std::logic_error("Binary round trip changed the circuit");
+        }
+      },
+      serialisation_inputs);
+  add_function(
+      "Statevector",
+      [](const Circuit &circ) { tket_sim::get_statevector(circ, EPS, 16); },
+      {qft_circ(14), clifford_t(12, 2000)});
+  add_function(
+      "Unitary", [](const Circuit &circ) { tket_sim::get_unitary(circ); },
+      {clifford_t(8, 1000), qft_circ(10)});
+  add_function(
+      "CliffordShots",
+      [](const Circuit &circ) {
+        tket_sim::sample_clifford_shots(circ, 1000, 0);
+      },
+      {{"clifford_q500_g5000", []() { return random_clifford(500, 5000); }}});
+  return cases;
+}
+
+}  // namespace bench
+}  // namespace tket
@@ -0,0 +1,53 @@
+// Copyright Quantinuum
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace tket {
+namespace bench {
+
+/** A piece of work to be measured */
+class Benchmark {
+ public:
+  virtual ~Benchmark() = default;
+
+  /** Prepare for a run of the benchmark; not measured */
+  virtual void setup() {}
+
+  /** The work to be measured */
+  virtual void run() = 0;
+};
+
+/**
+ * A named benchmark. Its inputs are only constructed when it is selected.
+ */
+struct BenchmarkCase {
+  std::string name;
+  std::function<std::unique_ptr<Benchmark>()> make;
+};
+
+/**
+ * All benchmarks, named "<operation>/<input>".
+ *
+ * @param circuits_dir directory containing the JSON test circuits
+ */
+std::vector<BenchmarkCase> all_benchmarks(const std::string &circuits_dir);
+
+}  // namespace bench
+}  // namespace tket
@@ -0,0 +1,117 @@
+// Copyright Quantinuum
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "Measure.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#if defined(__linux__)
+#include <fstream>
+#include <sstream>
+#include <string>
+#elif !defined(_WIN32)
+#include <sys/resource.h>
+#endif
+
+namespace {
+
+// Passes may allocate from several threads.
+std::atomic<std::size_t> n_allocations{0};
+std::atomic<std::size_t> n_bytes{0};
+
+void *counted_malloc(std::size_t size) {
+  n_allocations.fetch_add(1, std::memory_order_relaxed);
+  n_bytes.fetch_add(size, std::memory_order_relaxed);
+  if (size == 0) size = 1;
+  void *p = std::malloc(size);
+  if (!p) throw std::bad_alloc();
+  return p;
+}
+
+}  // namespace
+
+// Replacements for the global allocation functions. The other forms (nothrow
+// and sized) call these by default.
+void *operator new(std::size_t size) { return counted_malloc(size); }
+void *operator new[](std::size_t size) { return counted_malloc(size); }
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete[](void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void *p, std::size_t) noexcept { std::free(p); }
+
+namespace tket {
+namespace bench {
+
+void reset_allocation_count() {
+  n_allocations.store(0, std::memory_order_relaxed);
+  n_bytes.store(0, std::memory_order_relaxed);
+}
+
+AllocationCount get_allocation_count() {
+  return {
+      n_allocations.load(std::memory_order_relaxed),
+      n_bytes.load(std::memory_order_relaxed)};
+}
+
+#if defined(__linux__)
+
+bool reset_peak_rss() {
+  // Writing 5 to clear_refs resets VmHWM (Linux 4.0 and later).
+  std::ofstream clear_refs("/proc/self/clear_refs");
+  if (!clear_refs) return false;
+  clear_refs << "5";
+  clear_refs.close();
+  return !clear_refs.fail();
+}
+
+std::size_t get_peak_rss() {
+  std::ifstream status("/proc/self/status");
+  std::string line;
+  while (std::getline(status, line)) {
+    if (line.rfind("VmHWM:", 0) == 0) {
+      std::istringstream fields(line.substr(6));
+      std::size_t kb = 0;
+      fields >> kb;
+      return kb * 1024;
+    }
+  }
+  return 0;
+}
+
+#elif defined(_WIN32)
+
+bool reset_peak_rss() { return false; }
+
+std::size_t get_peak_rss() { return 0; }
+
+#else
+
+bool reset_peak_rss() { return false; }
+
+std::size_t get_peak_rss() {
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+#if defined(__APPLE__)
+  return usage.ru_maxrss;
+#else
+  return std::size_t(usage.ru_maxrss) * 1024;
+#endif
+}
+
+#endif
+
+}  // namespace bench
+}  // namespace tket
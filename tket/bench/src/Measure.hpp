@@ -0,0 +1,54 @@
+// Copyright Quantinuum
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+
+namespace tket {
+namespace bench {
+
+/**
+ * Allocations made through the global operator new since the last call to
+ * reset_allocation_count().
+ *
+ * Memory allocated directly with malloc (as Eigen does for its own
+ * aligned storage) is not counted.
+ */
+struct AllocationCount {
+  std::size_t n_allocations;
+  std::size_t n_bytes;
+};
+
+void reset_allocation_count();
+
+AllocationCount get_allocation_count();
+
+/**
+ * Reset the peak resident set size of the process to its current size.
+ *
+ * This is only possible on Linux. Elsewhere the peak is that of the whole
+ * process so far.
+ *
+ * @return whether the peak was reset
+ */
+bool reset_peak_rss();
+
+/**
+ * Peak resident set size of the process in bytes, or 0 if it is not known
+ */
+std::size_t get_peak_rss();
+
+}  // namespace bench
+}  // namespace tket
@@ -0,0 +1,198 @@
+// Copyright Quantinuum
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "Benchmarks.hpp"
+#include "Measure.hpp"
+#include "tket/Utils/Json.hpp"
+
+using namespace tket;
+using namespace tket::bench;
+
+#ifndef TKET_BENCH_CIRCUITS_DIR
+#define TKET_BENCH_CIRCUITS_DIR "."
+#endif
+
+namespace {
+
+struct Result {
+  std::string name;
+  unsigned repeats;
+  double min_seconds;
+  double median_seconds;
+  // Minimum over the runs, which excludes any one-off initialization.
+  std::size_t allocations;
+  std::size_t allocated_bytes;
+  // Maximum over the runs.
+  std::size_t peak_rss_bytes;
+};
+
+void to_json(nlohmann::json &j, const Result &r) {
+  j["name"] = r.name;
+  j["repeats"] = r.repeats;
+  j["min_seconds"] = r.min_seconds;
+  j["median_seconds"] = r.median_seconds;
+  j["allocations"] = r.allocations;
+  j["allocated_bytes"] = r.allocated_bytes;
+  j["peak_rss_bytes"] = r.peak_rss_bytes;
+}
+
+Result measure(const BenchmarkCase &bc, unsigned repeats) {
+  std::unique_ptr<Benchmark> b = bc.make();
+  std::vector<double> seconds;
+  Result r{bc.name, repeats, 0., 0., SIZE_MAX, SIZE_MAX, 0};
+  for (unsigned i = 0; i < repeats; ++i) {
+    b->setup();
+    reset_peak_rss();
+    reset_allocation_count();
+    const auto start = std::chrono::steady_clock::now();
+    b->run();
+    const auto end = std::chrono::steady_clock::now();
+    const AllocationCount count = get_allocation_count();
+    r.peak_rss_bytes = std::max(r.peak_rss_bytes, get_peak_rss());
+    seconds.push_back(std::chrono::duration<double>(end - start).count());
+    r.allocations = std::min(r.allocations, count.n_allocations);
+    r.allocated_bytes = std::min(r.allocated_bytes, count.n_bytes);
+  }
+  std::sort(seconds.begin(), seconds.end());
+  r.min_seconds = seconds.front();
+  r.median_seconds = seconds[seconds.size() / 2];
+  return r;
+}
+
+void print_header(bool with_baseline) {
+  std::printf(
+      "%-58s %10s %10s %12s %10s %10s%s\n", "benchmark", "min ms",
+      "median ms", "allocs", "alloc MB", "peak MB",
+      with_baseline ? "   vs base" : "");
+}
+
+void print_result(const Result &r, std::optional<double> baseline_seconds) {
+  std::printf(
+      "%-58s %10.3f %10.3f %12zu %10.2f %10.2f", r.name.c_str(),
+      1e3 * r.min_seconds, 1e3 * r.median_seconds, r.allocations,
+      r.allocated_bytes / 1048576., r.peak_rss_bytes / 1048576.);
+  if (baseline_seconds) {
+    std::printf("   %6.2fx", r.median_seconds / *baseline_seconds);
+  }
+  std::printf("\n");
+  std::fflush(stdout);
+}
+
+void usage(const char *program) {
+  std::cout
+      << "Usage: " << program << " [options] [filter...]\n\n"
+      << "Runs the benchmarks whose names contain any of the filters (or all "
+         "of them,\nif none are given), reporting the time, operator new "
+         "allocations and peak\nresident set size of each.\n\n"
+      << "Options:\n"
+      << "  --list            list the benchmarks and exit\n"
+      << "  --repeats N       runs of each benchmark (default 5)\n"
+      << "  --json FILE       write the results to FILE as JSON\n"
+      << "  --baseline FILE   compare median times with results written by "
+         "--json\n"
+      << "  --circuits DIR    directory of JSON test circuits (default "
+      << TKET_BENCH_CIRCUITS_DIR << ")\n";
+}
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  unsigned repeats = 5;
+  bool list = false;
+  std::string json_file, baseline_file;
+  std::string circuits_dir = TKET_BENCH_CIRCUITS_DIR;
+  std::vector<std::string> filters;
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    const bool has_value = i + 1 < argc;
+    if (arg == "--help" || arg == "-h") {
+      usage(argv[0]);
+      return 0;
+    } else if (arg == "--list") {
+      list = true;
+    } else if (arg == "--repeats" && has_value) {
+      repeats = std::max(std::stoi(argv[++i]), 1);
+    } else if (arg == "--json" && has_value) {
+      json_file = argv[++i];
+    } else if (arg == "--baseline" && has_value) {
+      baseline_file = argv[++i];
+    } else if (arg == "--circuits" && has_value) {
+      circuits_dir = argv[++i];
+    } else if (arg.rfind("--", 0) == 0) {
+      usage(argv[0]);
+      return 1;
+    } else {
+      filters.push_back(arg);
+    }
+  }
+
+  std::map<std::string, double> baseline;
+  if (!baseline_file.empty()) {
+    std::ifstream in(baseline_file);
+    if (!in) {
+      std::cerr << "Cannot open " << baseline_file << "\n";
+      return 1;
+    }
+    for (const nlohmann::json &j : nlohmann::json::parse(in)) {
+      baseline[j.at("name").get<std::string>()] =
+          j.at("median_seconds").get<double>();
+    }
+  }
+
+  std::vector<BenchmarkCase> selected;
+  for (const BenchmarkCase &bc : all_benchmarks(circuits_dir)) {
+    if (filters.empty() ||
+        std::any_of(filters.begin(), filters.end(), [&](const std::string &f) {
+          return bc.name.find(f) != std::string::npos;
+        })) {
+      selected.push_back(bc);
+    }
+  }
+  if (list) {
+    for (const BenchmarkCase &bc : selected) std::cout << bc.name << "\n";
+    return 0;
+  }
+
+  if (!reset_peak_rss()) {
+    std::cout << "Peak memory cannot be reset on this platform, so is "
+                 "reported for the process so far.\n";
+  }
+  print_header(!baseline.empty());
+  std::vector<Result> results;
+  for (const BenchmarkCase &bc : selected) {
+    results.push_back(measure(bc, repeats));
+    std::optional<double> base;
+    auto it = baseline.find(bc.name);
+    if (it != baseline.end()) base = it->second;
+    print_result(results.back(), base);
+  }
+
+  if (!json_file.empty()) {
+    std::ofstream out(json_file);
+    out << nlohmann::json(results).dump(2) << "\n";
+  }
+  return 0;
+}
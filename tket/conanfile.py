@@ -36,6 +36,8 @@ class TketConan(ConanFile):
         "with_test": [True, False],
         "with_proptest": [True, False],
         "with_all_tests": [True, False],
+        "with_bench": [True, False],
+        "pooled_dag": [True, False],
     }
     default_options = {
         "shared": False,
@@ -44,6 +46,8 @@ class TketConan(ConanFile):
         "with_test": False,
         "with_proptest": False,
         "with_all_tests": False,
+        "with_bench": False,
+        "pooled_dag": False,
     }
     exports_sources = (
         "CMakeLists.txt",
@@ -52,6 +56,7 @@ class TketConan(ConanFile):
         "include/*",
         "test/*",
         "proptest/*",
+        "bench/*",
     )
 
     def config_options(self):
@@ -70,6 +75,7 @@ class TketConan(ConanFile):
         deps.generate()
         tc = CMakeToolchain(self)
         tc.variables["PROFILE_COVERAGE"] = self.options.profile_coverage
+        tc.variables["TKET_POOLED_DAG"] = self.options.pooled_dag
         if self.build_test():
             tc.variables["BUILD_TKET_TEST"] = True
             architectures_dir = os.path.join(
@@ -80,6 +86,8 @@ class TketConan(ConanFile):
             copy(self, "*.json", circuits_dir, self.build_folder)
         if self.build_proptest():
             tc.variables["BUILD_TKET_PROPTEST"] = True
+        if self.options.with_bench:
+            tc.variables["BUILD_TKET_BENCH"] = True
         tc.generate()
 
     def set_version(self):
@@ -135,6 +143,8 @@ class TketConan(ConanFile):
 
     def package_info(self):
         self.cpp_info.libs = ["tket"]
+        if self.options.pooled_dag:
+            self.cpp_info.defines = ["TKET_POOLED_DAG"]
 
     def requirements(self):
         # libraries installed from remote:
@@ -147,7 +157,7 @@ class TketConan(ConanFile):
         self.requires("tklog/0.3.3@tket/stable")
         self.requires("tkrng/0.3.3@tket/stable")
         self.requires("tktokenswap/0.3.13@tket/stable")
-        self.requires("tkwsm/0.3.13@tket/stable")
+        self.requires("tkwsm/0.3.15@tket/stable")
         if self.build_test():
             self.test_requires("catch2/3.14.0@tket/stable")
         if self.build_proptest():
@@ -18,6 +18,7 @@
 #include <boost/uuid/uuid_generators.hpp>
 #include <boost/uuid/uuid_io.hpp>
 #include <memory>
+#include <mutex>
 #include <optional>
 
 #include "tket/Circuit/Simulation/CircuitSimulator.hpp"
@@ -63,8 +64,15 @@ class Box : public Op {
 
   static Op_ptr deserialize(const nlohmann::json &j);
 
-  /** Circuit represented by box */
+  /**
+   * Circuit represented by box
+   *
+   * The circuit is generated on first use. Boxes may be shared between
+   * circuits that are processed on different threads, so generation is
+   * serialised.
+   */
   std::shared_ptr<Circuit> to_circuit() const {
+    std::lock_guard<std::recursive_mutex> lock(generation_mutex());
     if (circ_ == nullptr) generate_circuit();
     return circ_;
   };
@@ -95,8 +103,12 @@ class Box : public Op {
 
  protected:
   static boost::uuids::uuid idgen() {
+    // The generator is not thread-safe, and boxes may be constructed on
+    // several threads at once.
+    static std::mutex gen_mutex;
     static boost::uuids::random_generator gen = {};
 
+    std::lock_guard<std::mutex> lock(gen_mutex);
     return gen();
   }
   op_signature_t signature_;
@@ -104,6 +116,9 @@ class Box : public Op {
   boost::uuids::uuid id_;
 
   virtual void generate_circuit() const = 0;
+
+ private:
+  static std::recursive_mutex &generation_mutex();
 };
 
 // json for base Box attributes
@@ -33,6 +33,7 @@
 #include <ostream>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <tkassert/Assert.hpp>
 #include <tklog/TketLog.hpp>
 #include <type_traits>
@@ -163,6 +164,12 @@ class CircuitInvalidity : public std::logic_error {
       : std::logic_error(message) {}
 };
 
+class BinaryFormatError : public std::logic_error {
+ public:
+  explicit BinaryFormatError(const std::string &message)
+      : std::logic_error(message) {}
+};
+
 class Unsupported : public std::logic_error {
  public:
   explicit Unsupported(const std::string &message)
@@ -275,6 +282,70 @@ class Circuit {
   const CommandIterator end() const;
   static const CommandIterator nullcit;
 
+  /**
+   * Input iterator yielding a CommandView for each command, in the same order
+   * as CommandIterator.
+   *
+   * Rather than searching the slice frontier for every argument and copying
+   * each command, it tracks the unit carried by every live output port, so
+   * that the args of each command are found by direct lookup and written into
+   * a buffer that is reused from one command to the next.
+   */
+  class CommandViewIterator {
+   public:
+    explicit CommandViewIterator(const Circuit &circ);
+    CommandViewIterator()
+        : current_index_(0),
+          current_vertex_(boost::graph_traits<DAG>::null_vertex()),
+          circ_(nullptr),
+          n_args_(0) {}
+
+    CommandView operator*() const;
+    Vertex get_vertex() const { return current_vertex_; }
+    bool operator==(const CommandViewIterator &other) const {
+      return current_vertex_ == other.current_vertex_;
+    }
+    bool operator!=(const CommandViewIterator &other) const {
+      return !(*this == other);
+    }
+    CommandViewIterator &operator++();
+
+   private:
+    // Unit carried by each live (vertex, out port).
+    typedef std::unordered_map<VertPort, UnitID, boost::hash<VertPort>>
+        port_unit_map_t;
+
+    void read_args();
+
+    SliceIterator slices_;
+    unsigned current_index_;
+    Vertex current_vertex_;
+    const Circuit *circ_;
+    port_unit_map_t port_units_;
+    // Only the first n_args_ entries belong to the current command.
+    unit_vector_t args_;
+    std::size_t n_args_;
+  };
+
+  class CommandViewRange {
+   public:
+    explicit CommandViewRange(const Circuit &circ) : circ_(&circ) {}
+    CommandViewIterator begin() const { return CommandViewIterator(*circ_); }
+    CommandViewIterator end() const { return CommandViewIterator(); }
+
+   private:
+    const Circuit *circ_;
+  };
+
+  /**
+   * Lazily iterate over the commands of the circuit, in the order given by
+   * @ref get_commands, without copying them.
+   *
+   * Each CommandView is only valid until the iteration advances, and the
+   * circuit must not be modified during the iteration.
+   */
+  CommandViewRange command_views() const { return CommandViewRange(*this); }
+
   ///////////////////////
   // Setters and Getters//
   ///////////////////////
@@ -1494,6 +1565,23 @@ class Circuit {
   /** Whether the circuit contains any symbolic parameters */
   bool is_symbolic() const;
 
+  /**
+   * Hash of the circuit's structure.
+   *
+   * Each vertex is hashed from its operation, its opgroup and the hashes and
+   * ports of its predecessors, so the result depends only on the DAG and
+   * the units, not on the order in which vertices are stored or commands
+   * were added. The name and global phase are included.
+   *
+   * Circuits with equal hashes are equal, up to hash collisions. The
+   * converse need not hold (see \ref Op::hash).
+   *
+   * O(V + E)
+   *
+   * @throw JsonError if an operation cannot be hashed
+   */
+  std::size_t structural_hash() const;
+
   // from Circuit to various output formats
   void to_graphviz_file(const std::string &filename) const;
   void to_graphviz(std::ostream &out) const;
@@ -1504,6 +1592,50 @@ class Circuit {
   std::string to_latex_str() const;
   void to_latex_file(const std::string &filename) const;
 
+  /** Version of the format written by \ref to_binary */
+  static constexpr unsigned binary_format_version = 1;
+
+  /**
+   * Serialise to a compact, versioned binary format.
+   *
+   * Register names and symbolic parameters are stored once in a string
+   * table, and units once in a unit table, with commands referring to them
+   * by index. Gates are stored inline as their OpType and parameters, with
+   * numeric parameters as doubles. Other operations are stored once each in
+   * an operation table as CBOR-encoded JSON, with boxes deduplicated by
+   * their ID.
+   *
+   * @return the serialised circuit
+   */
+  std::string to_binary() const;
+
+  /**
+   * Write \ref to_binary output to a file.
+   *
+   * @param filename path of the file to write
+   * @throw std::invalid_argument if the file cannot be opened
+   * @throw std::runtime_error if writing the file fails
+   */
+  void to_binary_file(const std::string &filename) const;
+
+  /**
+   * Deserialise a circuit written by \ref to_binary.
+   *
+   * @param data serialised circuit
+   * @return the circuit
+   * @throw BinaryFormatError if the data is malformed or was written by a
+   *   newer version of the format
+   */
+  static Circuit from_binary(std::string_view data);
+
+  /**
+   * Deserialise a circuit from a file written by \ref to_binary_file.
+   *
+   * Where supported the file is memory-mapped rather than read into a
+   * buffer.
+   */
+  static Circuit from_binary_file(const std::string &filename);
+
   void extract_slice_segment(unsigned slice_one, unsigned slice_two);
 
   /* 'backends' for tket */
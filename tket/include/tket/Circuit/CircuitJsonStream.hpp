@@ -0,0 +1,67 @@
+// Copyright Quantinuum
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <istream>
+#include <ostream>
+#include <string_view>
+
+#include "Circuit.hpp"
+
+namespace tket {
+
+/**
+ * Read a circuit from its JSON serialisation without first parsing the
+ * whole document into a JSON tree.
+ *
+ * Commands are decoded one at a time as the parser reaches them. If the
+ * "qubits" and "bits" fields (and "number_of_ws" and "number_of_rs", if
+ * present) precede "commands" in the document, as they do in the output of
+ * \ref circuit_to_json_stream, each command is added to the circuit as soon
+ * as it has been read. Otherwise the decoded commands are held until the
+ * end of the document. Either way only one command's JSON is in memory at a
+ * time.
+ *
+ * The result is the same as that of
+ * `nlohmann::json::parse(...).get<Circuit>()`.
+ *
+ * @param in input stream containing a serialised circuit
+ * @return the deserialised circuit
+ * @throw nlohmann::json::parse_error if the input is not valid JSON
+ * @throw JsonError if a required field is missing
+ */
+Circuit circuit_from_json_stream(std::istream &in);
+
+/**
+ * Read a circuit from its JSON serialisation held in a string.
+ *
+ * @see circuit_from_json_stream(std::istream &)
+ */
+Circuit circuit_from_json_stream(std::string_view s);
+
+/**
+ * Write the JSON serialisation of a circuit, one command at a time.
+ *
+ * Produces the same JSON object as `nlohmann::json(circ)`, but without
+ * building it in memory, and with the header fields placed before
+ * "commands" so that \ref circuit_from_json_stream can add commands to the
+ * circuit as it reads them.
+ *
+ * @param circ circuit to serialise
+ * @param out output stream
+ */
+void circuit_to_json_stream(const Circuit &circ, std::ostream &out);
+
+}  // namespace tket
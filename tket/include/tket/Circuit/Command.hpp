@@ -15,6 +15,7 @@
 #pragma once
 
 #include <optional>
+#include <span>
 #include <sstream>
 #include <string>
 #include <tklog/TketLog.hpp>
@@ -91,4 +92,39 @@ class Command {
 
 JSON_DECL(Command)
 
+/**
+ * A non-owning view of a command, as yielded by Circuit::command_views().
+ *
+ * The op and opgroup refer to the circuit's DAG and the args to storage
+ * owned by the iterator that produced the view, so a view is only valid
+ * until that iterator is advanced or the circuit is modified. Use
+ * to_command() to keep a copy.
+ */
+class CommandView {
+ public:
+  CommandView(
+      const Op_ptr &op_ptr, std::span<const UnitID> args,
+      const std::optional<std::string> &opgroup, Vertex vert)
+      : op_ptr_(&op_ptr), args_(args), opgroup_(&opgroup), vert_(vert) {}
+
+  const Op_ptr &get_op_ptr() const { return *op_ptr_; }
+  const std::optional<std::string> &get_opgroup() const { return *opgroup_; }
+  // indexed by port numbering
+  std::span<const UnitID> get_args() const { return args_; }
+  Vertex get_vertex() const { return vert_; }
+  Command to_command() const {
+    return Command(
+        *op_ptr_, unit_vector_t(args_.begin(), args_.end()), *opgroup_,
+        vert_);
+  }
+
+ private:
+  const Op_ptr *op_ptr_;
+  std::span<const UnitID> args_;
+  const std::optional<std::string> *opgroup_;
+  Vertex vert_;
+};
+
+void to_json(nlohmann::json &j, const CommandView &com);
+
 }  // namespace tket
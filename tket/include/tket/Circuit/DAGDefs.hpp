@@ -27,6 +27,7 @@
 #include "tket/OpType/EdgeType.hpp"
 #include "tket/Ops/Op.hpp"
 #include "tket/Utils/GraphHeaders.hpp"
+#include "tket/Utils/PoolAllocator.hpp"
 
 namespace tket {
 
@@ -49,14 +50,34 @@ struct EdgeProperties {
   std::pair<port_t, port_t> ports;
 };
 
-/** Graph representing a circuit, with operations as nodes. */
+#ifdef TKET_POOLED_DAG
+/**
+ * Container selector for the circuit graph.
+ *
+ * With the TKET_POOLED_DAG build option, graph nodes come from a
+ * PoolAllocator, so that a large circuit occupies a few contiguous chunks
+ * rather than millions of separate heap allocations. The chunks are returned
+ * to the system when the last circuit using them is destroyed, so a static
+ * circuit keeps them for the life of the process.
+ */
+typedef pooled_listS DAGContainerS;
+#else
+typedef boost::listS DAGContainerS;
+#endif
+
+/**
+ * Graph representing a circuit, with operations as nodes.
+ *
+ * Edge lists and the vertex list are node-based, so descriptors and
+ * iterators stay valid as the circuit is edited.
+ */
 typedef boost::adjacency_list<
     // OutEdgeList
-    boost::listS,
+    DAGContainerS,
 
-    // VertexList (use listS because we want to be able to remove vertices
+    // VertexList (list-like because we want to be able to remove vertices
     // without invalidating iterators)
-    boost::listS,
+    DAGContainerS,
 
     // we want access to incoming and outgoing edges
     boost::bidirectionalS,
@@ -64,7 +85,13 @@ typedef boost::adjacency_list<
     // indexing needed for algorithms such as topological sort
     boost::property<boost::vertex_index_t, std::size_t, VertexProperties>,
 
-    EdgeProperties>
+    EdgeProperties,
+
+    // GraphProperty
+    boost::no_property,
+
+    // EdgeList
+    DAGContainerS>
     DAG;
 
 typedef boost::graph_traits<DAG>::vertex_descriptor Vertex;
@@ -0,0 +1,98 @@
+// Copyright Quantinuum
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <optional>
+#include <unordered_map>
+
+#include "tket/Circuit/DAGDefs.hpp"
+
+namespace tket {
+
+class Circuit;
+
+/**
+ * Answers "is there a path from u to v?" queries on the DAG of a circuit.
+ *
+ * Every vertex is given a rank, such that the ranks increase along every
+ * edge. A path from u to v can then only pass through vertices whose ranks
+ * lie between those of u and v, so a search never leaves that window, and a
+ * query where v is ranked below u is answered without any search at all.
+ *
+ * The index may be kept while the circuit is edited, as long as the editor
+ * reports the changes through @ref insert_vertices and @ref erase_vertex.
+ * Inserted vertices are ranked between their neighbours where possible;
+ * otherwise, and whenever a query meets a vertex it does not know, the ranks
+ * are recomputed from scratch in time linear in the size of the circuit.
+ */
+class DAGReachability {
+ public:
+  /**
+   * Index the current vertices of a circuit.
+   *
+   * The circuit must outlive the index.
+   */
+  explicit DAGReachability(const Circuit &circ);
+
+  /**
+   * Whether there is a path from one vertex to another.
+   *
+   * A vertex reaches itself.
+   */
+  bool reaches(const Vertex &from, const Vertex &to);
+
+  /**
+   * Whether there is a path from a vertex to any of a set of vertices.
+   */
+  bool reaches_any(const Vertex &from, const VertexSet &to);
+
+  /**
+   * Whether there is a path from any of a set of vertices to a vertex.
+   */
+  bool reached_from_any(const VertexSet &from, const Vertex &to);
+
+  /**
+   * Rank vertices newly added to the circuit.
+   *
+   * @param verts new vertices, in a topological order
+   */
+  void insert_vertices(const VertexVec &verts);
+
+  /**
+   * Forget a vertex which is about to be, or has been, removed from the
+   * circuit.
+   *
+   * This must be called for every removed vertex, since the memory of a
+   * removed vertex may be reused for a new one.
+   */
+  void erase_vertex(const Vertex &v);
+
+ private:
+  const DAG &dag_;
+  std::unordered_map<Vertex, double> rank_;
+  bool valid_;
+
+  void rebuild();
+
+  // Search from `start` along (or against, if `forwards` is false) the edges
+  // for a vertex in `targets`, or return std::nullopt if a vertex without a
+  // rank is met.
+  std::optional<bool> search(
+      const Vertex &start, const VertexSet &targets, bool forwards) const;
+
+  bool query(const Vertex &start, const VertexSet &targets, bool forwards);
+};
+
+}  // namespace tket
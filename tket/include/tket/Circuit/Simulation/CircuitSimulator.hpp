@@ -33,10 +33,13 @@ namespace tket_sim {
  *              z as zero exactly in any intermediate sparse matrices
  *              (although not in the final dense result).
  *  @param max_number_of_qubits Throw an exception if this limit is exceeded.
+ *  @param n_threads Maximum number of threads to use. Threads are started
+ *              for each gate, so extra threads only help on large
+ *              statevectors or unitaries.
  */
 StateVector get_statevector(
     const Circuit& circ, double abs_epsilon = EPS,
-    unsigned max_number_of_qubits = 11);
+    unsigned max_number_of_qubits = 11, unsigned n_threads = 1);
 
 /** Calculates the unitary matrix of the circuit,
  *  using ILO-BE convention.
@@ -48,14 +51,15 @@ StateVector get_statevector(
  *  @param max_number_of_qubits Throw an exception if the circuit has too
  *              many qubits, to prevent users accidentally passing in
  *              huge circuits.
+ *  @param n_threads Maximum number of threads to use; see \ref get_statevector.
  */
 Eigen::MatrixXcd get_unitary(
     const Circuit& circ, double abs_epsilon = EPS,
-    unsigned max_number_of_qubits = 11);
+    unsigned max_number_of_qubits = 11, unsigned n_threads = 1);
 
 /** Let U be the unitary matrix which represents the given circuit
  *  using ILO-BE convention. Replace the given M with UM.
- *  Note that U is not calculated explicitly and sparse matrices are used,
+ *  Note that U is not calculated explicitly; each gate updates M in place,
  *  so it is quicker than calling calc_unitary if M is, e.g., a column vector.
  *  @param circ The circuit to simulate.
  *  @param matr The matrix M which will be premultiplied by the unitary matrix.
@@ -64,10 +68,11 @@ Eigen::MatrixXcd get_unitary(
  *              z as zero exactly in any intermediate sparse matrices
  *              (although not in the final dense result).
  * @param max_number_of_qubits Throw an exception if this limit is exceeded.
+ * @param n_threads Maximum number of threads to use; see \ref get_statevector.
  */
 void apply_unitary(
     const Circuit& circ, Eigen::MatrixXcd& matr, double abs_epsilon = EPS,
-    unsigned max_number_of_qubits = 11);
+    unsigned max_number_of_qubits = 11, unsigned n_threads = 1);
 
 }  // namespace tket_sim
 }  // namespace tket
@@ -0,0 +1,73 @@
+// Copyright Quantinuum
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "tket/Circuit/Simulation/CircuitSimulator.hpp"
+#include "tket/Utils/MatrixAnalysis.hpp"
+#include "tket/Utils/PauliTensor.hpp"
+
+namespace tket {
+namespace tket_sim {
+
+/** Sample outcomes of measuring every qubit of a state in the computational
+ *  basis, by binary search in the cumulative sums of the probabilities.
+ *  The state need not be normalised.
+ *  @param state The state, using ILO-BE convention.
+ *  @param n_shots Number of outcomes to sample.
+ *  @param seed Seed for the random number generator; the same seed always
+ *              gives the same outcomes, on any platform.
+ *  @return A matrix with one row per shot and one column per qubit, in the
+ *              same (ILO-BE) order as the qubits of the state.
+ */
+MatrixXb sample_shots(
+    const StateVector& state, unsigned n_shots, std::size_t seed);
+
+/** Simulate the circuit applied to the state |00...0> and sample outcomes
+ *  of measuring every qubit at the end. The circuit must not contain
+ *  measurements or other non-unitary operations.
+ *  @param circ The circuit to simulate.
+ *  @param n_shots Number of outcomes to sample.
+ *  @param seed Seed for the random number generator.
+ *  @param max_number_of_qubits Throw an exception if this limit is exceeded.
+ *  @param n_threads Maximum number of threads to use; see
+ *              \ref get_statevector.
+ *  @return A matrix with one row per shot and one column per qubit, in the
+ *              order of circ.all_qubits().
+ */
+MatrixXb sample_shots(
+    const Circuit& circ, unsigned n_shots, std::size_t seed,
+    unsigned max_number_of_qubits = 11, unsigned n_threads = 1);
+
+/** Simulate the circuit applied to the state |00...0> and calculate the
+ *  expectation value of an operator, given as a sum of Pauli terms, in the
+ *  resulting state. Each term is evaluated with pauli_state_expectation.
+ *  @param circ The circuit to simulate.
+ *  @param op The terms of the operator; they may only act on qubits of the
+ *              circuit.
+ *  @param max_number_of_qubits Throw an exception if this limit is exceeded.
+ *  @param n_threads Maximum number of threads to use; see
+ *              \ref get_statevector.
+ *  @return The expectation value, which is real if the operator is
+ *              Hermitian.
+ */
+Complex expectation(
+    const Circuit& circ, const std::vector<SpCxPauliTensor>& op,
+    unsigned max_number_of_qubits = 11, unsigned n_threads = 1);
+
+}  // namespace tket_sim
+}  // namespace tket
@@ -0,0 +1,126 @@
+// Copyright Quantinuum
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <tkrng/RNG.hpp>
+#include <vector>
+
+#include "tket/Clifford/SymplecticTableau.hpp"
+#include "tket/OpType/OpType.hpp"
+#include "tket/Utils/MatrixAnalysis.hpp"
+
+namespace tket {
+class Circuit;
+
+namespace tket_sim {
+
+/**
+ * A stabiliser state of n qubits, stored as an Aaronson-Gottesman tableau
+ * ("Improved Simulation of Stabilizer Circuits", 2004): n stabiliser rows,
+ * which generate the stabiliser group of the state, together with n
+ * destabiliser rows, which make single-qubit measurements O(n^2) instead of
+ * requiring Gaussian elimination.
+ *
+ * Gates take O(n) time and measurements O(n^2) time, so circuits on
+ * thousands of qubits can be simulated.
+ */
+class StabiliserState {
+ public:
+  /**
+   * Construct the state |00...0>.
+   */
+  explicit StabiliserState(unsigned n_qubits);
+
+  unsigned get_n_qubits() const { return n_qubits_; }
+
+  /**
+   * Apply a Clifford gate, of any type accepted by
+   * SymplecticTableau::apply_gate.
+   */
+  void apply_gate(OpType type, const std::vector<unsigned> &qbs);
+
+  /**
+   * Apply the Pauli rotation e^{-i (pi/4) half_pis P}, where P is the tensor
+   * product of the given Paulis on the given qubits.
+   */
+  void apply_pauli_rotation(
+      const std::vector<Pauli> &string, const std::vector<unsigned> &qbs,
+      unsigned half_pis);
+
+  /**
+   * Measure a qubit in the computational basis, collapsing the state.
+   * Random outcomes are drawn from rng.
+   *
+   * @return The outcome: true for |1>.
+   */
+  bool measure(unsigned qb, RNG &rng);
+
+  /**
+   * Reset a qubit to |0>.
+   */
+  void reset(unsigned qb, RNG &rng);
+
+  /**
+   * The stabiliser generators of the state, one row per qubit.
+   */
+  SymplecticTableau get_stabilisers() const;
+
+ private:
+  unsigned n_qubits_;
+
+  /**
+   * Rows [0, n) are the destabilisers, rows [n, 2n) the stabilisers, and row
+   * 2n is scratch space for deterministic measurements.
+   */
+  SymplecticTableau tab_;
+
+  void clear_row(unsigned r);
+};
+
+/**
+ * Simulate a Clifford circuit, which may contain measurements, resets and
+ * conditional gates, on the state |00...0>.
+ *
+ * Any op satisfying CliffordCircuitPredicate is supported, including boxes
+ * which can be decomposed into Clifford circuits.
+ *
+ * @param circ The circuit to simulate.
+ * @param seed Seed for the random measurement outcomes.
+ * @return The stabilisers of the final state, with one column per qubit in
+ *              the order of circ.all_qubits().
+ */
+SymplecticTableau get_stabiliser_state(
+    const Circuit &circ, std::size_t seed = 0);
+
+/**
+ * Sample the classical bits written by a Clifford circuit, simulating it
+ * once per shot on the state |00...0>.
+ *
+ * The longest prefix of the circuit without measurements or other
+ * non-unitary operations is only simulated once.
+ *
+ * @param circ The circuit to simulate.
+ * @param n_shots Number of times to run the circuit.
+ * @param seed Seed for the random measurement outcomes; the same seed always
+ *              gives the same shots.
+ * @return A matrix with one row per shot and one column per bit, in the
+ *              order of circ.all_bits().
+ */
+MatrixXb sample_clifford_shots(
+    const Circuit &circ, unsigned n_shots, std::size_t seed);
+
+}  // namespace tket_sim
+}  // namespace tket
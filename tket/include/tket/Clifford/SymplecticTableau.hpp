@@ -15,6 +15,7 @@
 #pragma once
 
 #include "tket/OpType/OpType.hpp"
+#include "tket/Utils/GF2Matrix.hpp"
 #include "tket/Utils/MatrixAnalysis.hpp"
 #include "tket/Utils/PauliTensor.hpp"
 
@@ -86,6 +87,8 @@ class SymplecticTableau {
    */
   explicit SymplecticTableau(
       const MatrixXb &xmat, const MatrixXb &zmat, const VectorXb &phase);
+  explicit SymplecticTableau(
+      const GF2Matrix &xmat, const GF2Matrix &zmat, const VectorXb &phase);
   explicit SymplecticTableau(const PauliStabiliserVec &rows);
 
   /**
@@ -173,26 +176,40 @@ class SymplecticTableau {
   /**
    * Tableau contents
    */
-  MatrixXb xmat;
-  MatrixXb zmat;
+  GF2Matrix xmat;
+  GF2Matrix zmat;
   VectorXb phase;
 
+  /**
+   * Swap two rows, including their phases
+   */
+  void swap_rows(unsigned r1, unsigned r2);
+
+  /**
+   * Resize the tableau, keeping existing entries and filling new rows and
+   * columns with identities with positive phase
+   */
+  void conservative_resize(unsigned n_rows, unsigned n_qubits);
+
   /**
    * Complex conjugate of the state by conjugating rows
    */
   SymplecticTableau conjugate() const;
 
  private:
+  typedef GF2Matrix::word_t word_t;
+
   /**
-   * Helper methods for manipulating the tableau when applying gates
+   * Helper method for row multiplication.
+   *
+   * Multiplies the Paulis given by (xa, za, pa) and (xb, zb, pb) with an
+   * extra coefficient, writing the result to (xw, zw, pw). The output words
+   * may alias either input.
    */
   void row_mult(
-      const MatrixXb::RowXpr &xa, const MatrixXb::RowXpr &za, const bool &pa,
-      const MatrixXb::RowXpr &xb, const MatrixXb::RowXpr &zb, const bool &pb,
-      Complex phase, MatrixXb::RowXpr &xw, MatrixXb::RowXpr &zw, bool &pw);
-  void col_mult(
-      const MatrixXb::ColXpr &a, const MatrixXb::ColXpr &b, bool flip,
-      MatrixXb::ColXpr &w, VectorXb &pw);
+      const word_t *xa, const word_t *za, bool pa, const word_t *xb,
+      const word_t *zb, bool pb, Complex phase, word_t *xw, word_t *zw,
+      bool &pw) const;
 };
 
 JSON_DECL(SymplecticTableau)
@@ -15,6 +15,7 @@
 #pragma once
 
 #include <stdexcept>
+#include <vector>
 
 #include "tket/Utils/GraphHeaders.hpp"
 #include "tket/Utils/PauliTensor.hpp"
@@ -82,11 +83,29 @@ enum class GraphColourMethod {
 /**
  * A helper class for converting QubitOperator into PauliACGraphs and
  * then colouring the PauliACGraph using some method.
+ *
+ * Strings are also held in a bit-packed form over a common qubit indexing,
+ * so that each pair is checked with a few word operations, and pairs whose
+ * supports are disjoint on a cheap 64-bucket signature are skipped.
  */
 class PauliPartitionerGraph {
  public:
+  /**
+   * Build the graph for the given strings.
+   *
+   * @param strings Pauli strings, one per vertex
+   * @param strat which pairs of strings are joined by edges
+   * @param n_threads number of threads used to find the edges
+   */
   explicit PauliPartitionerGraph(
-      const std::list<SpPauliString>& strings, PauliPartitionStrat strat);
+      const std::list<SpPauliString>& strings, PauliPartitionStrat strat,
+      unsigned n_threads = 1);
+
+  /**
+   * Add more strings to the graph, checking them against the existing
+   * vertices and each other without rebuilding the rest of the graph.
+   */
+  void add_strings(const std::list<SpPauliString>& strings);
 
   // KEY: the colour  VALUE: all the Pauli strings assigned that colour.
   std::map<unsigned, std::list<SpPauliString>> partition_paulis(
@@ -94,6 +113,13 @@ class PauliPartitionerGraph {
 
  private:
   PauliACGraph pac_graph;
+  PauliPartitionStrat strat_;
+  unsigned n_threads_;
+  // Position of each qubit seen so far in the packed strings
+  std::map<Qubit, unsigned> qubit_indices_;
+  // Packed string and support signature of each vertex
+  std::vector<SymplecticPauliMap> packed_strings_;
+  std::vector<SymplecticPauliMap::word_t> support_signatures_;
 };
 
 /**
@@ -101,9 +127,13 @@ class PauliPartitionerGraph {
  * Assumes that each `SpPauliString` is unique and does not attempt
  * to combine them. If it is given non-unique tensors it will produce
  * inefficient results.
+ *
+ * @param n_threads number of threads used to build the graph, for the
+ *   methods that build one
  */
 std::list<std::list<SpPauliString>> term_sequence(
     const std::list<SpPauliString>& strings, PauliPartitionStrat strat,
-    GraphColourMethod method = GraphColourMethod::Lazy);
+    GraphColourMethod method = GraphColourMethod::Lazy,
+    unsigned n_threads = 1);
 
 }  // namespace tket
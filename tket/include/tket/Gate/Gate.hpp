@@ -14,6 +14,9 @@
 
 #pragma once
 
+#include <array>
+#include <optional>
+
 #include "tket/Ops/Op.hpp"
 
 namespace tket {
@@ -24,6 +27,28 @@ class SubstitutionFailure : public std::logic_error {
       : std::logic_error(message) {}
 };
 
+/**
+ * The parameters of a gate as plain doubles, stored inline so that reading
+ * them allocates nothing.
+ */
+class NumericParams {
+ public:
+  /** No gate type has more parameters than this. */
+  static constexpr unsigned max_size = 3;
+
+  NumericParams() : values_{}, size_(0) {}
+
+  unsigned size() const { return size_; }
+  double operator[](unsigned i) const { return values_[i]; }
+  const double *begin() const { return values_.data(); }
+  const double *end() const { return values_.data() + size_; }
+  void push_back(double x) { values_.at(size_++) = x; }
+
+ private:
+  std::array<double, max_size> values_;
+  unsigned size_;
+};
+
 class Gate : public Op {
  public:
   // return hermitian conjugate
@@ -49,6 +74,23 @@ class Gate : public Op {
    */
   std::vector<Expr> get_tk1_angles() const;
   std::vector<Expr> get_params() const override;
+
+  /**
+   * The parameters as doubles, if every parameter is a plain number (see
+   * @ref eval_number); std::nullopt for symbolic gates.
+   *
+   * These are evaluated once on construction, so numeric code should read
+   * them rather than copying and evaluating the expressions from
+   * @ref get_params.
+   *
+   * They are stored alongside the expressions, not instead of them, so each
+   * gate is slightly larger. Squashing and rebasing still compute with the
+   * expressions.
+   */
+  const std::optional<NumericParams> &get_numeric_params() const {
+    return numeric_params_;
+  }
+
   std::vector<Expr> get_params_reduced() const override;
   SymSet free_symbols() const override;
 
@@ -60,6 +102,8 @@ class Gate : public Op {
 
   nlohmann::json serialize() const override;
 
+  std::size_t hash() const override;
+
   static Op_ptr deserialize(const nlohmann::json &j);
 
   std::optional<double> is_identity() const override;
@@ -84,6 +128,8 @@ class Gate : public Op {
   // vector of symbolic params
   const std::vector<Expr> params_;
   unsigned n_qubits_; /**< Number of qubits, when not deducible from type */
+  /** The params as doubles, unless any of them is not a plain number */
+  const std::optional<NumericParams> numeric_params_;
 };
 
 }  // namespace tket
@@ -14,6 +14,8 @@
 
 #pragma once
 
+#include <mutex>
+
 #include "tket/Utils/Expression.hpp"
 
 namespace tket {
@@ -29,7 +31,8 @@ void clear_symbol_table();
  * All members are static. There are no instances of this class.
  *
  * When an operation is created using \p get_op_ptr, any symbols in its
- * parameters are added to a global registry of symbols.
+ * parameters are added to a global registry of symbols. Access to the registry
+ * is serialised, so circuits may be built on several threads at once.
  */
 struct SymTable {
   /** Create a new symbol (not currently registered), and register it */
@@ -42,6 +45,7 @@ struct SymTable {
  private:
   friend void test_Ops::clear_symbol_table();
   static std::unordered_set<std::string> &get_registered_symbols();
+  static std::mutex &get_mutex();
 };
 
 }  // namespace tket
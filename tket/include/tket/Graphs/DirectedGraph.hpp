@@ -17,9 +17,14 @@
 #include <algorithm>
 #include <boost/range/adaptor/transformed.hpp>
 #include <boost/range/iterator_range_core.hpp>
+#include <cstdint>
 #include <map>
+#include <memory>
+#include <mutex>
+#include <numeric>
 #include <optional>
 #include <stdexcept>
+#include <utility>
 
 #include "tket/Graphs/AbstractGraph.hpp"
 #include "tket/Graphs/TreeSearch.hpp"
@@ -40,6 +45,82 @@ class NodesNotConnected : public std::logic_error {
             node1.repr() + " and " + node2.repr() + " are not connected") {}
 };
 
+/**
+ * Flat all-pairs distance and next-hop table of an undirected graph whose
+ * vertices are indexed 0, ..., n-1.
+ *
+ * The entries for the pair (root, v) are stored contiguously at index
+ * `root * n + v`. As elsewhere, a distance of zero between two distinct
+ * vertices means that they are disconnected.
+ *
+ * The next hop from v towards root is the parent of v in a breadth-first
+ * search rooted at root, visiting neighbours in the same order as
+ * `run_bfs`. Following next hops from v therefore reproduces
+ * `BFS::path_to_root`.
+ */
+class AllPairsDistanceTable {
+ public:
+  /** Largest number of vertices for which a table will be built. */
+  static constexpr std::size_t max_vertices = 4096;
+
+  template <typename Graph>
+  explicit AllPairsDistanceTable(const Graph& g)
+      : n_(boost::num_vertices(g)), dists_(n_ * n_, 0), next_hops_(n_ * n_) {
+    if (n_ > max_vertices) {
+      throw std::invalid_argument(
+          "Graph too large for an all-pairs distance table");
+    }
+    std::vector<std::uint16_t> queue(n_);
+    for (std::size_t root = 0; root < n_; ++root) {
+      std::uint16_t* dist_row = dists_.data() + root * n_;
+      std::uint16_t* hop_row = next_hops_.data() + root * n_;
+      // A vertex is its own next hop until it has been reached.
+      std::iota(hop_row, hop_row + n_, 0);
+      std::size_t head = 0, tail = 0;
+      queue[tail++] = root;
+      while (head < tail) {
+        std::uint16_t u = queue[head++];
+        for (auto [it, end] = boost::adjacent_vertices(u, g); it != end;
+             ++it) {
+          std::size_t v = *it;
+          if (v != root && hop_row[v] == v) {
+            hop_row[v] = u;
+            dist_row[v] = dist_row[u] + 1;
+            queue[tail++] = v;
+          }
+        }
+      }
+    }
+  }
+
+  /** Number of vertices. */
+  std::size_t size() const { return n_; }
+
+  /** Distance between two vertices (zero if disconnected). */
+  std::uint16_t get_distance(std::size_t root, std::size_t v) const {
+    return dists_[root * n_ + v];
+  }
+
+  /** Pointer to the n distances from a given root. */
+  const std::uint16_t* get_distances(std::size_t root) const {
+    return dists_.data() + root * n_;
+  }
+
+  /**
+   * Neighbour of v on a shortest path towards root.
+   *
+   * Returns v itself if v == root or v is disconnected from root.
+   */
+  std::uint16_t get_next_hop(std::size_t root, std::size_t v) const {
+    return next_hops_[root * n_ + v];
+  }
+
+ private:
+  std::size_t n_;
+  std::vector<std::uint16_t> dists_;
+  std::vector<std::uint16_t> next_hops_;
+};
+
 /** Weighted edge */
 struct WeightedEdge {
   explicit WeightedEdge(unsigned w = 1) : weight(w) {}
@@ -398,40 +479,74 @@ class DirectedGraph : public DirectedGraphBase<T> {
   using Connection = typename Base::Connection;
   using Vertex = typename Base::Vertex;
 
+  DirectedGraph(const DirectedGraph& other)
+      : Base(other), cache_(std::make_shared<Cache>()) {}
+  DirectedGraph(DirectedGraph&& other)
+      : Base(std::move(other)),
+        cache_(std::exchange(other.cache_, std::make_shared<Cache>())) {}
+  DirectedGraph& operator=(const DirectedGraph& other) {
+    Base::operator=(other);
+    invalidate_cache();
+    return *this;
+  }
+  DirectedGraph& operator=(DirectedGraph&& other) {
+    Base::operator=(std::move(other));
+    cache_ = std::exchange(other.cache_, std::make_shared<Cache>());
+    return *this;
+  }
+
   /**
    * Get all distances between nodes.
    */
   const std::vector<std::size_t>& get_distances(const T& root) const& {
     // We cache distances. A value of zero in the cache implies that the nodes
     // are disconnected (unless they are equal).
-    if (distance_cache.find(root) == distance_cache.end()) {
-      distance_cache[root] = Base::get_distances(root);
+    // The table must be built before taking the lock; see get_distance_table.
+    get_distance_table();
+    std::lock_guard<std::recursive_mutex> lock(cache_->mutex);
+    auto it = cache_->distances.find(root);
+    if (it == cache_->distances.end()) {
+      it = cache_->distances.emplace(root, compute_distances(root)).first;
     }
-    return distance_cache[root];
+    return it->second;
   }
 
   /**
    * Get all distances between nodes.
    */
   std::vector<std::size_t>&& get_distances(const T& root) const&& {
-    if (distance_cache.find(root) == distance_cache.end()) {
-      distance_cache[root] = Base::get_distances(root);
+    get_distance_table();
+    std::lock_guard<std::recursive_mutex> lock(cache_->mutex);
+    auto it = cache_->distances.find(root);
+    if (it == cache_->distances.end()) {
+      it = cache_->distances.emplace(root, compute_distances(root)).first;
     }
-    return std::move(distance_cache[root]);
+    return std::move(it->second);
   }
 
   unsigned get_distance(const T& node1, const T& node2) const override {
     if (node1 == node2) {
       return 0;
     }
+    if (!node_exists(node1) || !node_exists(node2)) {
+      throw NodeDoesNotExistError(
+          "Trying to get distance between non-existent vertices");
+    }
     std::size_t d;
-    if (distance_cache.find(node1) != distance_cache.end()) {
-      d = distance_cache[node1][this->to_vertices(node2)];
-    } else if (distance_cache.find(node2) != distance_cache.end()) {
-      d = distance_cache[node2][this->to_vertices(node1)];
+    if (const AllPairsDistanceTable* table = get_distance_table()) {
+      d = table->get_distance(
+          this->to_vertices(node1), this->to_vertices(node2));
     } else {
-      distance_cache[node1] = Base::get_distances(node1);
-      d = distance_cache[node1][this->to_vertices(node2)];
+      std::lock_guard<std::recursive_mutex> lock(cache_->mutex);
+      auto& distance_cache = cache_->distances;
+      if (distance_cache.find(node1) != distance_cache.end()) {
+        d = distance_cache[node1][this->to_vertices(node2)];
+      } else if (distance_cache.find(node2) != distance_cache.end()) {
+        d = distance_cache[node2][this->to_vertices(node1)];
+      } else {
+        distance_cache[node1] = Base::get_distances(node1);
+        d = distance_cache[node1][this->to_vertices(node2)];
+      }
     }
     if (d == 0) {
       throw NodesNotConnected(node1, node2);
@@ -439,20 +554,53 @@ class DirectedGraph : public DirectedGraphBase<T> {
     return d;
   }
 
+  /**
+   * Returns path between two nodes, starting at target and ending at root.
+   *
+   * An empty path is returned if the nodes are disconnected.
+   */
+  std::vector<T> get_path(const T& root, const T& target) const {
+    const AllPairsDistanceTable* table = get_distance_table();
+    if (!table) {
+      std::lock_guard<std::recursive_mutex> lock(cache_->mutex);
+      return Base::get_path(root, target);
+    }
+    if (!node_exists(root) || !node_exists(target)) {
+      throw NodeDoesNotExistError(
+          "Trying to get path between non-existent vertices");
+    }
+    const Vertex root_v = this->to_vertices(root);
+    Vertex current = this->to_vertices(target);
+    std::vector<T> path{target};
+    while (current != root_v) {
+      const Vertex next = table->get_next_hop(root_v, current);
+      if (next == current) {
+        // graph is disconnected and there is no path to root
+        return {};
+      }
+      current = next;
+      path.push_back(this->get_node(current));
+    }
+    return path;
+  }
+
   unsigned get_diameter() override {
     unsigned N = n_nodes();
     if (N == 0) {
       throw std::logic_error("Graph is empty.");
     }
+    get_distance_table();
+    std::lock_guard<std::recursive_mutex> lock(cache_->mutex);
     if (!this->diameter_) {
-      this->diameter_ = 0;
+      unsigned diameter = 0;
       const std::vector<T> nodes = get_all_nodes_vec();
       for (unsigned i = 0; i < N; i++) {
         for (unsigned j = i + 1; j < N; j++) {
           unsigned d = get_distance(nodes[i], nodes[j]);
-          if (d > *this->diameter_) this->diameter_ = d;
+          if (d > diameter) diameter = d;
         }
       }
+      this->diameter_ = diameter;
     }
     return *this->diameter_;
   }
@@ -472,18 +620,46 @@ class DirectedGraph : public DirectedGraphBase<T> {
   /** Return an unweighted undirected graph with the same connectivity. */
   const UndirectedConnGraph& get_undirected_connectivity() const& {
     // we cache the undirected graph
-    if (!undir_graph) {
-      undir_graph = Base::get_undirected_connectivity();
+    std::lock_guard<std::recursive_mutex> lock(cache_->mutex);
+    if (!cache_->undir_graph) {
+      cache_->undir_graph = Base::get_undirected_connectivity();
     }
-    return undir_graph.value();
+    return cache_->undir_graph.value();
   }
 
   /** Return an unweighted undirected graph with the same connectivity. */
   UndirectedConnGraph&& get_undirected_connectivity() const&& {
-    if (!undir_graph) {
-      undir_graph = Base::get_undirected_connectivity();
+    std::lock_guard<std::recursive_mutex> lock(cache_->mutex);
+    if (!cache_->undir_graph) {
+      cache_->undir_graph = Base::get_undirected_connectivity();
     }
-    return std::move(undir_graph.value());
+    return std::move(cache_->undir_graph.value());
+  }
+
+  /**
+   * The all-pairs distance table, built on first use.
+   *
+   * Returns nullptr if the graph has too many nodes for a table, in which case
+   * distances are computed by BFS from each root on demand.
+   *
+   * Once the table has been built, `get_distance` and `get_path` only read
+   * from it without taking a lock.
+   *
+   * This must never be called for the first time while holding the cache
+   * mutex: another thread may be inside the `call_once`, and the two would
+   * then wait on each other. For the same reason, the body builds the
+   * undirected graph itself rather than going through the cached copy.
+   */
+  const AllPairsDistanceTable* get_distance_table() const {
+    if (n_nodes() > AllPairsDistanceTable::max_vertices) {
+      return nullptr;
+    }
+    Cache& cache = *cache_;
+    std::call_once(cache.table_flag, [this, &cache]() {
+      cache.table = std::make_unique<const AllPairsDistanceTable>(
+          Base::get_undirected_connectivity());
+    });
+    return cache.table.get();
   }
 
   // The following functions invalidate caching.
@@ -525,12 +701,36 @@ class DirectedGraph : public DirectedGraphBase<T> {
   }
 
  private:
+  /**
+   * Lazily computed data. Const member functions may be called concurrently
+   * from several threads, so all access goes through the mutex, except for
+   * the distance table which is published once through `table_flag`.
+   */
+  struct Cache {
+    std::recursive_mutex mutex;
+    std::map<T, std::vector<std::size_t>> distances;
+    std::optional<UndirectedConnGraph> undir_graph;
+    std::once_flag table_flag;
+    std::unique_ptr<const AllPairsDistanceTable> table;
+  };
+
+  std::vector<std::size_t> compute_distances(const T& root) const {
+    const AllPairsDistanceTable* table = get_distance_table();
+    if (!table) {
+      return Base::get_distances(root);
+    }
+    if (!node_exists(root)) {
+      throw NodeDoesNotExistError(
+          "Trying to get distances from non-existent root vertex");
+    }
+    const std::uint16_t* row = table->get_distances(this->to_vertices(root));
+    return std::vector<std::size_t>(row, row + table->size());
+  }
+
   inline void invalidate_cache() {
-    distance_cache.clear();
-    undir_graph = std::nullopt;
+    cache_ = std::make_shared<Cache>();
   }
-  mutable std::map<T, std::vector<std::size_t>> distance_cache;
-  mutable std::optional<UndirectedConnGraph> undir_graph;
+  mutable std::shared_ptr<Cache> cache_ = std::make_shared<Cache>();
 };
 
 }  // namespace tket::graphs
@@ -38,10 +38,11 @@ class LexiRoute {
    * Class Constructor
    * @param _architecture Architecture object added operations must respect
    * @param _mapping_frontier Contains Circuit object to be modified
+   * @param _n_threads Maximum number of threads used to score candidate SWAPs
    */
   LexiRoute(
       const ArchitecturePtr& _architecture,
-      MappingFrontier_ptr& _mapping_frontier);
+      MappingFrontier_ptr& _mapping_frontier, unsigned _n_threads = 1);
 
   /**
    * When called, LexiRoute::solve will modify the Circuit held in
@@ -220,6 +221,8 @@ class LexiRoute {
   unit_map_t labelling_;
   //   Set tracking which Architecture Node are present in Circuit
   std::set<Node> assigned_nodes_;
+  //   Maximum number of threads used to score candidate SWAPs
+  unsigned n_threads_;
 };
 
 }  // namespace tket
@@ -25,8 +25,10 @@ class LexiRouteRoutingMethod : public RoutingMethod {
    * corresponding to lookahead, is a required parameter.
    *
    * @param _max_depth Number of layers of gates checked inr outed subcircuit.
+   * @param _n_threads Maximum number of threads used to score candidate SWAPs.
+   * The chosen SWAP does not depend on this value.
    */
-  LexiRouteRoutingMethod(unsigned _max_depth = 100);
+  LexiRouteRoutingMethod(unsigned _max_depth = 100, unsigned _n_threads = 1);
 
   /**
    * @param mapping_frontier Contains boundary of routed/unrouted circuit for
@@ -46,12 +48,18 @@ class LexiRouteRoutingMethod : public RoutingMethod {
    */
   unsigned get_max_depth() const;
 
+  /**
+   * @return Maximum number of threads used to score candidate SWAPs
+   */
+  unsigned get_n_threads() const;
+
   nlohmann::json serialize() const override;
 
   static LexiRouteRoutingMethod deserialize(const nlohmann::json& j);
 
  private:
   unsigned max_depth_;
+  unsigned n_threads_;
 };
 
 JSON_DECL(LexiRouteRoutingMethod);
@@ -89,12 +89,19 @@ class LexicographicalComparison {
    * way, only swaps with lexicographically identical swap for the given
    * interacting nodes remain after the method is called.
    *
+   * The distance vectors of the candidates may be computed on several threads;
+   * they are always compared in the order of candidate_swaps, so the result
+   * does not depend on n_threads.
+   *
    * @param candidate_swaps Potential pairs of nodes for comparing and removing
+   * @param n_threads Maximum number of threads used to score candidates
    */
-  void remove_swaps_lexicographical(swap_set_t& candidate_swaps) const;
+  void remove_swaps_lexicographical(
+      swap_set_t& candidate_swaps, unsigned n_threads = 1) const;
 
  private:
   ArchitecturePtr architecture_;
+  unsigned diameter_;
   lexicographical_distances_t lexicographical_distances;
   interacting_nodes_t interacting_nodes_;
 };
@@ -14,6 +14,10 @@
 
 #pragma once
 
+#include <functional>
+#include <map>
+#include <optional>
+
 #include "tket/Architecture/Architecture.hpp"
 #include "tket/Circuit/Circuit.hpp"
 #include "tket/Mapping/RoutingMethod.hpp"
@@ -28,6 +32,34 @@ class MappingManagerError : public std::logic_error {
       : std::logic_error(message) {}
 };
 
+/** One configuration tried by MappingManager::route_circuit_portfolio */
+struct PortfolioRoutingConfig {
+  /** Ranked routing methods, as passed to MappingManager::route_circuit */
+  std::vector<RoutingMethodPtr> routing_methods;
+  /** Placement applied to the circuit before routing, if any */
+  std::optional<std::map<Qubit, Node>> placement;
+};
+
+/** How MappingManager::route_circuit_portfolio ranks routed circuits */
+enum class PortfolioObjective {
+  /** Fewest SWAP and BRIDGE gates, then lowest depth */
+  SwapCount,
+  /** Lowest depth, then fewest SWAP and BRIDGE gates */
+  Depth
+};
+
+/** The configuration chosen by MappingManager::route_circuit_portfolio */
+struct PortfolioRoutingResult {
+  /** Index of the chosen configuration */
+  unsigned config_index;
+  /** Number of SWAP and BRIDGE gates in the routed circuit */
+  unsigned n_swaps;
+  /** Depth of the routed circuit */
+  unsigned depth;
+  /** Number of configurations that finished routing within the budget */
+  unsigned n_completed;
+};
+
 class MappingManager {
  public:
   /* Mapping Manager Constructor */
@@ -69,7 +101,47 @@ class MappingManager {
       Circuit& circuit, const std::vector<RoutingMethodPtr>& routing_methods,
       std::shared_ptr<unit_bimaps_t> maps) const;
 
+  /**
+   * route_circuit_portfolio
+   * Routes a copy of the circuit with each configuration concurrently, and
+   * replaces the circuit (and maps) with the best result.
+   *
+   * Once the time budget has passed and at least one configuration has
+   * finished, configurations not yet started are skipped and those still
+   * running are abandoned. Without a budget the result does not depend on
+   * the number of threads. Configurations that throw are ignored, unless all
+   * of them do, in which case the first exception is rethrown.
+   *
+   * All configurations route against the same architecture. A RoutingMethod
+   * object appearing in several configurations is called from several
+   * threads at once, so it must be thread-safe.
+   *
+   * @param circuit Circuit to be routed
+   * @param configs Configurations to try
+   * @param maps For tracking placed and permuted qubits during Compilation,
+   * or nullptr
+   * @param objective How to rank the routed circuits
+   * @param n_threads Maximum number of threads; 0 uses all hardware threads
+   * @param timeout_ms Wall-clock budget in milliseconds, if any
+   * @return The chosen configuration
+   */
+  PortfolioRoutingResult route_circuit_portfolio(
+      Circuit& circuit, const std::vector<PortfolioRoutingConfig>& configs,
+      std::shared_ptr<unit_bimaps_t> maps = nullptr,
+      PortfolioObjective objective = PortfolioObjective::SwapCount,
+      unsigned n_threads = 0,
+      std::optional<unsigned> timeout_ms = std::nullopt) const;
+
  private:
+  /**
+   * Implements route_circuit_with_maps, checking \p stop between routing
+   * steps. Returns std::nullopt if routing was stopped.
+   */
+  std::optional<bool> route_circuit_until(
+      Circuit& circuit, const std::vector<RoutingMethodPtr>& routing_methods,
+      std::shared_ptr<unit_bimaps_t> maps,
+      const std::function<bool()>& stop) const;
+
   ArchitecturePtr architecture_;
 };
 }  // namespace tket
\ No newline at end of file
@@ -26,10 +26,13 @@ namespace tket {
  * See: https://arxiv.org/abs/1907.07859, https://arxiv.org/abs/1908.11857,
  * https://arxiv.org/abs/1907.13623, https://arxiv.org/abs/1908.08067,
  * https://arxiv.org/abs/1908.06942, https://arxiv.org/abs/1907.03358
+ *
+ * @param n_threads number of threads used to build the graph, for the
+ *   colouring methods that build one
  */
 MeasurementSetup measurement_reduction(
     const std::list<SpPauliString>& strings, PauliPartitionStrat strat,
     GraphColourMethod method = GraphColourMethod::Lazy,
-    CXConfigType cx_config = CXConfigType::Snake);
+    CXConfigType cx_config = CXConfigType::Snake, unsigned n_threads = 1);
 
 }  // namespace tket
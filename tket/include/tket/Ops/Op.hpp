@@ -187,6 +187,19 @@ class Op : public std::enable_shared_from_this<Op> {
     throw JsonError("JSON serialization not yet implemented for " + get_name());
   }
 
+  /**
+   * Hash of the operation's type and data.
+   *
+   * Ops with equal hashes are equal (up to hash collisions). The converse
+   * need not hold: for example, gates whose parameters differ by a period
+   * compare equal but hash differently.
+   *
+   * The default implementation hashes the JSON serialization.
+   *
+   * @throw JsonError if the op cannot be serialized
+   */
+  virtual std::size_t hash() const;
+
   virtual ~Op() {}
 
   bool operator==(const Op &other) const {
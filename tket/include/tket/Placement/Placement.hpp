@@ -14,6 +14,9 @@
 
 #pragma once
 
+#include <deque>
+#include <mutex>
+
 #include "tket/Architecture/Architecture.hpp"
 #include "tket/Characterisation/DeviceCharacterisation.hpp"
 #include "tket/Circuit/Circuit.hpp"
@@ -191,8 +194,13 @@ class GraphPlacement : public Placement {
 
   mutable std::vector<WeightedEdge> weighted_target_edges;
 
-  //   we can use a vector as we index by incrementing size
-  mutable std::vector<Architecture::UndirectedConnGraph> extended_target_graphs;
+  //   we index by incrementing size; a deque keeps references to existing
+  //   graphs valid while further graphs are appended
+  mutable std::deque<Architecture::UndirectedConnGraph> extended_target_graphs;
+  //   guards extended_target_graphs, which may be extended concurrently when
+  //   one placement is used on several threads
+  mutable std::shared_ptr<std::mutex> extended_target_graphs_mutex =
+      std::make_shared<std::mutex>();
 
   const std::vector<WeightedEdge> default_pattern_weighting(
       const Circuit& circuit) const;
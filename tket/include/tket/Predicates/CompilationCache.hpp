@@ -0,0 +1,153 @@
+// Copyright Quantinuum
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include "tket/Circuit/Circuit.hpp"
+#include "tket/Utils/Json.hpp"
+#include "tket/Utils/UnitID.hpp"
+
+namespace tket {
+
+/**
+ * Hash of a pass configuration, as returned by BasePass::get_config.
+ *
+ * Returns nullopt if the configuration does not determine the pass's
+ * behaviour, i.e. if it contains a CustomPass, CustomPassMap,
+ * RepeatWithMetricPass, UserDefinedPredicate or a generic RoutingMethod
+ * (such as one defined in Python), since these wrap arbitrary functions that
+ * are not part of the configuration.
+ *
+ * @param config pass configuration
+ * @return hash, or nullopt if the pass cannot be identified by its
+ *   configuration
+ */
+std::optional<std::size_t> pass_config_hash(const nlohmann::json &config);
+
+/**
+ * Cache of compilation results, keyed by the structural hash of the input
+ * circuit and the hash of the pass configuration.
+ *
+ * Entries are held in memory with least-recently-used eviction and,
+ * optionally, written to files in a directory so that they persist between
+ * processes. Safe to share between threads.
+ *
+ * Each entry also records the serialized input circuit and pass
+ * configuration, and a lookup only hits if both match, so a hash collision
+ * is treated as a miss rather than returning another circuit's result.
+ *
+ * Boxes are identified by their unique ID rather than their contents, so a
+ * circuit containing boxes that were rebuilt, and so given new IDs, does not
+ * hit entries for the original circuit.
+ *
+ * @see BasePass::apply_cached
+ */
+class CompilationCache {
+ public:
+  /** Result of applying a pass to a circuit. */
+  struct Entry {
+    /** Compiled circuit */
+    Circuit circ;
+    /** Whether the pass modified the circuit */
+    bool changed;
+    /**
+     * Initial and final maps produced by the pass, from the units of the
+     * input circuit
+     */
+    unit_bimaps_t maps;
+    /** Input circuit, as written by Circuit::to_binary */
+    std::string input;
+    /** Pass configuration, as written by nlohmann::json::dump */
+    std::string config;
+  };
+
+  /**
+   * Construct an empty cache.
+   *
+   * @param capacity maximum number of entries held in memory
+   * @param directory if set, entries are also stored as files in this
+   *   existing directory, and looked up there when not in memory
+   */
+  explicit CompilationCache(
+      std::size_t capacity = 256,
+      std::optional<std::string> directory = std::nullopt);
+
+  /**
+   * Look up an entry, moving it to the front of the eviction order.
+   *
+   * An entry stored under the same hashes but for a different input or
+   * configuration is not returned.
+   *
+   * @param circ_hash structural hash of the input circuit
+   * @param pass_hash hash of the pass configuration
+   * @param input input circuit, as written by Circuit::to_binary
+   * @param config pass configuration, as written by nlohmann::json::dump
+   * @return a copy of the entry, if present
+   */
+  std::optional<Entry> find(
+      std::size_t circ_hash, std::size_t pass_hash, const std::string &input,
+      const std::string &config);
+
+  /**
+   * Add or replace an entry, evicting the least recently used entry from
+   * memory if the cache is full.
+   *
+   * @param circ_hash structural hash of the input circuit
+   * @param pass_hash hash of the pass configuration
+   * @param entry result of applying the pass
+   */
+  void insert(std::size_t circ_hash, std::size_t pass_hash, Entry entry);
+
+  /** Number of entries held in memory */
+  std::size_t size() const;
+
+  /** Number of successful lookups */
+  std::size_t hits() const;
+
+  /** Number of unsuccessful lookups */
+  std::size_t misses() const;
+
+  /** Remove all entries from memory (but not from the directory) */
+  void clear();
+
+ private:
+  typedef std::pair<std::size_t, std::size_t> Key;
+  struct KeyHash {
+    std::size_t operator()(const Key &key) const;
+  };
+  typedef std::list<std::pair<Key, Entry>> EntryList;
+
+  std::string filename(const Key &key) const;
+  std::optional<Entry> read_file(const Key &key) const;
+  void write_file(const Key &key, const Entry &entry) const;
+  void insert_locked(const Key &key, Entry entry);
+
+  std::size_t capacity_;
+  std::optional<std::string> directory_;
+  mutable std::mutex mutex_;
+  EntryList entries_;  // most recently used first
+  std::unordered_map<Key, EntryList::iterator, KeyHash> index_;
+  std::size_t hits_ = 0;
+  std::size_t misses_ = 0;
+};
+
+}  // namespace tket
@@ -15,7 +15,9 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 
+#include "PassTrace.hpp"
 #include "Predicates.hpp"
 
 namespace tket {
@@ -48,9 +50,20 @@ class CompilationUnit {
   const unit_bimap_t& get_final_map_ref() const { return maps->final; }
   std::string to_string() const;
 
+  /**
+   * Start recording the passes applied to this unit and the predicates they
+   * check, discarding any earlier record; or, if `enable` is false, stop
+   * recording.
+   */
+  void enable_trace(bool enable = true);
+  /** The record of passes applied since tracing was enabled, if it is */
+  const std::optional<PassTrace>& get_trace() const { return trace_; }
+
   friend class Circuit;
   friend class BasePass;
   friend class StandardPass;
+  friend class RepeatWithMetricPass;
+  friend class PassTraceScope;
 
   static TypePredicatePair make_type_pair(const PredicatePtr& ptr);
 
@@ -66,6 +79,10 @@ class CompilationUnit {
 
   // Maps from original logical qubits to corresponding current qubits
   std::shared_ptr<unit_bimaps_t> maps;
+
+  // Written by passes through PassTraceScope, including from const contexts
+  // such as predicate checks.
+  mutable std::optional<PassTrace> trace_;
 };
 
 }  // namespace tket
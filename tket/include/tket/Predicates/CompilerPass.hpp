@@ -24,6 +24,7 @@ namespace tket {
 enum class Guarantee;
 struct PostConditions;
 class BasePass;
+class CompilationCache;
 class StandardPass;
 class SequencePass;
 class RepeatPass;
@@ -116,6 +117,50 @@ class BasePass {
       const PassCallback& before_apply = trivial_callback,
       const PassCallback& after_apply = trivial_callback) const = 0;
 
+  /**
+   * @brief Apply the pass to each of a collection of compilation units
+   *
+   * The units are distributed over a pool of threads, each running `apply` on
+   * one unit at a time. The units must be distinct objects; in particular
+   * they must not be copies of one another, since copies of a
+   * CompilationUnit share their unit maps.
+   *
+   * Any exception thrown while compiling a unit is rethrown once all threads
+   * have finished; the remaining units may or may not have been compiled.
+   *
+   * @param c_units compilation units, modified in place
+   * @param n_threads maximum number of threads to use; 0 means the number of
+   * hardware threads
+   * @param safe_mode
+   * @return for each unit, true if the pass modified its circuit
+   */
+  std::vector<bool> apply_batch(
+      std::vector<CompilationUnit>& c_units, unsigned n_threads = 0,
+      SafetyMode safe_mode = SafetyMode::Default) const;
+
+  /**
+   * @brief Apply the pass, reusing a cached result if there is one
+   *
+   * The cache is keyed by the structural hash of the circuit and the hash of
+   * the pass configuration. On a hit the cached circuit replaces the circuit
+   * of the compilation unit and the cached maps are composed with its maps,
+   * without running the pass; on a miss the pass is applied and the result is
+   * stored. A hit also requires the serialized circuit and configuration to
+   * match those of the entry, so hash collisions are treated as misses.
+   * Passes whose configuration does not determine their behaviour
+   * (see \ref pass_config_hash) are always applied and never cached.
+   *
+   * Preconditions are checked as by `apply`, but no callbacks are invoked.
+   *
+   * @param c_unit compilation unit, modified in place
+   * @param cache cache of compilation results
+   * @param safe_mode
+   * @return True if pass modified the circuit, else False
+   */
+  bool apply_cached(
+      CompilationUnit& c_unit, CompilationCache& cache,
+      SafetyMode safe_mode = SafetyMode::Default) const;
+
   friend PassPtr operator>>(const PassPtr& lhs, const PassPtr& rhs);
 
   virtual std::string to_string() const = 0;
@@ -196,11 +241,13 @@ class SequencePass : public BasePass {
       CompilationUnit& c_unit, SafetyMode safe_mode = SafetyMode::Default,
       const PassCallback& before_apply = trivial_callback,
       const PassCallback& after_apply = trivial_callback) const override {
+    PassTraceScope trace_scope(c_unit, *this);
     before_apply(c_unit, this->get_config());
     bool success = false;
     for (const PassPtr& b : seq_)
       success |= b->apply(c_unit, safe_mode, before_apply, after_apply);
     after_apply(c_unit, this->get_config());
+    trace_scope.set_arg("changed", success);
     return success;
   }
   std::string to_string() const override;
@@ -223,13 +270,16 @@ class RepeatPass : public BasePass {
       CompilationUnit& c_unit, SafetyMode safe_mode = SafetyMode::Default,
       const PassCallback& before_apply = trivial_callback,
       const PassCallback& after_apply = trivial_callback) const override {
+    PassTraceScope trace_scope(c_unit, *this);
     before_apply(c_unit, this->get_config());
     bool success = false;
+    unsigned iterations = 0;
     if (strict_check_) {
       Circuit c0 = c_unit.get_circ_ref();
       bool keep_going = true;
       while (keep_going) {
         bool rv = pass_->apply(c_unit, safe_mode, before_apply, after_apply);
+        ++iterations;
         if (rv) {
           const Circuit& c1 = c_unit.get_circ_ref();
           if (c0 == c1) {
@@ -244,10 +294,15 @@ class RepeatPass : public BasePass {
         }
       }
     } else {
-      while (pass_->apply(c_unit, safe_mode, before_apply, after_apply))
+      while (pass_->apply(c_unit, safe_mode, before_apply, after_apply)) {
+        ++iterations;
         success = true;
+      }
+      ++iterations;
     }
     after_apply(c_unit, this->get_config());
+    trace_scope.set_arg("iterations", iterations);
+    trace_scope.set_arg("changed", success);
     return success;
   }
   std::string to_string() const override;
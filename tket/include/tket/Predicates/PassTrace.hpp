@@ -0,0 +1,112 @@
+// Copyright Quantinuum
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "tket/Utils/Json.hpp"
+
+namespace tket {
+
+class BasePass;
+class Circuit;
+class CompilationUnit;
+class Predicate;
+
+/** One timed span of a compilation: a pass, or a predicate check */
+struct PassTraceEvent {
+  /** Pass or predicate name */
+  std::string name;
+  /** "pass" or "predicate" */
+  std::string category;
+  /** Start time in microseconds, from when tracing was enabled */
+  double start;
+  /** Duration in microseconds */
+  double duration;
+  /** Number of enclosing spans */
+  unsigned level;
+  /**
+   * Details of the span. Passes record the gate count, depth and two-qubit
+   * gate count of the circuit under "before" and "after", whether the circuit
+   * changed, and for repeating passes the number of iterations. Predicate
+   * checks record the result.
+   */
+  nlohmann::json args;
+};
+
+/**
+ * Record of the passes applied to a CompilationUnit, and the predicate checks
+ * they made.
+ *
+ * Tracing is enabled with CompilationUnit::enable_trace. It costs a
+ * computation of the circuit depth before and after every pass, so is off by
+ * default.
+ */
+class PassTrace {
+ public:
+  PassTrace();
+
+  /** Events in the order in which they ended */
+  const std::vector<PassTraceEvent> &get_events() const { return events_; }
+
+  /**
+   * The events in the Chrome trace event format, which can be loaded into
+   * chrome://tracing or Perfetto to see the passes as nested spans.
+   */
+  nlohmann::json to_chrome_trace() const;
+
+ private:
+  friend class PassTraceScope;
+
+  std::chrono::steady_clock::time_point origin_;
+  std::vector<PassTraceEvent> events_;
+  unsigned open_spans_;
+
+  double now() const;
+};
+
+/**
+ * Records a span in the trace of a compilation unit, if it has one, from
+ * construction to destruction.
+ */
+class PassTraceScope {
+ public:
+  PassTraceScope(const CompilationUnit &c_unit, const BasePass &pass);
+  PassTraceScope(const CompilationUnit &c_unit, const Predicate &pred);
+  ~PassTraceScope();
+
+  PassTraceScope(const PassTraceScope &) = delete;
+  PassTraceScope &operator=(const PassTraceScope &) = delete;
+
+  /** Whether anything is being recorded */
+  bool active() const { return active_; }
+
+  /** Add a detail to the event, if active */
+  void set_arg(const std::string &key, const nlohmann::json &value);
+
+ private:
+  // The unit, rather than its trace, since passes may replace the whole unit
+  // while the span is open.
+  const CompilationUnit &c_unit_;
+  bool active_;
+  bool is_pass_;
+  PassTraceEvent event_;
+
+  PassTrace &trace() const;
+};
+
+}  // namespace tket
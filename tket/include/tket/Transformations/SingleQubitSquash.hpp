@@ -18,6 +18,7 @@
 #include <optional>
 
 #include "tket/Circuit/Circuit.hpp"
+#include "tket/Circuit/DAGReachability.hpp"
 #include "tket/Gate/GatePtr.hpp"
 
 namespace tket {
@@ -139,19 +140,22 @@ class SingleQubitSquash {
   bool reversed_;
   bool always_squash_symbols_;
 
+  // Reachability in circ_, built on the first commutation check and kept up
+  // to date with our own edits until the end of the squash
+  std::unique_ptr<DAGReachability> reachability_;
+
+  // squash_between without discarding reachability_
+  bool squash_wire(const Edge &in, const Edge &out);
+
   // substitute chain by a sub circuit, handling conditions
   // and backing up + restoring current edge
   void substitute(
       const Circuit &sub, const VertexVec &single_chain, Edge &e,
       const Condition &condition);
 
-  // whether there is a path in the DAG to v from any vertex in vs (if
-  // reversed_ is true then paths are considered in the reverse direction)
-  bool path_exists(const Vertex &v, const VertexSet &vs) const;
-
   // whether we are allowed to commute a given conditional single-qubit gate
   // through the target of e without invalidating the DAG structure
-  bool commute_ok(const Edge &e, const Condition &condition) const;
+  bool commute_ok(const Edge &e, const Condition &condition);
 
   // insert a gate at the given edge, respecting condition
   void insert_left_over_gate(
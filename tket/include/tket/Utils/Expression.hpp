@@ -104,6 +104,18 @@ SymSet expr_free_symbols(const Expr& e);
 /** Set of all free symbols contained in the expressions in the vector */
 SymSet expr_free_symbols(const std::vector<Expr>& es);
 
+/**
+ * Evaluate an expression which is a plain real number
+ *
+ * This is much cheaper than @ref eval_expr, but only accepts SymEngine
+ * integers, rationals and real doubles: other expressions, even numeric ones
+ * such as pi/2, give std::nullopt.
+ *
+ * @param e expression to evaluate
+ * @return value of expression, iff it is a plain real number
+ */
+std::optional<double> eval_number(const Expr& e);
+
 std::optional<double> eval_expr(const Expr& e);
 
 std::optional<Complex> eval_expr_c(const Expr& e);
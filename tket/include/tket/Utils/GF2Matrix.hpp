@@ -0,0 +1,195 @@
+// Copyright Quantinuum
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <bit>
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "tket/Utils/MatrixAnalysis.hpp"
+
+namespace tket {
+
+/**
+ * Dense matrix over GF(2), packed 64 entries to a word.
+ *
+ * Rows are stored contiguously, each padded to a whole number of words with
+ * the padding bits kept at zero, so that operations on whole rows (XOR,
+ * popcount, comparison) can work a word at a time.
+ *
+ * Element access follows Eigen: `m(r, c)` reads an entry, and on a non-const
+ * matrix returns a proxy that can be assigned to.
+ */
+class GF2Matrix {
+ public:
+  typedef std::uint64_t word_t;
+  static constexpr unsigned word_bits = 64;
+
+  /** Assignable reference to a single entry */
+  class reference {
+   public:
+    operator bool() const { return (*word_ & mask_) != 0; }
+    reference &operator=(bool b) {
+      if (b) {
+        *word_ |= mask_;
+      } else {
+        *word_ &= ~mask_;
+      }
+      return *this;
+    }
+    reference &operator=(const reference &other) {
+      return *this = static_cast<bool>(other);
+    }
+    reference &operator^=(bool b) {
+      if (b) *word_ ^= mask_;
+      return *this;
+    }
+
+   private:
+    friend class GF2Matrix;
+    reference(word_t *word, word_t mask) : word_(word), mask_(mask) {}
+    word_t *word_;
+    word_t mask_;
+  };
+
+  /** Empty matrix */
+  GF2Matrix() : GF2Matrix(0, 0) {}
+
+  /** Zero matrix of the given size */
+  GF2Matrix(unsigned rows, unsigned cols);
+
+  /** Copy of a byte-per-entry matrix */
+  explicit GF2Matrix(const MatrixXb &m);
+
+  static GF2Matrix identity(unsigned n);
+
+  unsigned rows() const { return rows_; }
+  unsigned cols() const { return cols_; }
+
+  /** Number of words used to store each row */
+  unsigned row_words() const { return row_words_; }
+
+  bool operator()(unsigned r, unsigned c) const {
+    return (data_[r * row_words_ + c / word_bits] >> (c % word_bits)) & 1;
+  }
+  reference operator()(unsigned r, unsigned c) {
+    return reference(
+        &data_[r * row_words_ + c / word_bits], word_t{1} << (c % word_bits));
+  }
+
+  /** Words of row `r`; bit `c % 64` of word `c / 64` is column `c` */
+  const word_t *row_data(unsigned r) const {
+    return data_.data() + r * row_words_;
+  }
+  word_t *row_data(unsigned r) { return data_.data() + r * row_words_; }
+
+  /** Add row `src` to row `dst` */
+  void row_xor(unsigned src, unsigned dst) {
+    const word_t *s = row_data(src);
+    word_t *d = row_data(dst);
+    for (unsigned w = 0; w < row_words_; ++w) d[w] ^= s[w];
+  }
+
+  /** Number of set entries in row `r` */
+  unsigned row_count(unsigned r) const {
+    const word_t *p = row_data(r);
+    unsigned n = 0;
+    for (unsigned w = 0; w < row_words_; ++w) n += std::popcount(p[w]);
+    return n;
+  }
+
+  bool row_is_zero(unsigned r) const;
+  bool is_zero() const;
+
+  void swap_rows(unsigned r1, unsigned r2);
+  void copy_row(unsigned from, unsigned to);
+  void copy_col(unsigned from, unsigned to);
+
+  /**
+   * Resize, keeping the entries that remain in range and setting any new
+   * entries to zero.
+   */
+  void conservative_resize(unsigned rows, unsigned cols);
+
+  MatrixXb to_MatrixXb() const;
+
+  /**
+   * Reduce to reduced row echelon form in place, by the method of Patel,
+   * Markov and Hayes ("Optimal Synthesis of Linear Reversible Circuits",
+   * 2008): duplicate chunks of `blocksize` columns are cancelled before each
+   * chunk is eliminated, which gives fewer row operations than plain
+   * Gaussian elimination.
+   *
+   * @param blocksize width of the chunks, between 1 and 64
+   * @return the row operations performed, in order: (i, j) adds row i to
+   *              row j
+   */
+  std::vector<std::pair<unsigned, unsigned>> gaussian_elimination_row_ops(
+      unsigned blocksize = 6);
+
+  /**
+   * Reduce to reduced row echelon form in place, with the method of four
+   * Russians ("M4RI"): columns are eliminated eight at a time, using a table
+   * of all sums of the pivot rows for those columns, so that clearing them
+   * from another row takes a single row addition.
+   *
+   * Pivots are only chosen among the first `n_pivot_cols` columns; the same
+   * row operations are applied to the remaining columns, so that they can
+   * hold right-hand sides.
+   *
+   * @return the pivot column of each of the first rank rows, in increasing
+   *              order; the remaining rows are zero in the pivot columns
+   */
+  std::vector<unsigned> row_echelon_reduce(unsigned n_pivot_cols);
+  std::vector<unsigned> row_echelon_reduce() {
+    return row_echelon_reduce(cols_);
+  }
+
+  unsigned rank() const;
+
+  /**
+   * Solve the system AX = B, where A is this matrix.
+   *
+   * Where there are several solutions, the free variables are set to zero.
+   *
+   * @param b the right-hand sides, one per column
+   * @return a solution X, or std::nullopt if any column of B is not in the
+   *              column space of A
+   */
+  std::optional<GF2Matrix> solve(const GF2Matrix &b) const;
+
+  bool operator==(const GF2Matrix &other) const {
+    return rows_ == other.rows_ && cols_ == other.cols_ &&
+           data_ == other.data_;
+  }
+  bool operator!=(const GF2Matrix &other) const { return !(*this == other); }
+
+ private:
+  unsigned rows_;
+  unsigned cols_;
+  unsigned row_words_;
+  std::vector<word_t> data_;
+
+  // Entries [c, c + n) of row r as the low bits of a word, for n <= 64.
+  word_t bits(unsigned r, unsigned c, unsigned n) const;
+
+  // Elimination shared by row_echelon_reduce and rank: if `full` is false,
+  // only rows below each pivot are cleared.
+  std::vector<unsigned> m4ri_reduce(unsigned n_pivot_cols, bool full);
+};
+
+}  // namespace tket
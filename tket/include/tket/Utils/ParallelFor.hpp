@@ -0,0 +1,102 @@
+// Copyright Quantinuum
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace tket {
+
+/**
+ * Call `f(i)` for every `i` in `[0, n)`, spreading the calls over at most
+ * `n_threads` threads (including the calling thread).
+ *
+ * Indices are handed out in chunks of `chunk_size` from a shared counter, so
+ * threads that finish early keep taking work from the remaining range. The
+ * order in which indices are processed is unspecified; callers that need
+ * deterministic results should write into per-index slots and reduce
+ * serially afterwards.
+ *
+ * If any call throws, no further chunks are started and the first exception
+ * is rethrown on the calling thread once all threads have joined.
+ *
+ * Threads are created on each call and joined before it returns, which costs
+ * tens of microseconds per thread. When each call of `f` is cheap, pass
+ * `min_per_thread` so that small ranges use fewer threads or run serially.
+ *
+ * @param n number of indices
+ * @param n_threads maximum number of threads; 0 or 1 runs serially
+ * @param f callable taking a std::size_t index
+ * @param chunk_size number of consecutive indices taken at a time
+ * @param min_per_thread minimum number of indices per thread
+ */
+template <typename F>
+void parallel_for(
+    std::size_t n, unsigned n_threads, F&& f, std::size_t chunk_size = 1,
+    std::size_t min_per_thread = 1) {
+  chunk_size = std::max<std::size_t>(chunk_size, 1);
+  const std::size_t n_chunks = (n + chunk_size - 1) / chunk_size;
+  const std::size_t n_workers = std::min<std::size_t>(
+      {std::max(n_threads, 1u), n_chunks,
+       n / std::max<std::size_t>(min_per_thread, 1)});
+  if (n_workers <= 1) {
+    for (std::size_t i = 0; i < n; ++i) {
+      f(i);
+    }
+    return;
+  }
+
+  std::atomic<std::size_t> next_chunk{0};
+  std::atomic<bool> failed{false};
+  std::exception_ptr first_exception;
+  std::mutex exception_mutex;
+  auto work = [&]() {
+    try {
+      for (std::size_t c = next_chunk++; c < n_chunks && !failed;
+           c = next_chunk++) {
+        const std::size_t end = std::min(n, (c + 1) * chunk_size);
+        for (std::size_t i = c * chunk_size; i < end; ++i) {
+          f(i);
+        }
+      }
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(exception_mutex);
+      if (!first_exception) {
+        first_exception = std::current_exception();
+      }
+      failed = true;
+    }
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve(n_workers - 1);
+  for (std::size_t t = 1; t < n_workers; ++t) {
+    threads.emplace_back(work);
+  }
+  work();
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  if (first_exception) {
+    std::rethrow_exception(first_exception);
+  }
+}
+
+}  // namespace tket
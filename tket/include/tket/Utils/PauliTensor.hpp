@@ -14,6 +14,9 @@
 
 #pragma once
 
+#include <cstdint>
+#include <vector>
+
 #include "tket/Utils/Constants.hpp"
 #include "tket/Utils/EigenConfig.hpp"
 #include "tket/Utils/Expression.hpp"
@@ -260,12 +263,78 @@ typedef std::map<Qubit, Pauli> QubitPauliMap;
  * padded at the end. Each qubit index is treated as the corresponding Qubit id
  * from the default register.
  *
- * In future work, it may be interesting to consider
- * a symplectic representation (representing each Pauli by a pair of bits
- * representing X and Z) for both speed and memory efficiency.
+ * See SymplecticPauliMap for a bit-packed alternative.
  */
 typedef std::vector<Pauli> DensePauliMap;
 
+/**
+ * A dense, unsigned-indexed Pauli container storing each Pauli as a pair of
+ * bits (X and Z components), packed 64 qubits to a word.
+ *
+ * Indexing follows DensePauliMap, and likewise any Pauli::Is padded at the end
+ * are ignored. Commutation, multiplication, comparison and hashing work on
+ * whole words, so are much faster than for DensePauliMap on long strings.
+ */
+class SymplecticPauliMap {
+ public:
+  typedef std::uint64_t word_t;
+  static constexpr unsigned word_bits = 64;
+
+  /** The empty string */
+  SymplecticPauliMap() : n_qubits_(0) {}
+
+  /** The identity on \p n_qubits qubits */
+  explicit SymplecticPauliMap(unsigned n_qubits);
+
+  /** Packed copy of a DensePauliMap */
+  explicit SymplecticPauliMap(const DensePauliMap &paulis);
+
+  /**
+   * Construct directly from X and Z components, in the layout of x_words()
+   * and z_words(). Each must hold exactly enough words for \p n_qubits.
+   */
+  SymplecticPauliMap(
+      unsigned n_qubits, std::vector<word_t> x, std::vector<word_t> z);
+
+  /** Number of qubits, including any trailing Pauli::Is */
+  unsigned size() const { return n_qubits_; }
+
+  /**
+   * Change the number of qubits, padding with Pauli::I or discarding the last
+   * qubits.
+   */
+  void resize(unsigned n_qubits);
+
+  /** Pauli on qubit \p qb, or Pauli::I if \p qb >= size() */
+  Pauli get(unsigned qb) const {
+    if (qb >= n_qubits_) return Pauli::I;
+    const unsigned w = qb / word_bits, b = qb % word_bits;
+    return pauli_from_bits((x_[w] >> b) & 1, (z_[w] >> b) & 1);
+  }
+
+  /** Set the Pauli on qubit \p qb, extending the string if needed */
+  void set(unsigned qb, Pauli p);
+
+  /**
+   * X and Z components, where bit `i % 64` of word `i / 64` refers to qubit
+   * `i`. Bits beyond size() are always zero.
+   */
+  const std::vector<word_t> &x_words() const { return x_; }
+  const std::vector<word_t> &z_words() const { return z_; }
+
+  static Pauli pauli_from_bits(bool x, bool z) {
+    return x ? (z ? Pauli::Y : Pauli::X) : (z ? Pauli::Z : Pauli::I);
+  }
+
+ private:
+  unsigned n_qubits_;
+  std::vector<word_t> x_;
+  std::vector<word_t> z_;
+};
+
+void to_json(nlohmann::json &j, const SymplecticPauliMap &paulis);
+void from_json(const nlohmann::json &j, SymplecticPauliMap &paulis);
+
 /**
  * Cast between two different Pauli container types.
  *
@@ -288,6 +357,21 @@ DensePauliMap cast_container<QubitPauliMap, DensePauliMap>(
 template <>
 DensePauliMap cast_container<DensePauliMap, DensePauliMap>(
     const DensePauliMap &cont);
+template <>
+SymplecticPauliMap cast_container<SymplecticPauliMap, SymplecticPauliMap>(
+    const SymplecticPauliMap &cont);
+template <>
+SymplecticPauliMap cast_container<DensePauliMap, SymplecticPauliMap>(
+    const DensePauliMap &cont);
+template <>
+DensePauliMap cast_container<SymplecticPauliMap, DensePauliMap>(
+    const SymplecticPauliMap &cont);
+template <>
+SymplecticPauliMap cast_container<QubitPauliMap, SymplecticPauliMap>(
+    const QubitPauliMap &cont);
+template <>
+QubitPauliMap cast_container<SymplecticPauliMap, QubitPauliMap>(
+    const SymplecticPauliMap &cont);
 
 /**
  * Compare two Pauli containers of the same type for ordering.
@@ -310,6 +394,9 @@ int compare_containers<QubitPauliMap>(
 template <>
 int compare_containers<DensePauliMap>(
     const DensePauliMap &first, const DensePauliMap &second);
+template <>
+int compare_containers<SymplecticPauliMap>(
+    const SymplecticPauliMap &first, const SymplecticPauliMap &second);
 
 /**
  * Find the set of Qubits on which \p first and \p second have the same
@@ -324,6 +411,8 @@ std::set<Qubit> common_qubits(
  */
 std::set<unsigned> common_indices(
     const DensePauliMap &first, const DensePauliMap &second);
+std::set<unsigned> common_indices(
+    const SymplecticPauliMap &first, const SymplecticPauliMap &second);
 
 /**
  * Find the set of Qubits on which \p first has a non-trivial Pauli (X, Y, Z)
@@ -339,6 +428,8 @@ std::set<Qubit> own_qubits(
  */
 std::set<unsigned> own_indices(
     const DensePauliMap &first, const DensePauliMap &second);
+std::set<unsigned> own_indices(
+    const SymplecticPauliMap &first, const SymplecticPauliMap &second);
 
 /**
  * Find the set of Qubits on which \p first and \p second have distinct
@@ -353,6 +444,8 @@ std::set<Qubit> conflicting_qubits(
  */
 std::set<unsigned> conflicting_indices(
     const DensePauliMap &first, const DensePauliMap &second);
+std::set<unsigned> conflicting_indices(
+    const SymplecticPauliMap &first, const SymplecticPauliMap &second);
 
 /**
  * Return whether two Pauli containers commute as Pauli strings (there are an
@@ -367,6 +460,9 @@ bool commuting_containers<QubitPauliMap>(
 template <>
 bool commuting_containers<DensePauliMap>(
     const DensePauliMap &first, const DensePauliMap &second);
+template <>
+bool commuting_containers<SymplecticPauliMap>(
+    const SymplecticPauliMap &first, const SymplecticPauliMap &second);
 
 /**
  * Generates the readable Pauli string portion of PauliTensor::to_str().
@@ -380,6 +476,9 @@ template <>
 void print_paulis<QubitPauliMap>(std::ostream &os, const QubitPauliMap &paulis);
 template <>
 void print_paulis<DensePauliMap>(std::ostream &os, const DensePauliMap &paulis);
+template <>
+void print_paulis<SymplecticPauliMap>(
+    std::ostream &os, const SymplecticPauliMap &paulis);
 
 /**
  * Hash a Pauli container, combining it with an existing hash of another
@@ -394,6 +493,9 @@ void hash_combine_paulis<QubitPauliMap>(
 template <>
 void hash_combine_paulis<DensePauliMap>(
     std::size_t &seed, const DensePauliMap &paulis);
+template <>
+void hash_combine_paulis<SymplecticPauliMap>(
+    std::size_t &seed, const SymplecticPauliMap &paulis);
 
 /**
  * Return the number of Pauli::Ys in the container. Used for
@@ -405,6 +507,8 @@ template <>
 unsigned n_ys<QubitPauliMap>(const QubitPauliMap &paulis);
 template <>
 unsigned n_ys<DensePauliMap>(const DensePauliMap &paulis);
+template <>
+unsigned n_ys<SymplecticPauliMap>(const SymplecticPauliMap &paulis);
 
 /**
  * Returns a const reference to a lookup table for multiplying individual
@@ -432,6 +536,10 @@ std::pair<quarter_turns_t, QubitPauliMap> multiply_strings<QubitPauliMap>(
 template <>
 std::pair<quarter_turns_t, DensePauliMap> multiply_strings<DensePauliMap>(
     const DensePauliMap &first, const DensePauliMap &second);
+template <>
+std::pair<quarter_turns_t, SymplecticPauliMap>
+multiply_strings<SymplecticPauliMap>(
+    const SymplecticPauliMap &first, const SymplecticPauliMap &second);
 
 /**
  * Evaluates a Pauli container to a sparse matrix describing the tensor product
@@ -455,6 +563,9 @@ template <>
 CmplxSpMat to_sparse_matrix<QubitPauliMap>(const QubitPauliMap &paulis);
 template <>
 CmplxSpMat to_sparse_matrix<DensePauliMap>(const DensePauliMap &paulis);
+template <>
+CmplxSpMat to_sparse_matrix<SymplecticPauliMap>(
+    const SymplecticPauliMap &paulis);
 
 /**
  * Evaluates a Pauli container to a sparse matrix describing the tensor product
@@ -478,6 +589,9 @@ CmplxSpMat to_sparse_matrix<QubitPauliMap>(
 template <>
 CmplxSpMat to_sparse_matrix<DensePauliMap>(
     const DensePauliMap &paulis, unsigned n_qubits);
+template <>
+CmplxSpMat to_sparse_matrix<SymplecticPauliMap>(
+    const SymplecticPauliMap &paulis, unsigned n_qubits);
 
 /**
  * Evaluates a Pauli container to a sparse matrix describing the tensor product
@@ -499,6 +613,26 @@ CmplxSpMat to_sparse_matrix<QubitPauliMap>(
 template <>
 CmplxSpMat to_sparse_matrix<DensePauliMap>(
     const DensePauliMap &paulis, const qubit_vector_t &qubits);
+template <>
+CmplxSpMat to_sparse_matrix<SymplecticPauliMap>(
+    const SymplecticPauliMap &paulis, const qubit_vector_t &qubits);
+
+/**
+ * Determines the expectation value <state|P|state> of the tensor product P of
+ * the Paulis in the container, without building its matrix: P maps each basis
+ * state to the basis state with the bits flipped on the qubits with X or Y,
+ * and a phase given by the parity of the bits on the qubits with Y or Z.
+ *
+ * \p qubits dictates the order of Qubits in the state, assuming a Big Endian
+ * format. An exception is thrown if the size of the state does not match up
+ * with the number of Qubits given, or if the container contains a Qubit not
+ * in \p qubits.
+ *
+ * The result does not depend on \p n_threads.
+ */
+Complex pauli_state_expectation(
+    const QubitPauliMap &paulis, const Eigen::VectorXcd &state,
+    const qubit_vector_t &qubits, unsigned n_threads = 1);
 
 /*******************************************************************************
  * PauliTensor TEMPLATE CLASS
@@ -511,7 +645,8 @@ CmplxSpMat to_sparse_matrix<DensePauliMap>(
  * global scalar coefficient. It is parameterised in two ways:
  * - PauliContainer describes the data structure used to map qubits to Paulis.
  * This may be sparse or dense, and indexed by arbitrary Qubits or unsigneds
- * (referring to indices in the default register).
+ * (referring to indices in the default register). Dense strings may also be
+ * bit-packed (SymplecticPauliMap).
  * - CoeffType describes the kind of coefficient stored, ranging from no data to
  * restricted values, to symbolic expressions.
  *
@@ -522,7 +657,8 @@ template <typename PauliContainer, typename CoeffType>
 class PauliTensor {
   static_assert(
       std::is_same<PauliContainer, QubitPauliMap>::value ||
-          std::is_same<PauliContainer, DensePauliMap>::value,
+          std::is_same<PauliContainer, DensePauliMap>::value ||
+          std::is_same<PauliContainer, SymplecticPauliMap>::value,
       "PauliTensor must be either dense or qubit-indexed.");
   static_assert(
       std::is_same<CoeffType, no_coeff_t>::value ||
@@ -562,15 +698,14 @@ class PauliTensor {
 
   /**
    * Convenience constructor to immediately cast a dense Pauli string on the
-   * default register to a sparse representation.
+   * default register to a sparse or bit-packed representation.
    */
   template <typename PC = PauliContainer>
   PauliTensor(
       const DensePauliMap &_string, const CoeffType &_coeff = default_coeff,
-      typename std::enable_if<std::is_same<PC, QubitPauliMap>::value>::type * =
+      typename std::enable_if<!std::is_same<PC, DensePauliMap>::value>::type * =
           0)
-      : string(cast_container<DensePauliMap, QubitPauliMap>(_string)),
-        coeff(_coeff) {}
+      : string(cast_container<DensePauliMap, PC>(_string)), coeff(_coeff) {}
 
   /**
    * Constructor for sparse representations which zips together an ordered list
@@ -721,7 +856,7 @@ class PauliTensor {
    */
   template <typename OtherCoeffType, typename PC = PauliContainer>
   typename std::enable_if<
-      std::is_same<PC, DensePauliMap>::value, std::set<unsigned>>::type
+      !std::is_same<PC, QubitPauliMap>::value, std::set<unsigned>>::type
   common_indices(
       const PauliTensor<PauliContainer, OtherCoeffType> &other) const {
     return tket::common_indices(string, other.string);
@@ -734,7 +869,7 @@ class PauliTensor {
    */
   template <typename OtherCoeffType, typename PC = PauliContainer>
   typename std::enable_if<
-      std::is_same<PC, DensePauliMap>::value, std::set<unsigned>>::type
+      !std::is_same<PC, QubitPauliMap>::value, std::set<unsigned>>::type
   own_indices(const PauliTensor<PauliContainer, OtherCoeffType> &other) const {
     return tket::own_indices(string, other.string);
   }
@@ -745,7 +880,7 @@ class PauliTensor {
    */
   template <typename OtherCoeffType, typename PC = PauliContainer>
   typename std::enable_if<
-      std::is_same<PC, DensePauliMap>::value, std::set<unsigned>>::type
+      !std::is_same<PC, QubitPauliMap>::value, std::set<unsigned>>::type
   conflicting_indices(
       const PauliTensor<PauliContainer, OtherCoeffType> &other) const {
     return tket::conflicting_indices(string, other.string);
@@ -773,6 +908,12 @@ class PauliTensor {
     else
       return string.at(qb);
   }
+  template <typename PC = PauliContainer>
+  typename std::enable_if<
+      std::is_same<PC, SymplecticPauliMap>::value, Pauli>::type
+  get(unsigned qb) const {
+    return string.get(qb);
+  }
 
   /**
    * Sets the Pauli at the given index within the string.
@@ -796,6 +937,11 @@ class PauliTensor {
     if (qb >= string.size()) string.resize(qb + 1, Pauli::I);
     string.at(qb) = p;
   }
+  template <typename PC = PauliContainer>
+  typename std::enable_if<std::is_same<PC, SymplecticPauliMap>::value>::type
+  set(unsigned qb, Pauli p) {
+    string.set(qb, p);
+  }
 
   /**
    * Asserts coefficient is real, and returns whether it is negative.
@@ -992,17 +1138,23 @@ class PauliTensor {
 
   /**
    * Determines the expectation value of a given statevector with respect to the
-   * PauliTensor by matrix multiplication.
+   * PauliTensor, using pauli_state_expectation.
    *
    * Determines the number of qubits from the size of the statevector, and
    * assumes default register qubits in ILO-BE format.
    */
   Complex state_expectation(const Eigen::VectorXcd &state) const {
-    return state.dot(dot_state(state));
+    // allowing room for big states
+    unsigned long long n = state.size();
+    if (!(n && (!(n & (n - 1)))))
+      throw std::logic_error("Statevector size is not a power of two.");
+    qubit_vector_t qubits;
+    for (n >>= 1; n; n >>= 1) qubits.push_back(Qubit(qubits.size()));
+    return state_expectation(state, qubits);
   }
   /**
    * Determines the expectation value of a given statevector with respect to the
-   * PauliTensor by matrix multiplication.
+   * PauliTensor, using pauli_state_expectation.
    *
    * \p qubits dictates the order of Qubits in the state, assuming a Big Endian
    * format. An exception is thrown if the size of the state does not match up
@@ -1010,7 +1162,10 @@ class PauliTensor {
    */
   Complex state_expectation(
       const Eigen::VectorXcd &state, const qubit_vector_t &qubits) const {
-    return state.dot(dot_state(state, qubits));
+    return cast_coeff<CoeffType, Complex>(coeff) *
+           pauli_state_expectation(
+               cast_container<PauliContainer, QubitPauliMap>(string), state,
+               qubits);
   }
 };
 
@@ -1046,6 +1201,12 @@ typedef PauliTensor<DensePauliMap, Complex> CxPauliTensor;
 typedef PauliTensor<QubitPauliMap, Expr> SpSymPauliTensor;
 typedef PauliTensor<DensePauliMap, Expr> SymPauliTensor;
 
+typedef PauliTensor<SymplecticPauliMap, no_coeff_t> SymplecticPauliString;
+typedef PauliTensor<SymplecticPauliMap, quarter_turns_t>
+    SymplecticPauliStabiliser;
+typedef PauliTensor<SymplecticPauliMap, Complex> SymplecticCxPauliTensor;
+typedef PauliTensor<SymplecticPauliMap, Expr> SymplecticSymPauliTensor;
+
 typedef std::vector<PauliStabiliser> PauliStabiliserVec;
 
 }  // namespace tket
@@ -0,0 +1,330 @@
+// Copyright Quantinuum
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+
+#include "tket/Utils/GraphHeaders.hpp"
+
+namespace tket {
+
+namespace pool_detail {
+
+struct FreeBlock {
+  FreeBlock* next;
+};
+
+constexpr std::size_t round_up(std::size_t n, std::size_t m) {
+  return ((n + m - 1) / m) * m;
+}
+
+/**
+ * Process-wide store of fixed-size blocks.
+ *
+ * Blocks are carved out of large contiguous chunks and handed to per-thread
+ * caches in batches, so a block allocated on one thread may safely be freed
+ * on another, or after the allocating thread has exited.
+ *
+ * Every PoolAllocator whose blocks come from this pool holds a lease on it.
+ * When the last lease is dropped no block can still be in use, so all chunks
+ * are returned to the system and the generation is bumped; blocks that
+ * thread caches still hold from an earlier generation are then discarded
+ * rather than reused.
+ */
+template <std::size_t BlockSize, std::size_t BlockAlign>
+class BlockPool {
+ public:
+  static constexpr std::size_t chunk_bytes = 1 << 16;
+  static constexpr std::size_t blocks_per_chunk =
+      chunk_bytes / BlockSize > 0 ? chunk_bytes / BlockSize : 1;
+
+  static BlockPool& get() {
+    // Deliberately leaked, so that blocks may still be freed during static
+    // destruction.
+    static BlockPool* pool = new BlockPool();
+    return *pool;
+  }
+
+  /** Take a lease on the pool. */
+  void acquire() {
+    // Only the transitions to and from zero need the lock.
+    std::size_t n = leases_.load(std::memory_order_relaxed);
+    while (n > 0) {
+      if (leases_.compare_exchange_weak(n, n + 1, std::memory_order_relaxed))
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    leases_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  /** Drop a lease, freeing all chunks if it was the last one. */
+  void release() noexcept {
+    std::size_t n = leases_.load(std::memory_order_relaxed);
+    while (n > 1) {
+      if (leases_.compare_exchange_weak(n, n - 1, std::memory_order_release))
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (leases_.fetch_sub(1, std::memory_order_acq_rel) == 1) free_chunks();
+  }
+
+  std::size_t generation() const noexcept {
+    return generation_.load(std::memory_order_acquire);
+  }
+
+  /** Number of chunks currently held. */
+  std::size_t n_chunks() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return chunks_.size();
+  }
+
+  /** Take a list of `n` blocks, terminated by nullptr. */
+  FreeBlock* take(std::size_t n) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    FreeBlock* head = nullptr;
+    for (std::size_t i = 0; i < n; ++i) {
+      if (free_ == nullptr) add_chunk();
+      FreeBlock* b = free_;
+      free_ = b->next;
+      b->next = head;
+      head = b;
+    }
+    return head;
+  }
+
+  /**
+   * Return the list of blocks from `head` to `tail` inclusive (or to the
+   * end of the list if `tail` is null), taken in generation `gen`. Blocks
+   * from an earlier generation are dropped without being read.
+   */
+  void give(FreeBlock* head, FreeBlock* tail, std::size_t gen) noexcept {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (gen != generation_.load(std::memory_order_relaxed)) return;
+    if (tail == nullptr) {
+      tail = head;
+      while (tail->next != nullptr) tail = tail->next;
+    }
+    tail->next = free_;
+    free_ = head;
+  }
+
+ private:
+  BlockPool() = default;
+
+  void add_chunk() {
+    chunks_.reserve(chunks_.size() + 1);
+    char* chunk = static_cast<char*>(::operator new(
+        blocks_per_chunk * BlockSize, std::align_val_t(BlockAlign)));
+    chunks_.push_back(chunk);
+    // Link in address order, so that fresh allocations are contiguous.
+    for (std::size_t i = blocks_per_chunk; i-- > 0;) {
+      FreeBlock* b = reinterpret_cast<FreeBlock*>(chunk + i * BlockSize);
+      b->next = free_;
+      free_ = b;
+    }
+  }
+
+  void free_chunks() noexcept {
+    for (char* chunk : chunks_) {
+      ::operator delete(chunk, std::align_val_t(BlockAlign));
+    }
+    chunks_.clear();
+    chunks_.shrink_to_fit();
+    free_ = nullptr;
+    generation_.fetch_add(1, std::memory_order_release);
+  }
+
+  std::mutex mutex_;
+  FreeBlock* free_ = nullptr;
+  std::vector<char*> chunks_;
+  std::atomic<std::size_t> leases_{0};
+  std::atomic<std::size_t> generation_{0};
+};
+
+/**
+ * Per-thread free list in front of a BlockPool, so that the common case of
+ * allocating and freeing on one thread takes no lock.
+ */
+template <std::size_t BlockSize, std::size_t BlockAlign>
+class BlockCache {
+ public:
+  static constexpr std::size_t batch = 256;
+  using Pool = BlockPool<BlockSize, BlockAlign>;
+
+  static void* allocate() {
+    if (destroyed_) {
+      FreeBlock* b = Pool::get().take(1);
+      return b;
+    }
+    return local().pop();
+  }
+
+  static void deallocate(void* p) noexcept {
+    FreeBlock* b = static_cast<FreeBlock*>(p);
+    if (destroyed_) {
+      Pool& pool = Pool::get();
+      pool.give(b, b, pool.generation());
+      return;
+    }
+    local().push(b);
+  }
+
+  ~BlockCache() {
+    if (head_ != nullptr) Pool::get().give(head_, nullptr, gen_);
+    destroyed_ = true;
+  }
+
+ private:
+  static BlockCache& local() {
+    thread_local BlockCache cache;
+    return cache;
+  }
+
+  // Forget any blocks left over from chunks the pool has since freed.
+  void drop_stale() noexcept {
+    std::size_t gen = Pool::get().generation();
+    if (gen != gen_) {
+      head_ = nullptr;
+      count_ = 0;
+      gen_ = gen;
+    }
+  }
+
+  void* pop() {
+    drop_stale();
+    if (head_ == nullptr) {
+      head_ = Pool::get().take(batch);
+      count_ = batch;
+    }
+    FreeBlock* b = head_;
+    head_ = b->next;
+    --count_;
+    return b;
+  }
+
+  void push(FreeBlock* b) noexcept {
+    drop_stale();
+    b->next = head_;
+    head_ = b;
+    if (++count_ >= 2 * batch) {
+      // Hand half back, so that memory freed on this thread can be reused
+      // by others.
+      FreeBlock* tail = head_;
+      for (std::size_t i = 1; i < batch; ++i) tail = tail->next;
+      FreeBlock* rest = tail->next;
+      Pool::get().give(head_, tail, gen_);
+      head_ = rest;
+      count_ -= batch;
+    }
+  }
+
+  FreeBlock* head_ = nullptr;
+  std::size_t count_ = 0;
+  std::size_t gen_ = 0;
+
+  // Trivially destructible, so it remains valid after the cache itself has
+  // been destroyed at thread exit.
+  static inline thread_local bool destroyed_ = false;
+};
+
+}  // namespace pool_detail
+
+/**
+ * Allocator that serves single-object allocations from pooled, contiguous
+ * chunks of same-sized blocks.
+ *
+ * Intended for node-based containers such as std::list, where it removes
+ * most of the per-node cost of the general-purpose heap and keeps nodes
+ * created together close together in memory. Array allocations go to
+ * std::allocator. All instances compare equal, so containers may exchange
+ * nodes freely.
+ *
+ * Each instance holds a lease on the pool for its block size, and the pool
+ * returns its chunks to the system once the last lease is dropped. Memory
+ * freed while other allocators for the same block size are alive is only
+ * recycled, so a long-lived container (for instance a static one) keeps its
+ * pool's chunks for the life of the process.
+ */
+template <typename T>
+class PoolAllocator {
+ public:
+  typedef T value_type;
+
+  PoolAllocator() { Cache::Pool::get().acquire(); }
+  PoolAllocator(const PoolAllocator&) : PoolAllocator() {}
+  template <typename U>
+  PoolAllocator(const PoolAllocator<U>&) : PoolAllocator() {}
+  PoolAllocator& operator=(const PoolAllocator&) noexcept { return *this; }
+  ~PoolAllocator() { Cache::Pool::get().release(); }
+
+  T* allocate(std::size_t n) {
+    if (n != 1) return std::allocator<T>().allocate(n);
+    return static_cast<T*>(Cache::allocate());
+  }
+
+  void deallocate(T* p, std::size_t n) noexcept {
+    if (n != 1) {
+      std::allocator<T>().deallocate(p, n);
+    } else {
+      Cache::deallocate(p);
+    }
+  }
+
+  friend bool operator==(const PoolAllocator&, const PoolAllocator&) noexcept {
+    return true;
+  }
+
+ private:
+  static constexpr std::size_t block_align =
+      alignof(T) > alignof(pool_detail::FreeBlock)
+          ? alignof(T)
+          : alignof(pool_detail::FreeBlock);
+  static constexpr std::size_t block_size = pool_detail::round_up(
+      sizeof(T) > sizeof(pool_detail::FreeBlock)
+          ? sizeof(T)
+          : sizeof(pool_detail::FreeBlock),
+      block_align);
+  typedef pool_detail::BlockCache<block_size, block_align> Cache;
+};
+
+/**
+ * Boost graph container selector for a std::list using PoolAllocator.
+ *
+ * Behaves exactly like boost::listS (stable descriptors and iterators under
+ * insertion and removal, parallel edges allowed) but with pooled storage.
+ */
+struct pooled_listS {};
+
+}  // namespace tket
+
+namespace boost {
+
+template <class ValueType>
+struct container_gen<tket::pooled_listS, ValueType> {
+  typedef std::list<ValueType, tket::PoolAllocator<ValueType>> type;
+};
+
+template <>
+struct parallel_edge_traits<tket::pooled_listS> {
+  typedef allow_parallel_edge_tag type;
+};
+
+}  // namespace boost
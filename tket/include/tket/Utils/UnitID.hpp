@@ -23,11 +23,14 @@
 #include <boost/functional/hash.hpp>
 #include <map>
 #include <memory>
+#include <initializer_list>
 #include <optional>
-#include <regex>
 #include <set>
+#include <span>
 #include <sstream>
 #include <string>
+#include <string_view>
+#include <vector>
 #include <tklog/TketLog.hpp>
 
 #include "Json.hpp"
@@ -65,78 +68,85 @@ class InvalidUnitConversion : public std::logic_error {
  *
  * Each location has a name (signifying the 'register' to which it belongs) and
  * an index within that register (which may be multi-dimensional).
+ *
+ * Names and indices are interned in global tables, so a UnitID is a pair of
+ * pointers to immutable shared data plus its type. Equality and hashing do
+ * not look at the strings, and constructing a unit only allocates the first
+ * time its name or index is seen.
  */
 class UnitID {
  public:
-  UnitID() : data_(std::make_shared<UnitData>()) {}
+  UnitID() : UnitID("", {}, UnitType::Qubit) {}
 
   /** String representation including name and index */
   std::string repr() const;
 
   /** Register name */
-  std::string reg_name() const { return data_->name_; }
+  const std::string &reg_name() const { return name_->str_; }
 
   /** Index dimension */
-  unsigned reg_dim() const { return data_->index_.size(); }
+  unsigned reg_dim() const { return index_->value_.size(); }
 
   /** Index */
-  std::vector<unsigned> index() const { return data_->index_; }
+  const std::vector<unsigned> &index() const { return index_->value_; }
 
   /** Unit type */
-  UnitType type() const { return data_->type_; }
+  UnitType type() const { return type_; }
 
   /** Register dimension and type */
   register_info_t reg_info() const { return {type(), reg_dim()}; }
 
   bool operator<(const UnitID &other) const {
-    int n = data_->name_.compare(other.data_->name_);
-    if (n > 0) return false;
-    if (n < 0) return true;
-    return data_->index_ < other.data_->index_;
+    if (name_ != other.name_) return name_->str_ < other.name_->str_;
+    return index_ != other.index_ && index_->value_ < other.index_->value_;
   }
   bool operator>(const UnitID &other) const { return other < *this; }
   bool operator==(const UnitID &other) const {
-    return (this->data_->name_ == other.data_->name_) &&
-           (this->data_->index_ == other.data_->index_);
+    return name_ == other.name_ && index_ == other.index_;
   }
   bool operator!=(const UnitID &other) const { return !(*this == other); }
 
   friend std::size_t hash_value(UnitID const &unitid) {
     std::size_t seed = 0;
-    boost::hash_combine(seed, unitid.data_->name_);
-    boost::hash_combine(seed, unitid.data_->index_);
-    boost::hash_combine(seed, unitid.data_->type_);
+    boost::hash_combine(seed, unitid.name_->hash_);
+    boost::hash_combine(seed, unitid.index_->hash_);
+    boost::hash_combine(seed, unitid.type_);
     return seed;
   }
 
  protected:
   UnitID(
-      const std::string &name, const std::vector<unsigned> &index,
+      std::string_view name, std::span<const unsigned> index, UnitType type)
+      : name_(intern_name(name)), index_(intern_index(index)), type_(type) {}
+  UnitID(
+      std::string_view name, std::initializer_list<unsigned> index,
       UnitType type)
-      : data_(std::make_shared<UnitData>(name, index, type)) {}
+      : UnitID(
+            name, std::span<const unsigned>(index.begin(), index.size()),
+            type) {}
 
  private:
-  struct UnitData {
-    std::string name_;
-    std::vector<unsigned> index_;
-    UnitType type_;
-
-    UnitData() : name_(), index_(), type_(UnitType::Qubit) {}
-    UnitData(
-        const std::string &name, const std::vector<unsigned> &index,
-        UnitType type)
-        : name_(name), index_(index), type_(type) {
-      static const std::string id_regex_str = "[a-z][A-Za-z0-9_]*";
-      static const std::regex id_regex(id_regex_str);
-      if (!name.empty() && !std::regex_match(name, id_regex)) {
-        std::stringstream msg;
-        msg << "UnitID name '" << name << "' does not match '" << id_regex_str
-            << "', as required for QASM conversion.";
-        tket_log()->warn(msg.str());
-      }
-    }
+  struct InternedName {
+    std::string str_;
+    std::size_t hash_;
+  };
+  struct InternedIndex {
+    std::vector<unsigned> value_;
+    std::size_t hash_;
   };
-  std::shared_ptr<UnitData> data_;
+
+  /**
+   * The unique interned copy of a name, created (and checked against the
+   * naming rules for QASM) when first seen. Thread-safe.
+   */
+  static const InternedName *intern_name(std::string_view name);
+
+  /** The unique interned copy of an index. Thread-safe. */
+  static const InternedIndex *intern_index(std::span<const unsigned> index);
+
+  const InternedName *name_;
+  const InternedIndex *index_;
+  UnitType type_;
 };
 
 template <class Unit_T>
@@ -37,6 +37,11 @@
 
 namespace tket {
 
+std::recursive_mutex &Box::generation_mutex() {
+  static std::recursive_mutex mutex;
+  return mutex;
+}
+
 unsigned Box::n_qubits() const {
   op_signature_t sig = get_signature();
   return std::count(sig.begin(), sig.end(), EdgeType::Quantum);
@@ -0,0 +1,565 @@
+// Copyright Quantinuum
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Binary circuit format, version 1. All integers are unsigned LEB128 varints
+// unless stated otherwise.
+//
+//   magic "TKBC", version
+//   string table:    count, then (length, bytes) for each string
+//   unit table:      count, then (type byte, name string, dim, indices...)
+//   operation table: count, then (length, CBOR-encoded op JSON)
+//   name:            0, or 1 + string index
+//   phase:           parameter
+//   qubits, bits:    count, then unit indices
+//   number of WASM wires, number of RNG wires
+//   implicit permutation: count, then pairs of unit indices
+//   commands:        count, then for each:
+//                      2 * OpType for a gate, or 2 * op index + 1 otherwise
+//                      for a gate: parameter count, then parameters
+//                      argument count, then unit indices
+//                      opgroup: 0, or 1 + string index
+//   created qubits, discarded qubits: count, then unit indices
+//
+// A parameter is a tag byte followed by either 8 little-endian bytes of an
+// IEEE double (tag 0) or the string index of a SymEngine expression (tag 1).
+
+#include <boost/functional/hash.hpp>
+#include <boost/uuid/uuid_hash.hpp>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <new>
+#include <span>
+#include <symengine/real_double.h>
+#include <unordered_map>
+
+#include "tket/Circuit/Circuit.hpp"
+#include "tket/Gate/Gate.hpp"
+#include "tket/Gate/GatePtr.hpp"
+#include "tket/Gate/OpPtrFunctions.hpp"
+#include "tket/OpType/OpTypeFunctions.hpp"
+#include "tket/OpType/OpTypeInfo.hpp"
+#include "tket/Utils/Json.hpp"
+
+#if defined(_WIN32)
+#define TKET_BINARY_NO_MMAP
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace tket {
+
+namespace {
+
+constexpr char binary_magic[4] = {'T', 'K', 'B', 'C'};
+
+enum ParamTag : std::uint8_t { Double = 0, Symbolic = 1 };
+
+class BinaryWriter {
+ public:
+  std::string &out() { return out_; }
+
+  void varint(std::uint64_t v) {
+    while (v >= 0x80) {
+      out_.push_back(static_cast<char>((v & 0x7f) | 0x80));
+      v >>= 7;
+    }
+    out_.push_back(static_cast<char>(v));
+  }
+
+  void byte(std::uint8_t b) { out_.push_back(static_cast<char>(b)); }
+
+  void f64(double d) {
+    std::uint64_t bits;
+    std::memcpy(&bits, &d, sizeof bits);
+    for (unsigned i = 0; i < 8; ++i) {
+      byte(static_cast<std::uint8_t>(bits >> (8 * i)));
+    }
+  }
+
+  void bytes(std::string_view s) {
+    varint(s.size());
+    out_.append(s);
+  }
+
+ private:
+  std::string out_;
+};
+
+class BinaryReader {
+ public:
+  explicit BinaryReader(std::string_view data) : data_(data) {}
+
+  std::uint64_t varint() {
+    std::uint64_t v = 0;
+    for (unsigned shift = 0; shift < 64; shift += 7) {
+      const std::uint8_t b = byte();
+      v |= static_cast<std::uint64_t>(b & 0x7f) << shift;
+      if (!(b & 0x80)) return v;
+    }
+    throw BinaryFormatError("Malformed varint in binary circuit");
+  }
+
+  /** Read a varint that indexes a table of the given size. */
+  std::size_t index(std::size_t size) {
+    const std::uint64_t i = varint();
+    if (i >= size) {
+      throw BinaryFormatError("Index out of range in binary circuit");
+    }
+    return static_cast<std::size_t>(i);
+  }
+
+  /** Read a count of items, each taking at least one byte. */
+  std::size_t count() {
+    const std::uint64_t n = varint();
+    if (n > remaining()) {
+      throw BinaryFormatError("Truncated binary circuit");
+    }
+    return static_cast<std::size_t>(n);
+  }
+
+  std::uint8_t byte() {
+    require(1);
+    return static_cast<std::uint8_t>(data_[pos_++]);
+  }
+
+  double f64() {
+    require(8);
+    std::uint64_t bits = 0;
+    for (unsigned i = 0; i < 8; ++i) {
+      bits |= static_cast<std::uint64_t>(
+                  static_cast<std::uint8_t>(data_[pos_ + i]))
+              << (8 * i);
+    }
+    pos_ += 8;
+    double d;
+    std::memcpy(&d, &bits, sizeof d);
+    return d;
+  }
+
+  std::string_view bytes() {
+    const std::size_t n = count();
+    std::string_view s = data_.substr(pos_, n);
+    pos_ += n;
+    return s;
+  }
+
+  std::size_t remaining() const { return data_.size() - pos_; }
+
+ private:
+  void require(std::size_t n) const {
+    if (remaining() < n) {
+      throw BinaryFormatError("Truncated binary circuit");
+    }
+  }
+
+  std::string_view data_;
+  std::size_t pos_ = 0;
+};
+
+/** UnitID equality ignores the type, but the table must not. */
+struct SameUnit {
+  bool operator()(const UnitID &a, const UnitID &b) const {
+    return a == b && a.type() == b.type();
+  }
+};
+
+/** Interning tables and command encoding for \ref Circuit::to_binary. */
+class CircuitEncoder {
+ public:
+  std::string encode(const Circuit &circ) {
+    const std::optional<std::string> name = circ.get_name();
+    if (name) {
+      body_.varint(1 + string_index(*name));
+    } else {
+      body_.varint(0);
+    }
+    param(circ.get_phase());
+    units(circ.all_qubits());
+    units(circ.all_bits());
+    body_.varint(circ._number_of_wasm_wires);
+    body_.varint(circ._number_of_rng_wires);
+
+    const qubit_map_t perm = circ.implicit_qubit_permutation();
+    body_.varint(perm.size());
+    for (const auto &[in, out] : perm) {
+      body_.varint(unit_index(in));
+      body_.varint(unit_index(out));
+    }
+
+    BinaryWriter commands;
+    std::size_t n_commands = 0;
+    for (const CommandView &com : circ.command_views()) {
+      command(com, commands);
+      ++n_commands;
+    }
+    body_.varint(n_commands);
+    body_.out().append(commands.out());
+
+    units(circ.created_qubits());
+    units(circ.discarded_qubits());
+
+    BinaryWriter head;
+    head.out().append(binary_magic, sizeof binary_magic);
+    head.varint(Circuit::binary_format_version);
+    head.varint(strings_.size());
+    for (const std::string &s : strings_) head.bytes(s);
+    head.varint(unit_table_.size());
+    for (const UnitID &u : unit_table_) {
+      head.byte(static_cast<std::uint8_t>(u.type()));
+      head.varint(string_index(u.reg_name()));
+      const std::vector<unsigned> idx = u.index();
+      head.varint(idx.size());
+      for (unsigned i : idx) head.varint(i);
+    }
+    head.varint(op_table_.size());
+    for (const std::string &op : op_table_) head.bytes(op);
+    return std::move(head.out()) + body_.out();
+  }
+
+ private:
+  void command(const CommandView &com, BinaryWriter &out) {
+    const Op_ptr &op = com.get_op_ptr();
+    const std::span<const UnitID> args = com.get_args();
+    const Gate *gate = dynamic_cast<const Gate *>(op.get());
+    if (gate != nullptr) {
+      out.varint(2 * static_cast<std::uint64_t>(op->get_type()));
+      const std::vector<Expr> params = gate->get_params();
+      out.varint(params.size());
+      for (const Expr &e : params) param(e, out);
+    } else {
+      out.varint(2 * op_index(op) + 1);
+    }
+    out.varint(args.size());
+    for (const UnitID &u : args) out.varint(unit_index(u));
+    const std::optional<std::string> &opgroup = com.get_opgroup();
+    out.varint(opgroup ? 1 + string_index(*opgroup) : 0);
+  }
+
+  void param(const Expr &e) { param(e, body_); }
+
+  void param(const Expr &e, BinaryWriter &out) {
+    const ExprPtr ep = e;
+    if (SymEngine::is_a<SymEngine::RealDouble>(*ep)) {
+      out.byte(ParamTag::Double);
+      out.f64(
+          SymEngine::down_cast<const SymEngine::RealDouble &>(*ep).as_double());
+    } else {
+      out.byte(ParamTag::Symbolic);
+      out.varint(string_index(ep->__str__()));
+    }
+  }
+
+  template <class T>
+  void units(const std::vector<T> &us) {
+    body_.varint(us.size());
+    for (const UnitID &u : us) body_.varint(unit_index(u));
+  }
+
+  std::size_t string_index(const std::string &s) {
+    auto [it, inserted] = string_ids_.try_emplace(s, strings_.size());
+    if (inserted) strings_.push_back(s);
+    return it->second;
+  }
+
+  std::size_t unit_index(const UnitID &u) {
+    auto [it, inserted] = unit_ids_.try_emplace(u, unit_table_.size());
+    if (inserted) {
+      unit_table_.push_back(u);
+      // Intern now: the string table is written before the unit table.
+      string_index(u.reg_name());
+    }
+    return it->second;
+  }
+
+  std::size_t op_index(const Op_ptr &op) {
+    auto found = op_ids_.find(op.get());
+    if (found != op_ids_.end()) return found->second;
+    const Box *box = dynamic_cast<const Box *>(op.get());
+    if (box != nullptr) {
+      auto found_box = box_ids_.find(box->get_id());
+      if (found_box != box_ids_.end()) {
+        op_ids_.emplace(op.get(), found_box->second);
+        return found_box->second;
+      }
+    }
+    const std::size_t i = op_table_.size();
+    const std::vector<std::uint8_t> cbor =
+        nlohmann::json::to_cbor(nlohmann::json(op));
+    op_table_.emplace_back(cbor.begin(), cbor.end());
+    op_ids_.emplace(op.get(), i);
+    // Keep the op alive so that its address is not reused by another op.
+    ops_.push_back(op);
+    if (box != nullptr) box_ids_.emplace(box->get_id(), i);
+    return i;
+  }
+
+  BinaryWriter body_;
+  std::vector<std::string> strings_;
+  std::unordered_map<std::string, std::size_t> string_ids_;
+  std::vector<UnitID> unit_table_;
+  std::unordered_map<UnitID, std::size_t, boost::hash<UnitID>, SameUnit>
+      unit_ids_;
+  std::vector<std::string> op_table_;
+  std::vector<Op_ptr> ops_;
+  std::unordered_map<const Op *, std::size_t> op_ids_;
+  std::unordered_map<
+      boost::uuids::uuid, std::size_t, boost::hash<boost::uuids::uuid>>
+      box_ids_;
+};
+
+UnitID make_unit(
+    UnitType type, const std::string &name, const std::vector<unsigned> &idx) {
+  switch (type) {
+    case UnitType::Qubit:
+      return Qubit(name, idx);
+    case UnitType::Bit:
+      return Bit(name, idx);
+    case UnitType::WasmState:
+      return WasmState(name, idx);
+    case UnitType::RngState:
+      return RngState(name, idx);
+    default:
+      throw BinaryFormatError("Unknown unit type in binary circuit");
+  }
+}
+
+/** Tables and command decoding for \ref Circuit::from_binary. */
+class CircuitDecoder {
+ public:
+  explicit CircuitDecoder(std::string_view data) : in_(data) {}
+
+  /**
+   * Decode the circuit, reporting any failure caused by the data as a
+   * BinaryFormatError.
+   *
+   * Malformed data can make the CBOR parser, SymEngine, unit conversion, op
+   * construction or Circuit::add_op throw; callers should only have to
+   * handle one exception type for bad input.
+   */
+  Circuit decode() {
+    try {
+      return read();
+    } catch (const BinaryFormatError &) {
+      throw;
+    } catch (const std::bad_alloc &) {
+      throw;
+    } catch (const std::exception &e) {
+      throw BinaryFormatError(
+          std::string("Malformed binary circuit: ") + e.what());
+    }
+  }
+
+ private:
+  Circuit read() {
+    if (in_.remaining() < sizeof binary_magic) {
+      throw BinaryFormatError("Not a binary circuit");
+    }
+    for (char c : binary_magic) {
+      if (in_.byte() != static_cast<std::uint8_t>(c)) {
+        throw BinaryFormatError("Not a binary circuit");
+      }
+    }
+    const std::uint64_t version = in_.varint();
+    if (version == 0 || version > Circuit::binary_format_version) {
+      throw BinaryFormatError(
+          "Unsupported binary circuit format version " +
+          std::to_string(version));
+    }
+
+    const std::size_t n_strings = in_.count();
+    strings_.reserve(n_strings);
+    for (std::size_t i = 0; i < n_strings; ++i) {
+      strings_.emplace_back(in_.bytes());
+    }
+    exprs_.resize(n_strings);
+    const std::size_t n_units = in_.count();
+    units_.reserve(n_units);
+    for (std::size_t i = 0; i < n_units; ++i) {
+      const std::uint8_t type = in_.byte();
+      const std::string &name = strings_[in_.index(n_strings)];
+      std::vector<unsigned> idx(in_.count());
+      for (unsigned &j : idx) j = static_cast<unsigned>(in_.varint());
+      units_.push_back(make_unit(static_cast<UnitType>(type), name, idx));
+    }
+    const std::size_t n_ops = in_.count();
+    ops_.reserve(n_ops);
+    for (std::size_t i = 0; i < n_ops; ++i) {
+      const std::string_view cbor = in_.bytes();
+      ops_.push_back(nlohmann::json::from_cbor(cbor.begin(), cbor.end())
+                         .get<Op_ptr>());
+    }
+
+    Circuit circ;
+    const std::uint64_t name = in_.varint();
+    if (name != 0) circ.set_name(string_at(name - 1));
+    circ.add_phase(param());
+    for (std::size_t i = 0, n = in_.count(); i < n; ++i) {
+      circ.add_qubit(Qubit(unit()));
+    }
+    for (std::size_t i = 0, n = in_.count(); i < n; ++i) {
+      circ.add_bit(Bit(unit()));
+    }
+    const std::uint64_t n_wasm = in_.varint();
+    if (n_wasm > 0) circ.add_wasm_register(n_wasm);
+    const std::uint64_t n_rng = in_.varint();
+    if (n_rng > 0) circ.add_rng_register(n_rng);
+
+    qubit_map_t perm;
+    for (std::size_t i = 0, n = in_.count(); i < n; ++i) {
+      Qubit in(unit());
+      perm.emplace(in, Qubit(unit()));
+    }
+
+    unit_vector_t args;
+    for (std::size_t i = 0, n = in_.count(); i < n; ++i) {
+      const std::uint64_t code = in_.varint();
+      Op_ptr op;
+      std::vector<Expr> params;
+      if (code % 2 == 0) {
+        gate_type(code / 2);
+        params.resize(in_.count());
+        for (Expr &e : params) e = param();
+      } else if (code / 2 < ops_.size()) {
+        op = ops_[code / 2];
+      } else {
+        throw BinaryFormatError("Index out of range in binary circuit");
+      }
+      args.resize(in_.count());
+      for (UnitID &u : args) u = unit();
+      if (code % 2 == 0) {
+        op = get_op_ptr(static_cast<OpType>(code / 2), params, args.size());
+      }
+      const std::uint64_t opgroup = in_.varint();
+      if (opgroup == 0) {
+        circ.add_op(op, args);
+      } else {
+        circ.add_op(op, args, string_at(opgroup - 1));
+      }
+    }
+
+    circ.permute_boundary_output(perm);
+    for (std::size_t i = 0, n = in_.count(); i < n; ++i) {
+      circ.qubit_create(Qubit(unit()));
+    }
+    for (std::size_t i = 0, n = in_.count(); i < n; ++i) {
+      circ.qubit_discard(Qubit(unit()));
+    }
+    return circ;
+  }
+
+  const UnitID &unit() { return units_[in_.index(units_.size())]; }
+
+  /** Check that a decoded gate code names a gate type. */
+  static void gate_type(std::uint64_t code) {
+    if (code > static_cast<std::uint64_t>(optypeinfo().rbegin()->first) ||
+        !is_gate_type(static_cast<OpType>(code))) {
+      throw BinaryFormatError("Unknown gate type in binary circuit");
+    }
+  }
+
+  const std::string &string_at(std::uint64_t i) const {
+    if (i >= strings_.size()) {
+      throw BinaryFormatError("Index out of range in binary circuit");
+    }
+    return strings_[i];
+  }
+
+  Expr param() {
+    switch (in_.byte()) {
+      case ParamTag::Double:
+        return Expr(in_.f64());
+      case ParamTag::Symbolic: {
+        const std::size_t i = in_.index(strings_.size());
+        if (!exprs_[i]) exprs_[i] = Expr(strings_[i]);
+        return *exprs_[i];
+      }
+      default:
+        throw BinaryFormatError("Unknown parameter tag in binary circuit");
+    }
+  }
+
+  BinaryReader in_;
+  std::vector<std::string> strings_;
+  std::vector<std::optional<Expr>> exprs_;
+  std::vector<UnitID> units_;
+  std::vector<Op_ptr> ops_;
+};
+
+}  // namespace
+
+std::string Circuit::to_binary() const {
+  return CircuitEncoder().encode(*this);
+}
+
+void Circuit::to_binary_file(const std::string &filename) const {
+  std::ofstream file(filename, std::ios::binary);
+  if (!file) {
+    throw std::invalid_argument("Cannot open " + filename);
+  }
+  const std::string data = to_binary();
+  file.write(data.data(), data.size());
+  file.close();
+  if (!file) {
+    throw std::runtime_error("Cannot write " + filename);
+  }
+}
+
+Circuit Circuit::from_binary(std::string_view data) {
+  return CircuitDecoder(data).decode();
+}
+
+Circuit Circuit::from_binary_file(const std::string &filename) {
+#if defined(TKET_BINARY_NO_MMAP)
+  std::ifstream file(filename, std::ios::binary);
+  if (!file) {
+    throw std::invalid_argument("Cannot open " + filename);
+  }
+  const std::string data(
+      (std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+  return from_binary(data);
+#else
+  const int fd = ::open(filename.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::invalid_argument("Cannot open " + filename);
+  }
+  struct stat st;
+  if (::fstat(fd, &st) != 0) {
+    ::close(fd);
+    throw std::invalid_argument("Cannot stat " + filename);
+  }
+  const std::size_t size = static_cast<std::size_t>(st.st_size);
+  if (size == 0) {
+    ::close(fd);
+    return from_binary(std::string_view());
+  }
+  void *map = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (map == MAP_FAILED) {
+    throw std::invalid_argument("Cannot map " + filename);
+  }
+  struct Unmap {
+    void *p;
+    std::size_t n;
+    ~Unmap() { ::munmap(p, n); }
+  } unmap{map, size};
+  return from_binary(std::string_view(static_cast<const char *>(map), size));
+#endif
+}
+
+}  // namespace tket
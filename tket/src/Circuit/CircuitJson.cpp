@@ -39,7 +39,7 @@ void to_json(nlohmann::json& j, const Circuit& circ) {
     j["implicit_permutation"] = impl;
   }
   j["commands"] = nlohmann::json::array();
-  for (const Command& com : circ) {
+  for (const CommandView& com : circ.command_views()) {
     j["commands"].push_back(com);
   }
   j["created_qubits"] = circ.created_qubits();
@@ -0,0 +1,228 @@
+// Copyright Quantinuum
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tket/Circuit/CircuitJsonStream.hpp"
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "tket/Circuit/Command.hpp"
+#include "tket/Utils/Json.hpp"
+
+namespace tket {
+
+namespace {
+
+typedef nlohmann::json::parse_event_t parse_event_t;
+
+/**
+ * Parser callback that consumes the top-level fields of a serialised circuit
+ * as they complete, and decodes each element of "commands" as soon as it has
+ * been parsed, discarding its JSON.
+ *
+ * Fields that are only needed once all commands have been added are left in
+ * the parsed document for \ref finish.
+ */
+class CircuitJsonReader {
+ public:
+  bool operator()(int depth, parse_event_t event, nlohmann::json &parsed) {
+    if (depth == 1 && event == parse_event_t::key) {
+      key_ = parsed.get<std::string>();
+      if (key_ == "commands") {
+        in_commands_ = true;
+        seen_commands_ = true;
+        if (qubits_ && bits_) add_units();
+      }
+      return true;
+    }
+    const bool complete = event == parse_event_t::value ||
+                          event == parse_event_t::object_end ||
+                          event == parse_event_t::array_end;
+    if (in_commands_) {
+      if (depth == 1 && complete) {
+        in_commands_ = false;
+        return false;
+      }
+      if (depth == 2 && complete) {
+        Command com = parsed.get<Command>();
+        if (units_added_ && pending_.empty() && has_registers_for(com)) {
+          add_command(com);
+        } else {
+          pending_.push_back(std::move(com));
+        }
+        return false;
+      }
+      return true;
+    }
+    if (depth == 1 && complete) {
+      return read_field(parsed);
+    }
+    return true;
+  }
+
+  Circuit finish(const nlohmann::json &j) {
+    if (!seen_phase_) throw JsonError("Circuit JSON has no \"phase\" field.");
+    if (!qubits_) throw JsonError("Circuit JSON has no \"qubits\" field.");
+    if (!bits_) throw JsonError("Circuit JSON has no \"bits\" field.");
+    if (!seen_commands_) {
+      throw JsonError("Circuit JSON has no \"commands\" field.");
+    }
+    if (!units_added_) add_units();
+    for (const Command &com : pending_) {
+      add_command(com);
+    }
+    pending_.clear();
+
+    const auto &imp_perm = j.at("implicit_permutation").get<qubit_map_t>();
+    circ_.permute_boundary_output(imp_perm);
+    if (j.contains("created_qubits")) {
+      for (const auto &j_q : j.at("created_qubits")) {
+        circ_.qubit_create(j_q.get<Qubit>());
+      }
+    }
+    if (j.contains("discarded_qubits")) {
+      for (const auto &j_q : j.at("discarded_qubits")) {
+        circ_.qubit_discard(j_q.get<Qubit>());
+      }
+    }
+    return std::move(circ_);
+  }
+
+ private:
+  /** Returns whether to keep the field in the parsed document. */
+  bool read_field(const nlohmann::json &value) {
+    if (key_ == "name") {
+      circ_.set_name(value.get<std::string>());
+    } else if (key_ == "phase") {
+      circ_.add_phase(value.get<Expr>());
+      seen_phase_ = true;
+    } else if (key_ == "qubits") {
+      qubits_ = value.get<qubit_vector_t>();
+    } else if (key_ == "bits") {
+      bits_ = value.get<bit_vector_t>();
+    } else if (key_ == "number_of_ws") {
+      n_wasm_ = value.get<unsigned>();
+      if (units_added_) circ_.add_wasm_register(*n_wasm_);
+    } else if (key_ == "number_of_rs") {
+      n_rng_ = value.get<unsigned>();
+      if (units_added_) circ_.add_rng_register(*n_rng_);
+    } else {
+      return true;
+    }
+    return false;
+  }
+
+  // Same order as from_json(const nlohmann::json &, Circuit &).
+  void add_units() {
+    for (const Qubit &qb : *qubits_) circ_.add_qubit(qb);
+    for (const Bit &b : *bits_) circ_.add_bit(b);
+    if (n_wasm_) circ_.add_wasm_register(*n_wasm_);
+    if (n_rng_) circ_.add_rng_register(*n_rng_);
+    units_added_ = true;
+  }
+
+  /**
+   * Whether the WASM and RNG wires used by the command are known to exist.
+   *
+   * Keys may come in any order, so "number_of_ws" or "number_of_rs" may not
+   * have been read yet. Adding the command would then create only as many
+   * wires as it uses, which is too few if it uses a wire other than the
+   * first. Such commands, and all after them, are held back until the end.
+   */
+  bool has_registers_for(const Command &com) const {
+    for (const UnitID &arg : com.get_args()) {
+      if ((arg.type() == UnitType::WasmState && !n_wasm_) ||
+          (arg.type() == UnitType::RngState && !n_rng_)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  void add_command(const Command &com) {
+    circ_.add_op(com.get_op_ptr(), com.get_args(), com.get_opgroup());
+  }
+
+  Circuit circ_;
+  std::string key_;
+  bool in_commands_ = false;
+  bool seen_commands_ = false;
+  bool seen_phase_ = false;
+  bool units_added_ = false;
+  std::optional<qubit_vector_t> qubits_;
+  std::optional<bit_vector_t> bits_;
+  std::optional<unsigned> n_wasm_;
+  std::optional<unsigned> n_rng_;
+  std::vector<Command> pending_;
+};
+
+template <typename... Input>
+Circuit read_circuit(Input &&...input) {
+  CircuitJsonReader reader;
+  const nlohmann::json rest = nlohmann::json::parse(
+      std::forward<Input>(input)...,
+      [&reader](int depth, parse_event_t event, nlohmann::json &parsed) {
+        return reader(depth, event, parsed);
+      });
+  return reader.finish(rest);
+}
+
+}  // namespace
+
+Circuit circuit_from_json_stream(std::istream &in) { return read_circuit(in); }
+
+Circuit circuit_from_json_stream(std::string_view s) {
+  return read_circuit(s.data(), s.data() + s.size());
+}
+
+void circuit_to_json_stream(const Circuit &circ, std::ostream &out) {
+  out << '{';
+  const auto name = circ.get_name();
+  if (name) {
+    out << "\"name\":" << nlohmann::json(name.value()).dump() << ',';
+  }
+  out << "\"phase\":" << nlohmann::json(circ.get_phase()).dump();
+  out << ",\"qubits\":" << nlohmann::json(circ.all_qubits()).dump();
+  out << ",\"bits\":" << nlohmann::json(circ.all_bits()).dump();
+  if (circ._number_of_wasm_wires > 0) {
+    out << ",\"number_of_ws\":" << circ._number_of_wasm_wires;
+  }
+  if (circ._number_of_rng_wires > 0) {
+    out << ",\"number_of_rs\":" << circ._number_of_rng_wires;
+  }
+
+  const auto impl = circ.implicit_qubit_permutation();
+  // empty maps are mapped to null instead of empty array
+  nlohmann::json j_impl = nlohmann::json::array();
+  if (!impl.empty()) {
+    j_impl = impl;
+  }
+  out << ",\"implicit_permutation\":" << j_impl.dump();
+
+  out << ",\"commands\":[";
+  bool first = true;
+  for (const CommandView &com : circ.command_views()) {
+    if (!first) out << ',';
+    first = false;
+    out << nlohmann::json(com).dump();
+  }
+  out << ']';
+  out << ",\"created_qubits\":" << nlohmann::json(circ.created_qubits()).dump();
+  out << ",\"discarded_qubits\":"
+      << nlohmann::json(circ.discarded_qubits()).dump();
+  out << '}';
+}
+
+}  // namespace tket
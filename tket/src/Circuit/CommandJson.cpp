@@ -19,16 +19,15 @@
 
 namespace tket {
 
-void to_json(nlohmann::json& j, const Command& com) {
-  const Op_ptr op = com.get_op_ptr();
-  const std::optional<std::string> opgroup = com.get_opgroup();
+static void command_to_json(
+    nlohmann::json& j, const Op_ptr& op,
+    const std::optional<std::string>& opgroup, std::span<const UnitID> args) {
   j["op"] = op;
   if (opgroup) {
     j["opgroup"] = opgroup.value();
   }
 
   const op_signature_t& sig = op->get_signature();
-  const unit_vector_t& args = com.get_args();
 
   if (sig.size() != args.size()) {
     throw JsonError("Number of args does not match signature of op.");
@@ -67,6 +66,16 @@ void to_json(nlohmann::json& j, const Command& com) {
 
   j["args"] = j_args;
 }
+
+void to_json(nlohmann::json& j, const Command& com) {
+  const unit_vector_t args = com.get_args();
+  command_to_json(j, com.get_op_ptr(), com.get_opgroup(), args);
+}
+
+void to_json(nlohmann::json& j, const CommandView& com) {
+  command_to_json(j, com.get_op_ptr(), com.get_opgroup(), com.get_args());
+}
+
 void from_json(const nlohmann::json& j, Command& com) {
   const auto op = j.at("op").get<Op_ptr>();
   std::optional<std::string> opgroup;
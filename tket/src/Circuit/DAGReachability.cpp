@@ -0,0 +1,192 @@
+// Copyright Quantinuum
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tket/Circuit/DAGReachability.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include "tket/Circuit/Circuit.hpp"
+
+namespace tket {
+
+DAGReachability::DAGReachability(const Circuit &circ)
+    : dag_(circ.dag), valid_(false) {
+  rebuild();
+}
+
+void DAGReachability::rebuild() {
+  // Kahn's algorithm: rank the vertices in the order in which all their
+  // predecessors have been ranked.
+  rank_.clear();
+  std::unordered_map<Vertex, std::size_t> n_unranked_preds;
+  std::vector<Vertex> ready;
+  BGL_FORALL_VERTICES(v, dag_, DAG) {
+    const std::size_t n_preds = boost::in_degree(v, dag_);
+    if (n_preds == 0) {
+      ready.push_back(v);
+    } else {
+      n_unranked_preds[v] = n_preds;
+    }
+  }
+  double next_rank = 0.;
+  while (!ready.empty()) {
+    const Vertex v = ready.back();
+    ready.pop_back();
+    rank_[v] = next_rank;
+    next_rank += 1.;
+    BGL_FORALL_OUTEDGES(v, e, dag_, DAG) {
+      const Vertex w = boost::target(e, dag_);
+      if (--n_unranked_preds[w] == 0) {
+        ready.push_back(w);
+      }
+    }
+  }
+  valid_ = true;
+}
+
+void DAGReachability::insert_vertices(const VertexVec &verts) {
+  if (!valid_ || verts.empty()) return;
+  const VertexSet new_verts{verts.begin(), verts.end()};
+  constexpr double inf = std::numeric_limits<double>::infinity();
+  // The new ranks must lie strictly between lo and hi.
+  double lo = -inf, hi = inf;
+  for (const Vertex &v : verts) {
+    BGL_FORALL_INEDGES(v, e, dag_, DAG) {
+      const Vertex u = boost::source(e, dag_);
+      if (new_verts.contains(u)) continue;
+      auto it = rank_.find(u);
+      if (it == rank_.end()) {
+        valid_ = false;
+        return;
+      }
+      lo = std::max(lo, it->second);
+    }
+    BGL_FORALL_OUTEDGES(v, e, dag_, DAG) {
+      const Vertex w = boost::target(e, dag_);
+      if (new_verts.contains(w)) continue;
+      auto it = rank_.find(w);
+      if (it == rank_.end()) {
+        valid_ = false;
+        return;
+      }
+      hi = std::min(hi, it->second);
+    }
+  }
+  const double n = verts.size();
+  if (lo == -inf && hi == inf) {
+    valid_ = false;
+    return;
+  }
+  if (lo == -inf) lo = hi - (n + 1.);
+  if (hi == inf) hi = lo + (n + 1.);
+  const double step = (hi - lo) / (n + 1.);
+  double prev = lo;
+  for (const Vertex &v : verts) {
+    const double r = prev + step;
+    // The neighbours may be ordered so that there is no room between them,
+    // or repeated insertion may have exhausted the precision of the ranks.
+    if (!(prev < r && r < hi)) {
+      valid_ = false;
+      return;
+    }
+    rank_[v] = r;
+    prev = r;
+  }
+}
+
+void DAGReachability::erase_vertex(const Vertex &v) { rank_.erase(v); }
+
+std::optional<bool> DAGReachability::search(
+    const Vertex &start, const VertexSet &targets, bool forwards) const {
+  auto start_it = rank_.find(start);
+  if (start_it == rank_.end()) return std::nullopt;
+  const double start_rank = start_it->second;
+  // Only targets on the right side of start can be reached, and the search
+  // need not go beyond the furthest of them.
+  bool any_reachable = false;
+  double bound = start_rank;
+  for (const Vertex &t : targets) {
+    if (t == start) return true;
+    auto it = rank_.find(t);
+    if (it == rank_.end()) return std::nullopt;
+    const double r = it->second;
+    if (forwards ? r > start_rank : r < start_rank) {
+      any_reachable = true;
+      bound = forwards ? std::max(bound, r) : std::min(bound, r);
+    }
+  }
+  if (!any_reachable) return false;
+
+  std::vector<Vertex> stack{start};
+  VertexSet visited{start};
+  while (!stack.empty()) {
+    const Vertex v = stack.back();
+    stack.pop_back();
+    auto visit = [&](const Vertex &w) -> std::optional<bool> {
+      if (targets.contains(w)) return true;
+      auto it = rank_.find(w);
+      if (it == rank_.end()) return std::nullopt;
+      if ((forwards ? it->second < bound : it->second > bound) &&
+          visited.insert(w).second) {
+        stack.push_back(w);
+      }
+      return false;
+    };
+    if (forwards) {
+      BGL_FORALL_OUTEDGES(v, e, dag_, DAG) {
+        std::optional<bool> found = visit(boost::target(e, dag_));
+        if (!found || *found) return found;
+      }
+    } else {
+      BGL_FORALL_INEDGES(v, e, dag_, DAG) {
+        std::optional<bool> found = visit(boost::source(e, dag_));
+        if (!found || *found) return found;
+      }
+    }
+  }
+  return false;
+}
+
+bool DAGReachability::query(
+    const Vertex &start, const VertexSet &targets, bool forwards) {
+  if (!valid_) rebuild();
+  std::optional<bool> found = search(start, targets, forwards);
+  if (!found) {
+    // The circuit has vertices we were not told about.
+    rebuild();
+    found = search(start, targets, forwards);
+    if (!found) {
+      throw std::logic_error("Reachability query for vertex not in circuit");
+    }
+  }
+  return *found;
+}
+
+bool DAGReachability::reaches(const Vertex &from, const Vertex &to) {
+  return query(from, {to}, true);
+}
+
+bool DAGReachability::reaches_any(const Vertex &from, const VertexSet &to) {
+  return query(from, to, true);
+}
+
+bool DAGReachability::reached_from_any(
+    const VertexSet &from, const Vertex &to) {
+  return query(to, from, false);
+}
+
+}  // namespace tket
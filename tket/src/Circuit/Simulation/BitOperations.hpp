@@ -22,8 +22,8 @@ namespace tket {
 namespace tket_sim {
 namespace internal {
 
-// Used to represent qubit indices.
-typedef std::uint_fast32_t SimUInt;
+// Used to represent basis state indices, i.e. sets of qubits.
+typedef std::uint64_t SimUInt;
 
 // Application: we have a mask like 000101100111001.
 // Those positions with "1" are "forbidden";
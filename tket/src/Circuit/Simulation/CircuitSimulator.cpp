@@ -26,16 +26,17 @@ namespace tket {
 namespace tket_sim {
 
 Eigen::MatrixXcd get_unitary(
-    const Circuit& circ, double abs_epsilon, unsigned max_number_of_qubits) {
+    const Circuit& circ, double abs_epsilon, unsigned max_number_of_qubits,
+    unsigned n_threads) {
   const auto matr_size = get_matrix_size(circ.n_qubits());
   Eigen::MatrixXcd result = Eigen::MatrixXcd::Identity(matr_size, matr_size);
-  apply_unitary(circ, result, abs_epsilon, max_number_of_qubits);
+  apply_unitary(circ, result, abs_epsilon, max_number_of_qubits, n_threads);
   return result;
 }
 
 static void apply_unitary_may_throw(
     const Circuit& circ, Eigen::MatrixXcd& matr, double abs_epsilon,
-    unsigned max_number_of_qubits) {
+    unsigned max_number_of_qubits, unsigned n_threads) {
   if (circ.n_qubits() > max_number_of_qubits) {
     throw GateUnitaryMatrixError(
         "Circuit to simulate has too many qubits",
@@ -51,16 +52,17 @@ static void apply_unitary_may_throw(
         "M has wrong number of rows",
         GateUnitaryMatrixError::Cause::INPUT_ERROR);
   }
-  internal::GateNodesBuffer buffer(matr, abs_epsilon);
+  internal::GateNodesBuffer buffer(matr, abs_epsilon, n_threads);
   internal::decompose_circuit(circ, buffer, abs_epsilon);
   matr = apply_qubit_permutation(matr, circ.implicit_qubit_permutation());
 }
 
 void apply_unitary(
     const Circuit& circ, Eigen::MatrixXcd& matr, double abs_epsilon,
-    unsigned max_number_of_qubits) {
+    unsigned max_number_of_qubits, unsigned n_threads) {
   try {
-    apply_unitary_may_throw(circ, matr, abs_epsilon, max_number_of_qubits);
+    apply_unitary_may_throw(
+        circ, matr, abs_epsilon, max_number_of_qubits, n_threads);
   } catch (const GateUnitaryMatrixError& e) {
     const auto full_matr_size = get_matrix_size(circ.n_qubits());
     std::stringstream ss;
@@ -80,11 +82,12 @@ void apply_unitary(
 }
 
 Eigen::VectorXcd get_statevector(
-    const Circuit& circ, double abs_epsilon, unsigned max_number_of_qubits) {
+    const Circuit& circ, double abs_epsilon, unsigned max_number_of_qubits,
+    unsigned n_threads) {
   Eigen::MatrixXcd result =
       Eigen::MatrixXcd::Zero(get_matrix_size(circ.n_qubits()), 1);
   result(0, 0) = 1.0;
-  apply_unitary(circ, result, abs_epsilon, max_number_of_qubits);
+  apply_unitary(circ, result, abs_epsilon, max_number_of_qubits, n_threads);
   return result;
 }
 
@@ -14,6 +14,7 @@
 
 #include "DecomposeCircuit.hpp"
 
+#include <span>
 #include <sstream>
 #include <tkassert/Assert.hpp>
 
@@ -80,7 +81,7 @@ static void throw_with_op_error_message(
 }
 
 static void fill_qubit_indices(
-    const unit_vector_t& args, const QMap& qmap, GateNode& node) {
+    std::span<const UnitID> args, const QMap& qmap, GateNode& node) {
   TKET_ASSERT(args.size() <= qmap.size());
   node.qubit_indices.resize(args.size());
   for (unsigned ii = 0; ii < args.size(); ++ii) {
@@ -93,11 +94,10 @@ static void decompose_circuit_recursive(
     const std::vector<unsigned>& parent_circuit_qubit_indices,
     double abs_epsilon) {
   const auto qmap = get_qmap_no_checks(circ, parent_circuit_qubit_indices);
-  unit_vector_t args;
   GateNode node;
 
-  for (const Command& command : circ) {
-    const Op_ptr current_op = command.get_op_ptr();
+  for (const CommandView& command : circ.command_views()) {
+    const Op_ptr& current_op = command.get_op_ptr();
     TKET_ASSERT(current_op.get());
     const OpType current_type = current_op->get_type();
     if (is_classical_type(current_type) || is_projective_type(current_type) ||
@@ -110,8 +110,7 @@ static void decompose_circuit_recursive(
       continue;
     }
     const OpDesc desc = current_op->get_desc();
-    args = command.get_args();
-    fill_qubit_indices(args, qmap, node);
+    fill_qubit_indices(command.get_args(), qmap, node);
     if (desc.is_gate()) {
       const Gate* gate = dynamic_cast<const Gate*>(current_op.get());
       TKET_ASSERT(gate);
@@ -14,9 +14,12 @@
 
 #include "GateNode.hpp"
 
+#include <algorithm>
+#include <array>
 #include <tkassert/Assert.hpp>
 
 #include "BitOperations.hpp"
+#include "tket/Utils/ParallelFor.hpp"
 
 /*
 The following is intended to be helpful, but there are no guarantees
@@ -121,18 +124,18 @@ This, then, is the algorithm:
     The x values are all distinct from each other (and so, too, are the y),
     so we get 2^{n-k} distinct positions (y,x) where we place the value u_{i,j}.
 
-SPARSITY: U is (2^k)*(2^k). Let 0 < s <= 1 be the sparsity of U,
-i.e. U has s.4^k nonzero entries. The final matrix M then has
-2^{n-k}.s.4^k = s.2^{n+k} nonzero entries, so dividing by 4^n,
-the sparsity of M is s.2^{k-n}. Thus, even if U is dense, in most applications
-M becomes very sparse as n increases since k <= 2 for almost all gates.
-(In the few gates where k > 2, usually U is sparse, so that s << 1.
-e.g., CCX has an 8x8 matrix U, with 8 nonzero entries, so s=1/8).
+IN PLACE: we never build M. The 2^n basis states split into 2^(n-k) blocks
+of 2^k states each, which share the same free bits (those NOT in positions
+[q0, q1, ...]); M acts on each block independently, exactly as U does.
+So for each column of the matrix being premultiplied, and each block,
+we gather the 2^k amplitudes, multiply by U, and scatter them back.
 
-This sparsity is essential. On an ordinary 2020 laptop,
-for n=8, with 560 gates, the full unitary M is found in <1 second.
-A single statevector for n=16, with 1120 gates, is found in ~3 seconds.
-This is without any really fancy, clever optimisation.
+For the common cases (k <= 2, or dense U with k <= 4, e.g. a block of gates
+fused by the buffer) U is copied into a fixed size array, and the blocks are
+enumerated by inserting zero bits into a counter, which gives runs of
+consecutive indices that the compiler can vectorise. Diagonal gates are not
+applied here at all, but collected by the buffer and applied together in
+a single sweep over the amplitudes.
 
 */
 
@@ -141,137 +144,253 @@ namespace tket_sim {
 namespace internal {
 
 namespace {
-/** There are k distinct qubits [q0, q1, q2, ...] chosen from the set
- * {0,1,2,...,n-1}. We want each binary string x of length k to have its bits
- * extracted and moved to the positions [q0, q1, q2, ...] within a larger binary
- * string of length n.
- *
- *  Thus 0 <= x < 2^k if we interpret x as an unsigned integer in the usual way.
- *
- *  Element[x] of the returned vector gives exactly the bits corresponding to x.
- */
-struct LiftedBitsResult {
-  // Element[x] tells us exactly the result of translating the bits of x.
-  std::vector<SimUInt> translated_bits;
-
-  // Simply the OR of all translated bits; has a "1" everywhere there is a slot
-  // for a translated bit to appear.
-  SimUInt translated_bits_mask;
-
-  /** Set the data members, given the list of relevant qubits, and the full
-   * number of qubits from which they are chosen.
-   *  @param qubits The distinct qubit indices chosen from {0,1,2,...,n-1}.
-   *  @param full_number_of_qubits The value n, the number of qubits in the full
-   * set, from which "qubits" is extracted.
-   */
-  void set(const std::vector<unsigned>& qubits, unsigned full_number_of_qubits);
-};
-
-void LiftedBitsResult::set(
-    const std::vector<unsigned>& qubits, unsigned full_number_of_qubits) {
-  TKET_ASSERT(full_number_of_qubits >= qubits.size());
-  TKET_ASSERT(full_number_of_qubits < 32);
-
-  translated_bits.assign(get_matrix_size(qubits.size()), 0);
 
-  // Build up the elements by ORing with shifted bits.
-  translated_bits_mask = 0;
-  SimUInt k_string_bit = 1;
+// Complex multiplication without the NaN/inf handling of the standard
+// operator, which prevents vectorisation.
+inline Complex mul(const Complex& a, const Complex& b) {
+  return {
+      a.real() * b.real() - a.imag() * b.imag(),
+      a.real() * b.imag() + a.imag() * b.real()};
+}
 
-  for (unsigned count = 0; count < qubits.size(); ++count) {
-    TKET_ASSERT(full_number_of_qubits >= qubits[count] + 1);
+// Insert a zero at bit position `bit` of `x`.
+inline std::size_t insert_zero_bit(std::size_t x, unsigned bit) {
+  const std::size_t low = x & ((std::size_t{1} << bit) - 1);
+  return ((x - low) << 1) | low;
+}
 
-    // This will be a bit within the length n string.
-    SimUInt long_string_bit = 1;
-    long_string_bit <<=
-        (full_number_of_qubits - (qubits[qubits.size() - 1 - count] + 1));
+// Number of blocks handed to each thread at a time; small enough to balance
+// the load, large enough that the scheduling cost is negligible.
+constexpr std::size_t BLOCK_CHUNK = 1 << 12;
 
-    translated_bits_mask |= long_string_bit;
+// The bit, within an index of the full statevector, that holds the value of
+// the given qubit (ILO-BE).
+inline unsigned state_bit(unsigned qubit, unsigned full_number_of_qubits) {
+  return full_number_of_qubits - 1 - qubit;
+}
 
-    // Go through the entries and add the new long string bit
-    // when appropriate
-    // (i.e., if "k_string_bit" occurs in the binary expansion of i).
-    for (SimUInt ii = 0; ii < translated_bits.size(); ++ii) {
-      // If "ii" has a 1 in the appropriate position,
-      // insert a "1" in the length n string for this ii.
+// Call f(column, first_block, end_block) over all columns and blocks,
+// splitting the work into chunks shared between the threads. parallel_for
+// starts and joins its threads on every call, i.e. once per gate, so each
+// chunk must be large enough to pay for that.
+template <typename F>
+void for_each_block_chunk(
+    Eigen::Index n_cols, std::size_t n_blocks, unsigned n_threads, F&& f) {
+  const std::size_t chunks_per_col = (n_blocks + BLOCK_CHUNK - 1) / BLOCK_CHUNK;
+  parallel_for(
+      n_cols * chunks_per_col, n_threads, [&](std::size_t chunk) {
+        const Eigen::Index col = chunk / chunks_per_col;
+        const std::size_t first = (chunk % chunks_per_col) * BLOCK_CHUNK;
+        f(col, first, std::min(n_blocks, first + BLOCK_CHUNK));
+      });
+}
 
-      // Trick: convert 0 to 0, but convert any nonzero number to 1.
-      // This hopefully is faster by avoiding branching.
-      const SimUInt has_bit = std::min(ii & k_string_bit, SimUInt(1));
-      translated_bits[ii] |= has_bit * long_string_bit;
+// Apply a unitary on K qubits, copied into a dense array, in place.
+template <unsigned K>
+void apply_dense(
+    Eigen::MatrixXcd& matr, const std::vector<TripletCd>& triplets,
+    const std::vector<unsigned>& qubits, unsigned full_number_of_qubits,
+    unsigned n_threads) {
+  constexpr unsigned size = 1u << K;
+  Complex u[size][size] = {};
+  for (const TripletCd& t : triplets) u[t.row()][t.col()] += t.value();
+  std::array<unsigned, K> bits;
+  for (unsigned r = 0; r < K; ++r) {
+    bits[r] = state_bit(qubits[r], full_number_of_qubits);
+  }
+  std::size_t offsets[size] = {};
+  for (unsigned j = 0; j < size; ++j) {
+    for (unsigned r = 0; r < K; ++r) {
+      if ((j >> (K - 1 - r)) & 1) offsets[j] |= std::size_t{1} << bits[r];
     }
-    k_string_bit <<= 1;
   }
+  std::array<unsigned, K> sorted_bits = bits;
+  std::sort(sorted_bits.begin(), sorted_bits.end());
+  const std::size_t stride = std::size_t{1} << sorted_bits[0];
+  const std::size_t n_blocks = matr.rows() >> K;
+  for_each_block_chunk(
+      matr.cols(), n_blocks, n_threads,
+      [&](Eigen::Index col, std::size_t first, std::size_t end) {
+        // Local copies, so that the compiler knows that writing
+        // amplitudes cannot change them.
+        Complex m[size][size];
+        std::copy(&u[0][0], &u[0][0] + size * size, &m[0][0]);
+        std::size_t offs[size];
+        std::copy(offsets, offsets + size, offs);
+        Complex* data = matr.col(col).data();
+        std::size_t p = first;
+        while (p < end) {
+          // Blocks p, p+1, ... up to the next multiple of the stride have
+          // consecutive indices.
+          const std::size_t run =
+              std::min(stride - (p & (stride - 1)), end - p);
+          std::size_t index = p;
+          for (unsigned bit : sorted_bits) index = insert_zero_bit(index, bit);
+          Complex* base = data + index;
+          for (std::size_t j = 0; j < run; ++j) {
+            Complex x[size], y[size];
+            for (unsigned c = 0; c < size; ++c) x[c] = base[offs[c] + j];
+            for (unsigned r = 0; r < size; ++r) {
+              y[r] = 0.;
+              for (unsigned c = 0; c < size; ++c) y[r] += mul(m[r][c], x[c]);
+            }
+            for (unsigned r = 0; r < size; ++r) base[offs[r] + j] = y[r];
+          }
+          p += run;
+        }
+      });
 }
-}  // namespace
 
-static void set_lifted_triplets(
-    const std::vector<TripletCd>& triplets, LiftedBitsResult& lifted_bits,
-    std::vector<TripletCd>& lifted_triplets, ExpansionData& expansion_data,
+// Offsets, within a block, of each of the 2^k sub-indices of U.
+std::vector<std::size_t> get_block_offsets(
     const std::vector<unsigned>& qubits, unsigned full_number_of_qubits) {
-  // translated_bits[j] gives the bits within the length n binary string,
-  // which correspond to the length k binary representation of j,
-  // but permuted and moved around so as to fit in the "slots" for qubits
-  // [q0, q1, q2,...].
-  // Since U is unitary of size 2^k, no column or row can be all zeros,
-  // so every index j will be needed at least once.
-  // Hence, it is not a waste of time to compute all,
-  // even if U is very sparse.
-  lifted_bits.set(qubits, full_number_of_qubits);
-  lifted_triplets.clear();
-
-  expansion_data = get_expansion_data(
-      lifted_bits.translated_bits_mask, full_number_of_qubits);
-
-  const SimUInt free_bits_limit =
-      get_matrix_size(full_number_of_qubits - qubits.size());
-  TKET_ASSERT(free_bits_limit != 0 || !"Too many bits");
-
-  for (SimUInt free_bits = 0; free_bits < free_bits_limit; ++free_bits) {
-    const SimUInt expanded_free_bits =
-        get_expanded_bits(expansion_data, free_bits);
-
-    // Now go down the U matrix entries and copy them to the appropriate
-    // positions.
-    for (const auto& triplet : triplets) {
-      lifted_triplets.emplace_back(
-          lifted_bits.translated_bits.at(triplet.row()) | expanded_free_bits,
-          lifted_bits.translated_bits.at(triplet.col()) | expanded_free_bits,
-          triplet.value());
+  const unsigned k = qubits.size();
+  std::vector<std::size_t> offsets(get_matrix_size(k), 0);
+  for (std::size_t j = 0; j < offsets.size(); ++j) {
+    for (unsigned r = 0; r < k; ++r) {
+      if ((j >> (k - 1 - r)) & 1) {
+        offsets[j] |= std::size_t{1}
+                      << state_bit(qubits[r], full_number_of_qubits);
+      }
     }
   }
+  return offsets;
 }
 
-namespace {
-// Contains data potentially of size roughly 2^n or larger,
-// to avoid expensive memory reallocation.
-struct LargeWorkData {
-  LiftedBitsResult lifted_bits;
-  std::vector<TripletCd> lifted_triplets;
-  SparseMatrixXcd sparse_matrix;
-  ExpansionData expansion_data;
-
-  static LargeWorkData& get_work_data();
-};
-
-LargeWorkData& LargeWorkData::get_work_data() {
-  static LargeWorkData data;
-  return data;
+void apply_general(
+    Eigen::MatrixXcd& matr, const std::vector<TripletCd>& triplets,
+    const std::vector<unsigned>& qubits, unsigned full_number_of_qubits,
+    unsigned n_threads) {
+  const std::vector<std::size_t> offsets =
+      get_block_offsets(qubits, full_number_of_qubits);
+  const ExpansionData expansion_data = get_expansion_data(
+      offsets.back(), full_number_of_qubits - qubits.size());
+  const std::size_t size = offsets.size();
+  const std::size_t n_blocks = matr.rows() / size;
+  // Mostly nonzero unitaries (e.g. fused blocks of gates) are quicker to
+  // multiply as dense row-major matrices than through the triplets.
+  std::vector<Complex> dense;
+  if (2 * triplets.size() >= size * size) {
+    dense.assign(size * size, 0.);
+    for (const TripletCd& t : triplets) {
+      dense[t.row() * size + t.col()] += t.value();
+    }
+  }
+  for_each_block_chunk(
+      matr.cols(), n_blocks, n_threads,
+      [&](Eigen::Index col, std::size_t first, std::size_t end) {
+        Complex* data = matr.col(col).data();
+        std::vector<Complex> in(size), out(size);
+        for (std::size_t p = first; p < end; ++p) {
+          Complex* base = data + get_expanded_bits(expansion_data, p);
+          for (std::size_t j = 0; j < size; ++j) {
+            in[j] = base[offsets[j]];
+            out[j] = 0.;
+          }
+          if (dense.empty()) {
+            for (const TripletCd& t : triplets) {
+              out[t.row()] += mul(t.value(), in[t.col()]);
+            }
+          } else {
+            for (std::size_t r = 0; r < size; ++r) {
+              const Complex* row = dense.data() + r * size;
+              for (std::size_t c = 0; c < size; ++c) {
+                out[r] += mul(row[c], in[c]);
+              }
+            }
+          }
+          for (std::size_t j = 0; j < size; ++j) {
+            base[offsets[j]] = out[j];
+          }
+        }
+      });
 }
-}  // namespace
 
-void GateNode::apply_full_unitary(
-    Eigen::MatrixXcd& matr, unsigned full_number_of_qubits) const {
-  auto& work_data = LargeWorkData::get_work_data();
+}  // namespace
 
-  set_lifted_triplets(
-      triplets, work_data.lifted_bits, work_data.lifted_triplets,
-      work_data.expansion_data, qubit_indices, full_number_of_qubits);
+bool GateNode::is_diagonal() const {
+  return std::all_of(triplets.begin(), triplets.end(), [](const TripletCd& t) {
+    return t.row() == t.col();
+  });
+}
 
-  work_data.sparse_matrix =
-      get_sparse_square_matrix(work_data.lifted_triplets, matr.rows());
+void GateNode::apply_full_unitary(
+    Eigen::MatrixXcd& matr, unsigned full_number_of_qubits,
+    unsigned n_threads) const {
+  TKET_ASSERT(full_number_of_qubits >= qubit_indices.size());
+  TKET_ASSERT(
+      matr.rows() == Eigen::Index{1} << full_number_of_qubits ||
+      !"Matrix has wrong number of rows");
+  const unsigned k = qubit_indices.size();
+  if (k == 0) {
+    // Only a scalar, which the triplets give as a 1x1 matrix.
+    Complex z = 0.;
+    for (const TripletCd& t : triplets) z += t.value();
+    matr *= z;
+    return;
+  }
+  // Small gates, and mostly nonzero gates on up to 4 qubits (e.g. fused
+  // blocks), use the dense kernels; anything else goes through the triplets.
+  const unsigned size = get_matrix_size(k);
+  if (k <= 2 || (k <= 4 && 2 * triplets.size() >= size * size)) {
+    switch (k) {
+      case 1:
+        apply_dense<1>(
+            matr, triplets, qubit_indices, full_number_of_qubits, n_threads);
+        return;
+      case 2:
+        apply_dense<2>(
+            matr, triplets, qubit_indices, full_number_of_qubits, n_threads);
+        return;
+      case 3:
+        apply_dense<3>(
+            matr, triplets, qubit_indices, full_number_of_qubits, n_threads);
+        return;
+      default:
+        apply_dense<4>(
+            matr, triplets, qubit_indices, full_number_of_qubits, n_threads);
+        return;
+    }
+  }
+  apply_general(
+      matr, triplets, qubit_indices, full_number_of_qubits, n_threads);
+}
 
-  matr = work_data.sparse_matrix * matr;
+void apply_diagonal_nodes(
+    Eigen::MatrixXcd& matr, const std::vector<GateNode>& nodes,
+    unsigned full_number_of_qubits, Complex factor, unsigned n_threads) {
+  struct Diagonal {
+    std::vector<unsigned> bits;
+    std::vector<Complex> entries;
+  };
+  std::vector<Diagonal> diagonals;
+  diagonals.reserve(nodes.size());
+  for (const GateNode& node : nodes) {
+    Diagonal& d = diagonals.emplace_back();
+    for (unsigned q : node.qubit_indices) {
+      d.bits.push_back(state_bit(q, full_number_of_qubits));
+    }
+    d.entries.assign(get_matrix_size(node.qubit_indices.size()), 0.);
+    for (const TripletCd& t : node.triplets) {
+      TKET_ASSERT(t.row() == t.col());
+      d.entries[t.row()] += t.value();
+    }
+  }
+  const std::size_t n_rows = matr.rows();
+  parallel_for(
+      (n_rows + BLOCK_CHUNK - 1) / BLOCK_CHUNK, n_threads,
+      [&](std::size_t chunk) {
+        const std::size_t end = std::min(n_rows, (chunk + 1) * BLOCK_CHUNK);
+        for (std::size_t i = chunk * BLOCK_CHUNK; i < end; ++i) {
+          Complex z = factor;
+          for (const Diagonal& d : diagonals) {
+            std::size_t j = 0;
+            for (unsigned bit : d.bits) j = (j << 1) | ((i >> bit) & 1);
+            z = mul(z, d.entries[j]);
+          }
+          matr.row(i) *= z;
+        }
+      });
 }
 
 }  // namespace internal
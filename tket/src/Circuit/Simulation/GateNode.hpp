@@ -31,13 +31,35 @@ struct GateNode {
    */
   std::vector<unsigned> qubit_indices;
 
-  /** Lift the triplets to a full unitary matrix U acting on n qubits,
-   *  then premultiply the given matrix by U.
+  /** Premultiply the given matrix by the full unitary U of this gate
+   *  acting on n qubits, updating each column in place without
+   *  constructing U.
+   *  @param matr The matrix to update; must have 2^n rows.
+   *  @param full_number_of_qubits The value n.
+   *  @param n_threads Maximum number of threads to use.
    */
   void apply_full_unitary(
-      Eigen::MatrixXcd& matr, unsigned full_number_of_qubits) const;
+      Eigen::MatrixXcd& matr, unsigned full_number_of_qubits,
+      unsigned n_threads = 1) const;
+
+  /** Whether the unitary is diagonal, i.e. all triplets lie on the
+   *  diagonal.
+   */
+  bool is_diagonal() const;
 };
 
+/** Premultiply the given matrix by the product of the diagonal gates
+ *  and a scalar factor, in a single pass over the rows.
+ *  @param matr The matrix to update; must have 2^n rows.
+ *  @param nodes Gates whose unitaries are all diagonal.
+ *  @param full_number_of_qubits The value n.
+ *  @param factor Scalar to multiply by, e.g. a global phase.
+ *  @param n_threads Maximum number of threads to use.
+ */
+void apply_diagonal_nodes(
+    Eigen::MatrixXcd& matr, const std::vector<GateNode>& nodes,
+    unsigned full_number_of_qubits, Complex factor, unsigned n_threads = 1);
+
 }  // namespace internal
 }  // namespace tket_sim
 }  // namespace tket
@@ -14,6 +14,8 @@
 
 #include "GateNodesBuffer.hpp"
 
+#include <algorithm>
+#include <iterator>
 #include <stdexcept>
 #include <tkassert/Assert.hpp>
 
@@ -25,12 +27,33 @@ struct GateNodesBuffer::Impl {
   Eigen::MatrixXcd& matrix;
   const double abs_epsilon;
   const unsigned number_of_qubits;
+  const unsigned n_threads;
+  const unsigned max_fused_qubits;
   double global_phase;
 
-  Impl(Eigen::MatrixXcd& matr, double abs_eps)
+  // Gates not yet applied, in the order pushed, which together act on
+  // at most max_fused_qubits qubits; they will be multiplied into
+  // a single gate before touching the matrix.
+  struct Block {
+    std::vector<unsigned> qubits;
+    std::vector<GateNode> nodes;
+  };
+
+  // The blocks act on disjoint sets of qubits, so commute with each other.
+  std::vector<Block> blocks;
+
+  // Diagonal gates not yet applied. They commute with each other, so can
+  // all be applied together in one pass over the matrix.
+  std::vector<GateNode> diagonal_nodes;
+
+  Impl(
+      Eigen::MatrixXcd& matr, double abs_eps, unsigned threads,
+      unsigned max_fused)
       : matrix(matr),
         abs_epsilon(abs_eps),
         number_of_qubits(get_number_of_qubits(matr.rows())),
+        n_threads(threads),
+        max_fused_qubits(max_fused),
         global_phase(0.0) {
     if (matr.cols() == 0) {
       throw std::invalid_argument("Matrix has zero cols");
@@ -41,26 +64,134 @@ struct GateNodesBuffer::Impl {
 
   void add_global_phase(double ph) { global_phase += ph; }
 
+  // Multiply the gates in the block together and pass the result on.
+  void apply_block(Block& block);
+
+  void apply(const GateNode&);
+
+  void apply_diagonal_nodes(bool include_global_phase);
+
   void flush();
 };
 
+// Applying a dense gate on k qubits costs about 2^k complex multiplications
+// per amplitude. (Merging also saves passes over the matrix, but larger
+// blocks vectorise less well, which roughly cancels this out).
+static unsigned get_application_cost(unsigned number_of_qubits) {
+  return get_matrix_size(number_of_qubits);
+}
+
+static bool overlap(
+    const std::vector<unsigned>& qubits1,
+    const std::vector<unsigned>& qubits2) {
+  return std::any_of(qubits1.begin(), qubits1.end(), [&](unsigned q) {
+    return std::find(qubits2.begin(), qubits2.end(), q) != qubits2.end();
+  });
+}
+
 void GateNodesBuffer::Impl::push(const GateNode& node) {
-  // Later, we might add fancy optimisation here:
-  // storing the gate for later use, looking for other compatible gates
-  // acting on the same qubits to merge with this, etc. etc.
-  node.apply_full_unitary(matrix, number_of_qubits);
+  // The gate must come after every block sharing a qubit with it.
+  // Either merge those blocks and the gate into one block, if that is
+  // cheaper to apply, or apply them now.
+  std::vector<Block> overlapping;
+  std::vector<Block> others;
+  for (Block& block : blocks) {
+    if (overlap(block.qubits, node.qubit_indices)) {
+      overlapping.push_back(std::move(block));
+    } else {
+      others.push_back(std::move(block));
+    }
+  }
+  blocks = std::move(others);
+
+  Block merged;
+  unsigned separate_cost = get_application_cost(node.qubit_indices.size());
+  for (const Block& block : overlapping) {
+    merged.qubits.insert(
+        merged.qubits.end(), block.qubits.begin(), block.qubits.end());
+    separate_cost += get_application_cost(block.qubits.size());
+  }
+  for (unsigned q : node.qubit_indices) {
+    if (std::find(merged.qubits.begin(), merged.qubits.end(), q) ==
+        merged.qubits.end()) {
+      merged.qubits.push_back(q);
+    }
+  }
+  if (merged.qubits.size() <= max_fused_qubits &&
+      get_application_cost(merged.qubits.size()) < separate_cost) {
+    for (Block& block : overlapping) {
+      std::move(
+          block.nodes.begin(), block.nodes.end(),
+          std::back_inserter(merged.nodes));
+    }
+  } else {
+    for (Block& block : overlapping) apply_block(block);
+    merged.qubits = node.qubit_indices;
+  }
+  merged.nodes.push_back(node);
+  if (merged.qubits.size() > max_fused_qubits) {
+    apply_block(merged);
+  } else {
+    blocks.push_back(std::move(merged));
+  }
 }
 
-void GateNodesBuffer::Impl::flush() {
-  if (global_phase != 0.0) {
-    const auto factor = std::polar(1.0, PI * global_phase);
-    matrix *= factor;
+void GateNodesBuffer::Impl::apply_block(Block& block) {
+  if (block.nodes.size() == 1) {
+    apply(block.nodes[0]);
+    return;
+  }
+  // Premultiply the identity on the block's qubits by each gate in turn,
+  // with the gate's qubits renumbered as positions in block.qubits.
+  const unsigned size = get_matrix_size(block.qubits.size());
+  Eigen::MatrixXcd product = Eigen::MatrixXcd::Identity(size, size);
+  for (GateNode& node : block.nodes) {
+    for (unsigned& q : node.qubit_indices) {
+      q = std::find(block.qubits.begin(), block.qubits.end(), q) -
+          block.qubits.begin();
+    }
+    node.apply_full_unitary(product, block.qubits.size());
+  }
+  GateNode fused_node;
+  fused_node.triplets = get_triplets(product, abs_epsilon);
+  fused_node.qubit_indices = block.qubits;
+  apply(fused_node);
+}
+
+void GateNodesBuffer::Impl::apply(const GateNode& node) {
+  if (node.is_diagonal()) {
+    diagonal_nodes.push_back(node);
+    return;
+  }
+  apply_diagonal_nodes(false);
+  node.apply_full_unitary(matrix, number_of_qubits, n_threads);
+}
+void GateNodesBuffer::Impl::apply_diagonal_nodes(bool include_global_phase) {
+  Complex factor = 1.0;
+  if (include_global_phase && global_phase != 0.0) {
+    factor = std::polar(1.0, PI * global_phase);
     global_phase = 0.0;
   }
+  if (diagonal_nodes.empty()) {
+    if (factor != 1.0) matrix *= factor;
+    return;
+  }
+  internal::apply_diagonal_nodes(
+      matrix, diagonal_nodes, number_of_qubits, factor, n_threads);
+  diagonal_nodes.clear();
+}
+
+void GateNodesBuffer::Impl::flush() {
+  for (Block& block : blocks) apply_block(block);
+  blocks.clear();
+  apply_diagonal_nodes(true);
 }
 
-GateNodesBuffer::GateNodesBuffer(Eigen::MatrixXcd& matrix, double abs_epsilon)
-    : pimpl(std::make_unique<Impl>(matrix, abs_epsilon)) {}
+GateNodesBuffer::GateNodesBuffer(
+    Eigen::MatrixXcd& matrix, double abs_epsilon, unsigned n_threads,
+    unsigned max_fused_qubits)
+    : pimpl(std::make_unique<Impl>(
+          matrix, abs_epsilon, n_threads, max_fused_qubits)) {}
 
 GateNodesBuffer::~GateNodesBuffer() {}
 
@@ -45,14 +45,21 @@ namespace internal {
  *  difference than you can combine the small unitaries together before lifting
  *  and copying the entries.
  *
+ *  Currently, gates are fused greedily into blocks acting on disjoint sets
+ *  of at most max_fused_qubits qubits: a gate is merged with the blocks it
+ *  overlaps when the merged block is cheaper to apply than the parts,
+ *  otherwise those blocks are multiplied out and applied. Then, consecutive
+ *  diagonal blocks are stored and applied together, in a single pass over
+ *  the matrix.
+ *
  *  Of course, this would all be simulating the exact same gates, just in a
  *  computationally more efficient way; allowing the gates themselves to be
  *  changed could give yet more speedup possibilities.
  */
 class GateNodesBuffer {
  public:
-  /** The full (2^n)*(2^n) unitaries of the nodes will be calculated,
-   *  and left-multiply the matrix.
+  /** The full (2^n)*(2^n) unitaries of the nodes will left-multiply
+   *  the matrix (without being constructed explicitly).
    *  The matrix must remain valid throughout the lifetime
    *  of this object, and the caller should not alter the matrix
    *  in any other way.
@@ -61,8 +68,14 @@ class GateNodesBuffer {
    *       arising the gates added in sequence, in ILO-BE convention.
    *  @param abs_epsilon Used to convert almost-zero entries to zero entries:
    *      any z with std::abs(z) <= abs_epsilon is treated as zero.
+   *  @param n_threads Maximum number of threads to use when updating
+   *      the matrix.
+   *  @param max_fused_qubits Largest number of qubits which a block of
+   *      fused gates may act on; 0 disables fusion.
    */
-  GateNodesBuffer(Eigen::MatrixXcd& matrix, double abs_epsilon);
+  GateNodesBuffer(
+      Eigen::MatrixXcd& matrix, double abs_epsilon, unsigned n_threads = 1,
+      unsigned max_fused_qubits = 4);
 
   ~GateNodesBuffer();
 
@@ -0,0 +1,81 @@
+// Copyright Quantinuum
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tket/Circuit/Simulation/SimulatedMeasurement.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <tkrng/RNG.hpp>
+
+#include "tket/Circuit/Circuit.hpp"
+
+namespace tket {
+namespace tket_sim {
+
+MatrixXb sample_shots(
+    const StateVector& state, unsigned n_shots, std::size_t seed) {
+  const unsigned n_qubits = get_number_of_qubits(state.size());
+  std::vector<double> cumulative(state.size());
+  double total = 0.;
+  for (Eigen::Index i = 0; i < state.size(); ++i) {
+    total += std::norm(state[i]);
+    cumulative[i] = total;
+  }
+  if (!(total > 0.)) {
+    throw std::invalid_argument("Cannot sample from a zero state");
+  }
+  RNG rng;
+  rng.set_seed(seed);
+  MatrixXb shots(n_shots, n_qubits);
+  for (unsigned shot = 0; shot < n_shots; ++shot) {
+    // A uniform double in [0, total), built from 53 random bits, so that it
+    // is the same on every platform.
+    const double u = (rng() >> 11) * 0x1.0p-53 * total;
+    const std::size_t index = std::min<std::size_t>(
+        std::upper_bound(cumulative.begin(), cumulative.end(), u) -
+            cumulative.begin(),
+        cumulative.size() - 1);
+    for (unsigned qb = 0; qb < n_qubits; ++qb) {
+      shots(shot, qb) = (index >> (n_qubits - 1 - qb)) & 1;
+    }
+  }
+  return shots;
+}
+
+MatrixXb sample_shots(
+    const Circuit& circ, unsigned n_shots, std::size_t seed,
+    unsigned max_number_of_qubits, unsigned n_threads) {
+  return sample_shots(
+      get_statevector(circ, EPS, max_number_of_qubits, n_threads), n_shots,
+      seed);
+}
+
+Complex expectation(
+    const Circuit& circ, const std::vector<SpCxPauliTensor>& op,
+    unsigned max_number_of_qubits, unsigned n_threads) {
+  const StateVector state =
+      get_statevector(circ, EPS, max_number_of_qubits, n_threads);
+  const qubit_vector_t qubits = circ.all_qubits();
+  Complex result = 0.;
+  for (const SpCxPauliTensor& term : op) {
+    result +=
+        term.coeff *
+        pauli_state_expectation(term.string, state, qubits, n_threads);
+  }
+  return result;
+}
+
+}  // namespace tket_sim
+}  // namespace tket
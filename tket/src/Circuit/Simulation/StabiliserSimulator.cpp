@@ -0,0 +1,358 @@
+// Copyright Quantinuum
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tket/Circuit/Simulation/StabiliserSimulator.hpp"
+
+#include <algorithm>
+#include <map>
+#include <optional>
+#include <stdexcept>
+#include <tkassert/Assert.hpp>
+
+#include "tket/Circuit/Boxes.hpp"
+#include "tket/Circuit/CircUtils.hpp"
+#include "tket/Circuit/Circuit.hpp"
+#include "tket/Circuit/Conditional.hpp"
+#include "tket/Gate/Gate.hpp"
+#include "tket/Gate/GatePtr.hpp"
+#include "tket/OpType/OpTypeFunctions.hpp"
+#include "tket/OpType/OpTypeInfo.hpp"
+#include "tket/Utils/Expression.hpp"
+
+namespace tket {
+namespace tket_sim {
+
+StabiliserState::StabiliserState(unsigned n_qubits)
+    : n_qubits_(n_qubits),
+      tab_(
+          GF2Matrix(2 * n_qubits + 1, n_qubits),
+          GF2Matrix(2 * n_qubits + 1, n_qubits),
+          VectorXb::Zero(2 * n_qubits + 1)) {
+  for (unsigned i = 0; i < n_qubits; ++i) {
+    tab_.xmat(i, i) = true;
+    tab_.zmat(n_qubits + i, i) = true;
+  }
+}
+
+void StabiliserState::apply_gate(
+    OpType type, const std::vector<unsigned> &qbs) {
+  tab_.apply_gate(type, qbs);
+}
+
+void StabiliserState::apply_pauli_rotation(
+    const std::vector<Pauli> &string, const std::vector<unsigned> &qbs,
+    unsigned half_pis) {
+  DensePauliMap dense(n_qubits_, Pauli::I);
+  for (unsigned i = 0; i < qbs.size(); ++i) dense.at(qbs.at(i)) = string.at(i);
+  tab_.apply_pauli_gadget(PauliStabiliser(dense), half_pis);
+}
+
+void StabiliserState::clear_row(unsigned r) {
+  std::fill_n(tab_.xmat.row_data(r), tab_.xmat.row_words(), 0);
+  std::fill_n(tab_.zmat.row_data(r), tab_.zmat.row_words(), 0);
+  tab_.phase(r) = false;
+}
+
+bool StabiliserState::measure(unsigned qb, RNG &rng) {
+  const unsigned n = n_qubits_;
+  std::optional<unsigned> p;
+  for (unsigned i = n; i < 2 * n; ++i) {
+    if (tab_.xmat(i, qb)) {
+      p = i;
+      break;
+    }
+  }
+  if (p) {
+    // Some stabiliser anticommutes with Z_qb, so the outcome is random. Make
+    // it the only row anticommuting with Z_qb (apart from its destabiliser,
+    // which is overwritten next), then replace it with +-Z_qb.
+    for (unsigned i = 0; i < 2 * n; ++i) {
+      if (i != *p && i + n != *p && tab_.xmat(i, qb)) tab_.row_mult(*p, i);
+    }
+    tab_.xmat.copy_row(*p, *p - n);
+    tab_.zmat.copy_row(*p, *p - n);
+    tab_.phase(*p - n) = tab_.phase(*p);
+    const bool outcome = rng.get_size_t(1) == 1;
+    clear_row(*p);
+    tab_.zmat(*p, qb) = true;
+    tab_.phase(*p) = outcome;
+    return outcome;
+  }
+  // Z_qb is in the stabiliser group: the destabilisers anticommuting with it
+  // pick out the stabilisers whose product is +-Z_qb.
+  const unsigned scratch = 2 * n;
+  clear_row(scratch);
+  for (unsigned i = 0; i < n; ++i) {
+    if (tab_.xmat(i, qb)) tab_.row_mult(i + n, scratch);
+  }
+  return tab_.phase(scratch);
+}
+
+void StabiliserState::reset(unsigned qb, RNG &rng) {
+  if (measure(qb, rng)) tab_.apply_X(qb);
+}
+
+SymplecticTableau StabiliserState::get_stabilisers() const {
+  const unsigned n = n_qubits_;
+  GF2Matrix xmat(n, n), zmat(n, n);
+  VectorXb phase(n);
+  for (unsigned i = 0; i < n; ++i) {
+    std::copy_n(tab_.xmat.row_data(n + i), xmat.row_words(), xmat.row_data(i));
+    std::copy_n(tab_.zmat.row_data(n + i), zmat.row_words(), zmat.row_data(i));
+    phase(i) = tab_.phase(n + i);
+  }
+  return SymplecticTableau(xmat, zmat, phase);
+}
+
+namespace {
+
+// The state of one run of a circuit: the quantum state, the values of the
+// classical bits and the source of random measurement outcomes.
+struct SimContext {
+  StabiliserState &state;
+  std::vector<bool> &bits;
+  RNG &rng;
+};
+
+}  // namespace
+
+static void apply_commands(
+    const std::vector<Command>::const_iterator &begin,
+    const std::vector<Command>::const_iterator &end,
+    const std::map<UnitID, unsigned> &index, SimContext &context);
+
+static std::map<UnitID, unsigned> get_unit_indices(const Circuit &circ) {
+  std::map<UnitID, unsigned> index;
+  unsigned i = 0;
+  for (const Qubit &q : circ.all_qubits()) index[q] = i++;
+  i = 0;
+  for (const Bit &b : circ.all_bits()) index[b] = i++;
+  return index;
+}
+
+static void apply_circuit(
+    const Circuit &circ, const std::vector<unsigned> &qbs,
+    const std::vector<unsigned> &bits, SimContext &context) {
+  // Map the units of the subcircuit to the indices in the parent.
+  std::map<UnitID, unsigned> index;
+  const qubit_vector_t sub_qubits = circ.all_qubits();
+  const bit_vector_t sub_bits = circ.all_bits();
+  TKET_ASSERT(sub_qubits.size() <= qbs.size());
+  TKET_ASSERT(sub_bits.size() <= bits.size());
+  for (unsigned i = 0; i < sub_qubits.size(); ++i) {
+    index[sub_qubits[i]] = qbs[i];
+  }
+  for (unsigned i = 0; i < sub_bits.size(); ++i) index[sub_bits[i]] = bits[i];
+  const std::vector<Command> commands = circ.get_commands();
+  apply_commands(commands.begin(), commands.end(), index, context);
+}
+
+static unsigned get_half_pis(const Expr &angle, OpType type) {
+  std::optional<unsigned> half_pis = equiv_Clifford(angle);
+  if (!half_pis) {
+    throw BadOpType(
+        "Cannot simulate as a stabiliser state: not a Clifford angle", type);
+  }
+  return *half_pis;
+}
+
+// Apply Rz(a) Rx(b) Rz(c), which is Clifford even if a and c are not
+// separately Clifford angles when b is a multiple of pi.
+static void apply_tk1(
+    const std::vector<Expr> &angles, unsigned qb, OpType type,
+    SimContext &context) {
+  const Expr &a = angles.at(0), &b = angles.at(1), &c = angles.at(2);
+  if (equiv_0(b)) {
+    context.state.apply_pauli_rotation(
+        {Pauli::Z}, {qb}, get_half_pis(a + c, type));
+  } else if (equiv_0(b - 1)) {
+    context.state.apply_pauli_rotation({Pauli::X}, {qb}, 2);
+    context.state.apply_pauli_rotation(
+        {Pauli::Z}, {qb}, get_half_pis(a - c, type));
+  } else {
+    context.state.apply_pauli_rotation({Pauli::Z}, {qb}, get_half_pis(c, type));
+    context.state.apply_pauli_rotation({Pauli::X}, {qb}, get_half_pis(b, type));
+    context.state.apply_pauli_rotation({Pauli::Z}, {qb}, get_half_pis(a, type));
+  }
+}
+
+static void apply_op(
+    const Op_ptr &op, const std::vector<unsigned> &qbs,
+    const std::vector<unsigned> &bits, SimContext &context) {
+  const OpType type = op->get_type();
+  switch (type) {
+    case OpType::Barrier:
+    case OpType::noop:
+    case OpType::Phase:
+      return;
+    case OpType::Measure:
+      context.bits.at(bits.at(0)) =
+          context.state.measure(qbs.at(0), context.rng);
+      return;
+    case OpType::Reset:
+      context.state.reset(qbs.at(0), context.rng);
+      return;
+    case OpType::Conditional: {
+      const Conditional &cond = static_cast<const Conditional &>(*op);
+      const unsigned width = cond.get_width();
+      unsigned value = 0;
+      for (unsigned i = 0; i < width; ++i) {
+        if (context.bits.at(bits.at(i))) value |= 1u << i;
+      }
+      if (value == cond.get_value()) {
+        apply_op(
+            cond.get_op(), qbs,
+            std::vector<unsigned>(bits.begin() + width, bits.end()), context);
+      }
+      return;
+    }
+    case OpType::Rz:
+    case OpType::U1:
+      context.state.apply_pauli_rotation(
+          {Pauli::Z}, qbs, get_half_pis(op->get_params().at(0), type));
+      return;
+    case OpType::Rx:
+      context.state.apply_pauli_rotation(
+          {Pauli::X}, qbs, get_half_pis(op->get_params().at(0), type));
+      return;
+    case OpType::Ry:
+      context.state.apply_pauli_rotation(
+          {Pauli::Y}, qbs, get_half_pis(op->get_params().at(0), type));
+      return;
+    case OpType::XXPhase:
+      context.state.apply_pauli_rotation(
+          {Pauli::X, Pauli::X}, qbs,
+          get_half_pis(op->get_params().at(0), type));
+      return;
+    case OpType::YYPhase:
+      context.state.apply_pauli_rotation(
+          {Pauli::Y, Pauli::Y}, qbs,
+          get_half_pis(op->get_params().at(0), type));
+      return;
+    case OpType::ZZPhase:
+    case OpType::PhaseGadget:
+      context.state.apply_pauli_rotation(
+          std::vector<Pauli>(qbs.size(), Pauli::Z), qbs,
+          get_half_pis(op->get_params().at(0), type));
+      return;
+    default:
+      break;
+  }
+  if (is_clifford_type(type) && op->get_desc().is_gate()) {
+    context.state.apply_gate(type, qbs);
+    return;
+  }
+  if (op->get_desc().is_gate()) {
+    const Gate_ptr gate = as_gate_ptr(op);
+    if (qbs.size() == 1) {
+      apply_tk1(gate->get_tk1_angles(), qbs.at(0), type, context);
+    } else {
+      apply_circuit(with_CX(gate), qbs, bits, context);
+    }
+    return;
+  }
+  if (op->get_desc().is_box()) {
+    const std::shared_ptr<const Box> box =
+        std::dynamic_pointer_cast<const Box>(op);
+    TKET_ASSERT(box);
+    const std::shared_ptr<Circuit> box_circ = box->to_circuit();
+    if (box_circ) {
+      apply_circuit(*box_circ, qbs, bits, context);
+      return;
+    }
+  }
+  throw BadOpType("Cannot simulate as a stabiliser state", type);
+}
+
+static void apply_commands(
+    const std::vector<Command>::const_iterator &begin,
+    const std::vector<Command>::const_iterator &end,
+    const std::map<UnitID, unsigned> &index, SimContext &context) {
+  std::vector<unsigned> qbs, bits;
+  for (auto it = begin; it != end; ++it) {
+    qbs.clear();
+    bits.clear();
+    for (const UnitID &arg : it->get_args()) {
+      if (arg.type() == UnitType::Qubit) {
+        qbs.push_back(index.at(arg));
+      } else {
+        bits.push_back(index.at(arg));
+      }
+    }
+    apply_op(it->get_op_ptr(), qbs, bits, context);
+  }
+}
+
+SymplecticTableau get_stabiliser_state(const Circuit &circ, std::size_t seed) {
+  const unsigned n = circ.n_qubits();
+  StabiliserState state(n);
+  std::vector<bool> bits(circ.n_bits());
+  RNG rng;
+  rng.set_seed(seed);
+  SimContext context{state, bits, rng};
+  const std::vector<Command> commands = circ.get_commands();
+  const std::map<UnitID, unsigned> index = get_unit_indices(circ);
+  apply_commands(commands.begin(), commands.end(), index, context);
+  SymplecticTableau stabilisers = state.get_stabilisers();
+
+  // The wire starting at a qubit may end at another one.
+  const qubit_map_t perm = circ.implicit_qubit_permutation();
+  if (std::any_of(perm.begin(), perm.end(), [](const auto &pair) {
+        return pair.first != pair.second;
+      })) {
+    SymplecticTableau permuted = stabilisers;
+    for (const auto &[in, out] : perm) {
+      const unsigned from = index.at(in), to = index.at(out);
+      for (unsigned r = 0; r < n; ++r) {
+        permuted.xmat(r, to) = stabilisers.xmat(r, from);
+        permuted.zmat(r, to) = stabilisers.zmat(r, from);
+      }
+    }
+    stabilisers = std::move(permuted);
+  }
+  return stabilisers;
+}
+
+MatrixXb sample_clifford_shots(
+    const Circuit &circ, unsigned n_shots, std::size_t seed) {
+  StabiliserState state(circ.n_qubits());
+  std::vector<bool> bits(circ.n_bits());
+  RNG rng;
+  rng.set_seed(seed);
+  SimContext context{state, bits, rng};
+  const std::vector<Command> commands = circ.get_commands();
+  const std::map<UnitID, unsigned> index = get_unit_indices(circ);
+
+  // Gates do not depend on the random outcomes, so the commands before the
+  // first non-gate are shared by all shots.
+  const auto first_non_gate =
+      std::find_if(commands.begin(), commands.end(), [](const Command &com) {
+        const Op_ptr op = com.get_op_ptr();
+        return !op->get_desc().is_gate() && op->get_type() != OpType::Barrier;
+      });
+  apply_commands(commands.begin(), first_non_gate, index, context);
+  const StabiliserState prefix_state = state;
+
+  MatrixXb shots(n_shots, circ.n_bits());
+  for (unsigned shot = 0; shot < n_shots; ++shot) {
+    state = prefix_state;
+    std::fill(bits.begin(), bits.end(), false);
+    apply_commands(first_non_gate, commands.end(), index, context);
+    for (unsigned b = 0; b < bits.size(); ++b) shots(shot, b) = bits[b];
+  }
+  return shots;
+}
+
+}  // namespace tket_sim
+}  // namespace tket
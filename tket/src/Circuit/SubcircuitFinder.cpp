@@ -13,7 +13,6 @@
 // limitations under the License.
 
 #include <algorithm>
-#include <boost/graph/transitive_closure.hpp>
 #include <cstddef>
 #include <iterator>
 #include <optional>
@@ -22,6 +21,7 @@
 
 #include "tket/Circuit/Circuit.hpp"
 #include "tket/Circuit/DAGDefs.hpp"
+#include "tket/Circuit/DAGReachability.hpp"
 #include "tket/OpType/EdgeType.hpp"
 
 namespace tket {
@@ -93,37 +93,11 @@ static subcircuit_info_t convex_union(
   return {verts, preds, succs};
 }
 
-static std::set<std::pair<Vertex, Vertex>> order_relations(
-    Circuit *circ /*const*/) {
-  // Put the vertices in reverse topological order:
-  VertexVec verts;
-  boost::topological_sort(circ->dag, std::back_inserter(verts));
-  // Construct a map v --> {all vertices in the future of v}:
-  std::map<Vertex, VertexSet> futures;
-  for (const Vertex &v : verts) {
-    VertexSet v_futures = {v};
-    for (const Vertex &w : circ->get_successors(v)) {
-      const VertexSet &w_futures = futures[w];
-      v_futures.insert(w_futures.begin(), w_futures.end());
-    }
-    futures[v] = v_futures;
-  }
-  // Construct the set of order relations:
-  std::set<std::pair<Vertex, Vertex>> rels;
-  for (const auto &v_ws : futures) {
-    const Vertex &v = v_ws.first;
-    for (const Vertex &w : v_ws.second) {
-      rels.insert({v, w});
-    }
-  }
-  return rels;
-}
-
 // Helper class for finding connected convex subcircuits.
 class SubcircuitFinder {
  public:
   SubcircuitFinder(Circuit *circ /*const*/)
-      : circ_(circ), order_relations_(order_relations(circ)) {}
+      : circ_(circ), reachability_(*circ) {}
   std::vector<VertexSet> find_subcircuits(
       std::function<bool(Op_ptr)> criterion) {
     // Find a maximal partition of the vertices satisfying the criterion into
@@ -177,17 +151,13 @@ class SubcircuitFinder {
     const VertexSet &preds1 = subcircuit_info1.preds;
     const VertexSet &succs1 = subcircuit_info1.succs;
     for (const Vertex &v0 : succs0) {
-      for (const Vertex &v1 : preds1) {
-        if (order_relations_.contains({v0, v1})) {
-          return false;
-        }
+      if (reachability_.reaches_any(v0, preds1)) {
+        return false;
       }
     }
     for (const Vertex &v1 : succs1) {
-      for (const Vertex &v0 : preds0) {
-        if (order_relations_.contains({v1, v0})) {
-          return false;
-        }
+      if (reachability_.reaches_any(v1, preds0)) {
+        return false;
       }
     }
     return true;
@@ -212,12 +182,11 @@ class SubcircuitFinder {
     return std::nullopt;
   }
   const Circuit *circ_;
-  std::set<std::pair<Vertex, Vertex>> order_relations_;
+  DAGReachability reachability_;
 };
 
 std::vector<VertexSet> Circuit::get_subcircuits(
     std::function<bool(Op_ptr)> criterion) /*const*/ {
-  index_vertices();
   SubcircuitFinder finder(this);
   return finder.find_subcircuits(criterion);
 }
@@ -16,13 +16,18 @@
 // ALL METHODS TO OBTAIN COMPLEX GRAPH INFORMATIION//
 ////////////////////////////////////////////////////
 
+#include <algorithm>
+#include <boost/functional/hash.hpp>
 #include <tklog/TketLog.hpp>
+#include <tuple>
+#include <unordered_map>
 
 #include "tket/Circuit/Circuit.hpp"
 #include "tket/Circuit/DAGDefs.hpp"
 #include "tket/Circuit/Slices.hpp"
 #include "tket/OpType/EdgeType.hpp"
 #include "tket/OpType/OpType.hpp"
+#include "tket/OpType/OpTypeFunctions.hpp"
 #include "tket/Ops/OpPtr.hpp"
 
 namespace tket {
@@ -516,6 +521,77 @@ unsigned Circuit::depth_2q() const {
   return count;
 }
 
+std::size_t Circuit::structural_hash() const {
+  // Hash vertices in topological order, each from its predecessors' hashes.
+  std::unordered_map<Vertex, std::size_t> hashes;
+  std::unordered_map<Vertex, std::size_t> n_pending;
+  std::vector<Vertex> ready;
+  BGL_FORALL_VERTICES(v, dag, DAG) {
+    const std::size_t n_in = boost::in_degree(v, dag);
+    if (n_in == 0) {
+      ready.push_back(v);
+    } else {
+      n_pending.emplace(v, n_in);
+    }
+  }
+  std::vector<std::tuple<port_t, EdgeType, std::size_t, port_t>> ins;
+  while (!ready.empty()) {
+    const Vertex v = ready.back();
+    ready.pop_back();
+    const Op_ptr op = get_Op_ptr_from_Vertex(v);
+    std::size_t seed = 0;
+    if (is_boundary_type(op->get_type())) {
+      boost::hash_combine(seed, op->get_type());
+    } else {
+      seed = op->hash();
+    }
+    const std::optional<std::string> &opgroup = get_opgroup_from_Vertex(v);
+    if (opgroup) boost::hash_combine(seed, *opgroup);
+    const auto found_in = boundary.get<TagIn>().find(v);
+    if (found_in != boundary.get<TagIn>().end()) {
+      boost::hash_combine(seed, found_in->id_);
+    }
+    ins.clear();
+    BGL_FORALL_INEDGES(v, e, dag, DAG) {
+      ins.emplace_back(
+          get_target_port(e), get_edgetype(e),
+          hashes.at(boost::source(e, dag)), get_source_port(e));
+    }
+    std::sort(ins.begin(), ins.end());
+    for (const auto &[t_port, type, s_hash, s_port] : ins) {
+      boost::hash_combine(seed, t_port);
+      boost::hash_combine(seed, type);
+      boost::hash_combine(seed, s_hash);
+      boost::hash_combine(seed, s_port);
+    }
+    hashes.emplace(v, seed);
+    BGL_FORALL_OUTEDGES(v, e, dag, DAG) {
+      const Vertex t = boost::target(e, dag);
+      if (--n_pending.at(t) == 0) ready.push_back(t);
+    }
+  }
+
+  std::size_t seed = 0;
+  if (name) boost::hash_combine(seed, *name);
+  const ExprPtr phase_ptr = phase;
+  boost::hash_combine(seed, phase_ptr->hash());
+  for (const BoundaryElement &el : boundary.get<TagID>()) {
+    boost::hash_combine(seed, el.id_);
+    boost::hash_combine(seed, hashes.at(el.out_));
+  }
+  // Vertices with no path to an output, such as argument-free phase gates.
+  std::vector<std::size_t> loose;
+  BGL_FORALL_VERTICES(v, dag, DAG) {
+    if (boost::out_degree(v, dag) == 0 &&
+        boundary.get<TagOut>().find(v) == boundary.get<TagOut>().end()) {
+      loose.push_back(hashes.at(v));
+    }
+  }
+  std::sort(loose.begin(), loose.end());
+  for (std::size_t h : loose) boost::hash_combine(seed, h);
+  return seed;
+}
+
 std::map<Vertex, unit_set_t> Circuit::vertex_unit_map() const {
   std::map<Vertex, unit_set_t> map;
   BGL_FORALL_VERTICES(v, dag, DAG) { map[v] = {}; }
@@ -628,6 +704,80 @@ Circuit::CommandIterator& Circuit::CommandIterator::operator++() {
   return *this;
 }
 
+Circuit::CommandViewIterator::CommandViewIterator(const Circuit& circ)
+    : slices_(circ.slice_begin()),
+      current_index_(0),
+      circ_(&circ),
+      n_args_(0) {
+  if (slices_.cut_.slice->empty()) {
+    *this = CommandViewIterator();
+    return;
+  }
+  // Each unit occupies one port at a time; a few more are live while a
+  // command is being read.
+  port_units_.reserve(circ.boundary.size() + 8);
+  for (const BoundaryElement& el : circ.boundary) {
+    port_units_.emplace(VertPort{el.in_, 0}, el.id_);
+  }
+  current_vertex_ = (*slices_.cut_.slice)[0];
+  read_args();
+}
+
+CommandView Circuit::CommandViewIterator::operator*() const {
+  const VertexProperties& props = circ_->dag[current_vertex_];
+  return CommandView(
+      props.op, std::span<const UnitID>(args_.data(), n_args_), props.opgroup,
+      current_vertex_);
+}
+
+Circuit::CommandViewIterator& Circuit::CommandViewIterator::operator++() {
+  if (circ_ == nullptr) return *this;
+  if (current_index_ + 1 == slices_.cut_.slice->size()) {
+    if (slices_.finished()) {
+      *this = CommandViewIterator();
+      return *this;
+    }
+    ++slices_;
+    current_index_ = 0;
+    TKET_ASSERT(!slices_.cut_.slice->empty());
+  } else {
+    ++current_index_;
+  }
+  current_vertex_ = (*slices_.cut_.slice)[current_index_];
+  read_args();
+  return *this;
+}
+
+void Circuit::CommandViewIterator::read_args() {
+  const Circuit& circ = *circ_;
+  const Vertex v = current_vertex_;
+  n_args_ = circ.n_in_edges(v);
+  if (args_.size() < n_args_) args_.resize(n_args_);
+  // Boolean edges share their source port with the linear edge of the bit
+  // they read, which may also be an input to this vertex, so look up all the
+  // args before moving any units on.
+  BGL_FORALL_INEDGES(v, e, circ.dag, DAG) {
+    port_unit_map_t::const_iterator found = port_units_.find(
+        {circ.source(e), circ.get_source_port(e)});
+    if (found == port_units_.end()) {
+      throw CircuitInvalidity(
+          "Vertex edges not found in frontier. Edge: " +
+          circ.get_Op_ptr_from_Vertex(circ.source(e))->get_name() + " -> " +
+          circ.get_Op_ptr_from_Vertex(v)->get_name());
+    }
+    args_[circ.get_target_port(e)] = found->second;
+  }
+  // Slicing places every reader of a Boolean edge no later than the next
+  // writer of the bit, so a port is finished with once its linear edge has
+  // been consumed.
+  BGL_FORALL_INEDGES(v, e, circ.dag, DAG) {
+    if (circ.get_edgetype(e) == EdgeType::Boolean) continue;
+    const port_t p = circ.get_target_port(e);
+    port_units_.erase({circ.source(e), circ.get_source_port(e)});
+    port_units_.emplace(VertPort{v, p}, args_[p]);
+  }
+}
+
 unit_vector_t Circuit::args_from_frontier(
     const Vertex& vert, std::shared_ptr<const unit_frontier_t> u_frontier,
     std::shared_ptr<const b_frontier_t> prev_b_frontier) const {
@@ -355,25 +355,15 @@ void ChoiMixTableau::apply_gate(
         // reinsert qubit initialised to maximally mixed state (no coherent
         // stabilizers)
         col_index_.insert({{qbs.at(0), TableauSegment::Input}, col});
-        tab_.xmat.conservativeResize(rows, col + 1);
-        tab_.xmat.col(col) = MatrixXb::Zero(rows, 1);
-        tab_.zmat.conservativeResize(rows, col + 1);
-        tab_.zmat.col(col) = MatrixXb::Zero(rows, 1);
+        tab_.conservative_resize(rows, col + 1);
       } else {
         discard_qubit(qbs.at(0), TableauSegment::Output);
         unsigned col = get_n_boundaries();
         unsigned rows = get_n_rows();
         // reinsert qubit initialised to |0> (add a Z stabilizer)
         col_index_.insert({{qbs.at(0), TableauSegment::Output}, col});
-        tab_.xmat.conservativeResize(rows + 1, col + 1);
-        tab_.xmat.col(col) = MatrixXb::Zero(rows + 1, 1);
-        tab_.xmat.row(rows) = MatrixXb::Zero(1, col + 1);
-        tab_.zmat.conservativeResize(rows + 1, col + 1);
-        tab_.zmat.col(col) = MatrixXb::Zero(rows + 1, 1);
-        tab_.zmat.row(rows) = MatrixXb::Zero(1, col + 1);
+        tab_.conservative_resize(rows + 1, col + 1);
         tab_.zmat(rows, col) = true;
-        tab_.phase.conservativeResize(rows + 1);
-        tab_.phase(rows) = false;
       }
       break;
     }
@@ -522,14 +512,8 @@ void ChoiMixTableau::remove_row(unsigned row) {
         std::to_string(get_n_rows()) + " rows");
   unsigned n_rows = get_n_rows();
   unsigned n_cols = get_n_boundaries();
-  if (row < n_rows - 1) {
-    tab_.xmat.row(row) = tab_.xmat.row(n_rows - 1);
-    tab_.zmat.row(row) = tab_.zmat.row(n_rows - 1);
-    tab_.phase(row) = tab_.phase(n_rows - 1);
-  }
-  tab_.xmat.conservativeResize(n_rows - 1, n_cols);
-  tab_.zmat.conservativeResize(n_rows - 1, n_cols);
-  tab_.phase.conservativeResize(n_rows - 1);
+  if (row < n_rows - 1) tab_.swap_rows(row, n_rows - 1);
+  tab_.conservative_resize(n_rows - 1, n_cols);
 }
 
 void ChoiMixTableau::remove_col(unsigned col) {
@@ -540,11 +524,10 @@ void ChoiMixTableau::remove_col(unsigned col) {
   unsigned n_rows = get_n_rows();
   unsigned n_cols = get_n_boundaries();
   if (col < n_cols - 1) {
-    tab_.xmat.col(col) = tab_.xmat.col(n_cols - 1);
-    tab_.zmat.col(col) = tab_.zmat.col(n_cols - 1);
+    tab_.xmat.copy_col(n_cols - 1, col);
+    tab_.zmat.copy_col(n_cols - 1, col);
   }
-  tab_.xmat.conservativeResize(n_rows, n_cols - 1);
-  tab_.zmat.conservativeResize(n_rows, n_cols - 1);
+  tab_.conservative_resize(n_rows, n_cols - 1);
   col_index_.right.erase(col);
   if (col < n_cols - 1) {
     tableau_col_index_t::right_iterator it = col_index_.right.find(n_cols - 1);
@@ -583,13 +566,15 @@ void ChoiMixTableau::canonical_column_order(TableauSegment first) {
     }
   }
   unsigned n_rows = get_n_rows();
-  MatrixXb xmat = MatrixXb::Zero(n_rows, i);
-  MatrixXb zmat = MatrixXb::Zero(n_rows, i);
+  GF2Matrix xmat(n_rows, i);
+  GF2Matrix zmat(n_rows, i);
   for (unsigned j = 0; j < i; ++j) {
     col_key_t key = new_index.right.at(j);
     unsigned c = col_index_.left.at(key);
-    xmat.col(j) = tab_.xmat.col(c);
-    zmat.col(j) = tab_.zmat.col(c);
+    for (unsigned r = 0; r < n_rows; ++r) {
+      xmat(r, j) = tab_.xmat(r, c);
+      zmat(r, j) = tab_.zmat(r, c);
+    }
   }
   tab_ = SymplecticTableau(xmat, zmat, tab_.phase);
   col_index_ = new_index;
@@ -629,10 +614,10 @@ ChoiMixTableau ChoiMixTableau::compose(
   }
   MatrixXb fullx(f_rows + s_rows, f_cols + s_cols),
       fullz(f_rows + s_rows, f_cols + s_cols);
-  fullx << first.tab_.xmat, MatrixXb::Zero(f_rows, s_cols),
-      MatrixXb::Zero(s_rows, f_cols), second.tab_.xmat;
-  fullz << first.tab_.zmat, MatrixXb::Zero(f_rows, s_cols),
-      MatrixXb::Zero(s_rows, f_cols), second.tab_.zmat;
+  fullx << first.tab_.xmat.to_MatrixXb(), MatrixXb::Zero(f_rows, s_cols),
+      MatrixXb::Zero(s_rows, f_cols), second.tab_.xmat.to_MatrixXb();
+  fullz << first.tab_.zmat.to_MatrixXb(), MatrixXb::Zero(f_rows, s_cols),
+      MatrixXb::Zero(s_rows, f_cols), second.tab_.zmat.to_MatrixXb();
   VectorXb fullph(f_rows + s_rows);
   fullph << first.tab_.phase, second.tab_.phase;
   ChoiMixTableau combined(fullx, fullz, fullph, 0);
@@ -14,6 +14,8 @@
 
 #include "tket/Clifford/SymplecticTableau.hpp"
 
+#include <array>
+#include <bit>
 #include <stdexcept>
 
 #include "tket/OpType/OpTypeInfo.hpp"
@@ -62,6 +64,10 @@ const std::map<std::pair<BoolPauli, BoolPauli>, std::pair<BoolPauli, Complex>>
 
 SymplecticTableau::SymplecticTableau(
     const MatrixXb &xmat, const MatrixXb &zmat, const VectorXb &phase)
+    : SymplecticTableau(GF2Matrix(xmat), GF2Matrix(zmat), phase) {}
+
+SymplecticTableau::SymplecticTableau(
+    const GF2Matrix &xmat, const GF2Matrix &zmat, const VectorXb &phase)
     : xmat(xmat), zmat(zmat), phase(phase) {
   if (zmat.rows() != xmat.rows() || phase.size() != xmat.rows())
     throw std::invalid_argument(
@@ -75,8 +81,8 @@ SymplecticTableau::SymplecticTableau(const PauliStabiliserVec &rows) {
   unsigned n_rows = rows.size();
   unsigned n_qubits = 0;
   if (n_rows != 0) n_qubits = rows[0].string.size();
-  xmat = MatrixXb::Zero(n_rows, n_qubits);
-  zmat = MatrixXb::Zero(n_rows, n_qubits);
+  xmat = GF2Matrix(n_rows, n_qubits);
+  zmat = GF2Matrix(n_rows, n_qubits);
   phase = VectorXb::Zero(n_rows);
   for (unsigned i = 0; i < n_rows; ++i) {
     const PauliStabiliser &stab = rows[i];
@@ -105,15 +111,17 @@ PauliStabiliser SymplecticTableau::get_pauli(unsigned i) const {
 }
 
 std::ostream &operator<<(std::ostream &os, const SymplecticTableau &tab) {
+  const MatrixXb xmat = tab.xmat.to_MatrixXb();
+  const MatrixXb zmat = tab.zmat.to_MatrixXb();
   for (unsigned i = 0; i < tab.get_n_rows(); ++i) {
-    os << tab.xmat.row(i) << " " << tab.zmat.row(i) << " " << tab.phase(i)
+    os << xmat.row(i) << " " << zmat.row(i) << " " << tab.phase(i)
        << std::endl;
   }
   return os;
 }
 
 bool SymplecticTableau::operator==(const SymplecticTableau &other) const {
-  // Need this to short-circuit before matrix checks as comparing matrices of
+  // Need this to short-circuit before the phase check as comparing vectors of
   // different sizes will throw an exception
   return (this->get_n_rows() == other.get_n_rows()) &&
          (this->get_n_qubits() == other.get_n_qubits()) &&
@@ -122,17 +130,36 @@ bool SymplecticTableau::operator==(const SymplecticTableau &other) const {
 }
 
 void SymplecticTableau::row_mult(unsigned ra, unsigned rw, Complex coeff) {
-  MatrixXb::RowXpr xa = xmat.row(ra);
-  MatrixXb::RowXpr za = zmat.row(ra);
-  MatrixXb::RowXpr xw = xmat.row(rw);
-  MatrixXb::RowXpr zw = zmat.row(rw);
-  row_mult(xa, za, phase(ra), xw, zw, phase(rw), coeff, xw, zw, phase(rw));
+  row_mult(
+      xmat.row_data(ra), zmat.row_data(ra), phase(ra), xmat.row_data(rw),
+      zmat.row_data(rw), phase(rw), coeff, xmat.row_data(rw),
+      zmat.row_data(rw), phase(rw));
+}
+
+void SymplecticTableau::swap_rows(unsigned r1, unsigned r2) {
+  xmat.swap_rows(r1, r2);
+  zmat.swap_rows(r1, r2);
+  std::swap(phase(r1), phase(r2));
+}
+
+void SymplecticTableau::conservative_resize(
+    unsigned n_rows, unsigned n_qubits) {
+  const unsigned old_rows = get_n_rows();
+  xmat.conservative_resize(n_rows, n_qubits);
+  zmat.conservative_resize(n_rows, n_qubits);
+  phase.conservativeResize(n_rows);
+  for (unsigned i = old_rows; i < n_rows; ++i) phase(i) = false;
 }
 
 void SymplecticTableau::apply_S(unsigned qb) {
-  MatrixXb::ColXpr xcol = xmat.col(qb);
-  MatrixXb::ColXpr zcol = zmat.col(qb);
-  col_mult(xcol, zcol, false, zcol, phase);
+  const unsigned w = qb / GF2Matrix::word_bits;
+  const word_t m = word_t{1} << (qb % GF2Matrix::word_bits);
+  for (unsigned i = 0; i < get_n_rows(); ++i) {
+    const word_t x = xmat.row_data(i)[w] & m;
+    word_t &z = zmat.row_data(i)[w];
+    phase(i) = phase(i) ^ ((x & z) != 0);
+    z ^= x;
+  }
 }
 
 void SymplecticTableau::apply_Z(unsigned qb) {
@@ -140,9 +167,14 @@ void SymplecticTableau::apply_Z(unsigned qb) {
 }
 
 void SymplecticTableau::apply_V(unsigned qb) {
-  MatrixXb::ColXpr xcol = xmat.col(qb);
-  MatrixXb::ColXpr zcol = zmat.col(qb);
-  col_mult(zcol, xcol, true, xcol, phase);
+  const unsigned w = qb / GF2Matrix::word_bits;
+  const word_t m = word_t{1} << (qb % GF2Matrix::word_bits);
+  for (unsigned i = 0; i < get_n_rows(); ++i) {
+    word_t &x = xmat.row_data(i)[w];
+    const word_t z = zmat.row_data(i)[w] & m;
+    phase(i) = phase(i) ^ ((z & ~x) != 0);
+    x ^= z;
+  }
 }
 
 void SymplecticTableau::apply_X(unsigned qb) {
@@ -150,11 +182,15 @@ void SymplecticTableau::apply_X(unsigned qb) {
 }
 
 void SymplecticTableau::apply_H(unsigned qb) {
+  const unsigned w = qb / GF2Matrix::word_bits;
+  const word_t m = word_t{1} << (qb % GF2Matrix::word_bits);
   for (unsigned i = 0; i < get_n_rows(); ++i) {
-    phase(i) = phase(i) ^ (xmat(i, qb) && zmat(i, qb));
-    bool temp = xmat(i, qb);
-    xmat(i, qb) = zmat(i, qb);
-    zmat(i, qb) = temp;
+    word_t &x = xmat.row_data(i)[w];
+    word_t &z = zmat.row_data(i)[w];
+    const word_t diff = (x ^ z) & m;
+    phase(i) = phase(i) ^ ((x & z & m) != 0);
+    x ^= diff;
+    z ^= diff;
   }
 }
 
@@ -163,10 +199,13 @@ void SymplecticTableau::apply_CX(unsigned qc, unsigned qt) {
     throw std::logic_error(
         "Attempting to apply a CX with equal control and target in a tableau");
   for (unsigned i = 0; i < get_n_rows(); ++i) {
-    phase(i) =
-        phase(i) ^ (xmat(i, qc) && zmat(i, qt) && !(xmat(i, qt) ^ zmat(i, qc)));
-    xmat(i, qt) = xmat(i, qc) ^ xmat(i, qt);
-    zmat(i, qc) = zmat(i, qc) ^ zmat(i, qt);
+    bool xc = xmat(i, qc);
+    bool zc = zmat(i, qc);
+    bool xt = xmat(i, qt);
+    bool zt = zmat(i, qt);
+    phase(i) = phase(i) ^ (xc && zt && !(xt ^ zc));
+    xmat(i, qt) = xc ^ xt;
+    zmat(i, qc) = zc ^ zt;
   }
 }
 
@@ -312,43 +351,47 @@ void SymplecticTableau::apply_pauli_gadget(
 
   // From here, half_pis == 1 or 3
   // They act the same except for a phase flip on the product term
-  MatrixXb pauli_xrow = MatrixXb::Zero(1, n_qubits);
-  MatrixXb pauli_zrow = MatrixXb::Zero(1, n_qubits);
+  GF2Matrix pauli_xrow(1, n_qubits);
+  GF2Matrix pauli_zrow(1, n_qubits);
   for (unsigned i = 0; i < n_qubits; ++i) {
     Pauli p = pauli.string.at(i);
-    pauli_xrow(i) = (p == Pauli::X) || (p == Pauli::Y);
-    pauli_zrow(i) = (p == Pauli::Z) || (p == Pauli::Y);
+    pauli_xrow(0, i) = (p == Pauli::X) || (p == Pauli::Y);
+    pauli_zrow(0, i) = (p == Pauli::Z) || (p == Pauli::Y);
   }
   bool phase_flip = pauli.is_real_negative() ^ (half_pis == 3);
 
+  const word_t *px = pauli_xrow.row_data(0);
+  const word_t *pz = pauli_zrow.row_data(0);
+  const unsigned n_words = xmat.row_words();
   for (unsigned i = 0; i < get_n_rows(); ++i) {
-    bool anti = false;
-    MatrixXb::RowXpr xr = xmat.row(i);
-    MatrixXb::RowXpr zr = zmat.row(i);
-    for (unsigned q = 0; q < n_qubits; ++q) {
-      anti ^= (xr(q) && pauli_zrow(q));
-      anti ^= (zr(q) && pauli_xrow(q));
+    word_t *xr = xmat.row_data(i);
+    word_t *zr = zmat.row_data(i);
+    unsigned anti = 0;
+    for (unsigned w = 0; w < n_words; ++w) {
+      anti += std::popcount((xr[w] & pz[w]) ^ (zr[w] & px[w]));
     }
-    if (anti) {
-      row_mult(
-          xr, zr, phase(i), pauli_xrow.row(0), pauli_zrow.row(0), phase_flip,
-          i_, xr, zr, phase(i));
+    if (anti % 2 == 1) {
+      row_mult(xr, zr, phase(i), px, pz, phase_flip, i_, xr, zr, phase(i));
     }
   }
 }
 
 MatrixXb SymplecticTableau::anticommuting_rows() const {
   unsigned n_rows = get_n_rows();
+  const unsigned n_words = xmat.row_words();
   MatrixXb res = MatrixXb::Zero(n_rows, n_rows);
   for (unsigned i = 0; i < n_rows; ++i) {
+    const word_t *xi = xmat.row_data(i);
+    const word_t *zi = zmat.row_data(i);
     for (unsigned j = 0; j < i; ++j) {
-      bool anti = false;
-      for (unsigned q = 0; q < get_n_qubits(); ++q) {
-        anti ^= (xmat(i, q) && zmat(j, q));
-        anti ^= (xmat(j, q) && zmat(i, q));
+      const word_t *xj = xmat.row_data(j);
+      const word_t *zj = zmat.row_data(j);
+      unsigned anti = 0;
+      for (unsigned w = 0; w < n_words; ++w) {
+        anti += std::popcount((xi[w] & zj[w]) ^ (xj[w] & zi[w]));
       }
-      res(i, j) = anti;
-      res(j, i) = anti;
+      res(i, j) = anti % 2 == 1;
+      res(j, i) = anti % 2 == 1;
     }
   }
   return res;
@@ -361,8 +404,8 @@ unsigned SymplecticTableau::rank() const {
   unsigned empty_rows = 0;
   unsigned n_rows = get_n_rows();
   for (unsigned i = 0; i < n_rows; ++i) {
-    if (copy.xmat.row(n_rows - 1 - i).isZero() &&
-        copy.zmat.row(n_rows - 1 - i).isZero())
+    if (copy.xmat.row_is_zero(n_rows - 1 - i) &&
+        copy.zmat.row_is_zero(n_rows - 1 - i))
       ++empty_rows;
     else
       break;
@@ -372,61 +415,62 @@ unsigned SymplecticTableau::rank() const {
 
 SymplecticTableau SymplecticTableau::conjugate() const {
   SymplecticTableau conj(*this);
+  const unsigned n_words = xmat.row_words();
   for (unsigned i = 0; i < get_n_rows(); ++i) {
+    const word_t *x = xmat.row_data(i);
+    const word_t *z = zmat.row_data(i);
     unsigned sum = 0;
-    for (unsigned j = 0; j < get_n_qubits(); ++j) {
-      if (xmat(i, j) && zmat(i, j)) ++sum;
-    }
+    for (unsigned w = 0; w < n_words; ++w) sum += std::popcount(x[w] & z[w]);
     if (sum % 2 == 1) conj.phase(i) ^= true;
   }
   return conj;
 }
 
 void SymplecticTableau::gaussian_form() {
-  MatrixXb fullmat = MatrixXb::Zero(get_n_rows(), 2 * get_n_qubits());
-  fullmat(
-      Eigen::placeholders::all, Eigen::seq(0, Eigen::placeholders::last, 2)) =
-      xmat;
-  fullmat(
-      Eigen::placeholders::all, Eigen::seq(1, Eigen::placeholders::last, 2)) =
-      zmat;
+  // Interleave the x and z parts, so that each qubit is eliminated in turn.
+  GF2Matrix fullmat(get_n_rows(), 2 * get_n_qubits());
+  for (unsigned r = 0; r < get_n_rows(); ++r) {
+    for (unsigned q = 0; q < get_n_qubits(); ++q) {
+      if (xmat(r, q)) fullmat(r, 2 * q) = true;
+      if (zmat(r, q)) fullmat(r, 2 * q + 1) = true;
+    }
+  }
   std::vector<std::pair<unsigned, unsigned>> row_ops =
-      gaussian_elimination_row_ops(fullmat);
+      fullmat.gaussian_elimination_row_ops();
   for (const std::pair<unsigned, unsigned> &op : row_ops) {
     row_mult(op.first, op.second);
   }
 }
 
 void SymplecticTableau::row_mult(
-    const MatrixXb::RowXpr &xa, const MatrixXb::RowXpr &za, const bool &pa,
-    const MatrixXb::RowXpr &xb, const MatrixXb::RowXpr &zb, const bool &pb,
-    Complex phase, MatrixXb::RowXpr &xw, MatrixXb::RowXpr &zw, bool &pw) {
-  if (pa) phase *= -1;
-  if (pb) phase *= -1;
-  for (unsigned i = 0; i < get_n_qubits(); i++) {
-    std::pair<BoolPauli, Complex> res =
-        BoolPauli::mult_lut.at({{xa(i), za(i)}, {xb(i), zb(i)}});
-    xw(i) = res.first.x;
-    zw(i) = res.first.z;
-    phase *= res.second;
+    const word_t *xa, const word_t *za, bool pa, const word_t *xb,
+    const word_t *zb, bool pb, Complex phase, word_t *xw, word_t *zw,
+    bool &pw) const {
+  static const std::array<Complex, 4> i_powers = {1., i_, -1., -i_};
+  // Count the factors of i picked up on each qubit: XY = iZ, YZ = iX and
+  // ZX = iY, while the products in the opposite order give -i = i^3.
+  unsigned n_i = 0;
+  if (pa) n_i += 2;
+  if (pb) n_i += 2;
+  for (unsigned w = 0; w < xmat.row_words(); ++w) {
+    const word_t x1 = xa[w], z1 = za[w], x2 = xb[w], z2 = zb[w];
+    const word_t plus = (x1 & ~z1 & x2 & z2) | (x1 & z1 & ~x2 & z2) |
+                        (~x1 & z1 & x2 & ~z2);
+    const word_t minus = (x1 & ~z1 & ~x2 & z2) | (x1 & z1 & x2 & ~z2) |
+                         (~x1 & z1 & x2 & z2);
+    n_i += std::popcount(plus) + 3 * std::popcount(minus);
+    xw[w] = x1 ^ x2;
+    zw[w] = z1 ^ z2;
   }
+  phase *= i_powers[n_i % 4];
   pw = (phase == -1.);
 }
 
-void SymplecticTableau::col_mult(
-    const MatrixXb::ColXpr &a, const MatrixXb::ColXpr &b, bool flip,
-    MatrixXb::ColXpr &w, VectorXb &pw) {
-  for (unsigned i = 0; i < get_n_rows(); i++) {
-    pw(i) = pw(i) ^ (a(i) && (b(i) ^ flip));
-    w(i) = a(i) ^ b(i);
-  }
-}
-
 void to_json(nlohmann::json &j, const SymplecticTableau &tab) {
   j["nrows"] = tab.get_n_rows();
   j["nqubits"] = tab.get_n_qubits();
-  j["xmat"] = tab.xmat;
-  j["zmat"] = tab.zmat;
+  j["xmat"] = tab.xmat.to_MatrixXb();
+  j["zmat"] = tab.zmat.to_MatrixXb();
   j["phase"] = tab.phase;
 }
 
@@ -23,10 +23,12 @@
 namespace tket {
 
 UnitaryTableau::UnitaryTableau(unsigned n) : tab_({}) {
-  MatrixXb xmat(2 * n, n);
-  xmat << MatrixXb::Identity(n, n), MatrixXb::Zero(n, n);
-  MatrixXb zmat(2 * n, n);
-  zmat << MatrixXb::Zero(n, n), MatrixXb::Identity(n, n);
+  GF2Matrix xmat(2 * n, n);
+  GF2Matrix zmat(2 * n, n);
+  for (unsigned i = 0; i < n; ++i) {
+    xmat(i, i) = true;
+    zmat(i + n, i) = true;
+  }
   tab_ = SymplecticTableau(xmat, zmat, VectorXb::Zero(2 * n));
   qubits_ = boost::bimap<Qubit, unsigned>();
   for (unsigned i = 0; i < n; ++i) {
@@ -186,12 +188,7 @@ void UnitaryTableau::apply_X_at_end(const Qubit& qb) {
 
 void UnitaryTableau::apply_H_at_front(const Qubit& qb) {
   unsigned uqb = qubits_.left.at(qb);
-  unsigned n_qubits = qubits_.size();
-  bool temp = tab_.phase(uqb);
-  tab_.phase(uqb) = tab_.phase(uqb + n_qubits);
-  tab_.phase(uqb + n_qubits) = temp;
-  tab_.xmat.row(uqb).swap(tab_.xmat.row(uqb + n_qubits));
-  tab_.zmat.row(uqb).swap(tab_.zmat.row(uqb + n_qubits));
+  tab_.swap_rows(uqb, uqb + qubits_.size());
 }
 
 void UnitaryTableau::apply_H_at_end(const Qubit& qb) {
@@ -471,17 +468,18 @@ UnitaryTableau UnitaryTableau::conjugate() const {
 
 std::ostream& operator<<(std::ostream& os, const UnitaryTableau& tab) {
   unsigned nqs = tab.qubits_.size();
+  const MatrixXb xmat = tab.tab_.xmat.to_MatrixXb();
+  const MatrixXb zmat = tab.tab_.zmat.to_MatrixXb();
   for (unsigned i = 0; i < nqs; ++i) {
     Qubit qi = tab.qubits_.right.at(i);
-    os << "X@" << qi.repr() << "\t->\t" << tab.tab_.xmat.row(i) << "   "
-       << tab.tab_.zmat.row(i) << "   " << tab.tab_.phase(i) << std::endl;
+    os << "X@" << qi.repr() << "\t->\t" << xmat.row(i) << "   " << zmat.row(i)
+       << "   " << tab.tab_.phase(i) << std::endl;
   }
   os << "--" << std::endl;
   for (unsigned i = 0; i < nqs; ++i) {
     Qubit qi = tab.qubits_.right.at(i);
-    os << "Z@" << qi.repr() << "\t->\t" << tab.tab_.xmat.row(i + nqs) << "   "
-       << tab.tab_.zmat.row(i + nqs) << "   " << tab.tab_.phase(i + nqs)
-       << std::endl;
+    os << "Z@" << qi.repr() << "\t->\t" << xmat.row(i + nqs) << "   "
+       << zmat.row(i + nqs) << "   " << tab.tab_.phase(i + nqs) << std::endl;
   }
   return os;
 }
@@ -711,17 +709,18 @@ UnitaryRevTableau UnitaryRevTableau::conjugate() const {
 
 std::ostream& operator<<(std::ostream& os, const UnitaryRevTableau& tab) {
   unsigned nqs = tab.tab_.qubits_.size();
+  const MatrixXb xmat = tab.tab_.tab_.xmat.to_MatrixXb();
+  const MatrixXb zmat = tab.tab_.tab_.zmat.to_MatrixXb();
   for (unsigned i = 0; i < nqs; ++i) {
     Qubit qi = tab.tab_.qubits_.right.at(i);
-    os << tab.tab_.tab_.xmat.row(i) << "   " << tab.tab_.tab_.zmat.row(i)
-       << "   " << tab.tab_.tab_.phase(i) << "\t->\t"
+    os << xmat.row(i) << "   " << zmat.row(i) << "   "
+       << tab.tab_.tab_.phase(i) << "\t->\t"
        << "X@" << qi.repr() << std::endl;
   }
   os << "--" << std::endl;
   for (unsigned i = 0; i < nqs; ++i) {
     Qubit qi = tab.tab_.qubits_.right.at(i);
-    os << tab.tab_.tab_.xmat.row(i + nqs) << "   "
-       << tab.tab_.tab_.zmat.row(i + nqs) << "   "
+    os << xmat.row(i + nqs) << "   " << zmat.row(i + nqs) << "   "
        << tab.tab_.tab_.phase(i + nqs) << "\t->\t"
        << "Z@" << qi.repr() << std::endl;
   }
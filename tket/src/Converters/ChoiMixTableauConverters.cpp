@@ -431,7 +431,7 @@ void ChoiMixBuilder::diagonalise_segments() {
   }
 
   // All rows are diagonalised, so we can just focus on the Z matrix
-  if (tab.tab_.xmat != MatrixXb::Zero(tab.get_n_rows(), tab.get_n_boundaries()))
+  if (!tab.tab_.xmat.is_zero())
     throw std::logic_error(
         "Diagonalisation in ChoiMixTableau synthesis failed");
 }
@@ -450,7 +450,8 @@ void ChoiMixBuilder::solve_postselected_subspace() {
   }
   unsigned n_ins = tab.get_n_inputs();
   unsigned n_outs = tab.get_n_outputs();
-  MatrixXb subtableau = tab.tab_.zmat.bottomRightCorner(n_postselected, n_ins);
+  MatrixXb subtableau =
+      tab.tab_.zmat.to_MatrixXb().bottomRightCorner(n_postselected, n_ins);
   std::vector<std::pair<unsigned, unsigned>> col_ops =
       leading_column_gaussian_col_ops(subtableau);
   for (const std::pair<unsigned, unsigned>& op : col_ops) {
@@ -503,8 +504,8 @@ void ChoiMixBuilder::solve_initialised_subspace() {
   }
   unsigned n_ins = tab.get_n_inputs();
   unsigned n_outs = tab.get_n_outputs();
-  MatrixXb subtableau =
-      tab.tab_.zmat.bottomRightCorner(tab.get_n_rows() - n_collapsed, n_outs);
+  MatrixXb subtableau = tab.tab_.zmat.to_MatrixXb().bottomRightCorner(
+      tab.get_n_rows() - n_collapsed, n_outs);
   std::vector<std::pair<unsigned, unsigned>> col_ops =
       leading_column_gaussian_col_ops(subtableau);
   for (const std::pair<unsigned, unsigned>& op : col_ops) {
@@ -546,7 +547,8 @@ void ChoiMixBuilder::solve_collapsed_subspace() {
   // minimal set of qubits using CX gates
   unsigned n_ins = tab.get_n_inputs();
   unsigned n_outs = tab.get_n_outputs();
-  MatrixXb subtableau = tab.tab_.zmat.topLeftCorner(tab.get_n_rows(), n_ins);
+  MatrixXb subtableau =
+      tab.tab_.zmat.to_MatrixXb().topLeftCorner(tab.get_n_rows(), n_ins);
   std::vector<std::pair<unsigned, unsigned>> col_ops =
       leading_column_gaussian_col_ops(subtableau);
   for (const std::pair<unsigned, unsigned>& op : col_ops) {
@@ -565,7 +567,7 @@ void ChoiMixBuilder::solve_collapsed_subspace() {
   n_ins = tab.get_n_inputs();
   n_outs = tab.get_n_outputs();
   col_ops = gaussian_elimination_col_ops(
-      tab.tab_.zmat.topRightCorner(tab.get_n_rows(), n_outs));
+      tab.tab_.zmat.to_MatrixXb().topRightCorner(tab.get_n_rows(), n_outs));
   for (const std::pair<unsigned, unsigned>& op : col_ops) {
     tab.tab_.apply_CX(n_ins + op.second, n_ins + op.first);
     ChoiMixTableau::col_key_t ctrl = tab.col_index_.right.at(n_ins + op.second);
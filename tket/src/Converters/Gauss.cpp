@@ -14,6 +14,8 @@
 
 #include "tket/Converters/Gauss.hpp"
 
+#include "tket/Utils/GF2Matrix.hpp"
+
 namespace tket {
 
 void CXMaker::row_add(unsigned r0, unsigned r1) {
@@ -36,12 +38,14 @@ void DiagMatrix::col_add(unsigned c0, unsigned c1) {
 }
 
 void DiagMatrix::gauss(CXMaker& cxmaker, unsigned blocksize) {
+  // Eliminate on the packed matrix, which is left in its reduced form.
+  GF2Matrix m(_matrix);
   std::vector<std::pair<unsigned, unsigned>> row_ops =
-      gaussian_elimination_row_ops(_matrix, blocksize);
+      m.gaussian_elimination_row_ops(blocksize);
   for (std::pair<unsigned, unsigned> op : row_ops) {
-    row_add(op.first, op.second);
     cxmaker.row_add(op.first, op.second);
   }
+  _matrix = m.to_MatrixXb();
 }
 
 bool DiagMatrix::is_id() const { return _matrix.isIdentity(); }
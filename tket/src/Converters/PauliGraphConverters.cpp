@@ -22,9 +22,10 @@ namespace tket {
 
 PauliGraph circuit_to_pauli_graph(const Circuit &circ) {
   PauliGraph pg(circ.all_qubits(), circ.all_bits());
-  for (const Command &com : circ) {
+  unit_vector_t args;
+  for (const CommandView &com : circ.command_views()) {
     const Op &op = *com.get_op_ptr();
-    unit_vector_t args = com.get_args();
+    args.assign(com.get_args().begin(), com.get_args().end());
     OpDesc od = op.get_desc();
     if (od.is_gate()) {
       pg.apply_gate_at_end(static_cast<const Gate &>(op), args);
@@ -44,7 +44,7 @@ Circuit unitary_tableau_to_circuit(const UnitaryTableau& tab) {
    * Step 1: Use Hadamards (in our case, Vs) to make C (z rows of xmat_) have
    * full rank
    */
-  MatrixXb echelon = tabl.xmat.block(size, 0, size, size);
+  MatrixXb echelon = tabl.xmat.to_MatrixXb().block(size, 0, size, size);
   std::map<unsigned, unsigned> leading_val_to_col;
   for (unsigned i = 0; i < size; i++) {
     for (unsigned j = 0; j < size; j++) {
@@ -65,7 +65,7 @@ Circuit unitary_tableau_to_circuit(const UnitaryTableau& tab) {
     c.add_op<unsigned>(OpType::V, {i});
     tabl.apply_V(i);
     tabl.apply_X(i);
-    echelon.col(i) = tabl.zmat.block(size, i, size, 1);
+    for (unsigned k = 0; k < size; k++) echelon(k, i) = tabl.zmat(size + k, i);
     for (unsigned j = 0; j < size; j++) {
       if (echelon(j, i)) {
         if (leading_val_to_col.find(j) == leading_val_to_col.end()) {
@@ -88,7 +88,7 @@ Circuit unitary_tableau_to_circuit(const UnitaryTableau& tab) {
    * / A B \
    * \ I D /
    */
-  MatrixXb to_reduce = tabl.xmat.block(size, 0, size, size);
+  MatrixXb to_reduce = tabl.xmat.to_MatrixXb().block(size, 0, size, size);
   for (const std::pair<unsigned, unsigned>& qbs :
        gaussian_elimination_col_ops(to_reduce)) {
     c.add_op<unsigned>(OpType::CX, {qbs.first, qbs.second});
@@ -101,8 +101,8 @@ Circuit unitary_tableau_to_circuit(const UnitaryTableau& tab) {
    * diagonal matrix to D and use Lemma 7 to convert D to the form D = MM^T
    * for some invertible M.
    */
-  std::pair<MatrixXb, MatrixXb> zp_z_llt =
-      binary_LLT_decomposition(tabl.zmat.block(size, 0, size, size));
+  std::pair<MatrixXb, MatrixXb> zp_z_llt = binary_LLT_decomposition(
+      tabl.zmat.to_MatrixXb().block(size, 0, size, size));
   for (unsigned i = 0; i < size; i++) {
     if (zp_z_llt.second(i, i)) {
       c.add_op<unsigned>(OpType::S, {i});
@@ -147,7 +147,7 @@ Circuit unitary_tableau_to_circuit(const UnitaryTableau& tab) {
    * \ I 0 /
    * By commutativity relations, IB^T = A0^T + I, therefore B = I.
    */
-  to_reduce = tabl.xmat.block(size, 0, size, size);
+  to_reduce = tabl.xmat.to_MatrixXb().block(size, 0, size, size);
   for (const std::pair<unsigned, unsigned>& qbs :
        gaussian_elimination_col_ops(to_reduce)) {
     c.add_op<unsigned>(OpType::CX, {qbs.first, qbs.second});
@@ -169,8 +169,8 @@ Circuit unitary_tableau_to_circuit(const UnitaryTableau& tab) {
    * therefore we can again use phase (S) gates and Lemma 7 to make A = NN^T for
    * some invertible N.
    */
-  std::pair<MatrixXb, MatrixXb> xp_z_llt =
-      binary_LLT_decomposition(tabl.zmat.block(0, 0, size, size));
+  std::pair<MatrixXb, MatrixXb> xp_z_llt = binary_LLT_decomposition(
+      tabl.zmat.to_MatrixXb().block(0, 0, size, size));
   for (unsigned i = 0; i < size; i++) {
     if (xp_z_llt.second(i, i)) {
       c.add_op<unsigned>(OpType::S, {i});
@@ -212,8 +212,8 @@ Circuit unitary_tableau_to_circuit(const UnitaryTableau& tab) {
    * / I 0 \
    * \ 0 I /
    */
-  for (const std::pair<unsigned, unsigned>& qbs :
-       gaussian_elimination_col_ops(tabl.xmat.block(0, 0, size, size))) {
+  for (const std::pair<unsigned, unsigned>& qbs : gaussian_elimination_col_ops(
+           tabl.xmat.to_MatrixXb().block(0, 0, size, size))) {
     c.add_op<unsigned>(OpType::CX, {qbs.first, qbs.second});
     tabl.apply_CX(qbs.first, qbs.second);
   }
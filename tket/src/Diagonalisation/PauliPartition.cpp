@@ -14,38 +14,104 @@
 
 #include "tket/Diagonalisation/PauliPartition.hpp"
 
+#include <bit>
 #include <numeric>
 #include <tkassert/Assert.hpp>
 
 #include "tket/Graphs/AdjacencyData.hpp"
 #include "tket/Graphs/GraphColouring.hpp"
+#include "tket/Utils/ParallelFor.hpp"
 
 namespace tket {
 
+typedef SymplecticPauliMap::word_t word_t;
+
+// Pack a string, giving any qubits not seen before the next free indices
+static SymplecticPauliMap pack_string(
+    const SpPauliString& tensor, std::map<Qubit, unsigned>& qubit_indices) {
+  SymplecticPauliMap packed;
+  for (const std::pair<const Qubit, Pauli>& qp : tensor.string) {
+    if (qp.second == Pauli::I) continue;
+    const unsigned index =
+        qubit_indices.insert({qp.first, (unsigned)qubit_indices.size()})
+            .first->second;
+    packed.set(index, qp.second);
+  }
+  return packed;
+}
+
+// Fold the support of a packed string into 64 buckets (qubit index mod 64);
+// strings whose signatures are disjoint cannot share a qubit.
+static word_t support_signature(const SymplecticPauliMap& packed) {
+  word_t signature = 0;
+  for (unsigned w = 0; w < packed.x_words().size(); ++w) {
+    signature |= packed.x_words()[w] | packed.z_words()[w];
+  }
+  return signature;
+}
+
+// Whether two strings are joined by an edge for the given strategy
+static bool pauli_edge(
+    const SymplecticPauliMap& a, const SymplecticPauliMap& b,
+    PauliPartitionStrat strat) {
+  const unsigned n = std::min(a.x_words().size(), b.x_words().size());
+  unsigned n_anticommuting = 0;
+  for (unsigned w = 0; w < n; ++w) {
+    const word_t anticommuting = (a.x_words()[w] & b.z_words()[w]) ^
+                                 (a.z_words()[w] & b.x_words()[w]);
+    if (strat == PauliPartitionStrat::NonConflictingSets) {
+      // Distinct non-trivial Paulis are exactly those that anticommute
+      if (anticommuting != 0) return true;
+    } else {
+      n_anticommuting += std::popcount(anticommuting);
+    }
+  }
+  return (n_anticommuting % 2) == 1;
+}
+
+static void check_strat(PauliPartitionStrat strat) {
+  if (strat != PauliPartitionStrat::NonConflictingSets &&
+      strat != PauliPartitionStrat::CommutingSets)
+    throw UnknownPauliPartitionStrat();
+}
+
 PauliPartitionerGraph::PauliPartitionerGraph(
-    const std::list<SpPauliString>& strings, PauliPartitionStrat strat) {
-  pac_graph = {};
+    const std::list<SpPauliString>& strings, PauliPartitionStrat strat,
+    unsigned n_threads)
+    : pac_graph(), strat_(strat), n_threads_(n_threads) {
+  check_strat(strat);
+  add_strings(strings);
+}
+
+void PauliPartitionerGraph::add_strings(
+    const std::list<SpPauliString>& strings) {
+  const std::size_t n_old = packed_strings_.size();
   for (const SpPauliString& tensor : strings) {
-    PauliACVertex new_vert = boost::add_vertex(tensor, pac_graph);
-    BGL_FORALL_VERTICES(v, pac_graph, PauliACGraph) {
-      if (v != new_vert) {
-        switch (strat) {
-          case (PauliPartitionStrat::NonConflictingSets): {
-            bool conflict = !tensor.conflicting_qubits(pac_graph[v]).empty();
-            if (conflict) boost::add_edge(new_vert, v, pac_graph);
-            break;
-          }
-          case (PauliPartitionStrat::CommutingSets): {
-            if (!tensor.commutes_with(pac_graph[v])) {
-              boost::add_edge(new_vert, v, pac_graph);
-            }
-            break;
-          }
-          default: {
-            throw UnknownPauliPartitionStrat();
-          }
+    packed_strings_.push_back(pack_string(tensor, qubit_indices_));
+    support_signatures_.push_back(support_signature(packed_strings_.back()));
+    boost::add_vertex(tensor, pac_graph);
+  }
+  // Each new vertex is checked against every vertex before it. Rows are
+  // independent, so they are shared between threads, and the edges are then
+  // added in the same order as a serial build would add them.
+  const std::size_t n_new = packed_strings_.size() - n_old;
+  std::vector<std::vector<unsigned>> neighbours(n_new);
+  parallel_for(
+      n_new, n_threads_,
+      [&](std::size_t k) {
+        const std::size_t i = n_old + k;
+        const SymplecticPauliMap& packed = packed_strings_[i];
+        const word_t signature = support_signatures_[i];
+        for (std::size_t j = 0; j < i; ++j) {
+          if ((signature & support_signatures_[j]) == 0) continue;
+          if (pauli_edge(packed, packed_strings_[j], strat_))
+            neighbours[k].push_back(j);
         }
-      }
+      },
+      16);
+  for (std::size_t k = 0; k < n_new; ++k) {
+    for (unsigned j : neighbours[k]) {
+      boost::add_edge(n_old + k, j, pac_graph);
     }
   }
 }
@@ -204,54 +270,57 @@ PauliPartitionerGraph::partition_paulis(GraphColourMethod method) const {
 static std::list<std::list<SpPauliString>>
 get_term_sequence_for_lazy_colouring_method(
     const std::list<SpPauliString>& strings, PauliPartitionStrat strat) {
-  std::list<std::list<SpPauliString>> terms;
+  check_strat(strat);
+  std::map<Qubit, unsigned> qubit_indices;
+  std::vector<SymplecticPauliMap> packed;
+  std::vector<word_t> signatures;
+  packed.reserve(strings.size());
+  signatures.reserve(strings.size());
   for (const SpPauliString& qpt : strings) {
-    if (terms.empty()) {
-      terms.push_back({qpt});
-      continue;
-    }
+    packed.push_back(pack_string(qpt, qubit_indices));
+    signatures.push_back(support_signature(packed.back()));
+  }
 
+  // Each bin holds the indices of its strings
+  std::vector<std::vector<unsigned>> bins;
+  for (unsigned i = 0; i < packed.size(); ++i) {
     bool found_bin = false;
-    for (std::list<SpPauliString>& qpt_list : terms) {
+    for (std::vector<unsigned>& bin : bins) {
       bool viable_bin = true;
-      for (const SpPauliString& qpt2 : qpt_list) {
-        switch (strat) {
-          case (PauliPartitionStrat::NonConflictingSets): {
-            bool conflict = !qpt.conflicting_qubits(qpt2).empty();
-            if (conflict) viable_bin = false;
-            break;
-          }
-          case (PauliPartitionStrat::CommutingSets): {
-            if (!qpt.commutes_with(qpt2)) viable_bin = false;
-            break;
-          }
-          default: {
-            throw UnknownPauliPartitionStrat();
-          }
+      for (unsigned j : bin) {
+        if ((signatures[i] & signatures[j]) != 0 &&
+            pauli_edge(packed[i], packed[j], strat)) {
+          viable_bin = false;
+          break;
         }
-
-        if (viable_bin == false) break;
       }
       if (viable_bin) {
-        qpt_list.push_back(qpt);
+        bin.push_back(i);
         found_bin = true;
         break;
       }
     }
 
     if (found_bin == false) {
-      terms.push_back({qpt});
+      bins.push_back({i});
     }
   }
+
+  const std::vector<SpPauliString> string_vec(strings.begin(), strings.end());
+  std::list<std::list<SpPauliString>> terms;
+  for (const std::vector<unsigned>& bin : bins) {
+    std::list<SpPauliString>& term = terms.emplace_back();
+    for (unsigned i : bin) term.push_back(string_vec[i]);
+  }
   return terms;
 }
 
 static std::list<std::list<SpPauliString>>
 get_term_sequence_with_constructed_dependency_graph(
     const std::list<SpPauliString>& strings, PauliPartitionStrat strat,
-    GraphColourMethod method) {
+    GraphColourMethod method, unsigned n_threads) {
   std::list<std::list<SpPauliString>> terms;
-  PauliPartitionerGraph pp(strings, strat);
+  PauliPartitionerGraph pp(strings, strat, n_threads);
   std::map<unsigned, std::list<SpPauliString>> colour_map =
       pp.partition_paulis(method);
 
@@ -264,7 +333,7 @@ get_term_sequence_with_constructed_dependency_graph(
 
 std::list<std::list<SpPauliString>> term_sequence(
     const std::list<SpPauliString>& strings, PauliPartitionStrat strat,
-    GraphColourMethod method) {
+    GraphColourMethod method, unsigned n_threads) {
   switch (method) {
     case GraphColourMethod::Lazy:
       return get_term_sequence_for_lazy_colouring_method(strings, strat);
@@ -273,7 +342,7 @@ std::list<std::list<SpPauliString>> term_sequence(
       // Deliberate fall through
     case GraphColourMethod::Exhaustive:
       return get_term_sequence_with_constructed_dependency_graph(
-          strings, strat, method);
+          strings, strat, method, n_threads);
     default:
       throw std::logic_error("term_sequence : unknown graph colouring method");
   }
@@ -15,6 +15,8 @@
 #include "tket/Gate/Gate.hpp"
 
 #include <algorithm>
+#include <boost/functional/hash.hpp>
+#include <regex>
 #include <stdexcept>
 #include <tkrng/RNG.hpp>
 #include <vector>
@@ -373,17 +375,28 @@ Op_ptr Gate::symbol_substitution(
   throw SubstitutionFailure(msg.str());
 }
 
-std::optional<double> Gate::is_identity() const {
+// Parameter checks shared by the symbolic and numeric forms of a gate.
+static bool param_is_0(const Expr& e, unsigned n = 2) { return equiv_0(e, n); }
+static bool param_is_0(double x, unsigned n = 2) {
+  return approx_eq(x, 0., n);
+}
+static std::optional<double> param_value(const Expr& e) {
+  return eval_expr(e);
+}
+static std::optional<double> param_value(double x) { return x; }
+
+template <typename Params>
+static std::optional<double> identity_phase(
+    OpType type, const Params& params) {
   static const std::optional<double> notid;
-  const std::vector<Expr>& params = get_params();
-  switch (get_type()) {
+  switch (type) {
     case OpType::noop: {
       return 0.;
     }
     case OpType::Phase: {
       // This is _always_ the identity up to phase, but the method does not
       // allow us to return a symbolic phase, so we must reject in that case.
-      std::optional<double> eval = eval_expr(params[0]);
+      std::optional<double> eval = param_value(params[0]);
       if (!eval) return notid;
       return eval.value();
     }
@@ -400,24 +413,24 @@ std::optional<double> Gate::is_identity() const {
     case OpType::XXPhase3:
     case OpType::ESWAP:
     case OpType::AAMS: {
-      Expr e = params[0];
-      if (equiv_0(e, 4)) {
+      const auto e = params[0];
+      if (param_is_0(e, 4)) {
         return 0.;
-      } else if (equiv_0(e + 2, 4)) {
+      } else if (param_is_0(e + 2, 4)) {
         return 1.;
       } else
         return notid;
     }
     case OpType::U1:
     case OpType::CU1: {
-      return equiv_0(params[0]) ? 0. : notid;
+      return param_is_0(params[0]) ? 0. : notid;
     }
     case OpType::U3: {
-      Expr theta = params[0];
-      if (equiv_0(params[1] + params[2])) {
-        if (equiv_0(theta, 4)) {
+      const auto theta = params[0];
+      if (param_is_0(params[1] + params[2])) {
+        if (param_is_0(theta, 4)) {
           return 0.;
-        } else if (equiv_0(theta + 2, 4)) {
+        } else if (param_is_0(theta + 2, 4)) {
           return 1.;
         } else
           return notid;
@@ -425,24 +438,25 @@ std::optional<double> Gate::is_identity() const {
         return notid;
     }
     case OpType::CU3: {
-      if (equiv_0(params[0], 4) && equiv_0(params[1] + params[2])) {
+      if (param_is_0(params[0], 4) && param_is_0(params[1] + params[2])) {
         return 0.;
       } else
         return notid;
     }
     case OpType::TK1: {
-      Expr s = params[0] + params[2], t = params[1];
-      if (equiv_0(s) && equiv_0(t)) {
-        return (equiv_0(s, 4) ^ equiv_0(t, 4)) ? 1. : 0.;
+      const auto s = params[0] + params[2];
+      const auto t = params[1];
+      if (param_is_0(s) && param_is_0(t)) {
+        return (param_is_0(s, 4) ^ param_is_0(t, 4)) ? 1. : 0.;
       } else
         return notid;
     }
     case OpType::TK2: {
       bool pi_phase = false;
-      for (const Expr& a : params) {
-        if (equiv_0(a + 2, 4)) {
+      for (const auto& a : params) {
+        if (param_is_0(a + 2, 4)) {
           pi_phase = !pi_phase;
-        } else if (!equiv_0(a, 4)) {
+        } else if (!param_is_0(a, 4)) {
           return notid;
         }
       }
@@ -456,23 +470,23 @@ std::optional<double> Gate::is_identity() const {
     case OpType::CnRy:
     case OpType::CnRx:
     case OpType::CnRz: {
-      return equiv_0(params[0], 4) ? 0. : notid;
+      return param_is_0(params[0], 4) ? 0. : notid;
     }
     case OpType::FSim: {
-      return (equiv_0(params[0]) && equiv_0(params[1])) ? 0. : notid;
+      return (param_is_0(params[0]) && param_is_0(params[1])) ? 0. : notid;
     }
     case OpType::PhasedISWAP: {
-      return (equiv_0(params[0], 1) && equiv_0(params[1], 4)) ? 0. : notid;
+      return (param_is_0(params[0], 1) && param_is_0(params[1], 4)) ? 0.
+                                                                    : notid;
     }
     default:
       return notid;
   }
 }
 
-bool Gate::is_clifford() const {
-  if (is_clifford_type(type_)) return true;
-
-  switch (type_) {
+template <typename Params>
+static bool clifford_params(OpType type, const Params& params) {
+  switch (type) {
     case OpType::Rx:
     case OpType::Ry:
     case OpType::Rz:
@@ -485,44 +499,55 @@ bool Gate::is_clifford() const {
     case OpType::YYPhase:
     case OpType::ZZPhase:
     case OpType::XXPhase3:
-      return std::all_of(params_.begin(), params_.end(), [](const Expr& e) {
-        return equiv_0(4 * e);
+      return std::all_of(params.begin(), params.end(), [](const auto& e) {
+        return param_is_0(4 * e);
       });
     case OpType::PhasedX:
     case OpType::NPhasedX:
     case OpType::TwinPhasedX:
     case OpType::PhasedXX:
       return std::all_of(
-                 params_.begin(), params_.end(),
-                 [](const Expr& e) { return equiv_0(4 * e); }) ||
-             (equiv_0(2 * params_.at(0)) && equiv_0(8 * params_.at(1)));
+                 params.begin(), params.end(),
+                 [](const auto& e) { return param_is_0(4 * e); }) ||
+             (param_is_0(2 * params[0]) && param_is_0(8 * params[1]));
     case OpType::ISWAP:
     case OpType::ESWAP:
-      return equiv_0(2 * params_.at(0));
+      return param_is_0(2 * params[0]);
     case OpType::PhasedISWAP:
     case OpType::FSim:
-      return equiv_0(4 * params_.at(0)) && equiv_0(2 * params_.at(1));
+      return param_is_0(4 * params[0]) && param_is_0(2 * params[1]);
     case OpType::GPI:
-      return equiv_0(8 * params_.at(0));
+      return param_is_0(8 * params[0]);
     case OpType::GPI2:
-      return equiv_0(4 * params_.at(0));
+      return param_is_0(4 * params[0]);
     case OpType::AAMS:
-      if (equiv_0(params_.at(0))) {
+      if (param_is_0(params[0])) {
         return true;
       } else if (
-          !equiv_0(4 * params_.at(0)) || !equiv_0(8 * params_.at(1)) ||
-          !equiv_0(8 * params_.at(2))) {
+          !param_is_0(4 * params[0]) || !param_is_0(8 * params[1]) ||
+          !param_is_0(8 * params[2])) {
         return false;
-      } else if (equiv_0(2 * params_.at(0))) {
+      } else if (param_is_0(2 * params[0])) {
         return true;
       } else {
-        return equiv_0(4 * params_.at(1)) && equiv_0(4 * params_.at(2));
+        return param_is_0(4 * params[1]) && param_is_0(4 * params[2]);
       }
     default:
       return false;
   }
 }
 
+std::optional<double> Gate::is_identity() const {
+  if (numeric_params_) return identity_phase(type_, *numeric_params_);
+  return identity_phase(type_, params_);
+}
+
+bool Gate::is_clifford() const {
+  if (is_clifford_type(type_)) return true;
+  if (numeric_params_) return clifford_params(type_, *numeric_params_);
+  return clifford_params(type_, params_);
+}
+
 bool Gate::has_symmetry(unsigned port1, unsigned port2) const {
   const auto n_q = n_qubits();
   if (port1 >= n_q || port2 >= n_q) {
@@ -667,6 +692,15 @@ bool Gate::is_equal(const Op& op_other) const {
 
   OpDesc desc = get_desc();
   if (n_qubits() != other.n_qubits()) return false;
+  if (numeric_params_ && other.numeric_params_) {
+    const NumericParams& params1 = *numeric_params_;
+    const NumericParams& params2 = *other.numeric_params_;
+    if (params1.size() != params2.size()) return false;
+    for (unsigned i = 0; i < params1.size(); i++) {
+      if (!approx_eq(params1[i], params2[i], desc.param_mod(i))) return false;
+    }
+    return true;
+  }
   std::vector<Expr> params1 = this->get_params();
   std::vector<Expr> params2 = other.get_params();
   unsigned param_count = params1.size();
@@ -993,6 +1027,17 @@ nlohmann::json Gate::serialize() const {
   return j;
 }
 
+std::size_t Gate::hash() const {
+  std::size_t seed = 0;
+  boost::hash_combine(seed, get_type());
+  boost::hash_combine(seed, n_qubits());
+  for (const Expr& e : get_params()) {
+    const ExprPtr ep = e;
+    boost::hash_combine(seed, ep->hash());
+  }
+  return seed;
+}
+
 Op_ptr Gate::deserialize(const nlohmann::json& j) {
   OpType optype = j.at("type").get<OpType>();
   std::vector<Expr> params;
@@ -1029,8 +1074,24 @@ Eigen::MatrixXcd Gate::get_unitary() const {
   }
 }
 
+// The params as doubles, if they are all plain numbers.
+static std::optional<NumericParams> to_numeric_params(
+    const std::vector<Expr>& params) {
+  if (params.size() > NumericParams::max_size) return std::nullopt;
+  NumericParams values;
+  for (const Expr& e : params) {
+    std::optional<double> x = eval_number(e);
+    if (!x) return std::nullopt;
+    values.push_back(*x);
+  }
+  return values;
+}
+
 Gate::Gate(OpType type, const std::vector<Expr>& params, unsigned n_qubits)
-    : Op(type), params_(params), n_qubits_(n_qubits) {
+    : Op(type),
+      params_(params),
+      n_qubits_(n_qubits),
+      numeric_params_(to_numeric_params(params)) {
   if (!is_gate_type(type)) {
     throw BadOpType(type);
   }
@@ -1039,6 +1100,7 @@ Gate::Gate(OpType type, const std::vector<Expr>& params, unsigned n_qubits)
   }
 }
 
-Gate::Gate() : Op(OpType::noop), params_() {}
+Gate::Gate()
+    : Op(OpType::noop), params_(), numeric_params_(NumericParams()) {}
 
 }  // namespace tket
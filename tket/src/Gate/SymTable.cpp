@@ -21,23 +21,33 @@ std::unordered_set<std::string>& SymTable::get_registered_symbols() {
   return symbols;
 }
 
+std::mutex& SymTable::get_mutex() {
+  static std::mutex mutex;
+  return mutex;
+}
+
 Sym SymTable::fresh_symbol(const std::string& preferred) {
   std::string new_symbol = preferred;
-  unsigned suffix = 0;
-  while (get_registered_symbols().find(new_symbol) !=
-         get_registered_symbols().cend()) {
-    suffix++;
-    new_symbol = preferred + "_" + std::to_string(suffix);
+  {
+    std::lock_guard<std::mutex> lock(get_mutex());
+    unsigned suffix = 0;
+    while (get_registered_symbols().find(new_symbol) !=
+           get_registered_symbols().cend()) {
+      suffix++;
+      new_symbol = preferred + "_" + std::to_string(suffix);
+    }
+    get_registered_symbols().insert(new_symbol);
   }
-  register_symbol(new_symbol);
   return SymEngine::symbol(new_symbol);
 }
 
 void SymTable::register_symbol(const std::string& symbol) {
+  std::lock_guard<std::mutex> lock(get_mutex());
   get_registered_symbols().insert(symbol);
 }
 
 void SymTable::register_symbols(const SymSet& ss) {
+  std::lock_guard<std::mutex> lock(get_mutex());
   for (const auto& s : ss) {
     get_registered_symbols().insert(s->get_name());
   }
@@ -20,8 +20,10 @@ namespace tket {
 
 LexiRoute::LexiRoute(
     const ArchitecturePtr& _architecture,
-    MappingFrontier_ptr& _mapping_frontier)
-    : architecture_(_architecture), mapping_frontier_(_mapping_frontier) {
+    MappingFrontier_ptr& _mapping_frontier, unsigned _n_threads)
+    : architecture_(_architecture),
+      mapping_frontier_(_mapping_frontier),
+      n_threads_(_n_threads) {
   // set initial logical->physical labelling
   for (const Qubit& qb : this->mapping_frontier_->circuit_.all_qubits()) {
     this->labelling_.insert({qb, qb});
@@ -689,7 +691,8 @@ std::pair<bool, bool> LexiRoute::check_bridge(
              Node(this->labelling_[p.second])});
       }
       LexicographicalComparison lookahead_lc(this->architecture_, convert_uids);
-      lookahead_lc.remove_swaps_lexicographical(candidate_swaps);
+      lookahead_lc.remove_swaps_lexicographical(
+          candidate_swaps, this->n_threads_);
     }
   }
   // condition implies bridge is chosen
@@ -808,7 +811,8 @@ bool LexiRoute::solve(unsigned lookahead) {
              Node(this->labelling_[p.second])});
       }
       LexicographicalComparison lookahead_lc(this->architecture_, convert_uids);
-      lookahead_lc.remove_swaps_lexicographical(candidate_swaps);
+      lookahead_lc.remove_swaps_lexicographical(
+          candidate_swaps, this->n_threads_);
     }
     counter++;
     this->mapping_frontier_->advance_next_2qb_slice(lookahead);
@@ -18,13 +18,14 @@
 
 namespace tket {
 
-LexiRouteRoutingMethod::LexiRouteRoutingMethod(unsigned _max_depth)
-    : max_depth_(_max_depth) {};
+LexiRouteRoutingMethod::LexiRouteRoutingMethod(
+    unsigned _max_depth, unsigned _n_threads)
+    : max_depth_(_max_depth), n_threads_(_n_threads) {};
 
 std::pair<bool, unit_map_t> LexiRouteRoutingMethod::routing_method(
     MappingFrontier_ptr& mapping_frontier,
     const ArchitecturePtr& architecture) const {
-  LexiRoute lr(architecture, mapping_frontier);
+  LexiRoute lr(architecture, mapping_frontier, this->n_threads_);
   return {lr.solve(this->max_depth_), {}};
 }
 
@@ -32,16 +33,25 @@ unsigned LexiRouteRoutingMethod::get_max_depth() const {
   return this->max_depth_;
 }
 
+unsigned LexiRouteRoutingMethod::get_n_threads() const {
+  return this->n_threads_;
+}
+
 nlohmann::json LexiRouteRoutingMethod::serialize() const {
   nlohmann::json j;
   j["depth"] = this->get_max_depth();
+  // Only recorded when set, so that existing serialisations are unchanged.
+  if (this->get_n_threads() != 1) {
+    j["n_threads"] = this->get_n_threads();
+  }
   j["name"] = "LexiRouteRoutingMethod";
   return j;
 }
 
 LexiRouteRoutingMethod LexiRouteRoutingMethod::deserialize(
     const nlohmann::json& j) {
-  return LexiRouteRoutingMethod(j.at("depth").get<unsigned>());
+  return LexiRouteRoutingMethod(
+      j.at("depth").get<unsigned>(), j.value("n_threads", 1u));
 }
 
 }  // namespace tket
\ No newline at end of file
@@ -14,13 +14,38 @@
 
 #include "tket/Mapping/LexicographicalComparison.hpp"
 
+#include "tket/Utils/ParallelFor.hpp"
+
 namespace tket {
 
+/**
+ * The swaps whose distances are lexicographically smallest, comparing in
+ * order so that ties are resolved in the same way however the distances
+ * were computed.
+ */
+static swap_set_t best_swaps(
+    const std::vector<swap_t>& swaps,
+    const std::vector<lexicographical_distances_t>& scores) {
+  swap_set_t preserved_swaps;
+  std::size_t winner = 0;
+  for (std::size_t i = 0; i < swaps.size(); ++i) {
+    if (preserved_swaps.empty() || scores[i] < scores[winner]) {
+      preserved_swaps = {swaps[i]};
+      winner = i;
+    } else if (scores[i] == scores[winner]) {
+      preserved_swaps.insert(swaps[i]);
+    }
+  }
+  return preserved_swaps;
+}
+
 LexicographicalComparison::LexicographicalComparison(
     const ArchitecturePtr& _architecture,
     const interacting_nodes_t& _interacting_nodes)
-    : architecture_(_architecture), interacting_nodes_(_interacting_nodes) {
-  unsigned diameter = this->architecture_->get_diameter();
+    : architecture_(_architecture),
+      diameter_(_architecture->get_diameter()),
+      interacting_nodes_(_interacting_nodes) {
+  unsigned diameter = this->diameter_;
 
   lexicographical_distances_t distance_vector(diameter, 0);
   for (const auto& interaction : this->interacting_nodes_) {
@@ -45,7 +70,7 @@ void LexicographicalComparison::increment_distances(
     lexicographical_distances_t& distances,
     const std::pair<Node, Node>& interaction, int increment) const {
   const unsigned distances_index =
-      this->architecture_->get_diameter() -
+      this->diameter_ -
       this->architecture_->get_distance(interaction.first, interaction.second);
   if (distances[distances_index] == 0 && increment < 0) {
     throw LexicographicalComparisonError(
@@ -118,23 +143,23 @@ lexicographical_distances_t LexicographicalComparison::get_updated_distances(
  * interacting logical
  */
 void LexicographicalComparison::remove_swaps_lexicographical(
-    swap_set_t& candidate_swaps) const {
-  auto it = candidate_swaps.begin();
-  lexicographical_distances_t winning_distances =
-      this->get_updated_distances(*it);
-  swap_set_t preserved_swaps = {*it};
-  ++it;
-  for (; it != candidate_swaps.end(); ++it) {
-    lexicographical_distances_t comparison_distances =
-        this->get_updated_distances(*it);
-
-    if (comparison_distances < winning_distances) {
-      preserved_swaps = {*it};
-      winning_distances = comparison_distances;
-    } else if (comparison_distances == winning_distances) {
-      preserved_swaps.insert(*it);
-    }
+    swap_set_t& candidate_swaps, unsigned n_threads) const {
+  const std::vector<swap_t> swaps(
+      candidate_swaps.begin(), candidate_swaps.end());
+  std::vector<lexicographical_distances_t> scores(swaps.size());
+  // Scoring concurrently requires the architecture's distance table, so that
+  // distance lookups do not write to any shared cache.
+  if (n_threads > 1 && this->architecture_->get_distance_table() == nullptr) {
+    n_threads = 1;
   }
-  candidate_swaps = preserved_swaps;
+  // Scoring a swap takes well under a microsecond, so a thread only pays
+  // for its creation with a few hundred swaps to score.
+  parallel_for(
+      swaps.size(), n_threads,
+      [&](std::size_t i) {
+        scores[i] = this->get_updated_distances(swaps[i]);
+      },
+      64, 256);
+  candidate_swaps = best_swaps(swaps, scores);
 }
 }  // namespace tket
\ No newline at end of file
@@ -14,6 +14,9 @@
 
 #include "tket/Mapping/MappingFrontier.hpp"
 
+#include <deque>
+#include <map>
+
 #include "tket/Circuit/Circuit.hpp"
 #include "tket/Utils/UnitID.hpp"
 
@@ -56,34 +59,6 @@ UnitID get_unitid_from_unit_frontier(
   return it->first;
 }
 
-/**
- * bit_frontier_t is <Bit, EdgeVec>, helper function returns
- * Bit corresponding to given Edge
- */
-static Bit get_bit_from_bool_frontier(
-    const std::shared_ptr<b_frontier_t>& b_frontier, const EdgeVec& ev) {
-  TKET_ASSERT(ev.size() > 0);
-  // condition is that if one Edge in EdgeVector ev is in a
-  // held bundle, then all are so return true
-  for (auto it = b_frontier->get<TagKey>().begin();
-       it != b_frontier->get<TagKey>().end(); ++it) {
-    for (const Edge& e0 : ev) {
-      for (const Edge& e1 : it->second) {
-        if (e0 == e1) {
-          return it->first;
-        }
-      }
-    }
-  }
-  /**
-   * static function should only be called by advance_frontier_boundary.
-   * Passed Edge known to be boolean
-   * Edge collected from a vertex known to be in next slice of vertices after
-   * boundary held in MappingFrontier, i.e. connected to b_frontier
-   */
-  TKET_ASSERT(false);
-}
-
 std::shared_ptr<unit_frontier_t> frontier_convert_vertport_to_edge(
     const Circuit& circuit,
     const std::shared_ptr<unit_vertport_frontier_t>& u_frontier) {
@@ -196,10 +171,12 @@ void MappingFrontier::advance_next_2qb_slice(unsigned max_advance) {
       frontier_convert_vertport_to_edge(this->circuit_, this->linear_boundary);
 
   // Get all vertices in first cut
-  VertexVec immediate_cut_vertices_v =
-      *(this->circuit_
-            .next_cut(current_frontier, std::make_shared<b_frontier_t>())
-            .slice);
+  std::shared_ptr<Slice> immediate_cut =
+      this->circuit_
+          .next_cut(current_frontier, std::make_shared<b_frontier_t>())
+          .slice;
+  const VertexSet immediate_cut_vertices(
+      immediate_cut->begin(), immediate_cut->end());
   do {
     // each do section first finds the next set of edges after the held set
     // for edges with target vertices with all their edges presented in the
@@ -216,10 +193,8 @@ void MappingFrontier::advance_next_2qb_slice(unsigned max_advance) {
       Vertex target_v = this->circuit_.target(pair.second);
       EdgeVec in_edges =
           this->circuit_.get_in_edges_of_type(target_v, EdgeType::Quantum);
-      bool in_slice =
-          std::find(
-              immediate_cut_vertices_v.begin(), immediate_cut_vertices_v.end(),
-              target_v) != immediate_cut_vertices_v.end();
+      bool in_slice = immediate_cut_vertices.find(target_v) !=
+                      immediate_cut_vertices.end();
       OpType ot = this->circuit_.get_OpType_from_Vertex(target_v);
       if (((!in_slice && in_edges.size() > 1) || ot == OpType::Output ||
            ot == OpType::ClOutput) &&
@@ -282,206 +257,249 @@ void MappingFrontier::advance_next_2qb_slice(unsigned max_advance) {
 
 /**
  * advance_frontier_boundary
- * terminates when next_cut returns a "slice" where
- * no vertices are physically permitted by the architecture
+ * moves the boundary past every vertex that is physically permitted by the
+ * architecture and whose predecessors have all been passed, stopping where
+ * no permitted vertex remains, i.e. the end of the circuit or a gate that
+ * needs SWAPs first.
  * linear_boundary and boolean_boundary updated to reflect this
+ *
+ * Rather than recomputing a whole slice from the boundary for each step,
+ * vertices are visited from a worklist: only the targets of boundary edges
+ * at the start, and then the successors of each vertex passed. The cost is
+ * proportional to the size of the boundary plus the number of vertices
+ * passed, and the result is the same as passing permitted vertices slice by
+ * slice.
  */
 void MappingFrontier::advance_frontier_boundary(
     const ArchitecturePtr& architecture) {
-  bool boundary_updated = false;
-  do {
-    /**
-     * Given a "Circuit slice" defined by a set of Quantum,
-     * Classical and Boolean Edges, we find a "next" set
-     * of causally forward adjacent vertices.
-     */
-    boundary_updated = false;
-    std::shared_ptr<unit_frontier_t> l_frontier_edges =
-        frontier_convert_vertport_to_edge(
-            this->circuit_, this->linear_boundary);
-    CutFrontier next_cut =
-        this->circuit_.next_cut(l_frontier_edges, this->boolean_boundary);
+  // Bit for each edge held in boolean_boundary
+  std::map<Edge, Bit> boolean_edge_bits;
+  for (const std::pair<Bit, EdgeVec>& pair :
+       this->boolean_boundary->get<TagKey>()) {
+    for (const Edge& edge : pair.second) {
+      boolean_edge_bits.insert({edge, pair.first});
+    }
+  }
+
+  std::deque<Vertex> candidates;
+  // Vertices found to have all in edges in the boundary but not permitted by
+  // the architecture. This does not change while advancing.
+  VertexSet rejected;
+  auto add_candidate = [&](const Vertex& vert) {
+    if (!this->circuit_.detect_final_Op(vert) &&
+        rejected.find(vert) == rejected.end()) {
+      candidates.push_back(vert);
+    }
+  };
+  for (const std::pair<UnitID, VertPort>& pair :
+       this->linear_boundary->get<TagKey>()) {
+    add_candidate(this->circuit_.target(this->circuit_.get_nth_out_edge(
+        pair.second.first, pair.second.second)));
+  }
+  for (const std::pair<const Edge, Bit>& pair : boolean_edge_bits) {
+    add_candidate(this->circuit_.target(pair.first));
+  }
+
+  while (!candidates.empty()) {
+    const Vertex vert = candidates.front();
+    candidates.pop_front();
+    if (rejected.find(vert) != rejected.end()) continue;
     /**
-     * For each vertex in a slice we check to see if its
-     * Quantum arguments are permitted by the Architecture.
-     *
-     * If true, we update our Circuit Slice by replacing
-     * "in edges" to the Vertex with appropriate "out edges"
-     * from the Vertex.
+     * Iterate through every edge (port ordered) to the Vertex.
+     * For each edge, store it's associated UnitID and Edge Type.
+     * If any edge is not yet in the boundary then the vertex will be
+     * revisited once its predecessor has been passed.
      */
-    for (const Vertex& vert : *next_cut.slice) {
-      /**
-       * Iterate through every edge (port ordered) to the Vertex.
-       * For each edge, store it's associated UnitID and Edge Type.
-       */
-      std::vector<std::pair<UnitID, EdgeType>> in_uids;
-      std::vector<Node> nodes;
-      std::vector<Edge> all_in_edges = this->circuit_.get_in_edges(vert);
-      for (const Edge& edge : all_in_edges) {
-        UnitID uid;
-        EdgeType edge_type = this->circuit_.get_edgetype(edge);
-        switch (edge_type) {
-          case EdgeType::Quantum: {
-            uid = get_unitid_from_unit_frontier(
-                this->linear_boundary, {this->circuit_.source(edge),
-                                        this->circuit_.get_source_port(edge)});
-            // We use "nodes" to check if Quantum arguments respect the
-            // architecture
-            nodes.push_back(Node(uid));
-            break;
-          }
-          case EdgeType::Classical: {
-            uid = get_unitid_from_unit_frontier(
-                this->linear_boundary, {this->circuit_.source(edge),
-                                        this->circuit_.get_source_port(edge)});
-            break;
-          }
-          case EdgeType::Boolean: {
-            // N.B. function will find uid even if the bundle has more than the
-            // single "edge" passed
-            uid = get_bit_from_bool_frontier(this->boolean_boundary, {edge});
-            break;
-          }
-          default: {
-            TKET_ASSERT(false);
-          }
+    std::vector<std::pair<UnitID, EdgeType>> in_uids;
+    std::vector<Node> nodes;
+    std::vector<Edge> all_in_edges = this->circuit_.get_in_edges(vert);
+    bool in_boundary = true;
+    for (const Edge& edge : all_in_edges) {
+      EdgeType edge_type = this->circuit_.get_edgetype(edge);
+      UnitID uid;
+      if (edge_type == EdgeType::Boolean) {
+        auto found = boolean_edge_bits.find(edge);
+        if (found == boolean_edge_bits.end()) {
+          in_boundary = false;
+          break;
+        }
+        uid = found->second;
+      } else {
+        auto found = this->linear_boundary->get<TagValue>().find(VertPort{
+            this->circuit_.source(edge), this->circuit_.get_source_port(edge)});
+        if (found == this->linear_boundary->get<TagValue>().end()) {
+          in_boundary = false;
+          break;
         }
-        in_uids.push_back({uid, edge_type});
+        uid = found->first;
       }
-      /**
-       * If there are no valid vertices in the boundary then
-       * the while loop will terminate.
-       */
-
-      if (nodes.empty() ||
-          this->valid_boundary_operation(
-              architecture, this->circuit_.get_Op_ptr_from_Vertex(vert),
-              nodes)) {
-        boundary_updated = true;
-
-        /**
-         * "Linear" in edges stored in "in_uids" (Quantum & Classical)
-         * each have a single corresponding "out edge".
-         * We first find these and update the "linear boundary".
-         */
-
-        for (const std::pair<UnitID, EdgeType>& uid : in_uids) {
-          switch (uid.second) {
-            case EdgeType::Boolean:
-              break;
-            case EdgeType::Quantum:
-            case EdgeType::Classical: {
-              Edge replacement_edge =
-                  next_cut.u_frontier->get<TagKey>().find(uid.first)->second;
-              this->linear_boundary->replace(
-                  this->linear_boundary->get<TagKey>().find(uid.first),
-                  {uid.first,
-                   {this->circuit_.source(replacement_edge),
-                    this->circuit_.get_source_port(replacement_edge)}});
-              break;
-            }
-            default: {
-              TKET_ASSERT(false);
+      switch (edge_type) {
+        case EdgeType::Quantum: {
+          // We use "nodes" to check if Quantum arguments respect the
+          // architecture
+          nodes.push_back(Node(uid));
+          break;
+        }
+        case EdgeType::Classical: {
+          // The Bit can only be overwritten once all of its boolean edges to
+          // other vertices have been passed
+          auto boolean_it =
+              this->boolean_boundary->get<TagKey>().find(Bit(uid));
+          if (boolean_it != this->boolean_boundary->get<TagKey>().end()) {
+            for (const Edge& e : boolean_it->second) {
+              if (this->circuit_.target(e) != vert) in_boundary = false;
             }
           }
+          break;
+        }
+        case EdgeType::Boolean: {
+          break;
+        }
+        default: {
+          TKET_ASSERT(false);
         }
+      }
+      if (!in_boundary) break;
+      in_uids.push_back({uid, edge_type});
+    }
+    if (!in_boundary) continue;
+
+    if (!nodes.empty() &&
+        !this->valid_boundary_operation(
+            architecture, this->circuit_.get_Op_ptr_from_Vertex(vert),
+            nodes)) {
+      rejected.insert(vert);
+      continue;
+    }
+
+    /**
+     * "Linear" in edges stored in "in_uids" (Quantum & Classical)
+     * each have a single corresponding "out edge" from the same port.
+     * We first find these and update the "linear boundary".
+     */
+    for (port_t port = 0; port < in_uids.size(); port++) {
+      const std::pair<UnitID, EdgeType>& uid = in_uids[port];
+      if (uid.second != EdgeType::Boolean) {
+        this->linear_boundary->replace(
+            this->linear_boundary->get<TagKey>().find(uid.first),
+            {uid.first, {vert, port}});
+      }
+    }
+
+    /**
+     * Boolean bundles don't respect linearity in edges, but in bundles.
+     * They can terminate or spawn at/from vertices.
+     * For an n port vertex, "get_b_in_bundles" and "get_b_out_bundles"
+     * will always return an n element vector of bundles. If
+     * a port has no bundle then the bundle is empty.
+     */
+
+    std::vector<EdgeVec> in_bundles = this->circuit_.get_b_in_bundles(vert);
+    std::vector<EdgeVec> out_bundles = this->circuit_.get_b_out_bundles(vert);
 
-        /**
-         * Boolean bundles don't respect linearity in edges, but in bundles.
-         * They can terminate or spawn at/from vertices.
-         * For an n port vertex, "get_b_in_bundles" and "get_b_out_bundles"
-         * will always return an n element vector of bundles. If
-         * a port has no bundle then the bundle is empty.
-         */
-
-        std::vector<EdgeVec> in_bundles = this->circuit_.get_b_in_bundles(vert);
-        std::vector<EdgeVec> out_bundles =
-            this->circuit_.get_b_out_bundles(vert);
-
-        unsigned n_in_bundles = in_bundles.size();
-        unsigned n_out_bundles = out_bundles.size();
-
-        TKET_ASSERT(n_out_bundles == n_in_bundles);
-        TKET_ASSERT(n_in_bundles == in_uids.size());
-
-        /**
-         * For each "in port" to the Vertex:
-         * If the "in edge" is Quantum we know linearity is respected
-         * and we pass.
-         *
-         * If the "in edge" is Classical then the vertex "out port"
-         * may spawn a boolean bundle.
-         * The "in bundle" should always be empty.
-         * If the associated "out bundle" isn't empty, we add a new entry
-         * to the boolean boundary.
-         *
-         * If the "in edge" is Boolean then the vertex may edit, replace or
-         * remove a boolean bundle. The "in bundle" should never be empty. We
-         * construct a new candidate "out bundle" by combining the vertex "out
-         * bundle" (for this port) with any other boolean edges the boolean
-         * boundary has for this Bit that are not connected to this vertex. If
-         * the candidate "out bundle" is empty, we erase the Bit from the
-         * boundary. Else, we replace the "out edges" stored in the boundary for
-         * this Bit.
-         */
-
-        for (port_t port = 0; port < n_in_bundles; port++) {
-          std::pair<UnitID, EdgeType> linear_uid = in_uids[port];
-          EdgeVec in_bundle = in_bundles[port];
-          EdgeVec out_bundle = out_bundles[port];
-          switch (linear_uid.second) {
-            // Linear & can't spawn Boolean bundle: pass
-            case EdgeType::Quantum:
-              break;
-            // Linear but can spawn Boolean bundle
-            // If Boolean edges spawned, add to boolean boundary
-            case EdgeType::Classical: {
-              EdgeVec out_bundle = out_bundles[port];
-              TKET_ASSERT(in_bundle.empty());
-              if (!out_bundle.empty()) {
-                this->boolean_boundary->insert(
-                    {Bit(linear_uid.first), out_bundle});
-              }
-              break;
+    unsigned n_in_bundles = in_bundles.size();
+    unsigned n_out_bundles = out_bundles.size();
+
+    TKET_ASSERT(n_out_bundles == n_in_bundles);
+    TKET_ASSERT(n_in_bundles == in_uids.size());
+
+    /**
+     * For each "in port" to the Vertex:
+     * If the "in edge" is Quantum we know linearity is respected
+     * and we pass.
+     *
+     * If the "in edge" is Classical then the vertex "out port"
+     * may spawn a boolean bundle.
+     * The "in bundle" should always be empty.
+     * If the associated "out bundle" isn't empty, we add a new entry
+     * to the boolean boundary.
+     *
+     * If the "in edge" is Boolean then the vertex may edit, replace or
+     * remove a boolean bundle. The "in bundle" should never be empty. We
+     * construct a new candidate "out bundle" by combining the vertex "out
+     * bundle" (for this port) with any other boolean edges the boolean
+     * boundary has for this Bit that are not connected to this vertex. If
+     * the candidate "out bundle" is empty, we erase the Bit from the
+     * boundary. Else, we replace the "out edges" stored in the boundary for
+     * this Bit. Passing the last reader of a Bit may allow the next vertex
+     * on its linear edge to be passed.
+     */
+
+    for (port_t port = 0; port < n_in_bundles; port++) {
+      std::pair<UnitID, EdgeType> linear_uid = in_uids[port];
+      EdgeVec in_bundle = in_bundles[port];
+      EdgeVec out_bundle = out_bundles[port];
+      switch (linear_uid.second) {
+        // Linear & can't spawn Boolean bundle: pass
+        case EdgeType::Quantum:
+          break;
+        // Linear but can spawn Boolean bundle
+        // If Boolean edges spawned, add to boolean boundary
+        case EdgeType::Classical: {
+          TKET_ASSERT(in_bundle.empty());
+          if (!out_bundle.empty()) {
+            Bit bit = Bit(linear_uid.first);
+            this->boolean_boundary->insert({bit, out_bundle});
+            for (const Edge& edge : out_bundle) {
+              boolean_edge_bits.insert({edge, bit});
             }
-            // Can spawn, erase or edit boolean bundles
-            case EdgeType::Boolean: {
-              TKET_ASSERT(!in_bundle.empty());
-              Bit bit = Bit(linear_uid.first);
-              auto boolean_it = this->boolean_boundary->get<TagKey>().find(bit);
-              TKET_ASSERT(
-                  boolean_it != this->boolean_boundary->get<TagKey>().end());
-              // update "out bundle" with other boolean edges attached to other
-              // vertices
-              for (const Edge& edge : boolean_it->second) {
-                if (std::find(in_bundle.begin(), in_bundle.end(), edge) ==
-                    in_bundle.end()) {
-                  out_bundle.push_back(edge);
-                }
-              }
-              if (out_bundle.empty()) {
-                // => all edges in boolean bundle in boolean boundary attached
-                // to this vertex
-                // => vertex has no edges in output boolean bundle for this port
-                // => can erase Bit from boolean boundary as its not longer used
-                this->boolean_boundary->erase(boolean_it);
-              } else {
-                // => either Vertex has edges in output boolean bundle
-                // => or there are other edges in boolean bundle held in boolean
-                // boundary that are not attached to this vertex
-                // => update boolean boundary
-                this->boolean_boundary->replace(boolean_it, {bit, out_bundle});
-              }
-              break;
+          }
+          break;
+        }
+        // Can spawn, erase or edit boolean bundles
+        case EdgeType::Boolean: {
+          TKET_ASSERT(!in_bundle.empty());
+          Bit bit = Bit(linear_uid.first);
+          auto boolean_it = this->boolean_boundary->get<TagKey>().find(bit);
+          TKET_ASSERT(
+              boolean_it != this->boolean_boundary->get<TagKey>().end());
+          for (const Edge& edge : in_bundle) {
+            boolean_edge_bits.erase(edge);
+          }
+          for (const Edge& edge : out_bundle) {
+            boolean_edge_bits.insert({edge, bit});
+          }
+          // update "out bundle" with other boolean edges attached to other
+          // vertices
+          for (const Edge& edge : boolean_it->second) {
+            if (std::find(in_bundle.begin(), in_bundle.end(), edge) ==
+                in_bundle.end()) {
+              out_bundle.push_back(edge);
             }
-            default: {
-              TKET_ASSERT(false);
+          }
+          if (out_bundle.empty()) {
+            // => all edges in boolean bundle in boolean boundary attached
+            // to this vertex
+            // => vertex has no edges in output boolean bundle for this port
+            // => can erase Bit from boolean boundary as its not longer used
+            this->boolean_boundary->erase(boolean_it);
+            auto linear_it = this->linear_boundary->get<TagKey>().find(bit);
+            if (linear_it != this->linear_boundary->get<TagKey>().end()) {
+              add_candidate(this->circuit_.target(
+                  this->circuit_.get_nth_out_edge(
+                      linear_it->second.first, linear_it->second.second)));
             }
+          } else {
+            // => either Vertex has edges in output boolean bundle
+            // => or there are other edges in boolean bundle held in boolean
+            // boundary that are not attached to this vertex
+            // => update boolean boundary
+            this->boolean_boundary->replace(boolean_it, {bit, out_bundle});
           }
+          break;
+        }
+        default: {
+          TKET_ASSERT(false);
         }
       }
     }
-  } while (boundary_updated);
+
+    // The vertices after this one may now have all their in edges in the
+    // boundary
+    for (const Edge& edge : this->circuit_.get_all_out_edges(vert)) {
+      add_candidate(this->circuit_.target(edge));
+    }
+  }
   /**
    * This process is repeated until no more vertices are deemed
    * Architecture appropriate, i.e. either the end of the Circuit
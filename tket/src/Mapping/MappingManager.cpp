@@ -14,7 +14,16 @@
 
 #include "tket/Mapping/MappingManager.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <thread>
+#include <tuple>
+
 #include "tket/Architecture/BestTsaWithArch.hpp"
+#include "tket/Placement/Placement.hpp"
+#include "tket/Utils/ParallelFor.hpp"
 
 namespace tket {
 
@@ -37,6 +46,14 @@ bool MappingManager::route_circuit(
 bool MappingManager::route_circuit_with_maps(
     Circuit& circuit, const std::vector<RoutingMethodPtr>& routing_methods,
     std::shared_ptr<unit_bimaps_t> maps) const {
+  return *this->route_circuit_until(
+      circuit, routing_methods, maps, std::function<bool()>());
+}
+
+std::optional<bool> MappingManager::route_circuit_until(
+    Circuit& circuit, const std::vector<RoutingMethodPtr>& routing_methods,
+    std::shared_ptr<unit_bimaps_t> maps,
+    const std::function<bool()>& stop) const {
   if (circuit.n_qubits() > this->architecture_->n_nodes()) {
     std::string error_string =
         "Circuit has" + std::to_string(circuit.n_qubits()) +
@@ -158,6 +175,7 @@ bool MappingManager::route_circuit_with_maps(
 
   bool circuit_modified = !check_finish();
   while (!check_finish()) {
+    if (stop && stop()) return std::nullopt;
     // The order methods are passed in std::vector<RoutingMethod> is
     // the order they are run
     // If a method performs better but only on specific subcircuits,
@@ -191,4 +209,95 @@ bool MappingManager::route_circuit_with_maps(
   }
   return (circuit_modified || modify_at_start);
 }
-}  // namespace tket
\ No newline at end of file
+PortfolioRoutingResult MappingManager::route_circuit_portfolio(
+    Circuit& circuit, const std::vector<PortfolioRoutingConfig>& configs,
+    std::shared_ptr<unit_bimaps_t> maps, PortfolioObjective objective,
+    unsigned n_threads, std::optional<unsigned> timeout_ms) const {
+  if (configs.empty()) {
+    throw MappingManagerError("No configurations given for portfolio routing.");
+  }
+  if (!maps) {
+    maps = std::make_shared<unit_bimaps_t>();
+    for (const Qubit& qubit : circuit.all_qubits()) {
+      maps->initial.left.insert({qubit, qubit});
+      maps->final.left.insert({qubit, qubit});
+    }
+  }
+  if (n_threads == 0) {
+    n_threads = std::max(std::thread::hardware_concurrency(), 1u);
+  }
+
+  struct Outcome {
+    Circuit circuit;
+    std::shared_ptr<unit_bimaps_t> maps;
+    bool modified;
+    unsigned n_swaps;
+    unsigned depth;
+  };
+  std::vector<std::optional<Outcome>> outcomes(configs.size());
+  std::vector<std::exception_ptr> errors(configs.size());
+
+  const auto deadline =
+      std::chrono::steady_clock::now() +
+      std::chrono::milliseconds(timeout_ms.value_or(0));
+  std::atomic<unsigned> n_completed{0};
+  // Only give up on configurations once there is a result to return.
+  auto out_of_time = [&]() {
+    return timeout_ms && n_completed > 0 &&
+           std::chrono::steady_clock::now() >= deadline;
+  };
+
+  // Every configuration routes against the shared architecture, so build its
+  // lazily computed distance table once, before the workers start.
+  this->architecture_->get_distance_table();
+
+  parallel_for(configs.size(), n_threads, [&](std::size_t i) {
+    if (out_of_time()) return;
+    try {
+      const PortfolioRoutingConfig& config = configs[i];
+      Outcome outcome{
+          circuit, std::make_shared<unit_bimaps_t>(*maps), false, 0, 0};
+      if (config.placement) {
+        std::map<Qubit, Node> placement = *config.placement;
+        outcome.modified = Placement::place_with_map(
+            outcome.circuit, placement, outcome.maps);
+      }
+      std::optional<bool> routed = this->route_circuit_until(
+          outcome.circuit, config.routing_methods, outcome.maps,
+          out_of_time);
+      if (!routed) return;
+      outcome.modified |= *routed;
+      outcome.n_swaps = outcome.circuit.count_gates(OpType::SWAP) +
+                        outcome.circuit.count_gates(OpType::BRIDGE);
+      outcome.depth = outcome.circuit.depth();
+      outcomes[i] = std::move(outcome);
+      ++n_completed;
+    } catch (...) {
+      errors[i] = std::current_exception();
+    }
+  });
+
+  std::optional<unsigned> best;
+  auto rank = [&](const Outcome& outcome) {
+    return objective == PortfolioObjective::Depth
+               ? std::make_tuple(outcome.depth, outcome.n_swaps)
+               : std::make_tuple(outcome.n_swaps, outcome.depth);
+  };
+  for (unsigned i = 0; i < configs.size(); ++i) {
+    if (outcomes[i] && (!best || rank(*outcomes[i]) < rank(*outcomes[*best]))) {
+      best = i;
+    }
+  }
+  if (!best) {
+    for (const std::exception_ptr& error : errors) {
+      if (error) std::rethrow_exception(error);
+    }
+    TKET_ASSERT(!"portfolio routing finished without a result");
+  }
+  Outcome& chosen = *outcomes[*best];
+  circuit = std::move(chosen.circuit);
+  *maps = *chosen.maps;
+  return {*best, chosen.n_swaps, chosen.depth, n_completed.load()};
+}
+
+}  // namespace tket
@@ -20,7 +20,7 @@ namespace tket {
 
 MeasurementSetup measurement_reduction(
     const std::list<SpPauliString>& strings, PauliPartitionStrat strat,
-    GraphColourMethod method, CXConfigType cx_config) {
+    GraphColourMethod method, CXConfigType cx_config, unsigned n_threads) {
   std::set<Qubit> qubits;
   for (const SpPauliString& qpt : strings) {
     for (const std::pair<const Qubit, Pauli>& qb_p : qpt.string)
@@ -35,7 +35,7 @@ MeasurementSetup measurement_reduction(
   }
 
   std::list<std::list<SpPauliString>> all_terms =
-      term_sequence(strings, strat, method);
+      term_sequence(strings, strat, method, n_threads);
   MeasurementSetup ms;
   unsigned i = 0;
   for (const std::list<SpPauliString>& terms : all_terms) {
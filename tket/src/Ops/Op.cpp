@@ -14,6 +14,7 @@
 
 #include "tket/Ops/Op.hpp"
 
+#include <boost/functional/hash.hpp>
 #include <sstream>
 
 #include "tket/Ops/OpPtr.hpp"
@@ -28,6 +29,13 @@ std::string Op::get_name(bool latex) const {
   }
 }
 
+std::size_t Op::hash() const {
+  std::size_t seed = 0;
+  boost::hash_combine(seed, type_);
+  boost::hash_combine(seed, serialize().dump());
+  return seed;
+}
+
 std::string Op::get_command_str(const unit_vector_t& args) const {
   std::stringstream out;
   out << get_name();
@@ -244,13 +244,19 @@ GraphPlacement::get_all_weighted_subgraph_monomorphisms(
      * As eventually an edge will be added between every Node on the
      * Architecture, meaning a solution will be found.
      */
-    if (extended_target_graphs.size() <= incrementer) {
-      extended_target_graphs.push_back(
-          this->construct_target_graph(this->weighted_target_edges, incrementer)
-              .get_undirected_connectivity());
-      TKET_ASSERT(extended_target_graphs.size() - 1 == incrementer);
+    const Architecture::UndirectedConnGraph* target_graph;
+    {
+      std::lock_guard<std::mutex> lock(*extended_target_graphs_mutex);
+      if (extended_target_graphs.size() <= incrementer) {
+        extended_target_graphs.push_back(
+            this->construct_target_graph(
+                    this->weighted_target_edges, incrementer)
+                .get_undirected_connectivity());
+        TKET_ASSERT(extended_target_graphs.size() - 1 == incrementer);
+      }
+      TKET_ASSERT(extended_target_graphs.size() > incrementer);
+      target_graph = &extended_target_graphs[incrementer];
     }
-    TKET_ASSERT(extended_target_graphs.size() > incrementer);
 
     // For each increment we construct a smaller pattern graph
     QubitGraph::UndirectedConnGraph pattern_graph =
@@ -270,7 +276,7 @@ GraphPlacement::get_all_weighted_subgraph_monomorphisms(
     auto it = all_pattern_graphs.begin();
     while (it != all_pattern_graphs.end() && all_bimaps.empty()) {
       all_bimaps = get_weighted_subgraph_monomorphisms(
-          *it, extended_target_graphs[incrementer], this->maximum_matches_,
+          *it, *target_graph, this->maximum_matches_,
           this->timeout_ -
               std::chrono::duration_cast<std::chrono::milliseconds>(
                   Clock::now() - init_start)
@@ -0,0 +1,237 @@
+// Copyright Quantinuum
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tket/Predicates/CompilationCache.hpp"
+
+#include <algorithm>
+#include <boost/functional/hash.hpp>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <sstream>
+
+namespace tket {
+
+namespace {
+
+bool is_opaque_config(const nlohmann::json &j) {
+  if (j.is_string()) {
+    const std::string &s = j.get_ref<const std::string &>();
+    // Every RoutingMethod defined outside tket, such as a Python
+    // RoutingMethodCircuit, serializes to the same {"name": "RoutingMethod"}.
+    return s == "CustomPass" || s == "CustomPassMap" ||
+           s == "RepeatWithMetricPass" || s == "UserDefinedPredicate" ||
+           s == "RoutingMethod";
+  }
+  if (j.is_structured()) {
+    for (const nlohmann::json &el : j) {
+      if (is_opaque_config(el)) return true;
+    }
+  }
+  return false;
+}
+
+// Cache files hold one line of JSON (the "changed" flag, the maps, the pass
+// configuration and the size of the input circuit) followed by the input and
+// then the compiled circuit, both in the format of Circuit::to_binary.
+
+nlohmann::json unit_to_json(const UnitID &u) {
+  return {static_cast<int>(u.type()), u.reg_name(), u.index()};
+}
+
+UnitID unit_from_json(const nlohmann::json &j) {
+  const auto type = static_cast<UnitType>(j.at(0).get<int>());
+  const auto name = j.at(1).get<std::string>();
+  const auto index = j.at(2).get<std::vector<unsigned>>();
+  switch (type) {
+    case UnitType::Qubit:
+      return Qubit(name, index);
+    case UnitType::Bit:
+      return Bit(name, index);
+    case UnitType::WasmState:
+      return WasmState(name, index);
+    case UnitType::RngState:
+      return RngState(name, index);
+    default:
+      throw JsonError("Unknown unit type in compilation cache file");
+  }
+}
+
+nlohmann::json bimap_to_json(const unit_bimap_t &m) {
+  nlohmann::json j = nlohmann::json::array();
+  for (const auto &[from, to] : m.left) {
+    j.push_back({unit_to_json(from), unit_to_json(to)});
+  }
+  return j;
+}
+
+unit_bimap_t bimap_from_json(const nlohmann::json &j) {
+  unit_bimap_t m;
+  for (const nlohmann::json &pair : j) {
+    m.left.insert({unit_from_json(pair.at(0)), unit_from_json(pair.at(1))});
+  }
+  return m;
+}
+
+}  // namespace
+
+std::optional<std::size_t> pass_config_hash(const nlohmann::json &config) {
+  if (is_opaque_config(config)) return std::nullopt;
+  return std::hash<std::string>()(config.dump());
+}
+
+std::size_t CompilationCache::KeyHash::operator()(const Key &key) const {
+  return boost::hash_value(key);
+}
+
+CompilationCache::CompilationCache(
+    std::size_t capacity, std::optional<std::string> directory)
+    : capacity_(std::max<std::size_t>(capacity, 1)),
+      directory_(std::move(directory)) {}
+
+std::optional<CompilationCache::Entry> CompilationCache::find(
+    std::size_t circ_hash, std::size_t pass_hash, const std::string &input,
+    const std::string &config) {
+  const Key key{circ_hash, pass_hash};
+  auto matches = [&](const Entry &entry) {
+    return entry.input == input && entry.config == config;
+  };
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto found = index_.find(key);
+    if (found != index_.end()) {
+      if (!matches(found->second->second)) {
+        // A hash collision; the caller will replace the entry.
+        ++misses_;
+        return std::nullopt;
+      }
+      entries_.splice(entries_.begin(), entries_, found->second);
+      ++hits_;
+      return found->second->second;
+    }
+  }
+  std::optional<Entry> entry = read_file(key);
+  if (entry && !matches(*entry)) entry.reset();
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (entry) {
+    ++hits_;
+    insert_locked(key, *entry);
+  } else {
+    ++misses_;
+  }
+  return entry;
+}
+
+void CompilationCache::insert(
+    std::size_t circ_hash, std::size_t pass_hash, Entry entry) {
+  const Key key{circ_hash, pass_hash};
+  write_file(key, entry);
+  std::lock_guard<std::mutex> lock(mutex_);
+  insert_locked(key, std::move(entry));
+}
+
+void CompilationCache::insert_locked(const Key &key, Entry entry) {
+  const auto found = index_.find(key);
+  if (found != index_.end()) {
+    found->second->second = std::move(entry);
+    entries_.splice(entries_.begin(), entries_, found->second);
+    return;
+  }
+  entries_.emplace_front(key, std::move(entry));
+  index_.emplace(key, entries_.begin());
+  if (entries_.size() > capacity_) {
+    index_.erase(entries_.back().first);
+    entries_.pop_back();
+  }
+}
+
+std::size_t CompilationCache::size() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return entries_.size();
+}
+
+std::size_t CompilationCache::hits() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return hits_;
+}
+
+std::size_t CompilationCache::misses() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return misses_;
+}
+
+void CompilationCache::clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  entries_.clear();
+  index_.clear();
+}
+
+std::string CompilationCache::filename(const Key &key) const {
+  std::ostringstream name;
+  name << std::hex << key.first << '-' << key.second << ".tkcc";
+  return (std::filesystem::path(*directory_) / name.str()).string();
+}
+
+std::optional<CompilationCache::Entry> CompilationCache::read_file(
+    const Key &key) const {
+  if (!directory_) return std::nullopt;
+  std::ifstream file(filename(key), std::ios::binary);
+  if (!file) return std::nullopt;
+  try {
+    std::string header;
+    std::getline(file, header);
+    const nlohmann::json j = nlohmann::json::parse(header);
+    const std::string data(
+        (std::istreambuf_iterator<char>(file)),
+        std::istreambuf_iterator<char>());
+    const std::size_t input_size = j.at("input_size").get<std::size_t>();
+    if (input_size > data.size()) return std::nullopt;
+    return Entry{
+        Circuit::from_binary(std::string_view(data).substr(input_size)),
+        j.at("changed").get<bool>(),
+        {bimap_from_json(j.at("initial")), bimap_from_json(j.at("final"))},
+        data.substr(0, input_size),
+        j.at("config").get<std::string>()};
+  } catch (const std::exception &) {
+    // Treat unreadable files as missing; they will be overwritten.
+    return std::nullopt;
+  }
+}
+
+void CompilationCache::write_file(const Key &key, const Entry &entry) const {
+  if (!directory_) return;
+  nlohmann::json j;
+  j["changed"] = entry.changed;
+  j["initial"] = bimap_to_json(entry.maps.initial);
+  j["final"] = bimap_to_json(entry.maps.final);
+  j["config"] = entry.config;
+  j["input_size"] = entry.input.size();
+  // Write to a temporary file and rename it, so that readers in other
+  // processes never see a partly written entry.
+  const std::string path = filename(key);
+  std::ostringstream tmp;
+  tmp << path << '.' << std::random_device()() << ".tmp";
+  {
+    std::ofstream file(tmp.str(), std::ios::binary);
+    if (!file) return;
+    file << j.dump() << '\n' << entry.input << entry.circ.to_binary();
+    if (!file) return;
+  }
+  std::error_code ec;
+  std::filesystem::rename(tmp.str(), path, ec);
+  if (ec) std::filesystem::remove(tmp.str(), ec);
+}
+
+}  // namespace tket
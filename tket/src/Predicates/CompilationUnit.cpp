@@ -45,7 +45,10 @@ TypePredicatePair CompilationUnit::make_type_pair(const PredicatePtr& ptr) {
 }
 
 bool CompilationUnit::calc_predicate(const Predicate& pred) const {
-  return pred.verify(circ_);
+  PassTraceScope scope(*this, pred);
+  bool result = pred.verify(circ_);
+  scope.set_arg("result", result);
+  return result;
 }
 
 bool CompilationUnit::check_all_predicates() const {
@@ -80,6 +83,14 @@ std::string CompilationUnit::to_string() const {
   return s.str();
 }
 
+void CompilationUnit::enable_trace(bool enable) {
+  if (enable) {
+    trace_ = PassTrace();
+  } else {
+    trace_ = std::nullopt;
+  }
+}
+
 void CompilationUnit::empty_cache() const { cache_ = {}; }
 
 void CompilationUnit::initialize_cache() const {
@@ -14,26 +14,117 @@
 
 #include "tket/Predicates/CompilerPass.hpp"
 
+#include <algorithm>
 #include <memory>
 #include <optional>
+#include <thread>
+#include <utility>
 #include <tklog/TketLog.hpp>
 
 #include "tket/Mapping/RoutingMethodJson.hpp"
+#include "tket/Predicates/CompilationCache.hpp"
 #include "tket/Predicates/PassGenerators.hpp"
 #include "tket/Predicates/PassLibrary.hpp"
 #include "tket/Transformations/ContextualReduction.hpp"
 #include "tket/Transformations/PauliOptimisation.hpp"
 #include "tket/Utils/Json.hpp"
+#include "tket/Utils/ParallelFor.hpp"
 #include "tket/Utils/UnitID.hpp"
 
 namespace tket {
 
 void trivial_callback(const CompilationUnit&, const nlohmann::json&) {}
 
+namespace {
+
+// Compose a map produced by compiling a copy of a circuit (which starts from
+// the identity on `units`) with the corresponding map of the original unit.
+void compose_map(
+    unit_bimap_t& map, const unit_bimap_t& delta, const unit_vector_t& units) {
+  const unit_set_t unit_set(units.begin(), units.end());
+  // Remove every affected pair before reinserting, since the delta may
+  // permute units.
+  std::vector<std::pair<UnitID, UnitID>> updates;
+  for (const UnitID& u : units) {
+    auto current = map.right.find(u);
+    if (current == map.right.end()) continue;
+    auto updated = delta.left.find(u);
+    if (updated != delta.left.end()) {
+      updates.push_back({current->second, updated->second});
+    }
+    map.right.erase(current);
+  }
+  for (const auto& [orig, to] : updates) map.left.insert({orig, to});
+  for (const auto& [from, to] : delta.left) {
+    if (unit_set.find(from) == unit_set.end()) map.left.insert({from, to});
+  }
+}
+
+}  // namespace
+
 PassConditions BasePass::get_conditions() const {
   return {precons_, postcons_};
 }
 
+std::vector<bool> BasePass::apply_batch(
+    std::vector<CompilationUnit>& c_units, unsigned n_threads,
+    SafetyMode safe_mode) const {
+  if (n_threads == 0) {
+    n_threads = std::max(std::thread::hardware_concurrency(), 1u);
+  }
+  // std::vector<bool> packs its elements, so concurrent writes to it race.
+  std::vector<char> modified(c_units.size(), 0);
+  parallel_for(c_units.size(), n_threads, [&](std::size_t i) {
+    modified[i] = this->apply(c_units[i], safe_mode);
+  });
+  return std::vector<bool>(modified.begin(), modified.end());
+}
+
+bool BasePass::apply_cached(
+    CompilationUnit& c_unit, CompilationCache& cache,
+    SafetyMode safe_mode) const {
+  const nlohmann::json config = this->get_config();
+  const std::optional<std::size_t> pass_hash = pass_config_hash(config);
+  if (!pass_hash) return this->apply(c_unit, safe_mode);
+  std::size_t circ_hash;
+  std::string input;
+  try {
+    circ_hash = c_unit.circ_.structural_hash();
+    input = c_unit.circ_.to_binary();
+  } catch (const JsonError&) {
+    // Some ops cannot be serialized, and so cannot be hashed.
+    return this->apply(c_unit, safe_mode);
+  }
+  const std::string config_str = config.dump();
+  std::optional<PredicatePtr> unsatisfied_precon =
+      unsatisfied_precondition(c_unit, safe_mode);
+  if (unsatisfied_precon)
+    throw UnsatisfiedPredicate(unsatisfied_precon.value()->to_string());
+
+  PassTraceScope trace_scope(c_unit, *this);
+  std::optional<CompilationCache::Entry> entry =
+      cache.find(circ_hash, *pass_hash, input, config_str);
+  trace_scope.set_arg("cache_hit", entry.has_value());
+  if (!entry) {
+    // Keep the target predicates, so that postconditions are checked
+    // exactly as by apply.
+    CompilationUnit fresh(c_unit.circ_, c_unit.target_preds);
+    std::swap(fresh.trace_, c_unit.trace_);
+    bool changed = this->apply(fresh, safe_mode);
+    std::swap(fresh.trace_, c_unit.trace_);
+    entry = CompilationCache::Entry{
+        fresh.circ_, changed, *fresh.maps, std::move(input), config_str};
+    cache.insert(circ_hash, *pass_hash, *entry);
+  }
+  const unit_vector_t units = c_unit.circ_.all_units();
+  c_unit.circ_ = std::move(entry->circ);
+  compose_map(c_unit.maps->initial, entry->maps.initial, units);
+  compose_map(c_unit.maps->final, entry->maps.final, units);
+  update_cache(c_unit, safe_mode);
+  trace_scope.set_arg("changed", entry->changed);
+  return entry->changed;
+}
+
 std::string BasePass::to_string() const {
   std::string str = "Preconditions:\n";
   for (const TypePredicatePair& pp : precons_) {
@@ -99,7 +190,7 @@ void BasePass::update_cache(
     }
   }
   for (const TypePredicatePair& pp : postcons_.specific_postcons_) {
-    if (safe_mode == SafetyMode::Audit && !pp.second->verify(c_unit.circ_))
+    if (safe_mode == SafetyMode::Audit && !c_unit.calc_predicate(*pp.second))
       throw UnsatisfiedPredicate(pp.second->to_string());
     std::pair<PredicatePtr, bool> cache_pair{pp.second, true};
     c_unit.cache_[pp.first] = cache_pair;
@@ -191,6 +282,7 @@ PassConditions BasePass::match_passes(const PassPtr& lhs, const PassPtr& rhs) {
 bool StandardPass::apply(
     CompilationUnit& c_unit, SafetyMode safe_mode,
     const PassCallback& before_apply, const PassCallback& after_apply) const {
+  PassTraceScope trace_scope(c_unit, *this);
   before_apply(c_unit, this->get_config());
   std::optional<PredicatePtr> unsatisfied_precon =
       unsatisfied_precondition(c_unit, safe_mode);
@@ -202,6 +294,7 @@ bool StandardPass::apply(
   bool changed = trans_.apply_fn(c_unit.circ_, c_unit.maps);
   update_cache(c_unit, safe_mode);
   after_apply(c_unit, this->get_config());
+  trace_scope.set_arg("changed", changed);
   return changed;
 }
 
@@ -283,8 +376,10 @@ RepeatWithMetricPass::RepeatWithMetricPass(
 bool RepeatWithMetricPass::apply(
     CompilationUnit& c_unit, SafetyMode safe_mode,
     const PassCallback& before_apply, const PassCallback& after_apply) const {
+  PassTraceScope trace_scope(c_unit, *this);
   before_apply(c_unit, this->get_config());
   bool success = false;
+  unsigned iterations = 1;
   unsigned currentVal = metric_(c_unit.get_circ_ref());
   CompilationUnit* c_unit_current = &c_unit;
   CompilationUnit c_unit_new = c_unit;
@@ -297,10 +392,18 @@ bool RepeatWithMetricPass::apply(
     currentVal = newVal;
     success = true;
     pass_->apply(c_unit_new, safe_mode, before_apply, after_apply);
+    ++iterations;
     newVal = metric_(c_unit_new.get_circ_ref());
   }
-  if (&c_unit != c_unit_current) c_unit = *c_unit_current;
+  if (&c_unit != c_unit_current) {
+    c_unit = *c_unit_current;
+  } else {
+    // Keep the trace of the rejected attempt.
+    c_unit.trace_ = std::move(c_unit_new.trace_);
+  }
   after_apply(c_unit, this->get_config());
+  trace_scope.set_arg("iterations", iterations);
+  trace_scope.set_arg("changed", success);
   return success;
 }
 
@@ -328,13 +431,18 @@ RepeatUntilSatisfiedPass::RepeatUntilSatisfiedPass(
 bool RepeatUntilSatisfiedPass::apply(
     CompilationUnit& c_unit, SafetyMode safe_mode,
     const PassCallback& before_apply, const PassCallback& after_apply) const {
+  PassTraceScope trace_scope(c_unit, *this);
   before_apply(c_unit, this->get_config());
   bool success = false;
-  while (!pred_->verify(c_unit.get_circ_ref())) {
+  unsigned iterations = 0;
+  while (!c_unit.calc_predicate(*pred_)) {
     pass_->apply(c_unit, safe_mode, before_apply, after_apply);
+    ++iterations;
     success = true;
   }
   after_apply(c_unit, this->get_config());
+  trace_scope.set_arg("iterations", iterations);
+  trace_scope.set_arg("changed", success);
   return success;
 }
 
@@ -0,0 +1,124 @@
+// Copyright Quantinuum
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tket/Predicates/PassTrace.hpp"
+
+#include <stdexcept>
+
+#include "tket/Predicates/CompilationUnit.hpp"
+#include "tket/Predicates/CompilerPass.hpp"
+
+namespace tket {
+
+static nlohmann::json circuit_stats(const Circuit &circ) {
+  nlohmann::json j;
+  j["n_gates"] = circ.n_gates();
+  j["depth"] = circ.depth();
+  j["n_2qb_gates"] = circ.count_n_qubit_gates(2);
+  return j;
+}
+
+// Serializing a composite pass serializes everything inside it, and may fail,
+// so only standard passes are asked for their configuration.
+static std::string pass_name(const BasePass &pass) {
+  if (dynamic_cast<const StandardPass *>(&pass)) {
+    return pass.get_config()["StandardPass"].value("name", "StandardPass");
+  }
+  if (dynamic_cast<const SequencePass *>(&pass)) return "SequencePass";
+  if (dynamic_cast<const RepeatPass *>(&pass)) return "RepeatPass";
+  if (dynamic_cast<const RepeatWithMetricPass *>(&pass)) {
+    return "RepeatWithMetricPass";
+  }
+  if (dynamic_cast<const RepeatUntilSatisfiedPass *>(&pass)) {
+    return "RepeatUntilSatisfiedPass";
+  }
+  return "BasePass";
+}
+
+PassTrace::PassTrace()
+    : origin_(std::chrono::steady_clock::now()), open_spans_(0) {}
+
+double PassTrace::now() const {
+  return std::chrono::duration<double, std::micro>(
+             std::chrono::steady_clock::now() - origin_)
+      .count();
+}
+
+nlohmann::json PassTrace::to_chrome_trace() const {
+  nlohmann::json events = nlohmann::json::array();
+  for (const PassTraceEvent &ev : events_) {
+    nlohmann::json j;
+    j["name"] = ev.name;
+    j["cat"] = ev.category;
+    j["ph"] = "X";
+    j["ts"] = ev.start;
+    j["dur"] = ev.duration;
+    j["pid"] = 0;
+    j["tid"] = 0;
+    j["args"] = ev.args;
+    events.push_back(j);
+  }
+  nlohmann::json j;
+  j["traceEvents"] = events;
+  j["displayTimeUnit"] = "ms";
+  return j;
+}
+
+PassTraceScope::PassTraceScope(
+    const CompilationUnit &c_unit, const BasePass &pass)
+    : c_unit_(c_unit), active_(c_unit.trace_.has_value()), is_pass_(true) {
+  if (!active_) return;
+  event_.name = pass_name(pass);
+  event_.category = "pass";
+  event_.args["before"] = circuit_stats(c_unit.get_circ_ref());
+  PassTrace &t = trace();
+  event_.level = t.open_spans_++;
+  event_.start = t.now();
+}
+
+PassTraceScope::PassTraceScope(
+    const CompilationUnit &c_unit, const Predicate &pred)
+    : c_unit_(c_unit), active_(c_unit.trace_.has_value()), is_pass_(false) {
+  if (!active_) return;
+  try {
+    event_.name = predicate_name(typeid(pred));
+  } catch (const std::out_of_range &) {
+    event_.name = "Predicate";
+  }
+  event_.category = "predicate";
+  PassTrace &t = trace();
+  event_.level = t.open_spans_++;
+  event_.start = t.now();
+}
+
+PassTraceScope::~PassTraceScope() {
+  // Tracing may have been switched off inside the span.
+  if (!active_ || !c_unit_.trace_) return;
+  PassTrace &t = trace();
+  event_.duration = t.now() - event_.start;
+  if (t.open_spans_ > 0) --t.open_spans_;
+  if (is_pass_) {
+    event_.args["after"] = circuit_stats(c_unit_.get_circ_ref());
+  }
+  t.events_.push_back(std::move(event_));
+}
+
+void PassTraceScope::set_arg(
+    const std::string &key, const nlohmann::json &value) {
+  if (active_) event_.args[key] = value;
+}
+
+PassTrace &PassTraceScope::trace() const { return *c_unit_.trace_; }
+
+}  // namespace tket
@@ -48,16 +48,23 @@ bool SingleQubitSquash::squash() {
     Edge in = circ_.get_nth_out_edge(inputs[i], 0);
     Edge out = circ_.get_nth_in_edge(outputs[i], 0);
     if (reversed_) {
-      success |= squash_between(out, in);
+      success |= squash_wire(out, in);
     } else {
-      success |= squash_between(in, out);
+      success |= squash_wire(in, out);
     }
   }
+  reachability_.reset();
 
   return success;
 }
 
 bool SingleQubitSquash::squash_between(const Edge &in, const Edge &out) {
+  bool success = squash_wire(in, out);
+  reachability_.reset();
+  return success;
+}
+
+bool SingleQubitSquash::squash_wire(const Edge &in, const Edge &out) {
   squasher_->clear();
   Edge e = in;
   Vertex v = next_vertex(e);
@@ -170,34 +177,28 @@ void SingleQubitSquash::substitute(
 
   // restore backup
   e = prev_edge(backup);
-}
 
-bool SingleQubitSquash::path_exists(
-    const Vertex &v, const VertexSet &vs) const {
-  VertexSet frontier{v};
-  while (!frontier.empty()) {
-    if (std::any_of(vs.begin(), vs.end(), [&frontier](const Vertex &v1) {
-          return frontier.contains(v1);
-        })) {
-      return true;
+  if (reachability_) {
+    for (const Vertex &v : single_chain) {
+      reachability_->erase_vertex(v);
     }
-    VertexSet new_frontier;
-    for (const Vertex &v1 : frontier) {
-      if (reversed_) {
-        const VertexVec &succs = circ_.get_successors(v1);
-        new_frontier.insert(succs.begin(), succs.end());
-      } else {
-        const VertexVec &preds = circ_.get_predecessors(v1);
-        new_frontier.insert(preds.begin(), preds.end());
-      }
+    // The replacement gates are the last sub.n_gates() vertices before e.
+    VertexVec new_verts;
+    Edge e1 = e;
+    for (unsigned i = 0; i < sub.n_gates(); ++i) {
+      const Vertex v = reversed_ ? circ_.target(e1) : circ_.source(e1);
+      new_verts.push_back(v);
+      e1 = reversed_ ? circ_.get_next_edge(v, e1) : circ_.get_last_edge(v, e1);
+    }
+    if (!reversed_) {
+      std::reverse(new_verts.begin(), new_verts.end());
     }
-    frontier = std::move(new_frontier);
+    reachability_->insert_vertices(new_verts);
   }
-  return false;
 }
 
 bool SingleQubitSquash::commute_ok(
-    const Edge &e, const Condition &condition) const {
+    const Edge &e, const Condition &condition) {
   VertexSet vs;
   for (const std::pair<std::list<VertPort>, unsigned> &cond : condition) {
     for (const VertPort &vp : cond.first) {
@@ -205,15 +206,18 @@ bool SingleQubitSquash::commute_ok(
     }
   }
   if (vs.empty()) return true;
+  if (!reachability_) {
+    reachability_ = std::make_unique<DAGReachability>(circ_);
+  }
   if (reversed_) {
     // Return true iff there is no path in the DAG from source(e) to any vertex
     // in vs. (Such a path would introduce a cycle after the commutation.)
-    return !path_exists(circ_.source(e), vs);
+    return !reachability_->reaches_any(circ_.source(e), vs);
   } else {
     // Return true iff there is no path in the DAG from any vertex in vs to
     // target(e). (Such a path would imply the condition is no longer live when
     // queried.)
-    return !path_exists(circ_.target(e), vs);
+    return !reachability_->reached_from_any(vs, circ_.target(e));
   }
 }
 
@@ -241,6 +245,9 @@ void SingleQubitSquash::insert_left_over_gate(
   preds.push_back(e);
   sigs.push_back(EdgeType::Quantum);
   circ_.rewire(new_v, preds, sigs);
+  if (reachability_) {
+    reachability_->insert_vertices({new_v});
+  }
 }
 
 bool SingleQubitSquash::sub_is_better(
@@ -15,6 +15,9 @@
 #include "tket/Utils/Expression.hpp"
 
 #include <optional>
+#include <symengine/eval_double.h>
+#include <symengine/rational.h>
+#include <symengine/real_double.h>
 
 #include "symengine/symengine_exception.h"
 #include "tket/Utils/Constants.hpp"
@@ -55,7 +58,22 @@ SymSet expr_free_symbols(const std::vector<Expr>& es) {
   return symbols;
 }
 
+std::optional<double> eval_number(const Expr& e) {
+  const SymEngine::Basic& b = *e.get_basic();
+  if (SymEngine::is_a<SymEngine::RealDouble>(b)) {
+    return SymEngine::down_cast<const SymEngine::RealDouble&>(b).as_double();
+  }
+  if (SymEngine::is_a<SymEngine::Integer>(b) ||
+      SymEngine::is_a<SymEngine::Rational>(b)) {
+    return SymEngine::eval_double(b);
+  }
+  return std::nullopt;
+}
+
 std::optional<double> eval_expr(const Expr& e) {
+  // Plain numbers are by far the most common case, and need no search for
+  // free symbols.
+  if (std::optional<double> x = eval_number(e)) return x;
   if (!SymEngine::free_symbols(e).empty()) {
     return std::nullopt;
   } else {
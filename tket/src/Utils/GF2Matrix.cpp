@@ -0,0 +1,290 @@
+// Copyright Quantinuum
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "tket/Utils/GF2Matrix.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace tket {
+
+GF2Matrix::GF2Matrix(unsigned rows, unsigned cols)
+    : rows_(rows),
+      cols_(cols),
+      row_words_((cols + word_bits - 1) / word_bits),
+      data_(std::size_t{rows} * row_words_, 0) {}
+
+GF2Matrix::GF2Matrix(const MatrixXb &m) : GF2Matrix(m.rows(), m.cols()) {
+  for (unsigned r = 0; r < rows_; ++r) {
+    word_t *p = row_data(r);
+    for (unsigned c = 0; c < cols_; ++c) {
+      if (m(r, c)) p[c / word_bits] |= word_t{1} << (c % word_bits);
+    }
+  }
+}
+
+GF2Matrix GF2Matrix::identity(unsigned n) {
+  GF2Matrix m(n, n);
+  for (unsigned i = 0; i < n; ++i) m(i, i) = true;
+  return m;
+}
+
+bool GF2Matrix::row_is_zero(unsigned r) const {
+  const word_t *p = row_data(r);
+  return std::all_of(p, p + row_words_, [](word_t w) { return w == 0; });
+}
+
+bool GF2Matrix::is_zero() const {
+  return std::all_of(
+      data_.begin(), data_.end(), [](word_t w) { return w == 0; });
+}
+
+void GF2Matrix::swap_rows(unsigned r1, unsigned r2) {
+  if (r1 == r2) return;
+  std::swap_ranges(row_data(r1), row_data(r1) + row_words_, row_data(r2));
+}
+
+void GF2Matrix::copy_row(unsigned from, unsigned to) {
+  if (from == to) return;
+  std::copy(row_data(from), row_data(from) + row_words_, row_data(to));
+}
+
+void GF2Matrix::copy_col(unsigned from, unsigned to) {
+  for (unsigned r = 0; r < rows_; ++r) {
+    (*this)(r, to) = (*this)(r, from);
+  }
+}
+
+void GF2Matrix::conservative_resize(unsigned rows, unsigned cols) {
+  GF2Matrix resized(rows, cols);
+  const unsigned keep_rows = std::min(rows, rows_);
+  const unsigned keep_words = std::min(row_words_, resized.row_words_);
+  for (unsigned r = 0; r < keep_rows; ++r) {
+    std::copy(row_data(r), row_data(r) + keep_words, resized.row_data(r));
+    if (cols < cols_ && cols % word_bits != 0) {
+      // Clear the entries beyond the new last column.
+      resized.row_data(r)[keep_words - 1] &=
+          (word_t{1} << (cols % word_bits)) - 1;
+    }
+  }
+  *this = std::move(resized);
+}
+
+MatrixXb GF2Matrix::to_MatrixXb() const {
+  MatrixXb m(rows_, cols_);
+  for (unsigned r = 0; r < rows_; ++r) {
+    for (unsigned c = 0; c < cols_; ++c) m(r, c) = (*this)(r, c);
+  }
+  return m;
+}
+
+GF2Matrix::word_t GF2Matrix::bits(unsigned r, unsigned c, unsigned n) const {
+  const word_t *p = row_data(r) + c / word_bits;
+  const unsigned shift = c % word_bits;
+  word_t x = p[0] >> shift;
+  if (shift != 0 && shift + n > word_bits) {
+    x |= p[1] << (word_bits - shift);
+  }
+  if (n < word_bits) x &= (word_t{1} << n) - 1;
+  return x;
+}
+
+std::vector<std::pair<unsigned, unsigned>>
+GF2Matrix::gaussian_elimination_row_ops(unsigned blocksize) {
+  if (blocksize == 0 || blocksize > word_bits) {
+    throw std::invalid_argument(
+        "Gaussian elimination block size must be between 1 and 64");
+  }
+  std::vector<std::pair<unsigned, unsigned>> ops;
+  std::vector<unsigned> pcols;  // columns with pivots, in order
+  unsigned pivot_row = 0;
+  const unsigned ceiling = (cols_ + blocksize - 1) / blocksize;
+  // Rows seen in the current section, keyed by their entries in it
+  std::unordered_map<word_t, unsigned> chunks;
+
+  // Get to upper echelon form
+  for (unsigned sec = 0; sec < ceiling; ++sec) {
+    const unsigned i0 = sec * blocksize;
+    const unsigned i1 = std::min(cols_, (sec + 1) * blocksize);
+
+    // First cancel repeated chunks, then eliminate the remaining entries.
+    chunks.clear();
+    for (unsigned r = pivot_row; r < rows_; ++r) {
+      const word_t t = bits(r, i0, i1 - i0);
+      if (t == 0) continue;
+      auto [chunk_it, inserted] = chunks.insert({t, r});
+      if (!inserted) {
+        row_xor(chunk_it->second, r);
+        ops.push_back({chunk_it->second, r});
+      }
+    }
+    for (unsigned col = i0; col < i1; ++col) {
+      unsigned first_1 = pivot_row;
+      while (first_1 < rows_ && !(*this)(first_1, col)) {
+        ++first_1;
+      }
+      if (first_1 == rows_) continue;
+      if (first_1 != pivot_row) {
+        row_xor(first_1, pivot_row);
+        ops.push_back({first_1, pivot_row});
+      }
+      for (unsigned r = std::max(pivot_row + 1, first_1); r < rows_; ++r) {
+        if ((*this)(r, col)) {
+          row_xor(pivot_row, r);
+          ops.push_back({pivot_row, r});
+        }
+      }
+      pcols.push_back(col);
+      ++pivot_row;
+    }
+  }
+
+  // Clear the entries above the pivots, in the same way.
+  --pivot_row;
+  for (unsigned sec = ceiling; sec-- > 0;) {
+    const unsigned i0 = sec * blocksize;
+    const unsigned i1 = std::min(cols_, (sec + 1) * blocksize);
+
+    chunks.clear();
+    for (unsigned r = pivot_row + 1; r-- > 0;) {
+      const word_t t = bits(r, i0, i1 - i0);
+      if (t == 0) continue;
+      auto [chunk_it, inserted] = chunks.insert({t, r});
+      if (!inserted) {
+        row_xor(chunk_it->second, r);
+        ops.push_back({chunk_it->second, r});
+      }
+    }
+    while (!pcols.empty() && i0 <= pcols.back() && pcols.back() < i1) {
+      const unsigned pcol = pcols.back();
+      pcols.pop_back();
+      for (unsigned r = 0; r < pivot_row; ++r) {
+        if ((*this)(r, pcol)) {
+          row_xor(pivot_row, r);
+          ops.push_back({pivot_row, r});
+        }
+      }
+      --pivot_row;
+    }
+  }
+
+  return ops;
+}
+
+std::vector<unsigned> GF2Matrix::m4ri_reduce(
+    unsigned n_pivot_cols, bool full) {
+  constexpr unsigned max_block = 8;
+  n_pivot_cols = std::min(n_pivot_cols, cols_);
+  std::vector<unsigned> pivots;
+  std::vector<word_t> table;
+  unsigned r = 0;  // first row without a pivot
+  for (unsigned c = 0; c < n_pivot_cols && r < rows_; c += max_block) {
+    const unsigned c_end = std::min(c + max_block, n_pivot_cols);
+    // Find pivots for columns [c, c_end), keeping the pivot rows reduced
+    // against each other. Rows scanned on the way are reduced against the
+    // pivots found so far, which only costs a row addition when one of those
+    // columns is set.
+    std::vector<unsigned> block;
+    for (unsigned col = c; col < c_end && r + block.size() < rows_; ++col) {
+      const unsigned p = r + block.size();
+      unsigned found = rows_;
+      for (unsigned i = p; i < rows_; ++i) {
+        for (unsigned j = 0; j < block.size(); ++j) {
+          if ((*this)(i, block[j])) row_xor(r + j, i);
+        }
+        if ((*this)(i, col)) {
+          found = i;
+          break;
+        }
+      }
+      if (found == rows_) continue;
+      swap_rows(found, p);
+      for (unsigned j = 0; j < block.size(); ++j) {
+        if ((*this)(r + j, col)) row_xor(p, r + j);
+      }
+      block.push_back(col);
+    }
+    const unsigned k = block.size();
+    if (k == 0) continue;
+
+    // Every row at or below r is zero before column c, so only the words from
+    // c onwards need adding.
+    const unsigned w0 = c / word_bits;
+    const unsigned n_words = row_words_ - w0;
+    const unsigned n_entries = 1u << k;
+    table.assign(std::size_t{n_entries} * n_words, 0);
+    for (unsigned m = 1; m < n_entries; ++m) {
+      // Entry m is the sum of the pivot rows j for the bits j set in m.
+      const word_t *prev = table.data() + std::size_t{m & (m - 1)} * n_words;
+      const word_t *pivot = row_data(r + std::countr_zero(m)) + w0;
+      word_t *entry = table.data() + std::size_t{m} * n_words;
+      for (unsigned w = 0; w < n_words; ++w) entry[w] = prev[w] ^ pivot[w];
+    }
+    for (unsigned i = full ? 0 : r + k; i < rows_; ++i) {
+      if (i == r) {
+        i += k - 1;
+        continue;
+      }
+      unsigned m = 0;
+      for (unsigned j = 0; j < k; ++j) {
+        if ((*this)(i, block[j])) m |= 1u << j;
+      }
+      if (m == 0) continue;
+      const word_t *entry = table.data() + std::size_t{m} * n_words;
+      word_t *row = row_data(i) + w0;
+      for (unsigned w = 0; w < n_words; ++w) row[w] ^= entry[w];
+    }
+    pivots.insert(pivots.end(), block.begin(), block.end());
+    r += k;
+  }
+  return pivots;
+}
+
+std::vector<unsigned> GF2Matrix::row_echelon_reduce(unsigned n_pivot_cols) {
+  return m4ri_reduce(n_pivot_cols, true);
+}
+
+unsigned GF2Matrix::rank() const {
+  GF2Matrix m(*this);
+  return m.m4ri_reduce(cols_, false).size();
+}
+
+std::optional<GF2Matrix> GF2Matrix::solve(const GF2Matrix &b) const {
+  if (b.rows_ != rows_) {
+    throw std::invalid_argument(
+        "Right-hand sides must have as many rows as the matrix");
+  }
+  GF2Matrix aug(rows_, cols_ + b.cols_);
+  for (unsigned r = 0; r < rows_; ++r) {
+    std::copy(row_data(r), row_data(r) + row_words_, aug.row_data(r));
+    for (unsigned c = 0; c < b.cols_; ++c) {
+      if (b(r, c)) aug(r, cols_ + c) = true;
+    }
+  }
+  const std::vector<unsigned> pivots = aug.row_echelon_reduce(cols_);
+  // The rows without pivots are zero on the left, so must be on the right.
+  for (unsigned r = pivots.size(); r < rows_; ++r) {
+    if (!aug.row_is_zero(r)) return std::nullopt;
+  }
+  GF2Matrix x(cols_, b.cols_);
+  for (unsigned r = 0; r < pivots.size(); ++r) {
+    for (unsigned c = 0; c < b.cols_; ++c) {
+      if (aug(r, cols_ + c)) x(pivots[r], c) = true;
+    }
+  }
+  return x;
+}
+
+}  // namespace tket
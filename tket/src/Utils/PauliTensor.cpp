@@ -14,13 +14,99 @@
 
 #include "tket/Utils/PauliTensor.hpp"
 
+#include <bit>
 #include <tkassert/Assert.hpp>
 
+#include "tket/Utils/ParallelFor.hpp"
+
 namespace tket {
 
 void to_json(nlohmann::json &, const no_coeff_t &) {}
 void from_json(const nlohmann::json &, no_coeff_t &) {}
 
+typedef SymplecticPauliMap::word_t word_t;
+
+static unsigned n_words(unsigned n_qubits) {
+  return (n_qubits + SymplecticPauliMap::word_bits - 1) /
+         SymplecticPauliMap::word_bits;
+}
+
+// Word w of a packed component, treating words beyond the end as zero
+static word_t word_at(const std::vector<word_t> &words, unsigned w) {
+  return (w < words.size()) ? words[w] : 0;
+}
+
+// Set of indices of the bits set in mask(w) for each word w < n
+template <typename MaskFn>
+static std::set<unsigned> indices_of_bits(unsigned n, MaskFn mask) {
+  std::set<unsigned> indices;
+  for (unsigned w = 0; w < n; ++w) {
+    word_t m = mask(w);
+    while (m != 0) {
+      indices.insert(w * SymplecticPauliMap::word_bits + std::countr_zero(m));
+      m &= m - 1;
+    }
+  }
+  return indices;
+}
+
+SymplecticPauliMap::SymplecticPauliMap(unsigned n_qubits)
+    : n_qubits_(n_qubits), x_(n_words(n_qubits), 0), z_(n_words(n_qubits), 0) {}
+
+SymplecticPauliMap::SymplecticPauliMap(const DensePauliMap &paulis)
+    : SymplecticPauliMap(paulis.size()) {
+  for (unsigned i = 0; i < paulis.size(); ++i) {
+    const Pauli p = paulis[i];
+    const word_t bit = word_t{1} << (i % word_bits);
+    if (p == Pauli::X || p == Pauli::Y) x_[i / word_bits] |= bit;
+    if (p == Pauli::Z || p == Pauli::Y) z_[i / word_bits] |= bit;
+  }
+}
+
+SymplecticPauliMap::SymplecticPauliMap(
+    unsigned n_qubits, std::vector<word_t> x, std::vector<word_t> z)
+    : n_qubits_(n_qubits), x_(std::move(x)), z_(std::move(z)) {
+  if (x_.size() != n_words(n_qubits) || z_.size() != n_words(n_qubits))
+    throw std::invalid_argument(
+        "Wrong number of words given to construct a SymplecticPauliMap");
+  if (n_qubits % word_bits != 0) {
+    const word_t mask = (word_t{1} << (n_qubits % word_bits)) - 1;
+    if ((x_.back() & ~mask) != 0 || (z_.back() & ~mask) != 0)
+      throw std::invalid_argument(
+          "SymplecticPauliMap words have bits set beyond the last qubit");
+  }
+}
+
+void SymplecticPauliMap::resize(unsigned n_qubits) {
+  n_qubits_ = n_qubits;
+  x_.resize(n_words(n_qubits), 0);
+  z_.resize(n_words(n_qubits), 0);
+  if (n_qubits % word_bits != 0) {
+    const word_t mask = (word_t{1} << (n_qubits % word_bits)) - 1;
+    x_.back() &= mask;
+    z_.back() &= mask;
+  }
+}
+
+void SymplecticPauliMap::set(unsigned qb, Pauli p) {
+  if (qb >= n_qubits_) {
+    if (p == Pauli::I) return;
+    resize(qb + 1);
+  }
+  const unsigned w = qb / word_bits;
+  const word_t bit = word_t{1} << (qb % word_bits);
+  x_[w] = (p == Pauli::X || p == Pauli::Y) ? (x_[w] | bit) : (x_[w] & ~bit);
+  z_[w] = (p == Pauli::Z || p == Pauli::Y) ? (z_[w] | bit) : (z_[w] & ~bit);
+}
+
+void to_json(nlohmann::json &j, const SymplecticPauliMap &paulis) {
+  j = cast_container<SymplecticPauliMap, DensePauliMap>(paulis);
+}
+
+void from_json(const nlohmann::json &j, SymplecticPauliMap &paulis) {
+  paulis = SymplecticPauliMap(j.get<DensePauliMap>());
+}
+
 template <>
 no_coeff_t default_coeff<no_coeff_t>() {
   return {};
@@ -82,6 +168,46 @@ DensePauliMap cast_container<DensePauliMap, DensePauliMap>(
   return cont;
 }
 
+template <>
+SymplecticPauliMap cast_container<SymplecticPauliMap, SymplecticPauliMap>(
+    const SymplecticPauliMap &cont) {
+  return cont;
+}
+
+template <>
+SymplecticPauliMap cast_container<DensePauliMap, SymplecticPauliMap>(
+    const DensePauliMap &cont) {
+  return SymplecticPauliMap(cont);
+}
+
+template <>
+DensePauliMap cast_container<SymplecticPauliMap, DensePauliMap>(
+    const SymplecticPauliMap &cont) {
+  DensePauliMap res(cont.size());
+  for (unsigned i = 0; i < cont.size(); ++i) res[i] = cont.get(i);
+  return res;
+}
+
+template <>
+SymplecticPauliMap cast_container<QubitPauliMap, SymplecticPauliMap>(
+    const QubitPauliMap &cont) {
+  return SymplecticPauliMap(
+      cast_container<QubitPauliMap, DensePauliMap>(cont));
+}
+
+template <>
+QubitPauliMap cast_container<SymplecticPauliMap, QubitPauliMap>(
+    const SymplecticPauliMap &cont) {
+  const std::vector<word_t> &x = cont.x_words();
+  const std::vector<word_t> &z = cont.z_words();
+  QubitPauliMap res;
+  for (unsigned i : indices_of_bits(
+           x.size(), [&](unsigned w) { return x[w] | z[w]; })) {
+    res.insert({Qubit(i), cont.get(i)});
+  }
+  return res;
+}
+
 template <>
 no_coeff_t cast_coeff<no_coeff_t, no_coeff_t>(const no_coeff_t &) {
   return {};
@@ -252,6 +378,26 @@ int compare_containers<DensePauliMap>(
   return (p2_it == second.end()) ? 0 : -1;
 }
 
+template <>
+int compare_containers<SymplecticPauliMap>(
+    const SymplecticPauliMap &first, const SymplecticPauliMap &second) {
+  const std::vector<word_t> &x1 = first.x_words(), &z1 = first.z_words();
+  const std::vector<word_t> &x2 = second.x_words(), &z2 = second.z_words();
+  const unsigned n = std::max(x1.size(), x2.size());
+  for (unsigned w = 0; w < n; ++w) {
+    const word_t diff = (word_at(x1, w) ^ word_at(x2, w)) |
+                        (word_at(z1, w) ^ word_at(z2, w));
+    if (diff != 0) {
+      // The first qubit on which they differ decides; I < X < Y < Z matches
+      // the order of the enum
+      const unsigned qb =
+          w * SymplecticPauliMap::word_bits + std::countr_zero(diff);
+      return (first.get(qb) < second.get(qb)) ? -1 : 1;
+    }
+  }
+  return 0;
+}
+
 template <>
 int compare_coeffs<no_coeff_t>(const no_coeff_t &, const no_coeff_t &) {
   return 0;
@@ -304,6 +450,15 @@ std::set<unsigned> common_indices(
   return common;
 }
 
+std::set<unsigned> common_indices(
+    const SymplecticPauliMap &first, const SymplecticPauliMap &second) {
+  const std::vector<word_t> &x1 = first.x_words(), &z1 = first.z_words();
+  const std::vector<word_t> &x2 = second.x_words(), &z2 = second.z_words();
+  return indices_of_bits(std::min(x1.size(), x2.size()), [&](unsigned w) {
+    return (x1[w] | z1[w]) & ~(x1[w] ^ x2[w]) & ~(z1[w] ^ z2[w]);
+  });
+}
+
 std::set<Qubit> own_qubits(
     const QubitPauliMap &first, const QubitPauliMap &second) {
   std::set<Qubit> own;
@@ -328,6 +483,15 @@ std::set<unsigned> own_indices(
   return own;
 }
 
+std::set<unsigned> own_indices(
+    const SymplecticPauliMap &first, const SymplecticPauliMap &second) {
+  const std::vector<word_t> &x1 = first.x_words(), &z1 = first.z_words();
+  const std::vector<word_t> &x2 = second.x_words(), &z2 = second.z_words();
+  return indices_of_bits(x1.size(), [&](unsigned w) {
+    return (x1[w] | z1[w]) & ~(word_at(x2, w) | word_at(z2, w));
+  });
+}
+
 std::set<Qubit> conflicting_qubits(
     const QubitPauliMap &first, const QubitPauliMap &second) {
   std::set<Qubit> conflicts;
@@ -353,6 +517,16 @@ std::set<unsigned> conflicting_indices(
   return conflicts;
 }
 
+std::set<unsigned> conflicting_indices(
+    const SymplecticPauliMap &first, const SymplecticPauliMap &second) {
+  const std::vector<word_t> &x1 = first.x_words(), &z1 = first.z_words();
+  const std::vector<word_t> &x2 = second.x_words(), &z2 = second.z_words();
+  return indices_of_bits(std::min(x1.size(), x2.size()), [&](unsigned w) {
+    // Distinct non-trivial Paulis are exactly those that anticommute
+    return (x1[w] & z2[w]) ^ (z1[w] & x2[w]);
+  });
+}
+
 template <>
 bool commuting_containers<QubitPauliMap>(
     const QubitPauliMap &first, const QubitPauliMap &second) {
@@ -365,6 +539,19 @@ bool commuting_containers<DensePauliMap>(
   return (conflicting_indices(first, second).size() % 2) == 0;
 }
 
+template <>
+bool commuting_containers<SymplecticPauliMap>(
+    const SymplecticPauliMap &first, const SymplecticPauliMap &second) {
+  const std::vector<word_t> &x1 = first.x_words(), &z1 = first.z_words();
+  const std::vector<word_t> &x2 = second.x_words(), &z2 = second.z_words();
+  const unsigned n = std::min(x1.size(), x2.size());
+  unsigned anticommuting = 0;
+  for (unsigned w = 0; w < n; ++w) {
+    anticommuting += std::popcount((x1[w] & z2[w]) ^ (z1[w] & x2[w]));
+  }
+  return (anticommuting % 2) == 0;
+}
+
 template <>
 void print_paulis<QubitPauliMap>(
     std::ostream &os, const QubitPauliMap &paulis) {
@@ -421,6 +608,13 @@ void print_paulis<DensePauliMap>(
   }
 }
 
+template <>
+void print_paulis<SymplecticPauliMap>(
+    std::ostream &os, const SymplecticPauliMap &paulis) {
+  print_paulis<DensePauliMap>(
+      os, cast_container<SymplecticPauliMap, DensePauliMap>(paulis));
+}
+
 template <>
 void print_coeff<no_coeff_t>(std::ostream &, const no_coeff_t &) {}
 
@@ -489,6 +683,19 @@ void hash_combine_paulis<DensePauliMap>(
   }
 }
 
+template <>
+void hash_combine_paulis<SymplecticPauliMap>(
+    std::size_t &seed, const SymplecticPauliMap &paulis) {
+  const std::vector<word_t> &x = paulis.x_words(), &z = paulis.z_words();
+  // Ignore trailing identities, as for DensePauliMap
+  unsigned n = x.size();
+  while (n > 0 && x[n - 1] == 0 && z[n - 1] == 0) --n;
+  for (unsigned w = 0; w < n; ++w) {
+    boost::hash_combine(seed, x[w]);
+    boost::hash_combine(seed, z[w]);
+  }
+}
+
 template <>
 void hash_combine_coeff<no_coeff_t>(std::size_t &, const no_coeff_t &) {}
 
@@ -526,6 +733,14 @@ unsigned n_ys<DensePauliMap>(const DensePauliMap &paulis) {
   return n;
 }
 
+template <>
+unsigned n_ys<SymplecticPauliMap>(const SymplecticPauliMap &paulis) {
+  const std::vector<word_t> &x = paulis.x_words(), &z = paulis.z_words();
+  unsigned n = 0;
+  for (unsigned w = 0; w < x.size(); ++w) n += std::popcount(x[w] & z[w]);
+  return n;
+}
+
 const std::map<std::pair<Pauli, Pauli>, std::pair<quarter_turns_t, Pauli>> &
 get_mult_matrix() {
   static const std::map<
@@ -610,6 +825,33 @@ std::pair<quarter_turns_t, DensePauliMap> multiply_strings<DensePauliMap>(
   return {total_turns, result};
 }
 
+template <>
+std::pair<quarter_turns_t, SymplecticPauliMap>
+multiply_strings<SymplecticPauliMap>(
+    const SymplecticPauliMap &first, const SymplecticPauliMap &second) {
+  const std::vector<word_t> &x1 = first.x_words(), &z1 = first.z_words();
+  const std::vector<word_t> &x2 = second.x_words(), &z2 = second.z_words();
+  const unsigned n_qubits = std::max(first.size(), second.size());
+  const unsigned n = n_words(n_qubits);
+  std::vector<word_t> x(n), z(n);
+  quarter_turns_t total_turns = 0;
+  for (unsigned w = 0; w < n; ++w) {
+    const word_t xa = word_at(x1, w), za = word_at(z1, w);
+    const word_t xb = word_at(x2, w), zb = word_at(z2, w);
+    x[w] = xa ^ xb;
+    z[w] = za ^ zb;
+    // XY = iZ, YZ = iX, ZX = iY, and the reverse orders give -i
+    const word_t a_x = xa & ~za, a_y = xa & za, a_z = ~xa & za;
+    const word_t b_x = xb & ~zb, b_y = xb & zb, b_z = ~xb & zb;
+    const word_t plus = (a_x & b_y) | (a_y & b_z) | (a_z & b_x);
+    const word_t minus = (a_y & b_x) | (a_z & b_y) | (a_x & b_z);
+    total_turns += std::popcount(plus) + 3 * std::popcount(minus);
+  }
+  return {
+      total_turns % 4,
+      SymplecticPauliMap(n_qubits, std::move(x), std::move(z))};
+}
+
 template <>
 no_coeff_t multiply_coeffs<no_coeff_t>(const no_coeff_t &, const no_coeff_t &) {
   return {};
@@ -685,6 +927,13 @@ CmplxSpMat to_sparse_matrix<DensePauliMap>(const DensePauliMap &paulis) {
   return result;
 }
 
+template <>
+CmplxSpMat to_sparse_matrix<SymplecticPauliMap>(
+    const SymplecticPauliMap &paulis) {
+  return to_sparse_matrix<DensePauliMap>(
+      cast_container<SymplecticPauliMap, DensePauliMap>(paulis));
+}
+
 template <>
 CmplxSpMat to_sparse_matrix<QubitPauliMap>(
     const QubitPauliMap &paulis, unsigned n_qubits) {
@@ -703,6 +952,12 @@ CmplxSpMat to_sparse_matrix<DensePauliMap>(
     matrix_paulis.push_back(Pauli::I);
   return to_sparse_matrix<DensePauliMap>(matrix_paulis);
 }
+template <>
+CmplxSpMat to_sparse_matrix<SymplecticPauliMap>(
+    const SymplecticPauliMap &paulis, unsigned n_qubits) {
+  return to_sparse_matrix<DensePauliMap>(
+      cast_container<SymplecticPauliMap, DensePauliMap>(paulis), n_qubits);
+}
 
 template <>
 CmplxSpMat to_sparse_matrix<QubitPauliMap>(
@@ -730,5 +985,76 @@ CmplxSpMat to_sparse_matrix<DensePauliMap>(
   return to_sparse_matrix<QubitPauliMap>(
       cast_container<DensePauliMap, QubitPauliMap>(paulis), qubits);
 }
+template <>
+CmplxSpMat to_sparse_matrix<SymplecticPauliMap>(
+    const SymplecticPauliMap &paulis, const qubit_vector_t &qubits) {
+  return to_sparse_matrix<QubitPauliMap>(
+      cast_container<SymplecticPauliMap, QubitPauliMap>(paulis), qubits);
+}
+
+Complex pauli_state_expectation(
+    const QubitPauliMap &paulis, const Eigen::VectorXcd &state,
+    const qubit_vector_t &qubits, unsigned n_threads) {
+  const unsigned n_qubits = qubits.size();
+  if (n_qubits >= 64 || state.size() != Eigen::Index{1} << n_qubits)
+    throw std::logic_error(
+        "Size of statevector does not match number of qubits passed to "
+        "state_expectation");
+  std::map<Qubit, unsigned> index_map;
+  for (const Qubit &q : qubits)
+    index_map.insert({q, (unsigned)index_map.size()});
+  if (index_map.size() != qubits.size())
+    throw std::logic_error(
+        "Qubit list given to state_expectation contains repeats.");
+  // P|i> = i^n_ys (-1)^|i & z_mask| |i ^ x_mask>
+  std::uint64_t x_mask = 0;
+  std::uint64_t z_mask = 0;
+  unsigned n_ys = 0;
+  for (const std::pair<const Qubit, Pauli> &pair : paulis) {
+    std::map<Qubit, unsigned>::iterator found = index_map.find(pair.first);
+    if (found == index_map.end())
+      throw std::logic_error(
+          "Qubit list given to state_expectation doesn't contain " +
+          pair.first.repr());
+    const std::uint64_t bit = std::uint64_t{1}
+                              << (n_qubits - 1 - found->second);
+    switch (pair.second) {
+      case Pauli::X:
+        x_mask |= bit;
+        break;
+      case Pauli::Y:
+        x_mask |= bit;
+        z_mask |= bit;
+        ++n_ys;
+        break;
+      case Pauli::Z:
+        z_mask |= bit;
+        break;
+      default:
+        break;
+    }
+  }
+  // Sum over fixed chunks of the state and add up the partial sums in order,
+  // so that the rounding is the same for any number of threads.
+  const std::uint64_t size = state.size();
+  const std::uint64_t chunk_size = 1 << 12;
+  std::vector<Complex> partial_sums((size + chunk_size - 1) / chunk_size);
+  parallel_for(partial_sums.size(), n_threads, [&](std::size_t c) {
+    double re = 0., im = 0.;
+    const std::uint64_t end = std::min(size, (c + 1) * chunk_size);
+    for (std::uint64_t i = c * chunk_size; i < end; ++i) {
+      // conj(state[i ^ x_mask]) * state[i]
+      const Complex &a = state[i ^ x_mask];
+      const Complex &b = state[i];
+      const double sign = (std::popcount(i & z_mask) & 1) ? -1. : 1.;
+      re += sign * (a.real() * b.real() + a.imag() * b.imag());
+      im += sign * (a.real() * b.imag() - a.imag() * b.real());
+    }
+    partial_sums[c] = {re, im};
+  });
+  Complex total = 0.;
+  for (const Complex &z : partial_sums) total += z;
+  return cast_coeff<quarter_turns_t, Complex>(n_ys % 4) * total;
+}
 
 }  // namespace tket
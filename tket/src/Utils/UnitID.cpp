@@ -14,17 +14,101 @@
 
 #include "tket/Utils/UnitID.hpp"
 
+#include <algorithm>
+#include <mutex>
+#include <regex>
+#include <shared_mutex>
 #include <sstream>
+#include <unordered_map>
 
 namespace tket {
 
+namespace {
+
+void check_name(std::string_view name) {
+  static const std::string id_regex_str = "[a-z][A-Za-z0-9_]*";
+  static const std::regex id_regex(id_regex_str);
+  if (!name.empty() &&
+      !std::regex_match(name.begin(), name.end(), id_regex)) {
+    std::stringstream msg;
+    msg << "UnitID name '" << name << "' does not match '" << id_regex_str
+        << "', as required for QASM conversion.";
+    tket_log()->warn(msg.str());
+  }
+}
+
+struct IndexHash {
+  std::size_t operator()(std::span<const unsigned> index) const {
+    return boost::hash_range(index.begin(), index.end());
+  }
+};
+
+struct IndexEqual {
+  bool operator()(
+      std::span<const unsigned> a, std::span<const unsigned> b) const {
+    return std::equal(a.begin(), a.end(), b.begin(), b.end());
+  }
+};
+
+}  // namespace
+
+/* The interning tables are keyed by views of the interned data itself. Like
+ * the register names below, the tables and their entries are never destroyed,
+ * so that units remain valid throughout static deinitialization.
+ */
+
+const UnitID::InternedName* UnitID::intern_name(std::string_view name) {
+  // Units are usually constructed many at a time from the same register.
+  thread_local const InternedName* last = nullptr;
+  if (last != nullptr && last->str_ == name) return last;
+
+  static std::shared_mutex* mutex = new std::shared_mutex();
+  static std::unordered_map<std::string_view, const InternedName*>* names =
+      new std::unordered_map<std::string_view, const InternedName*>();
+  {
+    std::shared_lock<std::shared_mutex> lock(*mutex);
+    auto found = names->find(name);
+    if (found != names->end()) return last = found->second;
+  }
+  std::unique_lock<std::shared_mutex> lock(*mutex);
+  auto found = names->find(name);
+  if (found != names->end()) return last = found->second;
+  check_name(name);
+  InternedName* interned = new InternedName{std::string(name), 0};
+  interned->hash_ = boost::hash<std::string>()(interned->str_);
+  names->emplace(interned->str_, interned);
+  return last = interned;
+}
+
+const UnitID::InternedIndex* UnitID::intern_index(
+    std::span<const unsigned> index) {
+  typedef std::unordered_map<
+      std::span<const unsigned>, const InternedIndex*, IndexHash, IndexEqual>
+      index_table_t;
+  static std::shared_mutex* mutex = new std::shared_mutex();
+  static index_table_t* indices = new index_table_t();
+  {
+    std::shared_lock<std::shared_mutex> lock(*mutex);
+    auto found = indices->find(index);
+    if (found != indices->end()) return found->second;
+  }
+  std::unique_lock<std::shared_mutex> lock(*mutex);
+  auto found = indices->find(index);
+  if (found != indices->end()) return found->second;
+  InternedIndex* interned = new InternedIndex{
+      std::vector<unsigned>(index.begin(), index.end()), IndexHash()(index)};
+  indices->emplace(interned->value_, interned);
+  return interned;
+}
+
 std::string UnitID::repr() const {
   std::stringstream str;
-  str << data_->name_;
-  if (!data_->index_.empty()) {
-    str << "[" << std::to_string(data_->index_[0]);
-    for (unsigned i = 1; i < data_->index_.size(); i++) {
-      str << ", " << std::to_string(data_->index_[i]);
+  str << name_->str_;
+  const std::vector<unsigned>& index = index_->value_;
+  if (!index.empty()) {
+    str << "[" << std::to_string(index[0]);
+    for (unsigned i = 1; i < index.size(); i++) {
+      str << ", " << std::to_string(index[i]);
     }
     str << "]";
   }
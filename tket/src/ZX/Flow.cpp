@@ -14,8 +14,8 @@
 
 #include "tket/ZX/Flow.hpp"
 
+#include "tket/Utils/GF2Matrix.hpp"
 #include "tket/Utils/GraphHeaders.hpp"
-#include "tket/Utils/MatrixAnalysis.hpp"
 
 namespace tket {
 
@@ -291,7 +291,7 @@ std::map<ZXVert, ZXVertSeqSet> Flow::gauss_solve_correctors(
   unsigned n_preserve = preserve.size();
   unsigned n_to_solve = to_solve.size();
   unsigned n_ys = ys.size();
-  MatrixXb mat = MatrixXb::Zero(n_preserve + n_ys, n_correctors + n_to_solve);
+  GF2Matrix mat(n_preserve + n_ys, n_correctors + n_to_solve);
   // Build adjacency matrix
   for (boost::bimap<ZXVert, unsigned>::const_iterator it = correctors.begin(),
                                                       end = correctors.end();
@@ -353,15 +353,8 @@ std::map<ZXVert, ZXVertSeqSet> Flow::gauss_solve_correctors(
     }
   }
 
-  // Gaussian elimination
-  std::vector<std::pair<unsigned, unsigned>> row_ops =
-      gaussian_elimination_row_ops(
-          mat.block(0, 0, n_preserve + n_ys, n_correctors));
-  for (const std::pair<unsigned, unsigned>& op : row_ops) {
-    for (unsigned j = 0; j < n_correctors + n_to_solve; ++j) {
-      mat(op.second, j) ^= mat(op.first, j);
-    }
-  }
+  // Gaussian elimination, pivoting only on the corrector columns
+  mat.row_echelon_reduce(n_correctors);
 
   // Back substitution
   // For each row i, pick a corrector j for which mat(i,j) == true, else
@@ -574,7 +567,7 @@ std::set<ZXVertSeqSet> Flow::identify_focussed_sets(const ZXDiagram& diag) {
     }
   }
 
-  MatrixXb mat = MatrixXb::Zero(n_preserve + n_ys, n_correctors);
+  GF2Matrix mat(n_preserve + n_ys, n_correctors);
 
   // Build adjacency matrix
   for (boost::bimap<ZXVert, unsigned>::const_iterator it = correctors.begin(),
@@ -601,13 +594,7 @@ std::set<ZXVertSeqSet> Flow::identify_focussed_sets(const ZXDiagram& diag) {
   }
 
   // Gaussian elimination
-  std::vector<std::pair<unsigned, unsigned>> row_ops =
-      gaussian_elimination_row_ops(mat);
-  for (const std::pair<unsigned, unsigned>& op : row_ops) {
-    for (unsigned j = 0; j < n_correctors; ++j) {
-      mat(op.second, j) ^= mat(op.first, j);
-    }
-  }
+  mat.row_echelon_reduce();
 
   // Back substitution
   // For each column j, it either a leading column (the first column for which
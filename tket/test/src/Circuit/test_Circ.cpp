@@ -1808,6 +1808,48 @@ SCENARIO("Test Command Iterator") {
   }
 }
 
+SCENARIO("Test command views") {
+  GIVEN("An empty circuit") {
+    Circuit circ(2, 1);
+    Circuit::CommandViewRange views = circ.command_views();
+    REQUIRE(views.begin() == views.end());
+  }
+  GIVEN("A circuit with classical control and an op group") {
+    Circuit circ(3, 2);
+    circ.add_op<unsigned>(OpType::H, {0});
+    circ.add_op<unsigned>(OpType::CX, {0, 1}, "group");
+    circ.add_measure(0, 0);
+    circ.add_conditional_gate<unsigned>(OpType::X, {}, {2}, {0}, 1);
+    circ.add_conditional_gate<unsigned>(OpType::Z, {}, {1}, {0}, 0);
+    // Reads the bit it writes
+    circ.add_conditional_gate<unsigned>(OpType::Measure, {}, {1, 0}, {0}, 1);
+    circ.add_op<unsigned>(OpType::Phase, 0.25, {});
+    circ.add_op<unsigned>(OpType::CCX, {2, 1, 0});
+    circ.add_measure(2, 1);
+    register_t qreg = circ.add_q_register("a", 2);
+    circ.add_op<UnitID>(OpType::CZ, {qreg[1], Qubit(2)});
+    WHEN("Iterating over the views") {
+      const std::vector<Command> commands = circ.get_commands();
+      std::vector<Command> copies;
+      nlohmann::json j_views = nlohmann::json::array();
+      for (const CommandView &view : circ.command_views()) {
+        const Command com = view.to_command();
+        copies.push_back(com);
+        CHECK(com.get_vertex() == view.get_vertex());
+        j_views.push_back(view);
+      }
+      THEN("They match the commands") {
+        REQUIRE(copies.size() == commands.size());
+        for (unsigned i = 0; i < commands.size(); ++i) {
+          CHECK(copies[i] == commands[i]);
+          CHECK(copies[i].get_vertex() == commands[i].get_vertex());
+        }
+        CHECK(j_views == nlohmann::json(commands));
+      }
+    }
+  }
+}
+
 SCENARIO("Test substitute_all") {
   Circuit circ(3, 1);
   circ.add_op<unsigned>(OpType::Rx, 0.6, {0});
@@ -3638,5 +3680,40 @@ SCENARIO("Filter conditional commands") {
   }
 }
 
+SCENARIO("Structural hash") {
+  GIVEN("Commuting gates added in different orders") {
+    Circuit c0(3);
+    c0.add_op<unsigned>(OpType::H, {0});
+    c0.add_op<unsigned>(OpType::Rz, 0.25, {2});
+    c0.add_op<unsigned>(OpType::CX, {0, 1});
+    Circuit c1(3);
+    c1.add_op<unsigned>(OpType::Rz, 0.25, {2});
+    c1.add_op<unsigned>(OpType::H, {0});
+    c1.add_op<unsigned>(OpType::CX, {0, 1});
+    REQUIRE(c0.structural_hash() == c1.structural_hash());
+    REQUIRE(c0.structural_hash() == Circuit(c0).structural_hash());
+  }
+  GIVEN("Circuits that differ") {
+    Circuit c0(2);
+    c0.add_op<unsigned>(OpType::Rz, 0.25, {0});
+    c0.add_op<unsigned>(OpType::CX, {0, 1});
+    const std::size_t h = c0.structural_hash();
+    Circuit c1(2);
+    c1.add_op<unsigned>(OpType::Rz, 0.5, {0});
+    c1.add_op<unsigned>(OpType::CX, {0, 1});
+    REQUIRE(c1.structural_hash() != h);
+    Circuit c2(2);
+    c2.add_op<unsigned>(OpType::Rz, 0.25, {0});
+    c2.add_op<unsigned>(OpType::CX, {1, 0});
+    REQUIRE(c2.structural_hash() != h);
+    Circuit c3(c0);
+    c3.add_phase(0.5);
+    REQUIRE(c3.structural_hash() != h);
+    Circuit c4(c0);
+    c4.rename_units<Qubit, Qubit>({{Qubit(1), Qubit("a", 0)}});
+    REQUIRE(c4.structural_hash() != h);
+  }
+}
+
 }  // namespace test_Circ
 }  // namespace tket
@@ -0,0 +1,74 @@
+// Copyright Quantinuum
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "tket/Circuit/Circuit.hpp"
+#include "tket/Circuit/DAGReachability.hpp"
+
+namespace tket {
+namespace test_DAGReachability {
+
+SCENARIO("Reachability queries on a circuit") {
+  GIVEN("A circuit with quantum and classical dependencies") {
+    Circuit circ(3, 1);
+    const Vertex h0 = circ.add_op<unsigned>(OpType::H, {0});
+    const Vertex cx01 = circ.add_op<unsigned>(OpType::CX, {0, 1});
+    const Vertex x2 = circ.add_op<unsigned>(OpType::X, {2});
+    const Vertex m1 = circ.add_measure(1, 0);
+    const Vertex cz2 =
+        circ.add_conditional_gate<unsigned>(OpType::Z, {}, {2}, {0}, 1);
+    const Vertex y0 = circ.add_op<unsigned>(OpType::Y, {0});
+    DAGReachability reach(circ);
+    THEN("Paths are found along every kind of edge") {
+      CHECK(reach.reaches(h0, h0));
+      CHECK(reach.reaches(h0, cx01));
+      CHECK(reach.reaches(h0, y0));
+      CHECK(reach.reaches(h0, cz2));
+      CHECK(reach.reaches(x2, cz2));
+      CHECK(reach.reaches_any(cx01, {x2, m1}));
+      CHECK(reach.reached_from_any({x2, y0}, cz2));
+    }
+    THEN("Unrelated or reversed pairs are not reachable") {
+      CHECK(!reach.reaches(cx01, h0));
+      CHECK(!reach.reaches(x2, y0));
+      CHECK(!reach.reaches(y0, cz2));
+      CHECK(!reach.reaches(cz2, m1));
+      CHECK(!reach.reaches_any(x2, {h0, cx01, m1, y0}));
+      CHECK(!reach.reached_from_any({y0, x2}, m1));
+    }
+    WHEN("Vertices are added without telling the index") {
+      const Vertex cx20 = circ.add_op<unsigned>(OpType::CX, {2, 0});
+      THEN("The index is rebuilt on demand") {
+        CHECK(reach.reaches(x2, cx20));
+        CHECK(reach.reaches(m1, cx20));
+        CHECK(!reach.reaches(cx20, cz2));
+      }
+    }
+    WHEN("A gate is inserted and reported") {
+      const Edge e = circ.get_nth_out_edge(h0, 0);
+      const Vertex s = circ.add_vertex(OpType::S);
+      circ.rewire(s, {e}, {EdgeType::Quantum});
+      reach.insert_vertices({s});
+      THEN("Queries see the new gate") {
+        CHECK(reach.reaches(h0, s));
+        CHECK(reach.reaches(s, m1));
+        CHECK(!reach.reaches(x2, s));
+      }
+    }
+  }
+}
+
+}  // namespace test_DAGReachability
+}  // namespace tket
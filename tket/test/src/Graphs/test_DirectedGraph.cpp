@@ -115,6 +115,44 @@ SCENARIO("Disconnected graphs") {
   }
 }
 
+SCENARIO("Cached distances and paths") {
+  using Conn = DirectedGraph<Node>::Connection;
+  GIVEN("a line graph") {
+    std::vector<Conn> edges{
+        {Node(0), Node(1)}, {Node(2), Node(1)}, {Node(2), Node(3)}};
+    DirectedGraph<Node> uidgraph(edges);
+    CHECK(uidgraph.get_distance(Node(0), Node(3)) == 3);
+    CHECK(uidgraph.get_distance(Node(3), Node(0)) == 3);
+    const std::vector<std::size_t>& dists = uidgraph.get_distances(Node(1));
+    CHECK(dists == std::vector<std::size_t>{1, 0, 1, 2});
+    std::vector<Node> path{Node(3), Node(2), Node(1), Node(0)};
+    CHECK(uidgraph.get_path(Node(0), Node(3)) == path);
+    CHECK(uidgraph.get_path(Node(2), Node(2)) == std::vector<Node>{Node(2)});
+    CHECK_THROWS_AS(
+        uidgraph.get_distance(Node(0), Node(4)), NodeDoesNotExistError);
+    CHECK_THROWS_AS(
+        uidgraph.get_distance(Node(4), Node(0)), NodeDoesNotExistError);
+    WHEN("an edge is added") {
+      uidgraph.add_connection(Node(3), Node(0));
+      THEN("the cached distances are updated") {
+        CHECK(uidgraph.get_distance(Node(0), Node(3)) == 1);
+        CHECK(uidgraph.get_distance(Node(1), Node(3)) == 2);
+        path = {Node(3), Node(0)};
+        CHECK(uidgraph.get_path(Node(0), Node(3)) == path);
+      }
+    }
+    WHEN("a node is removed") {
+      uidgraph.remove_node(Node(2));
+      THEN("the remaining nodes are disconnected") {
+        CHECK(uidgraph.get_distance(Node(0), Node(1)) == 1);
+        CHECK_THROWS_AS(
+            uidgraph.get_distance(Node(0), Node(3)), NodesNotConnected<Node>);
+        CHECK(uidgraph.get_path(Node(0), Node(3)).empty());
+      }
+    }
+  }
+}
+
 }  // namespace test_DirectedGraph
 }  // namespace tests
 }  // namespace graphs
@@ -828,5 +828,38 @@ SCENARIO("Clifford checks") {
   }
 }
 
+SCENARIO("Numeric gate parameters") {
+  GIVEN("Gates with plain numbers as parameters") {
+    const Expr half = SymEngine::div(Expr(1), Expr(2));
+    const Op_ptr op0 = get_op_ptr(OpType::TK1, {0.5, half, Expr(3)});
+    const auto& params = as_gate_ptr(op0)->get_numeric_params();
+    REQUIRE(params);
+    REQUIRE(params->size() == 3);
+    CHECK((*params)[0] == 0.5);
+    CHECK((*params)[1] == 0.5);
+    CHECK((*params)[2] == 3.);
+    THEN("Equality is checked modulo the parameter period") {
+      const Op_ptr op1 = get_op_ptr(OpType::Rz, 0.25);
+      const Op_ptr op2 = get_op_ptr(OpType::Rz, 4.25);
+      const Op_ptr op3 = get_op_ptr(OpType::Rz, 2.25);
+      CHECK(*op1 == *op2);
+      CHECK(!(*op1 == *op3));
+      CHECK(op3->is_identity() == std::nullopt);
+      CHECK(get_op_ptr(OpType::Rz, 2.)->is_identity() == 1.);
+    }
+  }
+  GIVEN("Gates with symbolic parameters") {
+    const Sym a = SymEngine::symbol("a");
+    const Expr ea(a);
+    const Op_ptr op0 = get_op_ptr(OpType::Rz, ea);
+    const Op_ptr op1 = get_op_ptr(OpType::Rz, Expr(SymEngine::pi));
+    CHECK(!as_gate_ptr(op0)->get_numeric_params());
+    CHECK(!as_gate_ptr(op1)->get_numeric_params());
+    CHECK(!op0->is_clifford());
+    CHECK(*op0 == *get_op_ptr(OpType::Rz, ea));
+    CHECK(!(*op0 == *get_op_ptr(OpType::Rz, 0.5)));
+  }
+}
+
 }  // namespace test_Ops
 }  // namespace tket
@@ -578,6 +578,90 @@ SCENARIO("Handling internal qubit permutations") {
   }
 }
 
+SCENARIO("Simulating with several threads") {
+  GIVEN("A GHZ circuit followed by diagonal gates") {
+    const unsigned n_qubits = 14;
+    Circuit circ(n_qubits);
+    circ.add_op<unsigned>(OpType::H, {0});
+    for (unsigned qq = 1; qq < n_qubits; ++qq) {
+      circ.add_op<unsigned>(OpType::CX, {qq - 1, qq});
+    }
+    for (unsigned qq = 0; qq < n_qubits; ++qq) {
+      circ.add_op<unsigned>(OpType::T, {qq});
+    }
+    circ.add_op<unsigned>(OpType::CZ, {3, 9});
+    circ.add_phase(0.5);
+    const auto sv = tket_sim::get_statevector(circ, EPS, n_qubits, 4);
+    const auto last = sv.rows() - 1;
+    const Complex i_unit(0, 1);
+    CHECK(std::abs(sv(0) - i_unit / std::sqrt(2.0)) < ERR_EPS);
+    // T^14 gives a phase of 14 pi/4, and CZ a further -1.
+    const Complex expected_last =
+        -i_unit * std::polar(1.0, 3.5 * PI) / std::sqrt(2.0);
+    CHECK(std::abs(sv(last) - expected_last) < ERR_EPS);
+    CHECK(sv.norm() == Approx(1.0));
+    CHECK(std::abs(sv(1)) < ERR_EPS);
+    CHECK(std::abs(sv(last - 1)) < ERR_EPS);
+  }
+  GIVEN("A circuit mixing diagonal and non-diagonal gates") {
+    Circuit circ(6);
+    circ.add_op<unsigned>(OpType::H, {2});
+    circ.add_op<unsigned>(OpType::Rz, 0.3, {2});
+    circ.add_op<unsigned>(OpType::CRz, 0.7, {4, 1});
+    circ.add_op<unsigned>(OpType::CX, {5, 0});
+    circ.add_op<unsigned>(OpType::Rx, 0.2, {0});
+    circ.add_op<unsigned>(OpType::CCX, {1, 5, 3});
+    circ.add_op<unsigned>(OpType::ZZPhase, 0.4, {0, 3});
+    circ.add_op<unsigned>(OpType::CSWAP, {2, 4, 0});
+    circ.add_op<unsigned>(OpType::U3, {0.1, 0.2, 0.3}, {5});
+    circ.add_op<unsigned>(OpType::Sdg, {1});
+    circ.add_phase(0.25);
+    const auto u1 = tket_sim::get_unitary(circ);
+    const auto u4 = tket_sim::get_unitary(circ, EPS, 11, 4);
+    THEN("The result does not depend on the number of threads") {
+      CHECK(u1.isApprox(u4, ERR_EPS));
+      CHECK(is_unitary(u1));
+    }
+    THEN("The result is the product of the gate unitaries") {
+      Eigen::MatrixXcd expected = Eigen::MatrixXcd::Identity(64, 64);
+      for (const Command& cmd : circ) {
+        Circuit single(6);
+        single.add_op<Qubit>(cmd.get_op_ptr(), cmd.get_qubits());
+        expected = tket_sim::get_unitary(single) * expected;
+      }
+      expected *= std::polar(1.0, 0.25 * PI);
+      CHECK(u1.isApprox(expected, ERR_EPS));
+    }
+  }
+}
+
+SCENARIO("Deep circuits with gates fused into blocks") {
+  // Layers of single-qubit rotations and overlapping two- and three-qubit
+  // gates, so that many different blocks are formed and merged.
+  Circuit circ(7);
+  for (unsigned layer = 0; layer < 6; ++layer) {
+    for (unsigned qq = 0; qq < 7; ++qq) {
+      circ.add_op<unsigned>(OpType::Rx, 0.1 * (qq + layer), {qq});
+      circ.add_op<unsigned>(OpType::Rz, 0.3 * qq + 0.2, {qq});
+    }
+    for (unsigned qq = layer % 2; qq + 1 < 7; qq += 2) {
+      circ.add_op<unsigned>(OpType::CX, {qq, qq + 1});
+    }
+    circ.add_op<unsigned>(OpType::CCX, {layer % 7, (layer + 3) % 7, 6});
+    circ.add_op<unsigned>(OpType::XXPhase, 0.15 * layer, {1, 5});
+    circ.add_op<unsigned>(OpType::CZ, {0, 4});
+  }
+  Eigen::MatrixXcd expected = Eigen::MatrixXcd::Identity(128, 128);
+  for (const Command& cmd : circ) {
+    Circuit single(7);
+    single.add_op<Qubit>(cmd.get_op_ptr(), cmd.get_qubits());
+    expected = tket_sim::get_unitary(single) * expected;
+  }
+  CHECK(tket_sim::get_unitary(circ).isApprox(expected, ERR_EPS));
+  const auto sv = tket_sim::get_statevector(circ, EPS, 11, 3);
+  CHECK(sv.isApprox(expected.col(0), ERR_EPS));
+}
+
 SCENARIO("compare_statevectors_or_unitaries gives expected errors") {
   const std::array<tket_sim::MatrixEquivalence, 2> equivalences{
       tket_sim::MatrixEquivalence::EQUAL,
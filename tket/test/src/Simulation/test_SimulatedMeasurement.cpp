@@ -0,0 +1,108 @@
+// Copyright Quantinuum
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "tket/Circuit/Circuit.hpp"
+#include "tket/Circuit/Simulation/CircuitSimulator.hpp"
+#include "tket/Circuit/Simulation/SimulatedMeasurement.hpp"
+
+namespace tket {
+namespace test_SimulatedMeasurement {
+
+SCENARIO("Sampling measurement outcomes") {
+  GIVEN("A GHZ circuit") {
+    Circuit circ(4);
+    circ.add_op<unsigned>(OpType::H, {0});
+    for (unsigned i = 1; i < 4; ++i) {
+      circ.add_op<unsigned>(OpType::CX, {0, i});
+    }
+    const MatrixXb shots = tket_sim::sample_shots(circ, 1000, 7);
+    REQUIRE(shots.rows() == 1000);
+    REQUIRE(shots.cols() == 4);
+    unsigned n_ones = 0;
+    for (unsigned s = 0; s < 1000; ++s) {
+      CHECK((shots.row(s).all() || !shots.row(s).any()));
+      if (shots(s, 0)) ++n_ones;
+    }
+    CHECK(n_ones > 400);
+    CHECK(n_ones < 600);
+    THEN("The same seed gives the same shots") {
+      CHECK(tket_sim::sample_shots(circ, 1000, 7) == shots);
+      CHECK(tket_sim::sample_shots(circ, 1000, 8) != shots);
+    }
+  }
+  GIVEN("A circuit flipping a single qubit") {
+    Circuit circ(3);
+    circ.add_op<unsigned>(OpType::X, {1});
+    const MatrixXb shots = tket_sim::sample_shots(circ, 10, 1);
+    THEN("The columns follow the order of the qubits") {
+      for (unsigned s = 0; s < 10; ++s) {
+        CHECK(!shots(s, 0));
+        CHECK(shots(s, 1));
+        CHECK(!shots(s, 2));
+      }
+    }
+  }
+  GIVEN("A zero state") {
+    const StateVector zero = StateVector::Zero(4);
+    REQUIRE_THROWS_AS(
+        tket_sim::sample_shots(zero, 1, 0), std::invalid_argument);
+  }
+}
+
+SCENARIO("Expectation values of Pauli operators") {
+  GIVEN("A Bell circuit") {
+    Circuit circ(2);
+    circ.add_op<unsigned>(OpType::H, {0});
+    circ.add_op<unsigned>(OpType::CX, {0, 1});
+    const std::vector<SpCxPauliTensor> zz{
+        SpCxPauliTensor({{Qubit(0), Pauli::Z}, {Qubit(1), Pauli::Z}})};
+    const std::vector<SpCxPauliTensor> xx{
+        SpCxPauliTensor({{Qubit(0), Pauli::X}, {Qubit(1), Pauli::X}})};
+    const std::vector<SpCxPauliTensor> z{
+        SpCxPauliTensor({{Qubit(0), Pauli::Z}})};
+    CHECK(std::abs(tket_sim::expectation(circ, zz) - 1.) < EPS);
+    CHECK(std::abs(tket_sim::expectation(circ, xx) - 1.) < EPS);
+    CHECK(std::abs(tket_sim::expectation(circ, z)) < EPS);
+  }
+  GIVEN("A circuit and an operator with several terms") {
+    Circuit circ(3);
+    circ.add_op<unsigned>(OpType::Rx, 0.3, {0});
+    circ.add_op<unsigned>(OpType::Ry, 0.7, {1});
+    circ.add_op<unsigned>(OpType::CX, {1, 2});
+    circ.add_op<unsigned>(OpType::Rz, 1.1, {2});
+    circ.add_op<unsigned>(OpType::CY, {2, 0});
+    const std::vector<SpCxPauliTensor> op{
+        SpCxPauliTensor({{Qubit(0), Pauli::Y}, {Qubit(2), Pauli::X}}, 0.5),
+        SpCxPauliTensor({{Qubit(1), Pauli::Z}}, -1.2),
+        SpCxPauliTensor({}, 0.25)};
+    const StateVector sv = tket_sim::get_statevector(circ);
+    const qubit_vector_t qubits = circ.all_qubits();
+    Complex expected = 0.;
+    for (const SpCxPauliTensor& term : op) {
+      expected += term.state_expectation(sv, qubits);
+    }
+    CHECK(std::abs(tket_sim::expectation(circ, op) - expected) < EPS);
+    CHECK(std::abs(tket_sim::expectation(circ, op, 11, 2) - expected) < EPS);
+    THEN("A term on another qubit is rejected") {
+      const std::vector<SpCxPauliTensor> bad{
+          SpCxPauliTensor({{Qubit(3), Pauli::X}})};
+      REQUIRE_THROWS_AS(tket_sim::expectation(circ, bad), std::logic_error);
+    }
+  }
+}
+
+}  // namespace test_SimulatedMeasurement
+}  // namespace tket
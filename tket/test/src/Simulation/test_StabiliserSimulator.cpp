@@ -0,0 +1,140 @@
+// Copyright Quantinuum
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "tket/Circuit/Boxes.hpp"
+#include "tket/Circuit/Circuit.hpp"
+#include "tket/Circuit/Simulation/CircuitSimulator.hpp"
+#include "tket/Circuit/Simulation/StabiliserSimulator.hpp"
+#include "tket/OpType/OpTypeInfo.hpp"
+#include "tket/Predicates/Predicates.hpp"
+
+namespace tket {
+namespace test_StabiliserSimulator {
+
+// Check that every row of the tableau stabilises the state.
+static void check_stabilises(
+    const SymplecticTableau& tab, const StateVector& sv) {
+  REQUIRE(tab.get_n_rows() == tab.get_n_qubits());
+  REQUIRE(tab.rank() == tab.get_n_rows());
+  for (unsigned r = 0; r < tab.get_n_rows(); ++r) {
+    CHECK(std::abs(tab.get_pauli(r).state_expectation(sv) - 1.) < EPS);
+  }
+}
+
+SCENARIO("Stabiliser states of unitary Clifford circuits") {
+  GIVEN("A circuit with many kinds of Clifford gate") {
+    Circuit circ(4);
+    circ.add_op<unsigned>(OpType::H, {0});
+    circ.add_op<unsigned>(OpType::CX, {0, 1});
+    circ.add_op<unsigned>(OpType::Rz, 0.5, {1});
+    circ.add_op<unsigned>(OpType::Ry, 1.5, {2});
+    circ.add_op<unsigned>(OpType::ECR, {2, 3});
+    circ.add_op<unsigned>(OpType::TK1, {0.3, 1., 0.8}, {3});
+    circ.add_op<unsigned>(OpType::ZZPhase, 1.5, {0, 3});
+    circ.add_op<unsigned>(OpType::ISWAPMax, {1, 2});
+    circ.add_op<unsigned>(OpType::U3, {0.5, 0., 1.}, {0});
+    circ.add_op<unsigned>(OpType::TK2, {0.5, 0., 0.}, {1, 3});
+    circ.add_op<unsigned>(OpType::PhasedX, {1.5, 0.5}, {2});
+    Circuit inner(2);
+    inner.add_op<unsigned>(OpType::SX, {1});
+    inner.add_op<unsigned>(OpType::CY, {1, 0});
+    circ.add_box(CircBox(inner), {3, 0});
+    circ.add_op<unsigned>(OpType::XXPhase, 0.5, {1, 2});
+    THEN("The stabilisers match the statevector") {
+      check_stabilises(
+          tket_sim::get_stabiliser_state(circ),
+          tket_sim::get_statevector(circ));
+    }
+    WHEN("The circuit has an implicit qubit permutation") {
+      circ.add_op<unsigned>(OpType::SWAP, {0, 2});
+      circ.add_op<unsigned>(OpType::S, {2});
+      circ.replace_SWAPs();
+      REQUIRE(circ.has_implicit_wireswaps());
+      THEN("The stabilisers match the permuted statevector") {
+        check_stabilises(
+            tket_sim::get_stabiliser_state(circ),
+            tket_sim::get_statevector(circ));
+      }
+    }
+  }
+  GIVEN("A non-Clifford circuit") {
+    Circuit circ(2);
+    circ.add_op<unsigned>(OpType::H, {0});
+    circ.add_op<unsigned>(OpType::T, {0});
+    REQUIRE_THROWS_AS(tket_sim::get_stabiliser_state(circ), BadOpType);
+  }
+}
+
+SCENARIO("Sampling Clifford circuits with measurements") {
+  GIVEN("A large GHZ state") {
+    const unsigned n = 2000;
+    Circuit circ(n, n);
+    circ.add_op<unsigned>(OpType::H, {0});
+    for (unsigned i = 1; i < n; ++i) {
+      circ.add_op<unsigned>(OpType::CX, {i - 1, i});
+    }
+    for (unsigned i = 0; i < n; ++i) {
+      circ.add_measure(i, i);
+    }
+    const MatrixXb shots = tket_sim::sample_clifford_shots(circ, 32, 3);
+    REQUIRE(shots.rows() == 32);
+    REQUIRE(shots.cols() == n);
+    for (unsigned s = 0; s < 32; ++s) {
+      CHECK((shots.row(s).all() || !shots.row(s).any()));
+    }
+    CHECK(shots.col(0).any());
+    CHECK(!shots.col(0).all());
+    THEN("The same seed gives the same shots") {
+      CHECK(tket_sim::sample_clifford_shots(circ, 32, 3) == shots);
+    }
+  }
+  GIVEN("Mid-circuit measurements, resets and conditional gates") {
+    Circuit circ(3, 3);
+    circ.add_op<unsigned>(OpType::H, {0});
+    circ.add_measure(0, 0);
+    // Copy the outcome to qubit 1 with a conditional X.
+    circ.add_conditional_gate<unsigned>(OpType::X, {}, {1}, {0}, 1);
+    circ.add_measure(1, 1);
+    // Reset qubit 0 and check that it is |0>.
+    circ.add_op<unsigned>(OpType::Reset, {0});
+    circ.add_op<unsigned>(OpType::CX, {0, 2});
+    circ.add_measure(2, 2);
+    REQUIRE(CliffordCircuitPredicate().verify(circ));
+    const MatrixXb shots = tket_sim::sample_clifford_shots(circ, 100, 11);
+    unsigned n_ones = 0;
+    for (unsigned s = 0; s < 100; ++s) {
+      CHECK(shots(s, 0) == shots(s, 1));
+      CHECK(!shots(s, 2));
+      if (shots(s, 0)) ++n_ones;
+    }
+    CHECK(n_ones > 25);
+    CHECK(n_ones < 75);
+  }
+  GIVEN("A measurement with a deterministic outcome") {
+    Circuit circ(2, 1);
+    circ.add_op<unsigned>(OpType::H, {0});
+    circ.add_op<unsigned>(OpType::CX, {0, 1});
+    circ.add_op<unsigned>(OpType::CX, {0, 1});
+    circ.add_op<unsigned>(OpType::H, {0});
+    circ.add_op<unsigned>(OpType::X, {0});
+    circ.add_measure(0, 0);
+    const MatrixXb shots = tket_sim::sample_clifford_shots(circ, 10, 0);
+    CHECK(shots.all());
+  }
+}
+
+}  // namespace test_StabiliserSimulator
+}  // namespace tket
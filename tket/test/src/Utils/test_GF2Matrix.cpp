@@ -0,0 +1,154 @@
+// Copyright Quantinuum
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "tket/Utils/GF2Matrix.hpp"
+
+namespace tket {
+namespace test_GF2Matrix {
+
+SCENARIO("GF2Matrix element access and conversion") {
+  GIVEN("A matrix spanning several words") {
+    const unsigned rows = 3, cols = 150;
+    MatrixXb dense = MatrixXb::Zero(rows, cols);
+    dense(0, 0) = true;
+    dense(0, 63) = true;
+    dense(1, 64) = true;
+    dense(2, 149) = true;
+    GF2Matrix m(dense);
+    REQUIRE(m.rows() == rows);
+    REQUIRE(m.cols() == cols);
+    REQUIRE(m.row_words() == 3);
+    REQUIRE(m(0, 63));
+    REQUIRE(m(1, 64));
+    REQUIRE_FALSE(m(1, 63));
+    REQUIRE(m.row_count(0) == 2);
+    REQUIRE(m.to_MatrixXb() == dense);
+    WHEN("Entries are modified") {
+      m(1, 100) = true;
+      m(0, 0) ^= true;
+      m(2, 5) = m(2, 149);
+      THEN("Only those entries change") {
+        dense(1, 100) = true;
+        dense(0, 0) = false;
+        dense(2, 5) = true;
+        REQUIRE(m.to_MatrixXb() == dense);
+      }
+    }
+    WHEN("Rows are combined") {
+      m.row_xor(0, 1);
+      m.swap_rows(0, 2);
+      THEN("The rows are updated") {
+        REQUIRE(m.row_count(1) == 3);
+        REQUIRE(m(0, 149));
+        REQUIRE(m(2, 63));
+        REQUIRE_FALSE(m.row_is_zero(2));
+      }
+    }
+    WHEN("The matrix is shrunk and regrown") {
+      m.conservative_resize(2, 64);
+      REQUIRE(m.row_words() == 1);
+      REQUIRE(m(0, 63));
+      REQUIRE(m.row_is_zero(1));
+      m.conservative_resize(3, 150);
+      THEN("Entries outside the smaller matrix are zero") {
+        MatrixXb expected = MatrixXb::Zero(rows, cols);
+        expected(0, 0) = true;
+        expected(0, 63) = true;
+        REQUIRE(m.to_MatrixXb() == expected);
+      }
+    }
+  }
+  GIVEN("An identity matrix") {
+    GF2Matrix id = GF2Matrix::identity(70);
+    REQUIRE(id.to_MatrixXb() == MatrixXb::Identity(70, 70));
+    REQUIRE_FALSE(id.is_zero());
+    REQUIRE(id != GF2Matrix(70, 70));
+    REQUIRE(GF2Matrix(70, 70).is_zero());
+  }
+}
+
+SCENARIO("GF2Matrix elimination") {
+  // A 100x100 matrix of rank 99: the product of lower and upper
+  // unitriangular matrices, with row 99 replaced by the sum of rows 0, 50 and
+  // 98.
+  const unsigned n = 100;
+  MatrixXb lower = MatrixXb::Identity(n, n), upper = MatrixXb::Identity(n, n);
+  for (unsigned r = 0; r < n; ++r) {
+    for (unsigned c = 0; c < r; ++c) {
+      lower(r, c) = (r * 37 + c * 11) % 7 < 3;
+      upper(c, r) = (r * 13 + c * 29) % 5 < 2;
+    }
+  }
+  MatrixXb dense = MatrixXb::Zero(n, n);
+  for (unsigned r = 0; r < n; ++r) {
+    for (unsigned c = 0; c < n; ++c) {
+      for (unsigned k = 0; k < n; ++k) {
+        dense(r, c) ^= lower(r, k) && upper(k, c);
+      }
+    }
+  }
+  dense.row(99) = MatrixXb::Zero(1, n);
+  for (unsigned r : {0, 50, 98}) {
+    for (unsigned c = 0; c < n; ++c) dense(99, c) ^= dense(r, c);
+  }
+  const GF2Matrix m(dense);
+  GIVEN("The row operations of Gaussian elimination") {
+    GF2Matrix reduced = m;
+    const std::vector<std::pair<unsigned, unsigned>> ops =
+        reduced.gaussian_elimination_row_ops();
+    THEN("They give the same reduced form as the method of four Russians") {
+      GF2Matrix m4ri = m;
+      const std::vector<unsigned> pivots = m4ri.row_echelon_reduce();
+      REQUIRE(pivots.size() == n - 1);
+      REQUIRE(m4ri == reduced);
+      REQUIRE(m4ri.row_is_zero(n - 1));
+      for (unsigned r = 0; r < pivots.size(); ++r) {
+        REQUIRE(m4ri(r, pivots[r]));
+      }
+    }
+    THEN("Replaying them on the original matrix gives the reduced form") {
+      GF2Matrix replayed = m;
+      for (const std::pair<unsigned, unsigned>& op : ops) {
+        replayed.row_xor(op.first, op.second);
+      }
+      REQUIRE(replayed == reduced);
+    }
+  }
+  GIVEN("Rank and solutions") {
+    REQUIRE(m.rank() == n - 1);
+    REQUIRE(GF2Matrix::identity(n).rank() == n);
+    REQUIRE(GF2Matrix(n, n).rank() == 0);
+    GF2Matrix b(n, 2);
+    // The first right-hand side is column 3 plus column 70.
+    for (unsigned r = 0; r < n; ++r) {
+      b(r, 0) = m(r, 3) != m(r, 70);
+    }
+    // The second has a single entry in row 99, so it is not in the span.
+    b(99, 1) = true;
+    REQUIRE_FALSE(m.solve(b));
+    b(99, 1) = false;
+    std::optional<GF2Matrix> x = m.solve(b);
+    REQUIRE(x);
+    for (unsigned r = 0; r < n; ++r) {
+      bool sum = false;
+      for (unsigned c = 0; c < n; ++c) sum ^= m(r, c) && (*x)(c, 0);
+      REQUIRE(sum == b(r, 0));
+    }
+  }
+}
+
+}  // namespace test_GF2Matrix
+}  // namespace tket
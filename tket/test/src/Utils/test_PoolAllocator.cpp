@@ -0,0 +1,204 @@
+// Copyright Quantinuum
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <numeric>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "tket/Utils/PoolAllocator.hpp"
+
+namespace tket {
+namespace test_PoolAllocator {
+
+// Each size gets its own pool, so the scenarios below do not see blocks
+// left over from one another or from circuits built by other tests.
+template <std::size_t N>
+struct Payload {
+  std::uint64_t data[N];
+};
+
+static constexpr std::size_t batch = pool_detail::BlockCache<8, 8>::batch;
+
+SCENARIO("Allocating and freeing on one thread") {
+  typedef Payload<29> P;
+  PoolAllocator<P> alloc;
+  GIVEN("Many single allocations") {
+    std::vector<P*> ps;
+    for (std::size_t i = 0; i < 3 * batch; ++i) {
+      P* p = alloc.allocate(1);
+      REQUIRE(reinterpret_cast<std::uintptr_t>(p) % alignof(P) == 0);
+      p->data[0] = i;
+      p->data[28] = i;
+      ps.push_back(p);
+    }
+    THEN("The blocks are distinct and keep their contents") {
+      REQUIRE(std::set<P*>(ps.begin(), ps.end()).size() == ps.size());
+      for (std::size_t i = 0; i < ps.size(); ++i) {
+        CHECK(ps[i]->data[0] == i);
+        CHECK(ps[i]->data[28] == i);
+      }
+    }
+    for (P* p : ps) alloc.deallocate(p, 1);
+  }
+  GIVEN("A block that has just been freed") {
+    P* p = alloc.allocate(1);
+    alloc.deallocate(p, 1);
+    THEN("It is reused by the next allocation") {
+      P* q = alloc.allocate(1);
+      CHECK(q == p);
+      alloc.deallocate(q, 1);
+    }
+  }
+  GIVEN("An array allocation") {
+    P* arr = alloc.allocate(4);
+    for (std::size_t i = 0; i < 4; ++i) arr[i].data[0] = i;
+    CHECK(arr[3].data[0] == 3);
+    alloc.deallocate(arr, 4);
+  }
+  GIVEN("A list using the allocator") {
+    std::list<int, PoolAllocator<int>> l(1000);
+    std::iota(l.begin(), l.end(), 0);
+    l.remove_if([](int i) { return i % 3 == 0; });
+    CHECK(l.size() == 666);
+    CHECK(l.front() == 1);
+    CHECK(l.back() == 998);
+  }
+}
+
+SCENARIO("Freeing blocks on a different thread") {
+  typedef Payload<30> P;
+  PoolAllocator<P> alloc;
+  GIVEN("Blocks allocated on a thread that has exited") {
+    std::vector<P*> ps(2 * batch + 1);
+    std::thread t([&]() {
+      for (std::size_t i = 0; i < ps.size(); ++i) {
+        ps[i] = alloc.allocate(1);
+        ps[i]->data[0] = i;
+      }
+    });
+    t.join();
+    THEN("They can be read and freed on this thread") {
+      for (std::size_t i = 0; i < ps.size(); ++i) {
+        CHECK(ps[i]->data[0] == i);
+        alloc.deallocate(ps[i], 1);
+      }
+    }
+  }
+  GIVEN("Lists built on several threads and destroyed on this one") {
+    typedef std::list<std::size_t, PoolAllocator<std::size_t>> List;
+    std::vector<List> lists(4);
+    std::vector<std::thread> threads;
+    for (std::size_t k = 0; k < lists.size(); ++k) {
+      threads.emplace_back([&lists, k]() {
+        for (std::size_t i = 0; i < 5000; ++i) lists[k].push_back(k + i);
+      });
+    }
+    for (std::thread& t : threads) t.join();
+    for (std::size_t k = 0; k < lists.size(); ++k) {
+      CHECK(lists[k].size() == 5000);
+      CHECK(lists[k].front() == k);
+      CHECK(lists[k].back() == k + 4999);
+    }
+    lists.clear();
+  }
+}
+
+SCENARIO("Thread caches hand freed blocks back to the pool") {
+  typedef Payload<31> P;
+  PoolAllocator<P> alloc;
+  // Empty this thread's cache for P, then free enough blocks into it to
+  // trigger a hand-back of the most recently freed batch.
+  std::vector<P*> ps(2 * batch);
+  for (P*& p : ps) p = alloc.allocate(1);
+  for (P* p : ps) alloc.deallocate(p, 1);
+  const std::set<P*> handed_back(ps.begin() + batch, ps.end());
+  GIVEN("Another thread allocating a batch") {
+    std::set<P*> taken;
+    std::thread t([&]() {
+      std::vector<P*> qs(batch);
+      for (P*& q : qs) q = alloc.allocate(1);
+      taken.insert(qs.begin(), qs.end());
+      for (P* q : qs) alloc.deallocate(q, 1);
+    });
+    t.join();
+    THEN("It receives the blocks freed here") {
+      CHECK(taken == handed_back);
+    }
+  }
+}
+
+SCENARIO("Pools return their chunks when the last allocator goes") {
+  typedef Payload<32> P;
+  typedef pool_detail::BlockPool<sizeof(P), alignof(P)> Pool;
+  GIVEN("Blocks freed while an allocator is alive") {
+    {
+      PoolAllocator<P> alloc;
+      std::vector<P*> ps(Pool::blocks_per_chunk + 1);
+      for (P*& p : ps) p = alloc.allocate(1);
+      for (P* p : ps) alloc.deallocate(p, 1);
+      THEN("The chunks are kept for reuse") {
+        CHECK(Pool::get().n_chunks() == 2);
+      }
+    }
+    THEN("They are released afterwards") {
+      CHECK(Pool::get().n_chunks() == 0);
+    }
+  }
+  GIVEN("A copy of an allocator that outlives the original") {
+    auto alloc = std::make_unique<PoolAllocator<P>>();
+    PoolAllocator<P> copy(*alloc);
+    P* p = alloc->allocate(1);
+    alloc.reset();
+    THEN("The chunks are kept until the copy goes") {
+      p->data[0] = 1;
+      copy.deallocate(p, 1);
+      CHECK(Pool::get().n_chunks() == 1);
+    }
+  }
+  GIVEN("No allocators") {
+    THEN("No chunks are held") { CHECK(Pool::get().n_chunks() == 0); }
+  }
+  GIVEN("Thread caches holding blocks from released chunks") {
+    {
+      PoolAllocator<P> alloc;
+      std::thread t([&]() { alloc.deallocate(alloc.allocate(1), 1); });
+      t.join();
+      alloc.deallocate(alloc.allocate(1), 1);
+    }
+    REQUIRE(Pool::get().n_chunks() == 0);
+    THEN("Those blocks are discarded rather than reused") {
+      PoolAllocator<P> alloc;
+      std::vector<P*> ps(2 * batch + 1);
+      std::thread t([&]() {
+        for (std::size_t i = 0; i < ps.size(); ++i) {
+          ps[i] = alloc.allocate(1);
+          ps[i]->data[31] = i;
+        }
+      });
+      t.join();
+      for (std::size_t i = 0; i < ps.size(); ++i) {
+        CHECK(ps[i]->data[31] == i);
+        alloc.deallocate(ps[i], 1);
+      }
+    }
+  }
+}
+
+}  // namespace test_PoolAllocator
+}  // namespace tket
@@ -0,0 +1,76 @@
+// Copyright Quantinuum
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <atomic>
+#include <boost/functional/hash.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "tket/Utils/UnitID.hpp"
+
+namespace tket {
+namespace test_UnitID {
+
+SCENARIO("UnitID comparison") {
+  GIVEN("Units in several registers") {
+    const Qubit q0(0), q1(1), q0_again("q", 0);
+    const Qubit a5("a", 5), q01("q", 0, 1), q_none("q");
+    REQUIRE(q0 == q0_again);
+    REQUIRE(hash_value(q0) == hash_value(q0_again));
+    REQUIRE(q0 != q1);
+    REQUIRE(q0 != q01);
+    REQUIRE(q0 != q_none);
+    THEN("Units are ordered by name, then index") {
+      const std::vector<Qubit> ordered = {a5, q_none, q0, q01, q1};
+      for (unsigned i = 0; i < ordered.size(); ++i) {
+        for (unsigned j = 0; j < ordered.size(); ++j) {
+          CHECK((ordered[i] < ordered[j]) == (i < j));
+        }
+      }
+    }
+    THEN("Names and indices are preserved") {
+      CHECK(q01.reg_name() == "q");
+      CHECK(q01.index() == std::vector<unsigned>{0, 1});
+      CHECK(q01.repr() == "q[0, 1]");
+      CHECK(q_none.reg_dim() == 0);
+      CHECK(UnitID() == Qubit());
+    }
+  }
+}
+
+SCENARIO("Concurrent UnitID construction") {
+  GIVEN("Threads constructing units in the same new registers") {
+    const unsigned n_threads = 4, n_regs = 20, n_units = 2000;
+    std::atomic<unsigned> n_mismatches{0};
+    std::vector<std::thread> threads;
+    for (unsigned t = 0; t < n_threads; ++t) {
+      threads.emplace_back([&]() {
+        for (unsigned i = 0; i < n_units; ++i) {
+          const std::string name = "concurrent" + std::to_string(i % n_regs);
+          const Bit b(name, i);
+          if (b != Bit(name, i) || b.reg_name() != name || b.index()[0] != i) {
+            ++n_mismatches;
+          }
+        }
+      });
+    }
+    for (std::thread& t : threads) t.join();
+    REQUIRE(n_mismatches == 0);
+  }
+}
+
+}  // namespace test_UnitID
+}  // namespace tket
@@ -15,6 +15,7 @@
 #include <algorithm>
 #include <catch2/catch_test_macros.hpp>
 #include <memory>
+#include <optional>
 #include <tkrng/RNG.hpp>
 #include <vector>
 
@@ -31,10 +32,12 @@
 #include "tket/OpType/OpTypeFunctions.hpp"
 #include "tket/Ops/ClassicalOps.hpp"
 #include "tket/Placement/Placement.hpp"
+#include "tket/Predicates/CompilationCache.hpp"
 #include "tket/Predicates/CompilationUnit.hpp"
 #include "tket/Predicates/CompilerPass.hpp"
 #include "tket/Predicates/PassGenerators.hpp"
 #include "tket/Predicates/PassLibrary.hpp"
+#include "tket/Predicates/PassTrace.hpp"
 #include "tket/Transformations/MeasurePass.hpp"
 #include "tket/Transformations/OptimisationPass.hpp"
 #include "tket/Transformations/PauliOptimisation.hpp"
@@ -570,6 +573,151 @@ SCENARIO("Track initial and final maps throughout compilation") {
   }
 }
 
+SCENARIO("Apply passes with a compilation cache") {
+  Circuit circ(5);
+  add_2qb_gates(circ, OpType::CX, {{0, 3}, {1, 4}, {1, 0}, {2, 1}});
+  circ.add_op<unsigned>(OpType::Z, {4});
+  SquareGrid grid(2, 3);
+  PassPtr pass = gen_default_mapping_pass(grid, false);
+  CompilationCache cache;
+  GIVEN("A pass applied twice to the same circuit") {
+    CompilationUnit cu0(circ);
+    bool changed0 = pass->apply(cu0);
+    CompilationUnit cu1(circ);
+    REQUIRE(pass->apply_cached(cu1, cache) == changed0);
+    REQUIRE(cache.misses() == 1);
+    CompilationUnit cu2(circ);
+    REQUIRE(pass->apply_cached(cu2, cache) == changed0);
+    REQUIRE(cache.hits() == 1);
+    REQUIRE(cache.size() == 1);
+    for (const CompilationUnit* cu : {&cu1, &cu2}) {
+      REQUIRE(cu->get_circ_ref() == cu0.get_circ_ref());
+      REQUIRE(cu->get_initial_map_ref() == cu0.get_initial_map_ref());
+      REQUIRE(cu->get_final_map_ref() == cu0.get_final_map_ref());
+    }
+  }
+  GIVEN("A cached pass following an uncached one") {
+    PassPtr rename = gen_rename_qubits_pass(
+        {{Qubit(0), Qubit("a", 0)}, {Qubit(2), Qubit("a", 1)}});
+    CompilationUnit cu0(circ);
+    rename->apply(cu0);
+    pass->apply(cu0);
+    CompilationUnit cu1(circ);
+    rename->apply(cu1);
+    pass->apply_cached(cu1, cache);
+    CompilationUnit cu2(circ);
+    rename->apply(cu2);
+    pass->apply_cached(cu2, cache);
+    REQUIRE(cache.hits() == 1);
+    for (const CompilationUnit* cu : {&cu1, &cu2}) {
+      REQUIRE(cu->get_circ_ref() == cu0.get_circ_ref());
+      REQUIRE(cu->get_initial_map_ref() == cu0.get_initial_map_ref());
+      REQUIRE(cu->get_final_map_ref() == cu0.get_final_map_ref());
+    }
+  }
+  GIVEN("A unit with target predicates") {
+    PredicatePtr gates = std::make_shared<GateSetPredicate>(
+        OpTypeSet{OpType::CX, OpType::Z, OpType::SWAP});
+    CompilationUnit cu0(circ, std::vector<PredicatePtr>{gates});
+    pass->apply(cu0, SafetyMode::Audit);
+    for (unsigned i = 0; i < 2; i++) {
+      CompilationUnit cu(circ, std::vector<PredicatePtr>{gates});
+      pass->apply_cached(cu, cache, SafetyMode::Audit);
+      REQUIRE(cu.get_circ_ref() == cu0.get_circ_ref());
+      REQUIRE(cu.check_all_predicates() == cu0.check_all_predicates());
+    }
+    REQUIRE(cache.hits() == 1);
+  }
+  GIVEN("Entries whose hashes collide") {
+    CompilationCache::Entry entry{circ, false, {}, "input", "config"};
+    cache.insert(1, 2, entry);
+    REQUIRE(cache.find(1, 2, "input", "config"));
+    REQUIRE(!cache.find(1, 2, "other input", "config"));
+    REQUIRE(!cache.find(1, 2, "input", "other config"));
+    REQUIRE(cache.hits() == 1);
+    REQUIRE(cache.misses() == 2);
+  }
+  GIVEN("A custom pass") {
+    PassPtr custom = CustomPass([](const Circuit& c) { return c; });
+    CompilationUnit cu(circ);
+    custom->apply_cached(cu, cache);
+    REQUIRE(cache.size() == 0);
+    REQUIRE(cache.misses() == 0);
+    REQUIRE(!pass_config_hash(custom->get_config()));
+    REQUIRE(pass_config_hash(pass->get_config()));
+    PassPtr custom_routing =
+        gen_routing_pass(grid, {std::make_shared<RoutingMethod>()});
+    REQUIRE(!pass_config_hash(custom_routing->get_config()));
+  }
+}
+
+SCENARIO("Tracing pass applications") {
+  Circuit circ(2);
+  circ.add_op<unsigned>(OpType::H, {0});
+  circ.add_op<unsigned>(OpType::H, {0});
+  circ.add_op<unsigned>(OpType::CX, {0, 1});
+  circ.add_op<unsigned>(OpType::CX, {0, 1});
+  circ.add_op<unsigned>(OpType::Rz, 0.5, {1});
+  PassPtr repeat = std::make_shared<RepeatPass>(RemoveRedundancies());
+  std::vector<PassPtr> passes = {repeat, SynthesiseTK()};
+  PassPtr sequence = std::make_shared<SequencePass>(passes);
+  GIVEN("A unit without tracing") {
+    CompilationUnit cu(circ);
+    sequence->apply(cu);
+    REQUIRE(!cu.get_trace());
+  }
+  GIVEN("A unit with tracing") {
+    CompilationUnit cu(circ);
+    cu.enable_trace();
+    REQUIRE(sequence->apply(cu));
+    const std::vector<PassTraceEvent>& events = cu.get_trace()->get_events();
+    REQUIRE(events.size() >= 4);
+    const PassTraceEvent& outer = events.back();
+    CHECK(outer.name == "SequencePass");
+    CHECK(outer.level == 0);
+    CHECK(outer.args["before"]["n_gates"] == 5);
+    CHECK(outer.args["before"]["n_2qb_gates"] == 2);
+    CHECK(outer.args["after"]["n_gates"] == 1);
+    CHECK(outer.args["changed"] == true);
+    unsigned n_inner = 0;
+    std::optional<PassTraceEvent> repeat_event;
+    for (const PassTraceEvent& ev : events) {
+      CHECK(ev.start >= outer.start);
+      CHECK(ev.start + ev.duration <= outer.start + outer.duration);
+      if (ev.name == "RemoveRedundancies") {
+        CHECK(ev.level == 2);
+        ++n_inner;
+      } else if (ev.name == "RepeatPass") {
+        CHECK(ev.level == 1);
+        repeat_event = ev;
+      }
+    }
+    REQUIRE(repeat_event);
+    CHECK(n_inner >= 2);
+    CHECK(repeat_event->args["iterations"] == n_inner);
+    WHEN("A predicate is checked") {
+      REQUIRE(cu.calc_predicate(NoSymbolsPredicate()));
+      const PassTraceEvent& check = cu.get_trace()->get_events().back();
+      CHECK(check.name == "NoSymbolsPredicate");
+      CHECK(check.category == "predicate");
+      CHECK(check.level == 0);
+      CHECK(check.args["result"] == true);
+    }
+    THEN("The trace can be exported in the Chrome format") {
+      nlohmann::json j = cu.get_trace()->to_chrome_trace();
+      REQUIRE(j["traceEvents"].size() == events.size());
+      CHECK(j["traceEvents"].back()["name"] == "SequencePass");
+      CHECK(j["traceEvents"].back()["ph"] == "X");
+    }
+    THEN("Tracing can be switched off") {
+      cu.enable_trace(false);
+      REQUIRE(!cu.get_trace());
+      sequence->apply(cu);
+      REQUIRE(!cu.get_trace());
+    }
+  }
+}
+
 SCENARIO("FlattenRegisters pass") {
   GIVEN("A simple circuit") {
     Circuit circ(3, 2);
@@ -17,7 +17,13 @@
 #include <nlohmann/json.hpp>
 #include <thread>
 
+#include "tket/Architecture/Architecture.hpp"
 #include "tket/Circuit/Circuit.hpp"
+#include "tket/Mapping/LexiLabelling.hpp"
+#include "tket/Mapping/LexiRouteRoutingMethod.hpp"
+#include "tket/Placement/Placement.hpp"
+#include "tket/Predicates/CompilerPass.hpp"
+#include "tket/Predicates/PassGenerators.hpp"
 #include "tket/Transformations/OptimisationPass.hpp"
 
 namespace tket {
@@ -64,5 +70,95 @@ SCENARIO("Concurrent circuit operations") {
 #endif
 }
 
+SCENARIO("Concurrent distance queries") {
+  GIVEN("A fresh Architecture shared between threads") {
+    // Both the distance table and the per-root distance cache are built
+    // lazily by whichever thread gets there first.
+    const SquareGrid reference(4, 5);
+    const node_vector_t nodes = reference.get_all_nodes_vec();
+    for (unsigned repeat = 0; repeat < 10; repeat++) {
+      const SquareGrid arc(4, 5);
+      const unsigned n_threads = 8;
+      std::vector<std::vector<std::size_t>> distances(n_threads);
+      std::vector<std::vector<unsigned>> pairwise(n_threads);
+      std::vector<std::thread> threads;
+      for (unsigned t = 0; t < n_threads; t++) {
+        threads.emplace_back([&, t]() {
+          for (unsigned i = 0; i < nodes.size(); i++) {
+            const Node &root = nodes[(i + t) % nodes.size()];
+            if (t % 2 == 0) {
+              distances[t] = arc.get_distances(root);
+            }
+            for (const Node &node : nodes) {
+              pairwise[t].push_back(arc.get_distance(root, node));
+            }
+          }
+        });
+      }
+      for (std::thread &thread : threads) {
+        thread.join();
+      }
+      for (unsigned t = 0; t < n_threads; t++) {
+        if (t % 2 == 0) {
+          const Node &last_root =
+              nodes[(nodes.size() - 1 + t) % nodes.size()];
+          CHECK(distances[t] == reference.get_distances(last_root));
+        }
+        REQUIRE(pairwise[t].size() == nodes.size() * nodes.size());
+        for (unsigned i = 0; i < nodes.size(); i++) {
+          const Node &root = nodes[(i + t) % nodes.size()];
+          for (unsigned j = 0; j < nodes.size(); j++) {
+            CHECK(
+                pairwise[t][i * nodes.size() + j] ==
+                reference.get_distance(root, nodes[j]));
+          }
+        }
+      }
+    }
+  }
+}
+
+SCENARIO("Batch compilation") {
+#ifdef NDEBUG
+  GIVEN("Many circuits compiled with a shared routing pass") {
+    // The pass holds one Architecture, whose lazily built caches are then
+    // queried from every thread.
+    SquareGrid arc(3, 3);
+    PassPtr pass = FullPeepholeOptimise() >>
+                   gen_full_mapping_pass(
+                       arc, std::make_shared<LinePlacement>(arc),
+                       {std::make_shared<LexiLabellingMethod>(),
+                        std::make_shared<LexiRouteRoutingMethod>()});
+    std::vector<Circuit> circs;
+    for (unsigned i = 0; i < 16; i++) {
+      Circuit circ(6);
+      for (unsigned j = 0; j < 6; j++) {
+        circ.add_op<unsigned>(OpType::Rz, 0.1 * (i + 1), {j});
+        circ.add_op<unsigned>(OpType::CX, {j, (j + 1 + i % 5) % 6});
+        circ.add_op<unsigned>(OpType::H, {(j + 2) % 6});
+      }
+      circs.push_back(circ);
+    }
+    std::vector<CompilationUnit> serial_cus, batch_cus;
+    for (const Circuit& circ : circs) {
+      serial_cus.emplace_back(circ);
+      batch_cus.emplace_back(circ);
+    }
+    for (CompilationUnit& cu : serial_cus) {
+      pass->apply(cu);
+    }
+    std::vector<bool> applied = pass->apply_batch(batch_cus, 4);
+    REQUIRE(applied.size() == circs.size());
+    for (unsigned i = 0; i < circs.size(); i++) {
+      CHECK(applied[i]);
+      CHECK(batch_cus[i].get_circ_ref() == serial_cus[i].get_circ_ref());
+      CHECK(
+          batch_cus[i].get_final_map_ref() ==
+          serial_cus[i].get_final_map_ref());
+    }
+  }
+#endif
+}
+
 }  // namespace test_Concurrency
 }  // namespace tket
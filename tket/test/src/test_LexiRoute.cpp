@@ -1134,6 +1134,40 @@ SCENARIO("Dense CX circuits route successfully") {
   }
 }
 
+SCENARIO("Multithreaded LexiRoute chooses the same SWAPs") {
+  GIVEN("A dense CX circuit on a square grid") {
+    Circuit circ(16);
+    for (unsigned x = 0; x < 16; ++x) {
+      for (unsigned y = 0; y + 1 < x; ++y) {
+        add_2qb_gates(circ, OpType::CX, {{x, y}, {y + 1, x}});
+      }
+    }
+    ArchitecturePtr arc = std::make_shared<SquareGrid>(4, 4);
+    Circuit circ_serial = circ;
+    Circuit circ_parallel = circ;
+    MappingManager mm(arc);
+    REQUIRE(mm.route_circuit(
+        circ_serial, {std::make_shared<LexiLabellingMethod>(),
+                      std::make_shared<LexiRouteRoutingMethod>(10, 1)}));
+    REQUIRE(mm.route_circuit(
+        circ_parallel, {std::make_shared<LexiLabellingMethod>(),
+                        std::make_shared<LexiRouteRoutingMethod>(10, 4)}));
+    REQUIRE(circ_serial == circ_parallel);
+    (Transforms::decompose_SWAP_to_CX() >> Transforms::decompose_BRIDGE_to_CX())
+        .apply(circ_parallel);
+    REQUIRE(respects_connectivity_constraints(circ_parallel, *arc, false));
+  }
+  GIVEN("A serialised LexiRouteRoutingMethod") {
+    LexiRouteRoutingMethod lrrm(20, 4);
+    nlohmann::json j = lrrm.serialize();
+    REQUIRE(j.at("n_threads") == 4);
+    LexiRouteRoutingMethod loaded = LexiRouteRoutingMethod::deserialize(j);
+    REQUIRE(loaded.get_max_depth() == 20);
+    REQUIRE(loaded.get_n_threads() == 4);
+    REQUIRE(!LexiRouteRoutingMethod(20).serialize().contains("n_threads"));
+  }
+}
+
 SCENARIO(
     "Dense CX circuits route successfully on undirected Ring with "
     "placement.",
@@ -220,4 +220,31 @@ SCENARIO("Test LexicographicalComparison::remove_swaps_lexicographical") {
     REQUIRE(candidate_swaps.size() == 1);
   }
 }
+
+SCENARIO("Multithreaded remove_swaps_lexicographical") {
+  GIVEN("Enough candidate swaps to be scored on several threads") {
+    // Candidates are split between threads in batches of at least 256.
+    ArchitecturePtr arc = std::make_shared<SquareGrid>(24, 24);
+    const std::vector<Node> nodes = arc->get_all_nodes_vec();
+    interacting_nodes_t interacting_nodes;
+    for (unsigned i = 0; i < 60; i += 3) {
+      interacting_nodes[nodes[i]] = nodes[nodes.size() - 1 - 5 * i];
+    }
+    swap_set_t all_swaps;
+    for (const auto& [n0, n1] : arc->get_all_edges_vec()) {
+      all_swaps.insert({n0, n1});
+    }
+    REQUIRE(all_swaps.size() >= 4 * 256);
+    LexicographicalComparison lc_test(arc, interacting_nodes);
+    swap_set_t serial_swaps = all_swaps;
+    lc_test.remove_swaps_lexicographical(serial_swaps);
+    REQUIRE(!serial_swaps.empty());
+    REQUIRE(serial_swaps.size() < all_swaps.size());
+    for (unsigned n_threads : {2, 4, 8}) {
+      swap_set_t parallel_swaps = all_swaps;
+      lc_test.remove_swaps_lexicographical(parallel_swaps, n_threads);
+      REQUIRE(parallel_swaps == serial_swaps);
+    }
+  }
+}
 }  // namespace tket
@@ -131,6 +131,37 @@ SCENARIO("Test MappingFrontier initialisation, advance_frontier_boundary.") {
     REQUIRE(vp1.first == v2);
     REQUIRE(vp2.first == v3);
   }
+  GIVEN("A bit that cannot be overwritten before a blocked gate reads it") {
+    Circuit circ(3, 1);
+    Vertex v0 = circ.add_op<unsigned>(OpType::Measure, {0, 0});
+    Vertex v1 = circ.add_op<unsigned>(OpType::H, {2});
+    // Not permitted: nodes 0 and 2 are not adjacent
+    Vertex v2 =
+        circ.add_conditional_gate<unsigned>(OpType::CX, {}, {0, 2}, {0}, 1);
+    Vertex v3 = circ.add_op<unsigned>(OpType::Measure, {1, 0});
+    circ.add_op<unsigned>(OpType::X, {1});
+    std::vector<Node> nodes = {Node(0), Node(1), Node(2)};
+    Architecture arc({{nodes[0], nodes[1]}, {nodes[1], nodes[2]}});
+    ArchitecturePtr shared_arc = std::make_shared<Architecture>(arc);
+    std::vector<Qubit> qubits = circ.all_qubits();
+    circ.rename_units<Qubit, Node>(
+        {{qubits[0], nodes[0]}, {qubits[1], nodes[1]}, {qubits[2], nodes[2]}});
+    MappingFrontier mf(circ);
+    mf.advance_frontier_boundary(shared_arc);
+    VertPort vp0 = mf.linear_boundary->get<TagKey>().find(nodes[0])->second;
+    VertPort vp1 = mf.linear_boundary->get<TagKey>().find(nodes[1])->second;
+    VertPort vp2 = mf.linear_boundary->get<TagKey>().find(nodes[2])->second;
+    VertPort vp_b = mf.linear_boundary->get<TagKey>().find(Bit(0))->second;
+    REQUIRE(vp0 == VertPort{v0, 0});
+    REQUIRE(circ.get_OpType_from_Vertex(vp1.first) == OpType::Input);
+    REQUIRE(vp2 == VertPort{v1, 0});
+    REQUIRE(vp_b == VertPort{v0, 1});
+    auto bool_it = mf.boolean_boundary->get<TagKey>().find(Bit(0));
+    REQUIRE(bool_it != mf.boolean_boundary->get<TagKey>().end());
+    REQUIRE(bool_it->second.size() == 1);
+    REQUIRE(circ.target(bool_it->second[0]) == v2);
+    REQUIRE(circ.target(circ.get_nth_out_edge(vp_b.first, vp_b.second)) == v3);
+  }
   GIVEN(
       "A circuit with multi edge bundles of booleans, conditional gates with "
       "multiple inputs, conditional 2-qubit gates.") {
@@ -15,6 +15,7 @@
 #include <catch2/catch_test_macros.hpp>
 #include <cstdlib>
 
+#include "tket/Mapping/LexiRouteRoutingMethod.hpp"
 #include "tket/Mapping/MappingManager.hpp"
 
 namespace tket {
@@ -92,4 +93,73 @@ SCENARIO("Test MappingManager::route_circuit") {
     REQUIRE(*c2.get_op_ptr() == *get_op_ptr(OpType::CX));
   }
 }
+
+SCENARIO("Test MappingManager::route_circuit_portfolio") {
+  std::vector<Node> nodes;
+  for (unsigned i = 0; i < 4; ++i) nodes.push_back(Node("test_node", i));
+  ArchitecturePtr shared_arc = std::make_shared<Architecture>(
+      std::vector<std::pair<Node, Node>>{
+          {nodes[0], nodes[1]}, {nodes[1], nodes[2]}, {nodes[2], nodes[3]}});
+  MappingManager test_mm(shared_arc);
+  Circuit circ(4);
+  circ.add_op<unsigned>(OpType::CX, {0, 1});
+  circ.add_op<unsigned>(OpType::CX, {2, 3});
+  std::vector<Qubit> qubits = circ.all_qubits();
+  std::map<Qubit, Node> far = {
+      {qubits[0], nodes[0]},
+      {qubits[1], nodes[3]},
+      {qubits[2], nodes[1]},
+      {qubits[3], nodes[2]}};
+  std::map<Qubit, Node> near = {
+      {qubits[0], nodes[0]},
+      {qubits[1], nodes[1]},
+      {qubits[2], nodes[2]},
+      {qubits[3], nodes[3]}};
+  std::vector<RoutingMethodPtr> lexi = {
+      std::make_shared<LexiRouteRoutingMethod>()};
+  std::vector<RoutingMethodPtr> unroutable = {
+      std::make_shared<RoutingMethod>()};
+  GIVEN("No configurations.") {
+    REQUIRE_THROWS_AS(
+        test_mm.route_circuit_portfolio(circ, {}), MappingManagerError);
+  }
+  GIVEN("Configurations of which one fails.") {
+    std::vector<PortfolioRoutingConfig> configs = {
+        {unroutable, far}, {lexi, far}, {lexi, near}};
+    for (unsigned n_threads : {1, 3}) {
+      Circuit copy = circ;
+      std::shared_ptr<unit_bimaps_t> maps = std::make_shared<unit_bimaps_t>();
+      for (const Qubit& qubit : qubits) {
+        maps->initial.insert({qubit, qubit});
+        maps->final.insert({qubit, qubit});
+      }
+      PortfolioRoutingResult result = test_mm.route_circuit_portfolio(
+          copy, configs, maps, PortfolioObjective::SwapCount, n_threads);
+      REQUIRE(result.config_index == 2);
+      REQUIRE(result.n_swaps == 0);
+      REQUIRE(result.depth == 1);
+      REQUIRE(result.n_completed == 2);
+      REQUIRE(copy.count_gates(OpType::SWAP) == 0);
+      REQUIRE(copy.all_qubits() == qubit_vector_t(nodes.begin(), nodes.end()));
+      REQUIRE(maps->initial.left.at(qubits[1]) == nodes[1]);
+      REQUIRE(maps->final.left.at(qubits[1]) == nodes[1]);
+    }
+  }
+  GIVEN("Configurations that all fail.") {
+    std::vector<PortfolioRoutingConfig> configs = {
+        {unroutable, far}, {unroutable, near}};
+    REQUIRE_THROWS_AS(
+        test_mm.route_circuit_portfolio(circ, configs), MappingManagerError);
+  }
+  GIVEN("A time budget.") {
+    std::vector<PortfolioRoutingConfig> configs = {{lexi, far}, {lexi, near}};
+    Circuit copy = circ;
+    PortfolioRoutingResult result = test_mm.route_circuit_portfolio(
+        copy, configs, nullptr, PortfolioObjective::Depth, 1, 0);
+    // The first configuration always runs to completion.
+    REQUIRE(result.config_index == 0);
+    REQUIRE(result.n_completed == 1);
+    REQUIRE(copy.n_gates() == 2 + result.n_swaps);
+  }
+}
 }  // namespace tket
@@ -89,5 +89,55 @@ SCENARIO("Small sets of Gadgets are partitioned correctly") {
   }
 }
 
+SCENARIO("Partitioner graphs built in parallel or incrementally") {
+  // Strings of weight 4 over 100 qubits, so the packed strings span two words
+  std::list<SpPauliString> strings;
+  std::set<SpPauliString> seen;
+  unsigned x = 1;
+  while (strings.size() < 200) {
+    QubitPauliMap qpm;
+    for (unsigned k = 0; k < 4; ++k) {
+      x = (1103515245 * x + 12345) % 2147483648;
+      qpm[Qubit(x % 100)] = Pauli(1 + (x / 100) % 3);
+    }
+    SpPauliString s(qpm);
+    if (seen.insert(s).second) strings.push_back(s);
+  }
+  const std::list<SpPauliString> first_half(
+      strings.begin(), std::next(strings.begin(), 100));
+  const std::list<SpPauliString> second_half(
+      std::next(strings.begin(), 100), strings.end());
+
+  for (PauliPartitionStrat strat :
+       {PauliPartitionStrat::NonConflictingSets,
+        PauliPartitionStrat::CommutingSets}) {
+    PauliPartitionerGraph serial(strings, strat);
+    PauliPartitionerGraph parallel(strings, strat, 4);
+    PauliPartitionerGraph incremental(first_half, strat, 2);
+    incremental.add_strings(second_half);
+    const std::map<unsigned, std::list<SpPauliString>> colours =
+        serial.partition_paulis(GraphColourMethod::LargestFirst);
+    CHECK(
+        parallel.partition_paulis(GraphColourMethod::LargestFirst) == colours);
+    CHECK(
+        incremental.partition_paulis(GraphColourMethod::LargestFirst) ==
+        colours);
+    for (const auto& [colour, terms] : colours) {
+      for (const SpPauliString& a : terms) {
+        for (const SpPauliString& b : terms) {
+          if (strat == PauliPartitionStrat::CommutingSets) {
+            CHECK(a.commutes_with(b));
+          } else {
+            CHECK(a.conflicting_qubits(b).empty());
+          }
+        }
+      }
+    }
+    CHECK(
+        term_sequence(strings, strat, GraphColourMethod::LargestFirst, 4)
+            .size() == colours.size());
+  }
+}
+
 }  // namespace test_Partition
 }  // namespace tket
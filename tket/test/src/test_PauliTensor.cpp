@@ -504,6 +504,54 @@ SCENARIO("Test hashing for dense PauliTensor") {
   }
 }
 
+SCENARIO("Testing bit-packed PauliTensor") {
+  GIVEN("Strings spanning several words") {
+    DensePauliMap a(130, Pauli::I), b(100, Pauli::I);
+    a.at(0) = Pauli::X;
+    a.at(64) = Pauli::Y;
+    a.at(129) = Pauli::Z;
+    b.at(0) = Pauli::Z;
+    b.at(64) = Pauli::X;
+    b.at(99) = Pauli::Y;
+    SymplecticPauliStabiliser sa(a, 2), sb(b, 1);
+    PauliStabiliser da(a, 2), db(b, 1);
+    THEN("They agree with the unpacked strings") {
+      CHECK(sa.size() == 130);
+      CHECK(sa.get(64) == Pauli::Y);
+      CHECK(sa.get(200) == Pauli::I);
+      CHECK(PauliStabiliser(sa) == da);
+      CHECK(sa.commutes_with(sb) == da.commutes_with(db));
+      CHECK(sa.commutes_with(sb));
+      CHECK(sa.conflicting_indices(sb) == std::set<unsigned>{0, 64});
+      CHECK(sa.own_indices(sb) == std::set<unsigned>{129});
+      CHECK(PauliStabiliser(sa * sb) == da * db);
+      CHECK(PauliStabiliser(sb * sa) == db * da);
+      CHECK(sa.compare(sb) == da.compare(db));
+      CHECK(sa.to_str() == da.to_str());
+      CHECK(SpPauliStabiliser(sa) == SpPauliStabiliser(da));
+    }
+    WHEN("A qubit anticommuting with the other string is changed") {
+      sa.set(99, Pauli::X);
+      THEN("They no longer commute") { CHECK_FALSE(sa.commutes_with(sb)); }
+    }
+  }
+  GIVEN("Strings differing only in trailing identities") {
+    SymplecticPauliString s1({Pauli::Z, Pauli::Y});
+    SymplecticPauliString s2({Pauli::Z, Pauli::Y});
+    s2.set(70, Pauli::X);
+    s2.set(70, Pauli::I);
+    REQUIRE(s2.size() == 71);
+    CHECK(s1 == s2);
+    CHECK(s1.hash_value() == s2.hash_value());
+  }
+  GIVEN("Serialisation") {
+    SymplecticCxPauliTensor yiy({Pauli::Y, Pauli::I, Pauli::Y}, 0.2 * i_);
+    nlohmann::json j = yiy;
+    CHECK(j == nlohmann::json(CxPauliTensor(yiy)));
+    CHECK(j.get<SymplecticCxPauliTensor>() == yiy);
+  }
+}
+
 SCENARIO("json serialisation of PauliTensor") {
   PauliString xyz({Pauli::X, Pauli::Y, Pauli::Z});
   nlohmann::json j = xyz;
@@ -617,6 +665,37 @@ SCENARIO("Test matrix evaluation") {
               .to_sparse_matrix()
               .isApprox(Complex(4.2 + 0.1 * i_) * ix));
   }
+  GIVEN("Expectation values agree with the matrices") {
+    Eigen::VectorXcd state(8);
+    for (unsigned i = 0; i < 8; ++i) {
+      state(i) = std::polar(0.1 * (i + 1), 1. * i);
+    }
+    const qubit_vector_t qubits{Qubit("b", 0), Qubit(2), Qubit("a", 1)};
+    for (const DensePauliMap &paulis :
+         {DensePauliMap{Pauli::X, Pauli::Y, Pauli::Z},
+          DensePauliMap{Pauli::Y, Pauli::I, Pauli::Y},
+          DensePauliMap{Pauli::I, Pauli::Z, Pauli::X},
+          DensePauliMap{Pauli::I, Pauli::I, Pauli::I}}) {
+      CxPauliTensor dense(paulis, 0.3 - 0.2 * i_);
+      CHECK(std::abs(
+                dense.state_expectation(state) -
+                state.dot(dense.to_sparse_matrix(3) * state)) < EPS);
+      SpCxPauliTensor sparse(
+          {{qubits[0], paulis[0]},
+           {qubits[1], paulis[1]},
+           {qubits[2], paulis[2]}},
+          -1.5);
+      CHECK(std::abs(
+                sparse.state_expectation(state, qubits) -
+                state.dot(sparse.to_sparse_matrix(qubits) * state)) < EPS);
+    }
+    SpPauliString outside({{Qubit(0), Pauli::Z}});
+    REQUIRE_THROWS_AS(
+        outside.state_expectation(state, qubits), std::logic_error);
+    REQUIRE_THROWS_AS(
+        outside.state_expectation(Eigen::VectorXcd::Ones(3)),
+        std::logic_error);
+  }
 }
 
 }  // namespace test_PauliTensor
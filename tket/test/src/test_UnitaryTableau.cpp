@@ -192,6 +192,36 @@ SCENARIO("Correct updates of SymplecticTableau") {
     CHECK(tab0 == tab2);
     CHECK(tab0 == tab3);
   }
+  GIVEN("Gates on a tableau spanning several words per row") {
+    const unsigned n = 100;
+    MatrixXb xmat(2 * n, n), zmat(2 * n, n);
+    xmat << MatrixXb::Identity(n, n), MatrixXb::Zero(n, n);
+    zmat << MatrixXb::Zero(n, n), MatrixXb::Identity(n, n);
+    SymplecticTableau tab0(xmat, zmat, VectorXb::Zero(2 * n));
+    SymplecticTableau tab1 = tab0;
+    REQUIRE(tab0.rank() == 2 * n);
+    std::vector<Pauli> z70(n, Pauli::I), zx(n, Pauli::I);
+    z70[70] = Pauli::Z;
+    zx[3] = Pauli::Z;
+    zx[90] = Pauli::X;
+    tab0.apply_S(70);
+    tab0.apply_CX(3, 90);
+    tab1.apply_pauli_gadget(PauliStabiliser(z70, 0), 1);
+    tab1.apply_pauli_gadget(PauliStabiliser(zx, 0), 3);
+    zx[3] = Pauli::I;
+    tab1.apply_pauli_gadget(PauliStabiliser(zx, 0), 1);
+    zx[3] = Pauli::Z;
+    zx[90] = Pauli::I;
+    tab1.apply_pauli_gadget(PauliStabiliser(zx, 0), 1);
+    CHECK(tab0 == tab1);
+    tab0.row_mult(70, 90);
+    tab0.row_mult(n + 70, n + 3, -1.);
+    CHECK(tab0.rank() == 2 * n);
+    CHECK(tab0.xmat(90, 70));
+    CHECK(tab0.zmat(90, 70));
+    CHECK(tab0.zmat(n + 3, 70));
+    CHECK(tab0.phase(n + 3));
+  }
 }
 
 SCENARIO("Correct creation of UnitaryTableau") {
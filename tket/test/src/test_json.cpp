@@ -12,8 +12,11 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
 #include <boost/range/join.hpp>
 #include <catch2/catch_test_macros.hpp>
+#include <cstdio>
+#include <sstream>
 
 #include "CircuitsForTesting.hpp"
 #include "testutil.hpp"
@@ -21,6 +24,7 @@
 #include "tket/Circuit/CircPool.hpp"
 #include "tket/Circuit/CircUtils.hpp"
 #include "tket/Circuit/Circuit.hpp"
+#include "tket/Circuit/CircuitJsonStream.hpp"
 #include "tket/Circuit/Command.hpp"
 #include "tket/Circuit/ConjugationBox.hpp"
 #include "tket/Circuit/DiagonalBox.hpp"
@@ -696,6 +700,223 @@ SCENARIO("Test Circuit serialization") {
   }
 }
 
+SCENARIO("Test streaming Circuit serialization") {
+  Circuit c(3, 2, "streamed");
+  c.add_op<unsigned>(OpType::Rz, 0.2, {0});
+  c.add_op<unsigned>(OpType::CX, {0, 1}, "grp");
+  Circuit inner(2);
+  inner.add_op<unsigned>(OpType::CZ, {0, 1});
+  c.add_box(CircBox(inner), {1, 2});
+  c.add_conditional_gate<unsigned>(OpType::X, {}, {2}, {0}, 1);
+  c.add_op<unsigned>(OpType::Measure, {2, 1});
+  c.add_phase(0.25);
+  c.add_op<unsigned>(OpType::SWAP, {0, 1});
+  c.replace_SWAPs();
+  c.qubit_discard(Qubit(2));
+  GIVEN("The streaming writer") {
+    std::stringstream ss;
+    circuit_to_json_stream(c, ss);
+    THEN("It produces the same JSON as the DOM serialization") {
+      REQUIRE(nlohmann::json::parse(ss.str()) == nlohmann::json(c));
+    }
+    THEN("The streaming reader recovers the circuit") {
+      const Circuit new_c = circuit_from_json_stream(ss);
+      REQUIRE(c.circuit_equality(new_c));
+      REQUIRE(new_c.get_name() == c.get_name());
+    }
+  }
+  GIVEN("JSON with commands before the qubits") {
+    // nlohmann::json orders keys alphabetically, so "qubits" comes last.
+    const std::string s = nlohmann::json(c).dump();
+    REQUIRE(s.find("\"commands\"") < s.find("\"qubits\""));
+    const Circuit new_c = circuit_from_json_stream(s);
+    REQUIRE(c.circuit_equality(new_c));
+  }
+  GIVEN("JSON with the top-level keys in any order") {
+    // The WASM op uses the second WASM wire, which only exists once
+    // "number_of_ws" has been read.
+    Circuit wc(2, 2);
+    wc.add_wasm_register(2);
+    const std::vector<unsigned> uv = {1};
+    wc.add_op<unsigned>(OpType::H, {0});
+    wc.add_op<UnitID>(
+        std::make_shared<WASMOp>(2, 1, uv, uv, "func", "file"),
+        {Bit(0), Bit(1), WasmState(1)});
+    wc.add_op<unsigned>(OpType::Measure, {1, 1});
+    const nlohmann::json j = wc;
+    std::vector<std::string> keys;
+    for (const auto& [key, value] : j.items()) keys.push_back(key);
+    std::vector<std::vector<std::string>> orders;
+    for (unsigned i = 0; i < keys.size(); ++i) {
+      std::rotate(keys.begin(), keys.begin() + 1, keys.end());
+      orders.push_back(keys);
+      orders.emplace_back(keys.rbegin(), keys.rend());
+    }
+    for (const std::vector<std::string>& order : orders) {
+      std::string s = "{";
+      for (const std::string& key : order) {
+        if (s.size() > 1) s += ",";
+        s += nlohmann::json(key).dump() + ":" + j.at(key).dump();
+      }
+      s += "}";
+      const Circuit new_c = circuit_from_json_stream(s);
+      REQUIRE(wc.circuit_equality(new_c));
+    }
+  }
+  GIVEN("JSON with a missing field") {
+    nlohmann::json j = c;
+    j.erase("qubits");
+    REQUIRE_THROWS_AS(circuit_from_json_stream(j.dump()), JsonError);
+  }
+  GIVEN("Invalid JSON") {
+    REQUIRE_THROWS_AS(
+        circuit_from_json_stream("{\"phase\": "),
+        nlohmann::json::parse_error);
+  }
+}
+
+// Position of the first byte at which two encodings of the same length differ.
+static std::size_t first_difference(
+    const std::string& data, const std::string& other) {
+  REQUIRE(data.size() == other.size());
+  const std::size_t pos =
+      std::mismatch(data.begin(), data.end(), other.begin()).first -
+      data.begin();
+  REQUIRE(pos < data.size());
+  return pos;
+}
+
+SCENARIO("Test binary Circuit serialization") {
+  Circuit c(3, 2, "binary");
+  const Sym a = SymEngine::symbol("a");
+  c.add_op<unsigned>(OpType::Rz, 0.2, {0});
+  c.add_op<unsigned>(OpType::Rx, Expr(a) / 2, {1});
+  c.add_op<unsigned>(OpType::CX, {0, 1}, "grp");
+  c.add_op<unsigned>(OpType::CnRy, 0.1, {0, 1, 2});
+  Circuit inner(2);
+  inner.add_op<unsigned>(OpType::CZ, {0, 1});
+  const CircBox box(inner);
+  c.add_box(box, {1, 2});
+  c.add_box(box, {0, 1});
+  c.add_conditional_gate<unsigned>(OpType::X, {}, {2}, {0}, 1);
+  c.add_op<unsigned>(OpType::Measure, {2, 1});
+  const Qubit anc("anc", 1, 2);
+  c.add_qubit(anc);
+  c.add_op<UnitID>(OpType::H, {anc});
+  c.add_phase(Expr(a) + 0.25);
+  c.add_op<unsigned>(OpType::SWAP, {0, 1});
+  c.replace_SWAPs();
+  c.qubit_create(Qubit(0));
+  c.qubit_discard(Qubit(2));
+  GIVEN("A round trip") {
+    const std::string data = c.to_binary();
+    const Circuit new_c = Circuit::from_binary(data);
+    REQUIRE(c.circuit_equality(new_c));
+    REQUIRE(new_c.get_name() == c.get_name());
+    REQUIRE(new_c.get_commands()[0].get_op_ptr()->get_params() ==
+            c.get_commands()[0].get_op_ptr()->get_params());
+    THEN("It is smaller than the JSON") {
+      REQUIRE(data.size() < nlohmann::json(c).dump().size());
+    }
+    THEN("Repeated boxes are only stored once") {
+      Circuit c2 = c;
+      c2.add_box(box, {0, 1});
+      REQUIRE(c2.to_binary().size() < data.size() + 8);
+    }
+  }
+  GIVEN("A round trip through a file") {
+    const std::string filename = "test_binary_circuit.tkbc";
+    c.to_binary_file(filename);
+    const Circuit new_c = Circuit::from_binary_file(filename);
+    REQUIRE(c.circuit_equality(new_c));
+    std::remove(filename.c_str());
+  }
+  GIVEN("Malformed data") {
+    const std::string data = c.to_binary();
+    REQUIRE_THROWS_AS(Circuit::from_binary(""), BinaryFormatError);
+    REQUIRE_THROWS_AS(Circuit::from_binary("TKBD"), BinaryFormatError);
+    REQUIRE_THROWS_AS(
+        Circuit::from_binary(std::string_view(data).substr(0, data.size() / 2)),
+        BinaryFormatError);
+    std::string newer = data;
+    newer[4] = static_cast<char>(Circuit::binary_format_version + 1);
+    REQUIRE_THROWS_AS(Circuit::from_binary(newer), BinaryFormatError);
+  }
+  GIVEN("Data with an invalid gate type") {
+    Circuit hc(1), xc(1);
+    hc.add_op<unsigned>(OpType::H, {0});
+    xc.add_op<unsigned>(OpType::X, {0});
+    const std::string h_data = hc.to_binary();
+    const std::size_t pos = first_difference(h_data, xc.to_binary());
+    // OpType::Input is not a gate.
+    std::string not_gate = h_data;
+    not_gate[pos] = 0;
+    REQUIRE_THROWS_AS(Circuit::from_binary(not_gate), BinaryFormatError);
+    // A varint far beyond the last OpType.
+    std::string out_of_range = h_data;
+    out_of_range.replace(pos, 1, "\xfe\xff\x7f");
+    REQUIRE_THROWS_AS(Circuit::from_binary(out_of_range), BinaryFormatError);
+  }
+  GIVEN("Corrupted data that is only detected while decoding its contents") {
+    // An operation that is not valid CBOR.
+    std::string bad_cbor = c.to_binary();
+    const std::size_t key = bad_cbor.find("type");
+    REQUIRE(key != std::string::npos);
+    bad_cbor[key - 1] = '\xff';
+    REQUIRE_THROWS_AS(Circuit::from_binary(bad_cbor), BinaryFormatError);
+
+    // A gate with the wrong number of parameters: Rz(0.5) recoded as H.
+    Circuit hc(1), rz(1), rx(1);
+    hc.add_op<unsigned>(OpType::H, {0});
+    rz.add_op<unsigned>(OpType::Rz, 0.5, {0});
+    rx.add_op<unsigned>(OpType::Rx, 0.5, {0});
+    Circuit xc(1);
+    xc.add_op<unsigned>(OpType::X, {0});
+    const std::string h_data = hc.to_binary();
+    std::string bad_params = rz.to_binary();
+    bad_params[first_difference(bad_params, rx.to_binary())] =
+        h_data[first_difference(h_data, xc.to_binary())];
+    REQUIRE_THROWS_AS(Circuit::from_binary(bad_params), BinaryFormatError);
+
+    // A CX whose two arguments are the same qubit.
+    Circuit cx01(3), cx02(3);
+    cx01.add_op<unsigned>(OpType::CX, {0, 1});
+    cx02.add_op<unsigned>(OpType::CX, {0, 2});
+    std::string repeated = cx01.to_binary();
+    const std::size_t arg = first_difference(repeated, cx02.to_binary());
+    repeated[arg] = repeated[arg - 1];
+    REQUIRE_THROWS_AS(Circuit::from_binary(repeated), BinaryFormatError);
+
+    // A bit in the list of qubits.
+    Circuit qc, bc;
+    qc.add_qubit(Qubit("r", 0));
+    bc.add_bit(Bit("r", 0));
+    std::string wrong_unit = qc.to_binary();
+    const std::string b_data = bc.to_binary();
+    const std::size_t type = first_difference(wrong_unit, b_data);
+    wrong_unit[type] = b_data[type];
+    REQUIRE_THROWS_AS(Circuit::from_binary(wrong_unit), BinaryFormatError);
+
+    // A symbolic parameter that SymEngine cannot parse.
+    Circuit sc(1);
+    sc.add_op<unsigned>(OpType::Rz, Expr(SymEngine::symbol("alpha")), {0});
+    std::string bad_expr = sc.to_binary();
+    const std::size_t name = bad_expr.find("alpha");
+    REQUIRE(name != std::string::npos);
+    bad_expr.replace(name, 5, "al)ha");
+    REQUIRE_THROWS_AS(Circuit::from_binary(bad_expr), BinaryFormatError);
+  }
+  GIVEN("A file that cannot be written") {
+    REQUIRE_THROWS_AS(
+        c.to_binary_file("no_such_directory/circuit.tkbc"),
+        std::invalid_argument);
+#ifdef __linux__
+    // Opening /dev/full succeeds but every write to it fails.
+    REQUIRE_THROWS_AS(c.to_binary_file("/dev/full"), std::runtime_error);
+#endif
+  }
+}
+
 SCENARIO("Test device serializations") {
   GIVEN("Architecture") {
     Architecture arc({{Node(0), Node(1)}, {Node(1), Node(2)}});